@@ -16,6 +16,7 @@
 #include "volume.h"
 #include "ray_box_intersect.h"
 #include "parallel_for.h"
+#include "default_num_threads.h"
 #include "ray_mesh_intersect.h"
 #include <iostream>
 #include <iomanip>
@@ -24,6 +25,11 @@
 #include <queue>
 #include <stack>
 
+extern "C"
+{
+#include "raytri.c"
+}
+
 template <typename DerivedV, int DIM>
 template <typename DerivedEle, typename Derivedbb_mins, typename Derivedbb_maxs, typename Derivedelements>
 IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
@@ -72,18 +78,25 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
     }
     MatrixXi SI(BC.rows(),BC.cols());
     {
-      MatrixXDIMS _;
-      MatrixXi IS;
-      igl::sort(BC,1,true,_,IS);
+      // Sort each coordinate independently (and in parallel)
+      MatrixXi IS(BC.rows(),BC.cols());
+      igl::parallel_for(BC.cols(),[&](const int d)
+        {
+          const Matrix<Scalar,Dynamic,1> BCd = BC.col(d);
+          Matrix<Scalar,Dynamic,1> _;
+          VectorXi ISd;
+          igl::sort(BCd,1,true,_,ISd);
+          IS.col(d) = ISd;
+        },2);
       // Need SI(i) to tell which place i would be sorted into
       const int dim = IS.cols();
-      for(int i = 0;i<IS.rows();i++)
-      {
-        for(int d = 0;d<dim;d++)
+      igl::parallel_for(IS.rows(),[&](const int i)
         {
-          SI(IS(i,d),d) = i;
-        }
-      }
+          for(int d = 0;d<dim;d++)
+          {
+            SI(IS(i,d),d) = i;
+          }
+        },10000);
     }
     init(V,Ele,SI,allI);
   }
@@ -100,6 +113,43 @@ void igl::AABB<DerivedV,DIM>::init(
   return init(V,Ele,MatrixXDIMS(),MatrixXDIMS(),VectorXi(),0);
 }
 
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedEle> & Ele,
+    const SplitMethod split_method)
+{
+  using namespace Eigen;
+  if(split_method == MEDIAN_ON_LONGEST_AXIS)
+  {
+    return init(V,Ele);
+  }
+  assert(split_method == SURFACE_AREA_HEURISTIC && "Unknown split method");
+  deinit();
+  if(V.size() == 0 || Ele.size() == 0)
+  {
+    return;
+  }
+  assert(DIM == V.cols() && "V.cols() should matched declared dimension");
+  // Bounding box of each element
+  MatrixXDIMS Ele_mins(Ele.rows(),DIM);
+  MatrixXDIMS Ele_maxs(Ele.rows(),DIM);
+  igl::parallel_for(Ele.rows(),[&](const int e)
+    {
+      Ele_mins.row(e) = V.row(Ele(e,0));
+      Ele_maxs.row(e) = V.row(Ele(e,0));
+      for(int c = 1;c<Ele.cols();c++)
+      {
+        Ele_mins.row(e) = Ele_mins.row(e).cwiseMin(V.row(Ele(e,c)));
+        Ele_maxs.row(e) = Ele_maxs.row(e).cwiseMax(V.row(Ele(e,c)));
+      }
+    },10000);
+  const VectorXi allI = colon<int>(0,Ele.rows()-1);
+  init_surface_area_heuristic(
+    Ele_mins,Ele_maxs,allI,igl::default_num_threads());
+}
+
   template <typename DerivedV, int DIM>
 template <
   typename DerivedEle,
@@ -110,6 +160,21 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
     const Eigen::MatrixBase<DerivedEle> & Ele,
     const Eigen::MatrixBase<DerivedSI> & SI,
     const Eigen::MatrixBase<DerivedI> & I)
+{
+  return init(V,Ele,SI,I,igl::default_num_threads());
+}
+
+  template <typename DerivedV, int DIM>
+template <
+  typename DerivedEle,
+  typename DerivedSI,
+  typename DerivedI>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedEle> & Ele,
+    const Eigen::MatrixBase<DerivedSI> & SI,
+    const Eigen::MatrixBase<DerivedI> & I,
+    const unsigned int num_threads)
 {
   using namespace Eigen;
   using namespace std;
@@ -179,22 +244,227 @@ IGL_INLINE void igl::AABB<DerivedV,DIM>::init(
           }
         }
         //m_depth = 0;
+        // Subtrees are independent so building them concurrently produces
+        // exactly the same tree. They are run as a two-iteration (nested)
+        // parallel_for so that the pool bounds the number of threads. Below
+        // this size scheduling a job costs more than it saves.
+        const int min_parallel = 5000;
+        if(num_threads > 1 && I.rows() >= min_parallel)
+        {
+          m_left = new AABB();
+          m_right = new AABB();
+          igl::parallel_for(2,[&](const int c)
+          {
+            if(c == 0)
+            {
+              m_left->init(V,Ele,SI,LI,num_threads);
+            }else
+            {
+              m_right->init(V,Ele,SI,RI,num_threads);
+            }
+          },2);
+          break;
+        }
         if(LI.rows()>0)
         {
           m_left = new AABB();
-          m_left->init(V,Ele,SI,LI);
+          m_left->init(V,Ele,SI,LI,num_threads);
           //m_depth = std::max(m_depth, m_left->m_depth+1);
         }
         if(RI.rows()>0)
         {
           m_right = new AABB();
-          m_right->init(V,Ele,SI,RI);
+          m_right->init(V,Ele,SI,RI,num_threads);
           //m_depth = std::max(m_depth, m_right->m_depth+1);
         }
       }
   }
 }
 
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::init_surface_area_heuristic(
+    const MatrixXDIMS & Ele_mins,
+    const MatrixXDIMS & Ele_maxs,
+    const Eigen::VectorXi & I,
+    const unsigned int num_threads)
+{
+  using namespace Eigen;
+  using namespace std;
+  typedef AlignedBox<Scalar,DIM> AlignedBoxDIMS;
+  deinit();
+  if(I.size() == 0)
+  {
+    return;
+  }
+  // Split candidates are classified by the centers of the elements' boxes
+  AlignedBoxDIMS center_box;
+  for(int i = 0;i<I.rows();i++)
+  {
+    m_box.extend(Ele_mins.row(I(i)).transpose());
+    m_box.extend(Ele_maxs.row(I(i)).transpose());
+    center_box.extend(
+      (Ele_mins.row(I(i))+Ele_maxs.row(I(i))).transpose()/Scalar(2));
+  }
+  if(I.size() == 1)
+  {
+    m_primitive = I(0);
+    return;
+  }
+  // Half the surface area of a box (generalizes to half the perimeter in 2D)
+  const auto half_area = [](const AlignedBoxDIMS & box)->Scalar
+  {
+    if(box.isEmpty())
+    {
+      return 0;
+    }
+    const VectorDIMS ext = box.diagonal();
+    Scalar area = 0;
+    for(int d = 0;d<DIM;d++)
+    {
+      Scalar face = 1;
+      for(int o = 0;o<DIM;o++)
+      {
+        if(o != d)
+        {
+          face *= ext(o);
+        }
+      }
+      area += face;
+    }
+    return area;
+  };
+  const int num_bins = 16;
+  const VectorDIMS center_min = center_box.min();
+  const VectorDIMS center_ext = center_box.diagonal();
+  const auto bin = [&](const int e, const int d)->int
+  {
+    const Scalar center = (Ele_mins(e,d)+Ele_maxs(e,d))/Scalar(2);
+    const int b = int(num_bins*((center-center_min(d))/center_ext(d)));
+    return std::max(std::min(b,num_bins-1),0);
+  };
+  // Find the plane between bins minimizing the SAH cost over all axes
+  int best_d = -1;
+  int best_b = -1;
+  Scalar best_cost = std::numeric_limits<Scalar>::infinity();
+  for(int d = 0;d<DIM;d++)
+  {
+    if(!(center_ext(d) > 0))
+    {
+      continue;
+    }
+    AlignedBoxDIMS bin_box[num_bins];
+    int bin_count[num_bins] = {0};
+    for(int i = 0;i<I.rows();i++)
+    {
+      const int b = bin(I(i),d);
+      bin_box[b].extend(Ele_mins.row(I(i)).transpose());
+      bin_box[b].extend(Ele_maxs.row(I(i)).transpose());
+      bin_count[b]++;
+    }
+    // Sweep from the right to accumulate the costs of right sides
+    Scalar right_area[num_bins];
+    int right_count[num_bins];
+    {
+      AlignedBoxDIMS box;
+      int count = 0;
+      for(int b = num_bins-1;b>0;b--)
+      {
+        box.extend(bin_box[b]);
+        count += bin_count[b];
+        right_area[b] = half_area(box);
+        right_count[b] = count;
+      }
+    }
+    AlignedBoxDIMS left_box;
+    int left_count = 0;
+    for(int b = 0;b<num_bins-1;b++)
+    {
+      left_box.extend(bin_box[b]);
+      left_count += bin_count[b];
+      if(left_count == 0 || right_count[b+1] == 0)
+      {
+        continue;
+      }
+      const Scalar cost =
+        half_area(left_box)*left_count + right_area[b+1]*right_count[b+1];
+      if(cost < best_cost)
+      {
+        best_cost = cost;
+        best_d = d;
+        best_b = b;
+      }
+    }
+  }
+  VectorXi LI,RI;
+  if(best_d != -1)
+  {
+    int num_left = 0;
+    for(int i = 0;i<I.rows();i++)
+    {
+      num_left += bin(I(i),best_d) <= best_b;
+    }
+    // Accept the plane unless it only peels off a sliver: repeatedly doing so
+    // (e.g., for exponentially spaced centers) would make the tree depth O(n)
+    if(std::min(num_left,int(I.rows())-num_left) >=
+      std::max(int(I.rows())/(2*num_bins),1))
+    {
+      LI.resize(num_left);
+      RI.resize(I.rows()-num_left);
+      int li = 0;
+      int ri = 0;
+      for(int i = 0;i<I.rows();i++)
+      {
+        if(bin(I(i),best_d) <= best_b)
+        {
+          LI(li++) = I(i);
+        }else
+        {
+          RI(ri++) = I(i);
+        }
+      }
+    }
+  }
+  if(LI.size() == 0)
+  {
+    // No useful plane (e.g., all centers coincide or all fall in one bin):
+    // median split along the longest extent of the centers
+    int max_d = 0;
+    center_ext.maxCoeff(&max_d);
+    VectorXi J = I;
+    const int num_left = (I.rows()+1)/2;
+    std::nth_element(J.data(),J.data()+num_left,J.data()+J.size(),
+      [&](const int a, const int b)
+      {
+        return Ele_mins(a,max_d)+Ele_maxs(a,max_d) <
+          Ele_mins(b,max_d)+Ele_maxs(b,max_d);
+      });
+    LI = J.head(num_left);
+    RI = J.tail(I.rows()-num_left);
+  }
+  assert(LI.rows() > 0 && RI.rows() > 0);
+  m_left = new AABB();
+  m_right = new AABB();
+  // See init(V,Ele,SI,I,num_threads)
+  const int min_parallel = 5000;
+  if(num_threads > 1 && I.rows() >= min_parallel)
+  {
+    igl::parallel_for(2,[&](const int c)
+    {
+      if(c == 0)
+      {
+        m_left->init_surface_area_heuristic(Ele_mins,Ele_maxs,LI,num_threads);
+      }else
+      {
+        m_right->init_surface_area_heuristic(Ele_mins,Ele_maxs,RI,num_threads);
+      }
+    },2);
+  }else
+  {
+    m_left->init_surface_area_heuristic(Ele_mins,Ele_maxs,LI,num_threads);
+    m_right->init_surface_area_heuristic(Ele_mins,Ele_maxs,RI,num_threads);
+  }
+}
+
 template <typename DerivedV, int DIM>
 IGL_INLINE bool igl::AABB<DerivedV,DIM>::is_leaf() const
 {
@@ -369,9 +639,27 @@ igl::AABB<DerivedV,DIM>::squared_distance(
   Scalar up_sqr_d,
   int & i,
   Eigen::PlainObjectBase<RowVectorDIMS> & c) const
+{
+  int num_visited = 0;
+  return squared_distance(V,Ele,p,low_sqr_d,up_sqr_d,i,c,num_visited);
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE typename igl::AABB<DerivedV,DIM>::Scalar
+igl::AABB<DerivedV,DIM>::squared_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & p,
+  Scalar low_sqr_d,
+  Scalar up_sqr_d,
+  int & i,
+  Eigen::PlainObjectBase<RowVectorDIMS> & c,
+  int & num_visited) const
 {
   using namespace Eigen;
   using namespace std;
+  num_visited++;
   //assert(low_sqr_d <= up_sqr_d);
   if(low_sqr_d > up_sqr_d)
   {
@@ -395,7 +683,8 @@ igl::AABB<DerivedV,DIM>::squared_distance(
       int i_left;
       RowVectorDIMS c_left = c;
       Scalar sqr_d_left =
-        m_left->squared_distance(V,Ele,p,low_sqr_d,sqr_d,i_left,c_left);
+        m_left->squared_distance(
+          V,Ele,p,low_sqr_d,sqr_d,i_left,c_left,num_visited);
       this->set_min(p,sqr_d_left,i_left,c_left,sqr_d,i,c);
       looked_left = true;
     };
@@ -404,7 +693,8 @@ igl::AABB<DerivedV,DIM>::squared_distance(
       int i_right;
       RowVectorDIMS c_right = c;
       Scalar sqr_d_right =
-        m_right->squared_distance(V,Ele,p,low_sqr_d,sqr_d,i_right,c_right);
+        m_right->squared_distance(
+          V,Ele,p,low_sqr_d,sqr_d,i_right,c_right,num_visited);
       this->set_min(p,sqr_d_right,i_right,c_right,sqr_d,i,c);
       looked_right = true;
     };
@@ -944,6 +1234,23 @@ igl::AABB<DerivedV,DIM>::intersect_ray(
   const Scalar _min_t,
   igl::Hit & hit) const
 {
+  int num_visited = 0;
+  return intersect_ray(V,Ele,origin,dir,_min_t,hit,num_visited);
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool
+igl::AABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  const Scalar _min_t,
+  igl::Hit & hit,
+  int & num_visited) const
+{
+  num_visited++;
   //// Naive, slow
   //std::vector<igl::Hit> hits;
   //intersect_ray(V,Ele,origin,dir,hits);
@@ -978,7 +1285,8 @@ igl::AABB<DerivedV,DIM>::intersect_ray(
   // differnce
   igl::Hit left_hit;
   igl::Hit right_hit;
-  bool left_ret = m_left->intersect_ray(V,Ele,origin,dir,min_t,left_hit);
+  bool left_ret = m_left->intersect_ray(
+    V,Ele,origin,dir,min_t,left_hit,num_visited);
   if(left_ret && left_hit.t<min_t)
   {
     // It's scary that this line doesn't seem to matter....
@@ -989,7 +1297,8 @@ igl::AABB<DerivedV,DIM>::intersect_ray(
   {
     left_ret = false;
   }
-  bool right_ret = m_right->intersect_ray(V,Ele,origin,dir,min_t,right_hit);
+  bool right_ret = m_right->intersect_ray(
+    V,Ele,origin,dir,min_t,right_hit,num_visited);
   if(right_ret && right_hit.t<min_t)
   {
     min_t = right_hit.t;
@@ -1002,6 +1311,165 @@ igl::AABB<DerivedV,DIM>::intersect_ray(
   return left_ret || right_ret;
 }
 
+template <typename DerivedV, int DIM>
+template <
+  typename DerivedEle,
+  typename Derivedorigin,
+  typename Deriveddir,
+  typename DerivedI,
+  typename DerivedT,
+  typename DerivedUV>
+IGL_INLINE void igl::AABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const Eigen::MatrixBase<Derivedorigin> & origin,
+  const Eigen::MatrixBase<Deriveddir> & dir,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedT> & T,
+  Eigen::PlainObjectBase<DerivedUV> & UV) const
+{
+  using namespace Eigen;
+  assert(DIM == 3 && "Rays only make sense in 3D");
+  assert(origin.cols() == 3 && dir.cols() == 3 && "Rays should be 3D");
+  assert(origin.rows() == dir.rows() && "Need as many origins as directions");
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  const Scalar inf = std::numeric_limits<Scalar>::infinity();
+  const int num_rays = origin.rows();
+  I.setConstant(num_rays,1,-1);
+  T.setConstant(num_rays,1,inf);
+  UV.setZero(num_rays,2);
+  if(num_rays == 0 || (m_primitive == -1 && m_left == NULL))
+  {
+    return;
+  }
+  const int packet_size = 4;
+  typedef Array<Scalar,packet_size,1> ArrayP;
+  // Allow for roundoff in the slab tests so that boxes are never culled
+  // wrongly ("Robust BVH Ray Traversal", Ize 2013)
+  const Scalar slack = 1+4*std::numeric_limits<Scalar>::epsilon();
+  const int num_packets = (num_rays+packet_size-1)/packet_size;
+  igl::parallel_for(num_packets,[&](const int pi)
+  {
+    const int r0 = pi*packet_size;
+    const int n = std::min(packet_size,num_rays-r0);
+    ArrayP o[3];
+    ArrayP inv_dir[3];
+    // Current nearest hit (pad unused rays with -inf to keep them inactive)
+    ArrayP min_t = ArrayP::Constant(-inf);
+    min_t.head(n).setConstant(inf);
+    // Should be but can't be const
+    double s_d[packet_size][3];
+    double dir_d[packet_size][3];
+    for(int d = 0;d<3;d++)
+    {
+      o[d].setZero();
+      inv_dir[d].setOnes();
+      for(int r = 0;r<n;r++)
+      {
+        o[d](r) = origin(r0+r,d);
+        // Avoid 0*inf = NaN in slab tests when the origin lies on a slab
+        // plane of a direction's zero coordinate
+        const Scalar dir_rd =
+          std::abs(Scalar(dir(r0+r,d))) < std::numeric_limits<Scalar>::min() ?
+          std::copysign(std::numeric_limits<Scalar>::min(),Scalar(dir(r0+r,d))) :
+          Scalar(dir(r0+r,d));
+        inv_dir[d](r) = Scalar(1)/dir_rd;
+        s_d[r][d] = origin(r0+r,d);
+        dir_d[r][d] = dir(r0+r,d);
+      }
+    }
+    // Slab test of all rays in the packet against a box at once. Returns
+    // entry parameters with +inf for rays missing the box.
+    const auto slab = [&](const AlignedBox<Scalar,DIM> & box)->ArrayP
+    {
+      ArrayP t_near = ArrayP::Zero();
+      ArrayP t_far = min_t;
+      for(int d = 0;d<3;d++)
+      {
+        const ArrayP t1 = (box.min()(d)-o[d])*inv_dir[d];
+        const ArrayP t2 = (box.max()(d)-o[d])*inv_dir[d];
+        t_near = t_near.max(t1.min(t2));
+        t_far = t_far.min(t1.max(t2));
+      }
+      return (t_near <= t_far*slack).select(t_near,inf);
+    };
+    // Pending nodes and their entry parameters: when popped, rays whose
+    // nearest hit so far is before the box are skipped.
+    std::vector<const AABB *> stack(1,this);
+    std::vector<Scalar> stack_t_near;
+    {
+      const ArrayP t_near = slab(m_box);
+      stack_t_near.insert(stack_t_near.end(),t_near.data(),t_near.data()+packet_size);
+    }
+    while(!stack.empty())
+    {
+      const AABB * node = stack.back();
+      stack.pop_back();
+      const ArrayP t_near_p = Map<const ArrayP>(
+        stack_t_near.data()+stack_t_near.size()-packet_size);
+      // Missed lanes carry inf, which would otherwise pass inf <= inf
+      const Array<bool,packet_size,1> active =
+        (t_near_p < inf) && (t_near_p <= min_t*slack);
+      stack_t_near.resize(stack_t_near.size()-packet_size);
+      if(!active.any())
+      {
+        continue;
+      }
+      if(!node->is_leaf())
+      {
+        const ArrayP l_t_near = slab(node->m_left->m_box);
+        const ArrayP r_t_near = slab(node->m_right->m_box);
+        const bool l_any = (l_t_near < inf).any();
+        const bool r_any = (r_t_near < inf).any();
+        // Visit nearer child first (pushed last)
+        const bool right_first = l_any && r_any &&
+          r_t_near.minCoeff() < l_t_near.minCoeff();
+        const auto push = [&](const AABB * child, const ArrayP & t_near)
+        {
+          stack.push_back(child);
+          stack_t_near.insert(
+            stack_t_near.end(),t_near.data(),t_near.data()+packet_size);
+        };
+        if(right_first)
+        {
+          push(node->m_left,l_t_near);
+          push(node->m_right,r_t_near);
+        }else
+        {
+          if(r_any) { push(node->m_right,r_t_near); }
+          if(l_any) { push(node->m_left,l_t_near); }
+        }
+        continue;
+      }
+      const int f = node->m_primitive;
+      // Should be but can't be const
+      RowVector3d v0 = V.row(Ele(f,0)).template cast<double>();
+      RowVector3d v1 = V.row(Ele(f,1)).template cast<double>();
+      RowVector3d v2 = V.row(Ele(f,2)).template cast<double>();
+      for(int r = 0;r<n;r++)
+      {
+        double t,u,v;
+        if(active(r) &&
+          intersect_triangle1(
+            s_d[r],dir_d[r],v0.data(),v1.data(),v2.data(),&t,&u,&v) &&
+          t>0 &&
+          // Hits are stored in single precision (see igl::Hit)
+          (float)t < min_t(r))
+        {
+          min_t(r) = (float)t;
+          I(r0+r) = f;
+          UV(r0+r,0) = (float)u;
+          UV(r0+r,1) = (float)v;
+        }
+      }
+    }
+    for(int r = 0;r<n;r++)
+    {
+      T(r0+r) = min_t(r);
+    }
+  },1);
+}
+
 // This is a bullshit template because AABB annoyingly needs templates for bad
 // combinations of 3D V with DIM=2 AABB
 //
@@ -1029,6 +1497,7 @@ template void igl::AABB<Eigen::Matrix<double, -1, 3, 1, -1, 3>, 3>::squared_dist
 // generated by autoexplicit.sh
 template void igl::AABB<Eigen::Matrix<double, -1, 3, 1, -1, 3>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
 template bool igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, igl::Hit&) const;
+template bool igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, std::vector<igl::Hit, std::allocator<igl::Hit> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 2, 1, 1, 2> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 2, 1, 1, 2> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, double, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
@@ -1063,6 +1532,11 @@ template void igl::AABB<Eigen::Matrix<float, -1, 3, 0, -1, 3>, 3>::init<Eigen::M
 template void igl::AABB<Eigen::Matrix<float, -1, 3, 1, -1, 3>, 3>::init<Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&);
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
 template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::Matrix<double, 1, 2, 1, 1, 2> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 2, 1, 1, 2> >&) const;
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::SplitMethod);
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::SplitMethod);
+template double igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, double, double, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&, int&) const;
+template bool igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, double, igl::Hit&, int&) const;
+template void igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
 #ifdef WIN32
 template void igl::AABB<class Eigen::Matrix<double,-1,-1,0,-1,-1>,2>::squared_distance<class Eigen::Matrix<int,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,1,0,-1,1>,class Eigen::Matrix<__int64,-1,1,0,-1,1>,class Eigen::Matrix<double,-1,3,0,-1,3> >(class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<int,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,3,0,-1,3> > &)const;
 template void igl::AABB<class Eigen::Matrix<double,-1,-1,0,-1,-1>,3>::squared_distance<class Eigen::Matrix<int,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,-1,0,-1,-1>,class Eigen::Matrix<double,-1,1,0,-1,1>,class Eigen::Matrix<__int64,-1,1,0,-1,1>,class Eigen::Matrix<double,-1,3,0,-1,3> >(class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<int,-1,-1,0,-1,-1> > const &,class Eigen::MatrixBase<class Eigen::Matrix<double,-1,-1,0,-1,-1> > const &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<__int64,-1,1,0,-1,1> > &,class Eigen::PlainObjectBase<class Eigen::Matrix<double,-1,3,0,-1,3> > &)const;
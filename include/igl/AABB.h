@@ -30,6 +30,17 @@ public:
       typedef Eigen::Matrix<Scalar,1,DIM> RowVectorDIMS;
       typedef Eigen::Matrix<Scalar,DIM,1> VectorDIMS;
       typedef Eigen::Matrix<Scalar,Eigen::Dynamic,DIM> MatrixXDIMS;
+      // How to divide the elements of a node between its two children
+      enum SplitMethod
+      {
+        // Median of barycenters along the longest axis of the node's box
+        // (balanced tree)
+        MEDIAN_ON_LONGEST_AXIS = 0,
+        // Binned surface area heuristic: among candidate planes on all axes
+        // pick the one minimizing area(left)*#left + area(right)*#right
+        SURFACE_AREA_HEURISTIC = 1,
+        NUM_SPLIT_METHODS = 2
+      };
       // Shared pointers are slower...
       AABB * m_left;
       AABB * m_right;
@@ -122,6 +133,22 @@ public:
       IGL_INLINE void init(
           const Eigen::MatrixBase<DerivedV> & V,
           const Eigen::MatrixBase<DerivedEle> & Ele);
+      // Build an Axis-Aligned Bounding Box tree for a given mesh using a given
+      // split method.
+      //
+      // Inputs:
+      //   V  #V by dim list of mesh vertex positions. 
+      //   Ele  #Ele by dim+1 list of mesh indices into #V. 
+      //   split_method  method used to split nodes (see SplitMethod):
+      //     MEDIAN_ON_LONGEST_AXIS  same as init(V,Ele)
+      //     SURFACE_AREA_HEURISTIC  better trees when elements vary wildly in
+      //       size (e.g., CAD meshes), at the cost of a slower build. The tree
+      //       may be unbalanced, so its serialization may be much larger.
+      template <typename DerivedEle>
+      IGL_INLINE void init(
+          const Eigen::MatrixBase<DerivedV> & V,
+          const Eigen::MatrixBase<DerivedEle> & Ele,
+          const SplitMethod split_method);
       // Build an Axis-Aligned Bounding Box tree for a given mesh.
       //
       // Inputs:
@@ -137,9 +164,21 @@ public:
       template <typename DerivedEle, typename DerivedSI, typename DerivedI>
       IGL_INLINE void init(
           const Eigen::MatrixBase<DerivedV> & V,
-          const Eigen::MatrixBase<DerivedEle> & Ele, 
+          const Eigen::MatrixBase<DerivedEle> & Ele,
           const Eigen::MatrixBase<DerivedSI> & SI,
           const Eigen::MatrixBase<DerivedI>& I);
+      // Inputs:
+      //   num_threads  if greater than 1, subtrees above a size cutoff are
+      //     built concurrently by the igl::parallel_for thread pool (of
+      //     igl::default_num_threads() threads). The resulting tree does not
+      //     depend on num_threads. {igl::default_num_threads()}
+      template <typename DerivedEle, typename DerivedSI, typename DerivedI>
+      IGL_INLINE void init(
+          const Eigen::MatrixBase<DerivedV> & V,
+          const Eigen::MatrixBase<DerivedEle> & Ele,
+          const Eigen::MatrixBase<DerivedSI> & SI,
+          const Eigen::MatrixBase<DerivedI>& I,
+          const unsigned int num_threads);
       // Return whether at leaf node
       IGL_INLINE bool is_leaf() const;
       // Find the indices of elements containing given point: this makes sense
@@ -230,6 +269,20 @@ public:
         const Scalar up_sqr_d,
         int & i,
         Eigen::PlainObjectBase<RowVectorDIMS> & c) const;
+      // Inputs:
+      //   num_visited  number of tree nodes visited so far, see output
+      // Outputs:
+      //   num_visited  incremented by the number of nodes visited by this query
+      template <typename DerivedEle>
+      IGL_INLINE Scalar squared_distance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele, 
+        const RowVectorDIMS & p,
+        const Scalar low_sqr_d,
+        const Scalar up_sqr_d,
+        int & i,
+        Eigen::PlainObjectBase<RowVectorDIMS> & c,
+        int & num_visited) const;
       // Default low_sqr_d
       template <typename DerivedEle>
       IGL_INLINE Scalar squared_distance(
@@ -255,6 +308,40 @@ public:
         const RowVectorDIMS & origin,
         const RowVectorDIMS & dir,
         igl::Hit & hit) const;
+      // First hits of many rays at once. Rays are traced in packets of
+      // consecutive rows sharing a single traversal of the tree (box tests
+      // are vectorized across each packet), so rays that are close to each
+      // other (e.g., with the same origin) should be stored consecutively.
+      // Packets are traced in parallel. Results match calling intersect_ray
+      // for each ray, up to which element is reported when several are hit
+      // at exactly the same t.
+      //
+      // Inputs:
+      //   V  #V by 3 list of vertex positions
+      //   Ele  #Ele by 3 list of triangle indices
+      //   origin  #R by 3 list of ray origins
+      //   dir  #R by 3 list of ray directions
+      // Outputs:
+      //   I  #R list of indices into Ele of first hit, -1 if ray misses
+      //   T  #R list of parameters of first hit so that hit = origin + T*dir,
+      //     infinity if ray misses
+      //   UV  #R by 2 list of barycentric coordinates of first hit (see
+      //     igl::Hit), 0 if ray misses
+      template <
+        typename DerivedEle,
+        typename Derivedorigin,
+        typename Deriveddir,
+        typename DerivedI,
+        typename DerivedT,
+        typename DerivedUV>
+      IGL_INLINE void intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele, 
+        const Eigen::MatrixBase<Derivedorigin> & origin,
+        const Eigen::MatrixBase<Deriveddir> & dir,
+        Eigen::PlainObjectBase<DerivedI> & I,
+        Eigen::PlainObjectBase<DerivedT> & T,
+        Eigen::PlainObjectBase<DerivedUV> & UV) const;
 //private:
       template <typename DerivedEle>
       IGL_INLINE bool intersect_ray(
@@ -264,6 +351,21 @@ public:
         const RowVectorDIMS & dir,
         const Scalar min_t,
         igl::Hit & hit) const;
+      // First hit with t < min_t
+      //
+      // Inputs:
+      //   num_visited  number of tree nodes visited so far, see output
+      // Outputs:
+      //   num_visited  incremented by the number of nodes visited by this query
+      template <typename DerivedEle>
+      IGL_INLINE bool intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele, 
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        const Scalar min_t,
+        igl::Hit & hit,
+        int & num_visited) const;
 
 
 public:
@@ -325,6 +427,21 @@ public:
         Eigen::PlainObjectBase<DerivedI> & I,
         Eigen::PlainObjectBase<DerivedC> & C) const;
 private:
+      // Build subtree splitting with SURFACE_AREA_HEURISTIC. Falls back to a
+      // median split when no plane separates more than a sliver of elements,
+      // so that the depth stays O(log #I).
+      //
+      // Inputs:
+      //   Ele_mins  #Ele by dim list of element bounding box min corners
+      //   Ele_maxs  #Ele by dim list of element bounding box max corners
+      //   I  #I list of indices into Ele of elements to include
+      //   num_threads  if greater than 1, large subtrees are built
+      //     concurrently (see init(V,Ele,SI,I,num_threads))
+      IGL_INLINE void init_surface_area_heuristic(
+        const MatrixXDIMS & Ele_mins,
+        const MatrixXDIMS & Ele_maxs,
+        const Eigen::VectorXi & I,
+        const unsigned int num_threads);
       template < 
         typename DerivedEle,
         typename Derivedother_V,
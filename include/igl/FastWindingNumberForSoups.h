@@ -4337,7 +4337,7 @@ inline void BVH<N>::traverseParallelHelper(
                 if (nnodes[s] < parallel_threshold) {
                     continue;
                 }
-                if (parallel_count == taski) {
+                if (parallel_count == INT_TYPE(taski)) {
                     break;
                 }
                 ++parallel_count;
@@ -4544,13 +4544,13 @@ inline void BVH<N>::initNode(UT_Array<Node>& nodes, Node &node, const Box<T,NAXE
             for (childi = 0; childi < N; ++childi) {
                 sub_nboxes = sub_indices[childi+1]-sub_indices[childi];
                 if (sub_nboxes >= PARALLEL_THRESHOLD) {
-                    if (counted_parallel == taski) {
+                    if (counted_parallel == INT_TYPE(taski)) {
                         break;
                     }
                     ++counted_parallel;
                 }
             }
-            UT_ASSERT_P(counted_parallel == taski);
+            UT_ASSERT_P(counted_parallel == INT_TYPE(taski));
 
             UT_Array<Node>& local_nodes = parallel_nodes[taski];
             // Preallocate an overestimate of the number of nodes needed.
@@ -4650,14 +4650,14 @@ inline void BVH<N>::initNodeReorder(UT_Array<Node>& nodes, Node &node, const Box
     INT_TYPE sub_nboxes0 = sub_indices[1]-sub_indices[0];
     if (sub_nboxes0 <= max_items_per_leaf) {
         leaf_sizes[0] = sub_nboxes0;
-        for (int j = 0; j < sub_nboxes0; ++j)
+        for (INT_TYPE j = 0; j < sub_nboxes0; ++j)
             leaf_indices.append(sub_indices[0][j]);
         ++nleaves;
     }
     INT_TYPE sub_nboxes1 = sub_indices[2]-sub_indices[1];
     if (sub_nboxes1 <= max_items_per_leaf) {
         leaf_sizes[nleaves] = sub_nboxes1;
-        for (int j = 0; j < sub_nboxes1; ++j)
+        for (INT_TYPE j = 0; j < sub_nboxes1; ++j)
             leaf_indices.append(sub_indices[1][j]);
         ++nleaves;
     }
@@ -4665,7 +4665,7 @@ inline void BVH<N>::initNodeReorder(UT_Array<Node>& nodes, Node &node, const Box
         INT_TYPE sub_nboxes = sub_indices[i+1]-sub_indices[i];
         if (sub_nboxes <= max_items_per_leaf) {
             leaf_sizes[nleaves] = sub_nboxes;
-            for (int j = 0; j < sub_nboxes; ++j)
+            for (INT_TYPE j = 0; j < sub_nboxes; ++j)
                 leaf_indices.append(sub_indices[i][j]);
             ++nleaves;
         }
@@ -4693,7 +4693,7 @@ inline void BVH<N>::initNodeReorder(UT_Array<Node>& nodes, Node &node, const Box
         for (INT_TYPE i = 0; i < nleaves; ++i) {
             INT_TYPE sub_nboxes = leaf_sizes[i];
             sub_indices[i] = indices+index_move_distance;
-            for (int j = 0; j < sub_nboxes; ++j)
+            for (INT_TYPE j = 0; j < sub_nboxes; ++j)
                 indices[index_move_distance+j] = leaf_indices[index_move_distance+j];
             index_move_distance += sub_nboxes;
         }
@@ -5213,7 +5213,7 @@ inline void BVH<N>::split(const Box<T,NAXES>& axes_minmax, const BOX_TYPE* boxes
           },
           [&parallel_boxes,&parallel_counts,&span_boxes,&span_counts](int t)
           {
-            for(int i = 0;i<NSPANS;i++)
+            for(INT_TYPE i = 0;i<NSPANS;i++)
             {
               span_counts[i] += parallel_counts[t*NSPANS + i];
               span_boxes[i].combine(parallel_boxes[t*NSPANS + i]);
@@ -5275,7 +5275,7 @@ inline void BVH<N>::split(const Box<T,NAXES>& axes_minmax, const BOX_TYPE* boxes
 
     SRC_INT_TYPE*const indices_end = indices+nboxes;
 
-    if (split_index == -1) {
+    if (split_index == INT_TYPE(-1)) {
         // No split was anywhere close to balanced, so we fall back to searching for one.
 
         // First, find the span containing the "balance" point, namely where left_counts goes from
@@ -5376,7 +5376,7 @@ inline void BVH<N>::adjustParallelChildNodes(INT_TYPE nparallel, UT_Array<Node>&
     //UTparallelFor(UT_BlockedRange<INT_TYPE>(0,nparallel), [&node,&nodes,&parallel_nodes,&sub_indices](const UT_BlockedRange<INT_TYPE>& r) {
         INT_TYPE counted_parallel = 0;
         INT_TYPE childi = 0;
-        for(int taski = 0;taski < nparallel; taski++)
+        for(INT_TYPE taski = 0;taski < nparallel; taski++)
         {
         //for (INT_TYPE taski = r.begin(), end = r.end(); taski < end; ++taski) {
             // First, find which child this is
@@ -6484,7 +6484,7 @@ inline void UT_SolidAngle<T,S>::init(
                 ((T*)&current_box_data.myAverageP[1])[i] = local_P[1];
                 ((T*)&current_box_data.myAverageP[2])[i] = local_P[2];
             }
-            for (int i = nchildren; i < BVH_N; ++i)
+            for (int i = nchildren; i < int(BVH_N); ++i)
             {
                 // Set to zero, just to avoid false positives for uses of uninitialized memory.
                 ((T*)&current_box_data.myN[0])[i] = 0;
@@ -6519,7 +6519,7 @@ inline void UT_SolidAngle<T,S>::init(
                 const UT_Vector3T<T> maxPDiff = SYSmax(local_P-UT_Vector3T<T>(local_box.getMin()), UT_Vector3T<T>(local_box.getMax())-local_P);
                 ((T*)&current_box_data.myMaxPDist2)[i] = maxPDiff.length2();
             }
-            for (int i = nchildren; i < BVH_N; ++i)
+            for (int i = nchildren; i < int(BVH_N); ++i)
             {
                 // This child is non-existent.  If we set myMaxPDist2 to infinity, it will never
                 // use the approximation, and the traverseVector function can check for EMPTY.
@@ -6594,7 +6594,7 @@ inline void UT_SolidAngle<T,S>::init(
                     ((T*)&current_box_data.my2Nzzx_Nxzz)[i] = child_data_array[i].my2Nzzx_Nxzz;
                     ((T*)&current_box_data.my2Nzzy_Nyzz)[i] = child_data_array[i].my2Nzzy_Nyzz;
                 }
-                for (int i = nchildren; i < BVH_N; ++i)
+                for (int i = nchildren; i < int(BVH_N); ++i)
                 {
                     // Set to zero, just to avoid false positives for uses of uninitialized memory.
                     for (int j = 0; j < 3; ++j)
@@ -6815,7 +6815,7 @@ inline T UT_SolidAngle<T, S>::computeSolidAngle(const UT_Vector3T<T> &query_poin
             descend_bitmask = (~_mm_movemask_ps(V4SF(mask.vector))) & allchildbits;
 
             T sum = Omega_approx[0];
-            for (int i = 1; i < BVH_N; ++i)
+            for (int i = 1; i < int(BVH_N); ++i)
                 sum += Omega_approx[i];
             *data_for_parent = sum;
 
@@ -0,0 +1,701 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "FlatAABB.h"
+#include "EPS.h"
+#include "barycenter.h"
+#include "doublearea.h"
+#include "point_simplex_squared_distance.h"
+#include "volume.h"
+#include "ray_box_intersect.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <functional>
+#include <limits>
+
+extern "C"
+{
+#include "raytri.c"
+}
+
+// Traversal stacks hold at most one pending sibling per level. Median splits
+// keep the depth below log2(#Ele)+1 and serialized trees of depth d need 2^d
+// rows, so a fixed size stack never overflows in practice.
+#define IGL_FLAT_AABB_MAX_DEPTH 64
+
+template <typename DerivedV, int DIM>
+IGL_INLINE void igl::FlatAABB<DerivedV,DIM>::deinit()
+{
+  m_nodes.clear();
+  m_elements.clear();
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE void igl::FlatAABB<DerivedV,DIM>::init(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedEle> & Ele,
+    const int max_leaf_size)
+{
+  deinit();
+  if(V.size() == 0 || Ele.size() == 0)
+  {
+    return;
+  }
+  assert(DIM == V.cols() && "V.cols() should matched declared dimension");
+  assert(max_leaf_size >= 1 && "Leaves must hold at least one primitive");
+  MatrixXDIMS BC;
+  if(Ele.cols() == 1)
+  {
+    // points
+    BC = V;
+  }else
+  {
+    // Simplices
+    barycenter(V,Ele,BC);
+  }
+  const int m = Ele.rows();
+  m_elements.resize(m);
+  for(int e = 0;e<m;e++)
+  {
+    m_elements[e] = e;
+  }
+  // A full binary tree with ceil(m/max_leaf_size) leaves
+  m_nodes.reserve(2*((m+max_leaf_size-1)/max_leaf_size));
+  // Returns index of the node built for m_elements[begin,end)
+  const std::function<int(const int,const int)> build =
+    [&](const int begin, const int end)->int
+  {
+    const int n = m_nodes.size();
+    m_nodes.push_back(Node());
+    const int count = end-begin;
+    if(count <= max_leaf_size)
+    {
+      Eigen::AlignedBox<Scalar,DIM> box;
+      for(int e = begin;e<end;e++)
+      {
+        for(int c = 0;c<Ele.cols();c++)
+        {
+          box.extend(V.row(Ele(m_elements[e],c)).transpose());
+        }
+      }
+      m_nodes[n].m_box = box;
+      m_nodes[n].m_offset = begin;
+      m_nodes[n].m_count = count;
+      return n;
+    }
+    // Split at median of barycenters along longest direction of barycenters'
+    // box. Ties are broken by index so the split is deterministic.
+    Eigen::AlignedBox<Scalar,DIM> bc_box;
+    for(int e = begin;e<end;e++)
+    {
+      bc_box.extend(BC.row(m_elements[e]).transpose());
+    }
+    int max_d = -1;
+    bc_box.diagonal().maxCoeff(&max_d);
+    const int mid = begin + (count+1)/2;
+    std::nth_element(
+      m_elements.begin()+begin,
+      m_elements.begin()+mid,
+      m_elements.begin()+end,
+      [&BC,max_d](const int a, const int b)->bool
+      {
+        return BC(a,max_d) < BC(b,max_d) ||
+          (BC(a,max_d) == BC(b,max_d) && a < b);
+      });
+    const int left = build(begin,mid);
+    const int right = build(mid,end);
+    m_nodes[n].m_box = m_nodes[left].m_box.merged(m_nodes[right].m_box);
+    m_nodes[n].m_offset = right;
+    m_nodes[n].m_count = 0;
+    return n;
+  };
+  build(0,m);
+}
+
+template <typename DerivedV, int DIM>
+template <
+  typename DerivedEle,
+  typename Derivedbb_mins,
+  typename Derivedbb_maxs,
+  typename Derivedelements>
+IGL_INLINE void igl::FlatAABB<DerivedV,DIM>::init(
+    const Eigen::MatrixBase<DerivedV> & /*V*/,
+    const Eigen::MatrixBase<DerivedEle> & /*Ele*/,
+    const Eigen::MatrixBase<Derivedbb_mins> & bb_mins,
+    const Eigen::MatrixBase<Derivedbb_maxs> & bb_maxs,
+    const Eigen::MatrixBase<Derivedelements> & elements)
+{
+  deinit();
+  if(bb_mins.size() == 0)
+  {
+    return;
+  }
+  assert(bb_mins.rows() == bb_maxs.rows() && "Serial tree arrays must match");
+  assert(bb_mins.cols() == DIM && "Serial tree array dim must match DIM");
+  assert(bb_mins.cols() == bb_maxs.cols() && "Serial tree arrays must match");
+  assert(bb_mins.rows() == elements.rows() &&
+      "Serial tree arrays must match");
+  const auto same_box = [&](const int i, const int j)->bool
+  {
+    return
+      bb_mins.row(i) == bb_mins.row(j) && bb_maxs.row(i) == bb_maxs.row(j);
+  };
+  // Whether every node in the subtree at i has the same box as node r
+  const std::function<bool(const int,const int)> uniform =
+    [&](const int r, const int i)->bool
+  {
+    if(!same_box(r,i))
+    {
+      return false;
+    }
+    return elements(i) != -1 || (uniform(r,2*i+1) && uniform(r,2*i+2));
+  };
+  // Append leaves of subtree at i to m_elements in depth-first order
+  const std::function<void(const int)> gather = [&](const int i)
+  {
+    if(elements(i) != -1)
+    {
+      m_elements.push_back(elements(i));
+      return;
+    }
+    gather(2*i+1);
+    gather(2*i+2);
+  };
+  const std::function<int(const int)> read = [&](const int i)->int
+  {
+    const int n = m_nodes.size();
+    m_nodes.push_back(Node());
+    Eigen::AlignedBox<Scalar,DIM> box;
+    box.extend(bb_mins.row(i).transpose());
+    box.extend(bb_maxs.row(i).transpose());
+    m_nodes[n].m_box = box;
+    if(elements(i) != -1 || uniform(i,i))
+    {
+      const int begin = m_elements.size();
+      gather(i);
+      m_nodes[n].m_offset = begin;
+      m_nodes[n].m_count = m_elements.size()-begin;
+      return n;
+    }
+    read(2*i+1);
+    // m_nodes may be reallocated during recursion
+    const int right = read(2*i+2);
+    m_nodes[n].m_offset = right;
+    m_nodes[n].m_count = 0;
+    return n;
+  };
+  read(0);
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE bool igl::FlatAABB<DerivedV,DIM>::is_leaf(const int n) const
+{
+  return m_nodes[n].m_count > 0;
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE int igl::FlatAABB<DerivedV,DIM>::size() const
+{
+  return m_nodes.size();
+}
+
+template <typename DerivedV, int DIM>
+IGL_INLINE size_t igl::FlatAABB<DerivedV,DIM>::memory_footprint() const
+{
+  return
+    sizeof(*this) +
+    m_nodes.capacity()*sizeof(Node) +
+    m_elements.capacity()*sizeof(int);
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle, typename Derivedq>
+IGL_INLINE std::vector<int> igl::FlatAABB<DerivedV,DIM>::find(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedEle> & Ele,
+    const Eigen::MatrixBase<Derivedq> & q,
+    const bool first) const
+{
+  assert(q.size() == DIM &&
+      "Query dimension should match aabb dimension");
+  assert(Ele.cols() == V.cols()+1 &&
+      "FlatAABB::find only makes sense for (d+1)-simplices");
+  const Scalar epsilon = igl::EPS<Scalar>();
+  std::vector<int> found;
+  if(m_nodes.empty())
+  {
+    return found;
+  }
+  const auto inside_element = [&](const int e)->bool
+  {
+    // Initialize to some value > -epsilon
+    Scalar a1=0,a2=0,a3=0,a4=0;
+    switch(DIM)
+    {
+      case 3:
+        {
+          // Barycentric coordinates
+          typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+          const RowVector3S V1 = V.row(Ele(e,0));
+          const RowVector3S V2 = V.row(Ele(e,1));
+          const RowVector3S V3 = V.row(Ele(e,2));
+          const RowVector3S V4 = V.row(Ele(e,3));
+          a1 = volume_single(V2,V4,V3,(RowVector3S)q);
+          a2 = volume_single(V1,V3,V4,(RowVector3S)q);
+          a3 = volume_single(V1,V4,V2,(RowVector3S)q);
+          a4 = volume_single(V1,V2,V3,(RowVector3S)q);
+          break;
+        }
+      case 2:
+        {
+          // Barycentric coordinates
+          typedef Eigen::Matrix<Scalar,2,1> Vector2S;
+          const Vector2S V1 = V.row(Ele(e,0));
+          const Vector2S V2 = V.row(Ele(e,1));
+          const Vector2S V3 = V.row(Ele(e,2));
+          const Vector2S q2 = q.head(2);
+          a1 = doublearea_single(V1,V2,q2);
+          a2 = doublearea_single(V2,V3,q2);
+          a3 = doublearea_single(V3,V1,q2);
+          break;
+        }
+      default:assert(false);
+    }
+    // Normalization is important for correcting sign
+    Scalar sum = a1+a2+a3+a4;
+    a1 /= sum;
+    a2 /= sum;
+    a3 /= sum;
+    a4 /= sum;
+    return
+      a1>=-epsilon &&
+      a2>=-epsilon &&
+      a3>=-epsilon &&
+      a4>=-epsilon;
+  };
+  int stack[IGL_FLAT_AABB_MAX_DEPTH];
+  int top = 0;
+  stack[top++] = 0;
+  while(top > 0)
+  {
+    const int n = stack[--top];
+    const Node & node = m_nodes[n];
+    if(!node.m_box.contains(q.transpose()))
+    {
+      continue;
+    }
+    if(node.m_count > 0)
+    {
+      for(int e = node.m_offset;e<node.m_offset+node.m_count;e++)
+      {
+        if(inside_element(m_elements[e]))
+        {
+          found.push_back(m_elements[e]);
+          if(first)
+          {
+            return found;
+          }
+        }
+      }
+      continue;
+    }
+    // Visit left (next node) before right
+    assert(top+2 <= IGL_FLAT_AABB_MAX_DEPTH);
+    stack[top++] = node.m_offset;
+    stack[top++] = n+1;
+  }
+  return found;
+}
+
+template <typename DerivedV, int DIM>
+template <typename Derivedbb_mins, typename Derivedbb_maxs, typename Derivedelements>
+IGL_INLINE void igl::FlatAABB<DerivedV,DIM>::serialize(
+    Eigen::PlainObjectBase<Derivedbb_mins> & bb_mins,
+    Eigen::PlainObjectBase<Derivedbb_maxs> & bb_maxs,
+    Eigen::PlainObjectBase<Derivedelements> & elements) const
+{
+  if(m_nodes.empty())
+  {
+    bb_mins.resize(0,DIM);
+    bb_maxs.resize(0,DIM);
+    elements.resize(0,1);
+    return;
+  }
+  // Size of complete binary tree holding a balanced split of count primitives
+  const std::function<int(const int)> range_size = [&](const int count)->int
+  {
+    return count == 1 ? 1 : 1 + 2*range_size((count+1)/2);
+  };
+  // Size of complete binary tree holding subtree at node n (see
+  // AABB::subtree_size)
+  const std::function<int(const int)> subtree_size = [&](const int n)->int
+  {
+    const Node & node = m_nodes[n];
+    if(node.m_count > 0)
+    {
+      return range_size(node.m_count);
+    }
+    return 1 +
+      2*std::max(subtree_size(n+1),subtree_size(node.m_offset));
+  };
+  const int m = subtree_size(0);
+  bb_mins.setZero(m,DIM);
+  bb_maxs.setZero(m,DIM);
+  elements.setConstant(m,1,-1);
+  const std::function<void(const int,const int,const int,const int)>
+    write_range =
+    [&](const int n, const int offset, const int count, const int i)
+  {
+    bb_mins.row(i) = m_nodes[n].m_box.min();
+    bb_maxs.row(i) = m_nodes[n].m_box.max();
+    if(count == 1)
+    {
+      elements(i) = m_elements[offset];
+      return;
+    }
+    write_range(n,offset,(count+1)/2,2*i+1);
+    write_range(n,offset+(count+1)/2,count/2,2*i+2);
+  };
+  const std::function<void(const int,const int)> write =
+    [&](const int n, const int i)
+  {
+    const Node & node = m_nodes[n];
+    if(node.m_count > 0)
+    {
+      write_range(n,node.m_offset,node.m_count,i);
+      return;
+    }
+    bb_mins.row(i) = node.m_box.min();
+    bb_maxs.row(i) = node.m_box.max();
+    write(n+1,2*i+1);
+    write(node.m_offset,2*i+2);
+  };
+  write(0,0);
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE typename igl::FlatAABB<DerivedV,DIM>::Scalar
+igl::FlatAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & p,
+  int & i,
+  Eigen::PlainObjectBase<RowVectorDIMS> & c) const
+{
+  return squared_distance(V,Ele,p,std::numeric_limits<Scalar>::infinity(),i,c);
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE typename igl::FlatAABB<DerivedV,DIM>::Scalar
+igl::FlatAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & p,
+  const Scalar low_sqr_d,
+  const Scalar up_sqr_d,
+  int & i,
+  Eigen::PlainObjectBase<RowVectorDIMS> & c) const
+{
+  if(low_sqr_d > up_sqr_d)
+  {
+    return low_sqr_d;
+  }
+  Scalar sqr_d = up_sqr_d;
+  assert((Ele.cols() == 3 || Ele.cols() == 2 || Ele.cols() == 1)
+    && "Code has only been tested for simplex sizes 3,2,1");
+  if(m_nodes.empty())
+  {
+    return sqr_d;
+  }
+  // Depth-first, nearest child first. Pending nodes are stored with the
+  // squared distance to their box so they can be pruned when popped.
+  int stack[IGL_FLAT_AABB_MAX_DEPTH];
+  Scalar stack_d[IGL_FLAT_AABB_MAX_DEPTH];
+  int top = 0;
+  stack[top] = 0;
+  stack_d[top++] = 0;
+  while(top > 0)
+  {
+    --top;
+    // Once we're below the lower bound there's no need to look further
+    if(low_sqr_d > sqr_d)
+    {
+      break;
+    }
+    if(stack_d[top] >= sqr_d)
+    {
+      continue;
+    }
+    const int n = stack[top];
+    const Node & node = m_nodes[n];
+    if(node.m_count > 0)
+    {
+      for(int e = node.m_offset;e<node.m_offset+node.m_count;e++)
+      {
+        if(low_sqr_d > sqr_d)
+        {
+          break;
+        }
+        RowVectorDIMS c_candidate;
+        Scalar sqr_d_candidate;
+        igl::point_simplex_squared_distance<DIM>(
+          p,V,Ele,m_elements[e],sqr_d_candidate,c_candidate);
+        if(sqr_d_candidate < sqr_d)
+        {
+          i = m_elements[e];
+          c = c_candidate;
+          sqr_d = sqr_d_candidate;
+        }
+      }
+      continue;
+    }
+    const int l = n+1;
+    const int r = node.m_offset;
+    const Scalar l_sqr_d = m_nodes[l].m_box.squaredExteriorDistance(p.transpose());
+    const Scalar r_sqr_d = m_nodes[r].m_box.squaredExteriorDistance(p.transpose());
+    assert(top+2 <= IGL_FLAT_AABB_MAX_DEPTH);
+    // Push farther first so that nearer is popped first
+    if(l_sqr_d < r_sqr_d)
+    {
+      if(r_sqr_d < sqr_d) { stack[top] = r; stack_d[top++] = r_sqr_d; }
+      if(l_sqr_d < sqr_d) { stack[top] = l; stack_d[top++] = l_sqr_d; }
+    }else
+    {
+      if(l_sqr_d < sqr_d) { stack[top] = l; stack_d[top++] = l_sqr_d; }
+      if(r_sqr_d < sqr_d) { stack[top] = r; stack_d[top++] = r_sqr_d; }
+    }
+  }
+  return sqr_d;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE typename igl::FlatAABB<DerivedV,DIM>::Scalar
+igl::FlatAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & p,
+  const Scalar up_sqr_d,
+  int & i,
+  Eigen::PlainObjectBase<RowVectorDIMS> & c) const
+{
+  return squared_distance(V,Ele,p,0.0,up_sqr_d,i,c);
+}
+
+template <typename DerivedV, int DIM>
+template <
+  typename DerivedEle,
+  typename DerivedP,
+  typename DerivedsqrD,
+  typename DerivedI,
+  typename DerivedC>
+IGL_INLINE void igl::FlatAABB<DerivedV,DIM>::squared_distance(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const Eigen::MatrixBase<DerivedP> & P,
+  Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedC> & C) const
+{
+  assert(P.cols() == V.cols() && "cols in P should match dim of cols in V");
+  sqrD.resize(P.rows(),1);
+  I.resize(P.rows(),1);
+  C.resizeLike(P);
+  igl::parallel_for(P.rows(),[&](int p)
+    {
+      RowVectorDIMS Pp = P.row(p), c;
+      int Ip = -1;
+      sqrD(p) = squared_distance(V,Ele,Pp,Ip,c);
+      I(p) = Ip;
+      C.row(p).head(DIM) = c;
+    },
+    10000);
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool
+igl::FlatAABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  std::vector<igl::Hit> & hits) const
+{
+  hits.clear();
+  if(m_nodes.empty())
+  {
+    return false;
+  }
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  const Scalar t0 = 0;
+  const Scalar t1 = std::numeric_limits<Scalar>::infinity();
+  // Should be but can't be const
+  Eigen::Vector3d s_d = origin.transpose().template cast<double>();
+  Eigen::Vector3d dir_d = dir.transpose().template cast<double>();
+  int stack[IGL_FLAT_AABB_MAX_DEPTH];
+  int top = 0;
+  stack[top++] = 0;
+  while(top > 0)
+  {
+    const int n = stack[--top];
+    const Node & node = m_nodes[n];
+    {
+      Scalar _1,_2;
+      if(!ray_box_intersect(origin,dir,node.m_box,t0,t1,_1,_2))
+      {
+        continue;
+      }
+    }
+    if(node.m_count > 0)
+    {
+      for(int e = node.m_offset;e<node.m_offset+node.m_count;e++)
+      {
+        const int f = m_elements[e];
+        Eigen::RowVector3d v0 = V.row(Ele(f,0)).template cast<double>();
+        Eigen::RowVector3d v1 = V.row(Ele(f,1)).template cast<double>();
+        Eigen::RowVector3d v2 = V.row(Ele(f,2)).template cast<double>();
+        double t,u,v;
+        if(intersect_triangle1(
+          s_d.data(),dir_d.data(),v0.data(),v1.data(),v2.data(),&t,&u,&v) &&
+          t>0)
+        {
+          hits.push_back({f,(int)-1,(float)u,(float)v,(float)t});
+        }
+      }
+      continue;
+    }
+    // Visit left (next node) before right
+    assert(top+2 <= IGL_FLAT_AABB_MAX_DEPTH);
+    stack[top++] = node.m_offset;
+    stack[top++] = n+1;
+  }
+  return hits.size() > 0;
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool
+igl::FlatAABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  igl::Hit & hit) const
+{
+  return intersect_ray(
+    V,Ele,origin,dir,std::numeric_limits<Scalar>::infinity(),hit);
+}
+
+template <typename DerivedV, int DIM>
+template <typename DerivedEle>
+IGL_INLINE bool
+igl::FlatAABB<DerivedV,DIM>::intersect_ray(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedEle> & Ele,
+  const RowVectorDIMS & origin,
+  const RowVectorDIMS & dir,
+  const Scalar _min_t,
+  igl::Hit & hit) const
+{
+  if(m_nodes.empty())
+  {
+    return false;
+  }
+  assert((Ele.size() == 0 || Ele.cols() == 3) && "Elements should be triangles");
+  Scalar min_t = _min_t;
+  const Scalar t0 = 0;
+  bool any_hit = false;
+  // Should be but can't be const
+  Eigen::Vector3d s_d = origin.transpose().template cast<double>();
+  Eigen::Vector3d dir_d = dir.transpose().template cast<double>();
+  // Pending nodes are stored with the entry parameter of their box so they
+  // can be pruned when popped after min_t shrinks.
+  int stack[IGL_FLAT_AABB_MAX_DEPTH];
+  Scalar stack_t[IGL_FLAT_AABB_MAX_DEPTH];
+  int top = 0;
+  {
+    Scalar tmin,tmax;
+    if(!ray_box_intersect(origin,dir,m_nodes[0].m_box,t0,min_t,tmin,tmax))
+    {
+      return false;
+    }
+    stack[top] = 0;
+    stack_t[top++] = tmin;
+  }
+  while(top > 0)
+  {
+    --top;
+    if(stack_t[top] > min_t)
+    {
+      continue;
+    }
+    const int n = stack[top];
+    const Node & node = m_nodes[n];
+    if(node.m_count > 0)
+    {
+      for(int e = node.m_offset;e<node.m_offset+node.m_count;e++)
+      {
+        const int f = m_elements[e];
+        Eigen::RowVector3d v0 = V.row(Ele(f,0)).template cast<double>();
+        Eigen::RowVector3d v1 = V.row(Ele(f,1)).template cast<double>();
+        Eigen::RowVector3d v2 = V.row(Ele(f,2)).template cast<double>();
+        double t,u,v;
+        if(intersect_triangle1(
+          s_d.data(),dir_d.data(),v0.data(),v1.data(),v2.data(),&t,&u,&v) &&
+          t>0 && t<min_t)
+        {
+          hit = {f,(int)-1,(float)u,(float)v,(float)t};
+          min_t = t;
+          any_hit = true;
+        }
+      }
+      continue;
+    }
+    const int l = n+1;
+    const int r = node.m_offset;
+    Scalar l_tmin,r_tmin,_;
+    const bool l_hit =
+      ray_box_intersect(origin,dir,m_nodes[l].m_box,t0,min_t,l_tmin,_);
+    const bool r_hit =
+      ray_box_intersect(origin,dir,m_nodes[r].m_box,t0,min_t,r_tmin,_);
+    assert(top+2 <= IGL_FLAT_AABB_MAX_DEPTH);
+    // Push farther first so that nearer is popped first
+    if(l_hit && r_hit && r_tmin < l_tmin)
+    {
+      stack[top] = l; stack_t[top++] = l_tmin;
+      stack[top] = r; stack_t[top++] = r_tmin;
+    }else
+    {
+      if(r_hit) { stack[top] = r; stack_t[top++] = r_tmin; }
+      if(l_hit) { stack[top] = l; stack_t[top++] = l_tmin; }
+    }
+  }
+  return any_hit;
+}
+
+#undef IGL_FLAT_AABB_MAX_DEPTH
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>;
+template class igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>;
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int);
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int);
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::init<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&);
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::serialize<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&) const;
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template void igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template double igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::squared_distance<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, int&, Eigen::PlainObjectBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> >&) const;
+template bool igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, igl::Hit&) const;
+template bool igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::intersect_ray<Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, Eigen::Matrix<double, 1, 3, 1, 1, 3> const&, std::vector<igl::Hit, std::allocator<igl::Hit> >&) const;
+template std::vector<int, std::allocator<int> > igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 2>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 1, -1, 1, 1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, -1, 1, 1, -1> > const&, bool) const;
+template std::vector<int, std::allocator<int> > igl::FlatAABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3>::find<Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, 1, -1, 1, 1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, -1, 1, 1, -1> > const&, bool) const;
+#endif
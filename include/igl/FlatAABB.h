@@ -0,0 +1,230 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_FLAT_AABB_H
+#define IGL_FLAT_AABB_H
+
+#include "Hit.h"
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+#include <vector>
+namespace igl
+{
+  // Linearized (flat) version of igl::AABB. All nodes live in a single
+  // contiguous array in depth-first order: the left child of node n is always
+  // node n+1 and internal nodes store the index of their right child. Leaves
+  // hold up to `max_leaf_size` primitives as a contiguous range of a single
+  // permutation of the element indices. Building performs O(1) allocations
+  // (rather than one per node) and traversals are iterative and walk memory
+  // mostly front-to-back.
+  //
+  // The query API mirrors igl::AABB. The mesh (V,Ele) is stored and managed by
+  // the caller and each routine here simply takes it as references (it better
+  // not change between calls).
+  //
+  // See also: AABB.h
+  template <typename DerivedV, int DIM>
+    class FlatAABB
+    {
+public:
+      typedef typename DerivedV::Scalar Scalar;
+      typedef Eigen::Matrix<Scalar,1,DIM> RowVectorDIMS;
+      typedef Eigen::Matrix<Scalar,DIM,1> VectorDIMS;
+      typedef Eigen::Matrix<Scalar,Eigen::Dynamic,DIM> MatrixXDIMS;
+      struct Node
+      {
+        Eigen::AlignedBox<Scalar,DIM> m_box;
+        // Internal node: index into m_nodes of right child (left child is
+        // always the next node). Leaf: offset into m_elements.
+        int m_offset;
+        // Number of primitives in leaf, 0 for internal nodes
+        int m_count;
+        EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+      };
+      // #nodes list of nodes in depth-first order, root is m_nodes[0]
+      std::vector<Node,Eigen::aligned_allocator<Node> > m_nodes;
+      // #Ele list of indices into Ele so that each leaf owns the range
+      // m_elements[m_offset,m_offset+m_count)
+      std::vector<int> m_elements;
+      FlatAABB(){}
+      IGL_INLINE void deinit();
+      // Build a flat Axis-Aligned Bounding Box tree for a given mesh.
+      //
+      // Inputs:
+      //   V  #V by dim list of mesh vertex positions.
+      //   Ele  #Ele by dim+1 list of mesh indices into #V.
+      //   max_leaf_size  maximum number of primitives stored in a leaf {4}
+      template <typename DerivedEle>
+      IGL_INLINE void init(
+          const Eigen::MatrixBase<DerivedV> & V,
+          const Eigen::MatrixBase<DerivedEle> & Ele,
+          const int max_leaf_size = 4);
+      // Build from a serialization of a previous (Flat)AABB tree (see
+      // igl::AABB::serialize and serialize below). Subtrees whose nodes all
+      // share the same box are collapsed into a single multi-primitive leaf,
+      // so that `serialize` followed by `init` reproduces this tree.
+      //
+      // Inputs:
+      //   V  #V by dim list of mesh vertex positions.
+      //   Ele  #Ele by dim+1 list of mesh indices into #V.
+      //   bb_mins  max_tree by dim list of bounding box min corner positions
+      //   bb_maxs  max_tree by dim list of bounding box max corner positions
+      //   elements  max_tree list of element or (not leaf id) indices into Ele
+      template <
+        typename DerivedEle,
+        typename Derivedbb_mins,
+        typename Derivedbb_maxs,
+        typename Derivedelements>
+        IGL_INLINE void init(
+            const Eigen::MatrixBase<DerivedV> & V,
+            const Eigen::MatrixBase<DerivedEle> & Ele,
+            const Eigen::MatrixBase<Derivedbb_mins> & bb_mins,
+            const Eigen::MatrixBase<Derivedbb_maxs> & bb_maxs,
+            const Eigen::MatrixBase<Derivedelements> & elements);
+      // Return whether node n is a leaf
+      IGL_INLINE bool is_leaf(const int n) const;
+      // Number of nodes
+      IGL_INLINE int size() const;
+      // Number of bytes used to store the tree (nodes and element indices)
+      IGL_INLINE size_t memory_footprint() const;
+      // Find the indices of elements containing given point: this makes sense
+      // when Ele is a co-dimension 0 simplex (tets in 3D, triangles in 2D).
+      //
+      // Inputs:
+      //   V  #V by dim list of mesh vertex positions. **Should be same as used to
+      //     construct mesh.**
+      //   Ele  #Ele by dim+1 list of mesh indices into #V. **Should be same as used to
+      //     construct mesh.**
+      //   q  dim row-vector query position
+      //   first  whether to only return first element containing q
+      // Returns:
+      //   list of indices of elements containing q
+      template <typename DerivedEle, typename Derivedq>
+      IGL_INLINE std::vector<int> find(
+          const Eigen::MatrixBase<DerivedV> & V,
+          const Eigen::MatrixBase<DerivedEle> & Ele,
+          const Eigen::MatrixBase<Derivedq> & q,
+          const bool first=false) const;
+      // Serialize this class into the same 3 arrays as igl::AABB::serialize
+      // (complete binary tree, children of i at 2*i+1 and 2*i+2). Leaves with
+      // more than one primitive are expanded into balanced subtrees whose
+      // nodes all carry the leaf's box.
+      //
+      // Outputs:
+      //   bb_mins  max_tree by dim list of bounding box min corner positions
+      //   bb_maxs  max_tree by dim list of bounding box max corner positions
+      //   elements  max_tree list of element or (not leaf id) indices into Ele
+      template <
+        typename Derivedbb_mins,
+        typename Derivedbb_maxs,
+        typename Derivedelements>
+        IGL_INLINE void serialize(
+            Eigen::PlainObjectBase<Derivedbb_mins> & bb_mins,
+            Eigen::PlainObjectBase<Derivedbb_maxs> & bb_maxs,
+            Eigen::PlainObjectBase<Derivedelements> & elements) const;
+      // Compute squared distance to a query point
+      //
+      // Inputs:
+      //   V  #V by dim list of vertex positions
+      //   Ele  #Ele by dim list of simplex indices
+      //   p  dim-long query point
+      // Outputs:
+      //   i  facet index corresponding to smallest distances
+      //   c  closest point
+      // Returns squared distance
+      template <typename DerivedEle>
+      IGL_INLINE Scalar squared_distance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & p,
+        int & i,
+        Eigen::PlainObjectBase<RowVectorDIMS> & c) const;
+      // Inputs:
+      //   low_sqr_d  lower bound on squared distance, specified maximum squared
+      //     distance
+      //   up_sqr_d  current upper bounded on squared distance, current minimum
+      //     squared distance (only consider distances less than this), see
+      //     output.
+      template <typename DerivedEle>
+      IGL_INLINE Scalar squared_distance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & p,
+        const Scalar low_sqr_d,
+        const Scalar up_sqr_d,
+        int & i,
+        Eigen::PlainObjectBase<RowVectorDIMS> & c) const;
+      // Default low_sqr_d
+      template <typename DerivedEle>
+      IGL_INLINE Scalar squared_distance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & p,
+        const Scalar up_sqr_d,
+        int & i,
+        Eigen::PlainObjectBase<RowVectorDIMS> & c) const;
+      // Compute the squared distance from all query points in P to the
+      // _closest_ points on the primitives stored in the hierarchy for the
+      // mesh (V,Ele).
+      //
+      // Inputs:
+      //   V  #V by dim list of vertex positions
+      //   Ele  #Ele by dim list of simplex indices
+      //   P  #P by dim list of query points
+      // Outputs:
+      //   sqrD  #P list of squared distances
+      //   I  #P list of indices into Ele of closest primitives
+      //   C  #P by dim list of closest points
+      template <
+        typename DerivedEle,
+        typename DerivedP,
+        typename DerivedsqrD,
+        typename DerivedI,
+        typename DerivedC>
+      IGL_INLINE void squared_distance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const Eigen::MatrixBase<DerivedP> & P,
+        Eigen::PlainObjectBase<DerivedsqrD> & sqrD,
+        Eigen::PlainObjectBase<DerivedI> & I,
+        Eigen::PlainObjectBase<DerivedC> & C) const;
+      // All hits
+      template <typename DerivedEle>
+      IGL_INLINE bool intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        std::vector<igl::Hit> & hits) const;
+      // First hit
+      template <typename DerivedEle>
+      IGL_INLINE bool intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        igl::Hit & hit) const;
+      // First hit with t < min_t
+      template <typename DerivedEle>
+      IGL_INLINE bool intersect_ray(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedEle> & Ele,
+        const RowVectorDIMS & origin,
+        const RowVectorDIMS & dir,
+        const Scalar min_t,
+        igl::Hit & hit) const;
+    };
+}
+
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "FlatAABB.cpp"
+#endif
+
+#endif
@@ -0,0 +1,218 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_INDEXED_PRIORITY_QUEUE_H
+#define IGL_INDEXED_PRIORITY_QUEUE_H
+#include <Eigen/Core>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace igl
+{
+  // Min-priority queue of integer keys 0,...,n-1 (e.g., edge indices) which
+  // knows where each key is stored: the priority of a key already in the
+  // queue can be decreased or increased and a key can be removed in O(log n)
+  // time. Unlike igl::min_heap with lazy deletion, each key is stored at most
+  // once so the size never exceeds n.
+  //
+  // Keys with equal priority are ordered by key (smaller key first), so the
+  // order of pops is the same as for igl::min_heap<std::tuple<Scalar,int,...> >.
+  //
+  // Templates:
+  //   Scalar  type of priorities
+  //
+  // Example:
+  //   igl::IndexedPriorityQueue<double> Q(E.rows());
+  //   Q.update(e,cost);
+  //   ...
+  //   const int e = Q.top();
+  //   Q.pop();
+  template <typename Scalar>
+  class IndexedPriorityQueue
+  {
+    public:
+      IndexedPriorityQueue(){}
+      // Inputs:
+      //   n  number of keys
+      IndexedPriorityQueue(const int n){ resize(n); }
+      // Remove all keys and set the number of keys
+      //
+      // Inputs:
+      //   n  number of keys
+      void resize(const int n)
+      {
+        assert(n >= 0);
+        m_heap.clear();
+        m_pos.assign(n,-1);
+      }
+      // Insert all keys at once in O(n) time
+      //
+      // Inputs:
+      //   P  n list of priorities so that key i has priority P(i)
+      template <typename DerivedP>
+      void init(const Eigen::MatrixBase<DerivedP> & P)
+      {
+        resize(P.size());
+        m_heap.resize(P.size());
+        for(int i = 0;i<P.size();i++)
+        {
+          m_heap[i] = Entry(P(i),i);
+          m_pos[i] = i;
+        }
+        for(int k = int(m_heap.size())/2-1;k>=0;k--)
+        {
+          sift_down(k);
+        }
+      }
+      // Number of keys (n)
+      int num_keys() const { return int(m_pos.size()); }
+      // Number of keys currently in the queue
+      int size() const { return int(m_heap.size()); }
+      bool empty() const { return m_heap.empty(); }
+      void clear()
+      {
+        for(const Entry & entry : m_heap) { m_pos[entry.second] = -1; }
+        m_heap.clear();
+      }
+      // Whether key i is in the queue
+      bool contains(const int i) const
+      {
+        assert(i >= 0 && i < num_keys());
+        return m_pos[i] != -1;
+      }
+      // Priority of key i (which must be in the queue)
+      Scalar priority(const int i) const
+      {
+        assert(contains(i));
+        return m_heap[m_pos[i]].first;
+      }
+      // Key with the smallest priority
+      int top() const
+      {
+        assert(!empty());
+        return m_heap.front().second;
+      }
+      // Smallest priority
+      Scalar top_priority() const
+      {
+        assert(!empty());
+        return m_heap.front().first;
+      }
+      // Remove key with the smallest priority
+      void pop()
+      {
+        assert(!empty());
+        remove(top());
+      }
+      // Insert key i with priority p or, if i is already in the queue, change
+      // its priority to p
+      void update(const int i, const Scalar p)
+      {
+        assert(i >= 0 && i < num_keys());
+        if(m_pos[i] == -1)
+        {
+          m_pos[i] = int(m_heap.size());
+          m_heap.emplace_back(p,i);
+          sift_up(m_pos[i]);
+        }else
+        {
+          const int k = m_pos[i];
+          const Entry old = m_heap[k];
+          m_heap[k].first = p;
+          if(less(m_heap[k],old))
+          {
+            sift_up(k);
+          }else
+          {
+            sift_down(k);
+          }
+        }
+      }
+      // Remove key i from the queue (no-op if it is not in the queue)
+      void remove(const int i)
+      {
+        assert(i >= 0 && i < num_keys());
+        const int k = m_pos[i];
+        if(k == -1)
+        {
+          return;
+        }
+        m_pos[i] = -1;
+        const Entry last = m_heap.back();
+        m_heap.pop_back();
+        if(k < int(m_heap.size()))
+        {
+          // Move last entry into the hole
+          m_heap[k] = last;
+          m_pos[last.second] = k;
+          if(k > 0 && less(last,m_heap[(k-1)/2]))
+          {
+            sift_up(k);
+          }else
+          {
+            sift_down(k);
+          }
+        }
+      }
+    private:
+      typedef std::pair<Scalar,int> Entry;
+      static bool less(const Entry & a, const Entry & b)
+      {
+        return a.first < b.first || (a.first == b.first && a.second < b.second);
+      }
+      void sift_up(int k)
+      {
+        const Entry entry = m_heap[k];
+        while(k > 0)
+        {
+          const int parent = (k-1)/2;
+          if(!less(entry,m_heap[parent]))
+          {
+            break;
+          }
+          m_heap[k] = m_heap[parent];
+          m_pos[m_heap[k].second] = k;
+          k = parent;
+        }
+        m_heap[k] = entry;
+        m_pos[entry.second] = k;
+      }
+      void sift_down(int k)
+      {
+        const int size = int(m_heap.size());
+        const Entry entry = m_heap[k];
+        while(true)
+        {
+          int child = 2*k+1;
+          if(child >= size)
+          {
+            break;
+          }
+          if(child+1 < size && less(m_heap[child+1],m_heap[child]))
+          {
+            child++;
+          }
+          if(!less(m_heap[child],entry))
+          {
+            break;
+          }
+          m_heap[k] = m_heap[child];
+          m_pos[m_heap[k].second] = k;
+          k = child;
+        }
+        m_heap[k] = entry;
+        m_pos[entry.second] = k;
+      }
+      // Binary heap of (priority,key) pairs
+      std::vector<Entry> m_heap;
+      // n list of positions of keys in m_heap, -1 if not in the queue
+      std::vector<int> m_pos;
+  };
+}
+
+#endif
@@ -0,0 +1,124 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "MappedFile.h"
+#include <cstdio>
+#if defined(_WIN32)
+#  include <windows.h>
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <sys/stat.h>
+#  include <unistd.h>
+#endif
+
+IGL_INLINE bool igl::MappedFile::open(const std::string & path)
+{
+  close();
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(
+    path.c_str(),GENERIC_READ,FILE_SHARE_READ,NULL,OPEN_EXISTING,
+    FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,NULL);
+  if(file != INVALID_HANDLE_VALUE)
+  {
+    LARGE_INTEGER size;
+    if(GetFileSizeEx(file,&size) && size.QuadPart == 0)
+    {
+      CloseHandle(file);
+      m_is_open = true;
+      return true;
+    }
+    HANDLE mapping = CreateFileMappingA(file,NULL,PAGE_READONLY,0,0,NULL);
+    if(mapping != NULL)
+    {
+      const void * view = MapViewOfFile(mapping,FILE_MAP_READ,0,0,0);
+      if(view != NULL)
+      {
+        m_file = file;
+        m_mapping = mapping;
+        m_data = static_cast<const char *>(view);
+        m_size = size_t(size.QuadPart);
+        m_mapped = true;
+        m_is_open = true;
+        return true;
+      }
+      CloseHandle(mapping);
+    }
+    CloseHandle(file);
+  }
+#else
+  const int fd = ::open(path.c_str(),O_RDONLY);
+  if(fd == -1)
+  {
+    return false;
+  }
+  struct stat st;
+  if(fstat(fd,&st) == 0 && S_ISREG(st.st_mode))
+  {
+    if(st.st_size == 0)
+    {
+      ::close(fd);
+      m_is_open = true;
+      return true;
+    }
+    void * map = mmap(NULL,size_t(st.st_size),PROT_READ,MAP_PRIVATE,fd,0);
+    if(map != MAP_FAILED)
+    {
+#  ifdef MADV_SEQUENTIAL
+      madvise(map,size_t(st.st_size),MADV_SEQUENTIAL);
+#  endif
+      // The mapping stays valid after closing the file descriptor
+      ::close(fd);
+      m_data = static_cast<const char *>(map);
+      m_size = size_t(st.st_size);
+      m_mapped = true;
+      m_is_open = true;
+      return true;
+    }
+  }
+  ::close(fd);
+#endif
+  // Fall back to reading the whole file
+  FILE * fp = fopen(path.c_str(),"rb");
+  if(fp == NULL)
+  {
+    return false;
+  }
+  char chunk[1<<16];
+  size_t count;
+  while((count = fread(chunk,1,sizeof(chunk),fp)) > 0)
+  {
+    m_buffer.insert(m_buffer.end(),chunk,chunk+count);
+  }
+  fclose(fp);
+  m_data = m_buffer.empty() ? nullptr : m_buffer.data();
+  m_size = m_buffer.size();
+  m_is_open = true;
+  return true;
+}
+
+IGL_INLINE void igl::MappedFile::close()
+{
+  if(m_mapped)
+  {
+#if defined(_WIN32)
+    UnmapViewOfFile(m_data);
+    CloseHandle(m_mapping);
+    CloseHandle(m_file);
+    m_mapping = nullptr;
+    m_file = nullptr;
+#else
+    munmap(const_cast<char *>(m_data),m_size);
+#endif
+  }
+  m_buffer.clear();
+  m_buffer.shrink_to_fit();
+  m_data = nullptr;
+  m_size = 0;
+  m_mapped = false;
+  m_is_open = false;
+}
@@ -0,0 +1,70 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_MAPPED_FILE_H
+#define IGL_MAPPED_FILE_H
+#include "igl_inline.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace igl
+{
+  // Read-only view of the contents of a file. The file is memory mapped if
+  // possible (mmap on unix, MapViewOfFile on windows) so that its pages are
+  // loaded lazily by the operating system without copying them into a buffer.
+  // If mapping fails (e.g., for pipes) the file is read into memory instead.
+  //
+  // Example:
+  //   igl::MappedFile file;
+  //   if(!file.open("mesh.obj")) { ... }
+  //   const char * begin = file.data();
+  //   const char * end = file.data() + file.size();
+  class MappedFile
+  {
+    public:
+      MappedFile(){}
+      // Inputs:
+      //   path  path to file
+      MappedFile(const std::string & path){ open(path); }
+      ~MappedFile(){ close(); }
+      MappedFile(const MappedFile &) = delete;
+      MappedFile & operator=(const MappedFile &) = delete;
+      // Map a file, closing any previously opened file
+      //
+      // Inputs:
+      //   path  path to file
+      // Returns true on success, false if the file could not be opened
+      IGL_INLINE bool open(const std::string & path);
+      // Unmap the file
+      IGL_INLINE void close();
+      // Returns whether a file is open
+      bool is_open() const { return m_is_open; }
+      // Returns pointer to the first byte of the file (nullptr if the file is
+      // empty)
+      const char * data() const { return m_data; }
+      // Returns number of bytes in the file
+      size_t size() const { return m_size; }
+    private:
+      bool m_is_open = false;
+      const char * m_data = nullptr;
+      size_t m_size = 0;
+      // Whether m_data points into a mapping rather than m_buffer
+      bool m_mapped = false;
+#ifdef _WIN32
+      void * m_file = nullptr;
+      void * m_mapping = nullptr;
+#endif
+      std::vector<char> m_buffer;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "MappedFile.cpp"
+#endif
+
+#endif
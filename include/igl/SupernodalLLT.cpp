@@ -0,0 +1,478 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "SupernodalLLT.h"
+#include "parallel_for.h"
+#include <Eigen/Cholesky>
+#include <Eigen/OrderingMethods>
+#include <algorithm>
+#include <cassert>
+
+namespace
+{
+  // Call func(i) for i in [0,num_panels), in parallel only if there is
+  // enough work (in flops) to pay for it
+  template <typename Func>
+  void for_each_panel(const int num_panels, const double work, const Func & func)
+  {
+    if(num_panels > 1 && work > 1e6)
+    {
+      igl::parallel_for(num_panels,func,2);
+    }else
+    {
+      for(int i = 0;i<num_panels;i++) { func(i); }
+    }
+  }
+}
+
+template <typename Scalar>
+IGL_INLINE igl::SupernodalLLT<Scalar> & igl::SupernodalLLT<Scalar>::compute(
+  const SparseMatrixS & A)
+{
+  analyzePattern(A);
+  factorize(A);
+  return *this;
+}
+
+template <typename Scalar>
+IGL_INLINE void igl::SupernodalLLT<Scalar>::analyzePattern(
+  const SparseMatrixS & A)
+{
+  assert(A.rows() == A.cols() && "A should be square");
+  const int n = A.rows();
+  m_n = n;
+  m_L.clear();
+  m_info = Eigen::InvalidInput;
+
+  // Upper triangle of P A P': column k lists the rows j ≤ k of row k of L
+  const auto permuted_upper = [&A](
+    const Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic,int> & P)
+  {
+    SparseMatrixS C(A.rows(),A.cols());
+    C.template selfadjointView<Eigen::Upper>() =
+      A.template selfadjointView<Eigen::Lower>().twistedBy(P);
+    C.makeCompressed();
+    return C;
+  };
+  // Elimination tree (Liu's algorithm with path compression)
+  const auto etree = [n](const SparseMatrixS & C, std::vector<int> & parent)
+  {
+    std::vector<int> ancestor(n,-1);
+    parent.assign(n,-1);
+    for(int k = 0;k<n;k++)
+    {
+      for(typename SparseMatrixS::InnerIterator it(C,k);it;++it)
+      {
+        int i = it.row();
+        while(i != -1 && i < k)
+        {
+          const int next = ancestor[i];
+          ancestor[i] = k;
+          if(next == -1) { parent[i] = k; }
+          i = next;
+        }
+      }
+    }
+  };
+
+  // Fill-reducing ordering (the same as Eigen::SimplicialLLT's default)
+  Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic,int> amd;
+  {
+    SparseMatrixS C;
+    C = A.template selfadjointView<Eigen::Lower>();
+    Eigen::AMDOrdering<int> ordering;
+    Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic,int> amd_inv;
+    ordering(C,amd_inv);
+    amd = amd_inv.inverse();
+  }
+  // Postorder the elimination tree so that chains of columns (and thus
+  // supernodes) are contiguous
+  std::vector<int> parent;
+  {
+    std::vector<int> amd_parent;
+    etree(permuted_upper(amd),amd_parent);
+    std::vector<int> head(n,-1),next(n,-1);
+    for(int j = n-1;j>=0;j--)
+    {
+      if(amd_parent[j] != -1)
+      {
+        next[j] = head[amd_parent[j]];
+        head[amd_parent[j]] = j;
+      }
+    }
+    std::vector<int> post_inv(n);
+    std::vector<int> stack;
+    int k = 0;
+    for(int j = 0;j<n;j++)
+    {
+      if(amd_parent[j] != -1) { continue; }
+      stack.push_back(j);
+      while(!stack.empty())
+      {
+        const int p = stack.back();
+        const int i = head[p];
+        if(i == -1)
+        {
+          stack.pop_back();
+          post_inv[p] = k++;
+        }else
+        {
+          head[p] = next[i];
+          stack.push_back(i);
+        }
+      }
+    }
+    m_P.resize(n);
+    for(int i = 0;i<n;i++)
+    {
+      m_P.indices()(i) = post_inv[amd.indices()(i)];
+    }
+    m_Pinv = m_P.inverse();
+    parent.assign(n,-1);
+    for(int j = 0;j<n;j++)
+    {
+      if(amd_parent[j] != -1)
+      {
+        parent[post_inv[j]] = post_inv[amd_parent[j]];
+      }
+    }
+  }
+  const SparseMatrixS C = permuted_upper(m_P);
+
+  // Column counts of L by traversing the row subtrees
+  std::vector<int> count(n,1);
+  {
+    std::vector<int> mark(n,-1);
+    for(int k = 0;k<n;k++)
+    {
+      mark[k] = k;
+      for(typename SparseMatrixS::InnerIterator it(C,k);it;++it)
+      {
+        for(int i = it.row();mark[i] != k;i = parent[i])
+        {
+          count[i]++;
+          mark[i] = k;
+        }
+      }
+    }
+  }
+
+  // Fundamental supernodes: chains j→j+1 where j+1 has the pattern of j minus
+  // the diagonal and no other child
+  std::vector<int> num_children(n,0);
+  for(int j = 0;j<n;j++) { if(parent[j] != -1) { num_children[parent[j]]++; } }
+  std::vector<int> first;
+  for(int j = 0;j<n;j++)
+  {
+    if(!(j > 0 &&
+      parent[j-1] == j && count[j-1] == count[j]+1 && num_children[j] == 1))
+    {
+      first.push_back(j);
+    }
+  }
+  first.push_back(n);
+
+  // Relaxed amalgamation: merge a supernode into the supernode right after it
+  // if that is its parent and not too many explicit zeros are introduced
+  m_first.clear();
+  {
+    // current merged supernode
+    int cur_first = 0,cur_cols = 0,cur_rows = 0;
+    double cur_zeros = 0;
+    const auto entries = [](const double cols, const double rows)
+    {
+      return cols*rows - cols*(cols-1)/2;
+    };
+    for(int s = 0;s+1<int(first.size());s++)
+    {
+      const int cols = first[s+1]-first[s];
+      const int rows = count[first[s]];
+      if(s > 0 && parent[first[s]-1] == first[s])
+      {
+        const int merged_cols = cur_cols + cols;
+        const int merged_rows = cur_cols + rows;
+        const double merged_zeros =
+          cur_zeros + double(cur_cols)*(cur_cols + rows - cur_rows);
+        const double z = merged_zeros/entries(merged_cols,merged_rows);
+        if(merged_cols <= 4 ||
+          (merged_cols <= 16 && z < 0.8) ||
+          (merged_cols <= 48 && z < 0.1) ||
+          z < 0.05)
+        {
+          cur_cols = merged_cols;
+          cur_rows = merged_rows;
+          cur_zeros = merged_zeros;
+          continue;
+        }
+      }
+      if(s > 0) { m_first.push_back(cur_first); }
+      cur_first = first[s];
+      cur_cols = cols;
+      cur_rows = rows;
+      cur_zeros = 0;
+    }
+    if(n > 0) { m_first.push_back(cur_first); }
+    m_first.push_back(n);
+  }
+  const int ns = int(m_first.size())-1;
+  std::vector<int> supernode(n);
+  for(int s = 0;s<ns;s++)
+  {
+    std::fill(supernode.begin()+m_first[s],supernode.begin()+m_first[s+1],s);
+  }
+  m_parent.resize(ns);
+  m_children_start.assign(ns+1,0);
+  for(int s = 0;s<ns;s++)
+  {
+    const int j = parent[m_first[s+1]-1];
+    m_parent[s] = j == -1 ? -1 : supernode[j];
+    if(j != -1) { m_children_start[m_parent[s]+1]++; }
+  }
+  for(int s = 0;s<ns;s++) { m_children_start[s+1] += m_children_start[s]; }
+  m_children.resize(m_children_start[ns]);
+  {
+    std::vector<int> fill(m_children_start.begin(),m_children_start.end()-1);
+    for(int s = 0;s<ns;s++)
+    {
+      if(m_parent[s] != -1) { m_children[fill[m_parent[s]]++] = s; }
+    }
+  }
+
+  // Symbolic factorization: rows of each supernode are the rows of its
+  // columns in A and the rows of its children's fronts below their columns
+  SparseMatrixS Cl(n,n);
+  Cl.template selfadjointView<Eigen::Lower>() =
+    A.template selfadjointView<Eigen::Lower>().twistedBy(m_P);
+  Cl.makeCompressed();
+  m_rows.clear();
+  m_rows_start.assign(1,0);
+  m_relative.assign(ns,std::vector<int>());
+  m_A_rows.resize(Cl.nonZeros());
+  std::vector<int> level(ns,0);
+  {
+    std::vector<int> mark(n,-1);
+    std::vector<int> position(n);
+    for(int s = 0;s<ns;s++)
+    {
+      const int f = m_first[s];
+      const int l = m_first[s+1]-1;
+      const size_t start = m_rows.size();
+      for(int j = f;j<=l;j++) { m_rows.push_back(j); }
+      const auto add = [&](const int i)
+      {
+        if(i > l && mark[i] != s)
+        {
+          mark[i] = s;
+          m_rows.push_back(i);
+        }
+      };
+      for(int j = f;j<=l;j++)
+      {
+        for(typename SparseMatrixS::InnerIterator it(Cl,j);it;++it)
+        {
+          add(it.row());
+        }
+      }
+      for(int c = m_children_start[s];c<m_children_start[s+1];c++)
+      {
+        const int child = m_children[c];
+        const int child_cols = m_first[child+1]-m_first[child];
+        for(int r = m_rows_start[child]+child_cols;r<m_rows_start[child+1];r++)
+        {
+          add(m_rows[r]);
+        }
+        level[s] = std::max(level[s],level[child]+1);
+      }
+      std::sort(m_rows.begin()+start+(l-f+1),m_rows.end());
+      m_rows_start.push_back(int(m_rows.size()));
+      for(size_t r = start;r<m_rows.size();r++)
+      {
+        position[m_rows[r]] = int(r-start);
+      }
+      for(int c = m_children_start[s];c<m_children_start[s+1];c++)
+      {
+        const int child = m_children[c];
+        const int child_cols = m_first[child+1]-m_first[child];
+        for(int r = m_rows_start[child]+child_cols;r<m_rows_start[child+1];r++)
+        {
+          m_relative[child].push_back(position[m_rows[r]]);
+        }
+      }
+      for(int j = f;j<=l;j++)
+      {
+        for(int p = Cl.outerIndexPtr()[j];p<Cl.outerIndexPtr()[j+1];p++)
+        {
+          m_A_rows[p] = position[Cl.innerIndexPtr()[p]];
+        }
+      }
+    }
+  }
+  m_levels.clear();
+  for(int s = 0;s<ns;s++)
+  {
+    if(level[s] >= int(m_levels.size())) { m_levels.resize(level[s]+1); }
+    m_levels[level[s]].push_back(s);
+  }
+}
+
+template <typename Scalar>
+IGL_INLINE void igl::SupernodalLLT<Scalar>::factorize(const SparseMatrixS & A)
+{
+  assert(A.rows() == m_n && A.cols() == m_n && "A should match analyzePattern");
+  SparseMatrixS C(m_n,m_n);
+  C.template selfadjointView<Eigen::Lower>() =
+    A.template selfadjointView<Eigen::Lower>().twistedBy(m_P);
+  C.makeCompressed();
+  assert(C.nonZeros() == Eigen::Index(m_A_rows.size()) &&
+    "A should have the same sparsity pattern as passed to analyzePattern");
+  const int ns = num_supernodes();
+  m_L.assign(ns,MatrixXS());
+  // Update matrices (Schur complements) waiting to be added to their parents
+  std::vector<MatrixXS> U(ns);
+  std::vector<char> success(ns,true);
+  // Block size of the dense partial factorizations
+  const int nb = 64;
+  const auto factor_supernode = [&](const int s)
+  {
+    const int f = m_first[s];
+    const int k = m_first[s+1]-f;
+    const int m = m_rows_start[s+1]-m_rows_start[s];
+    // Assemble front
+    MatrixXS F = MatrixXS::Zero(m,m);
+    for(int j = 0;j<k;j++)
+    {
+      for(int p = C.outerIndexPtr()[f+j];p<C.outerIndexPtr()[f+j+1];p++)
+      {
+        F(m_A_rows[p],j) += C.valuePtr()[p];
+      }
+    }
+    for(int c = m_children_start[s];c<m_children_start[s+1];c++)
+    {
+      const int child = m_children[c];
+      const std::vector<int> & rel = m_relative[child];
+      const MatrixXS & Uc = U[child];
+      for(int b = 0;b<Uc.cols();b++)
+      {
+        for(int a = b;a<Uc.rows();a++)
+        {
+          F(rel[a],rel[b]) += Uc(a,b);
+        }
+      }
+      U[child] = MatrixXS();
+    }
+    // Factor first k columns and update the rest (right-looking, blocked)
+    for(int j0 = 0;j0<k;j0+=nb)
+    {
+      const int jb = std::min(nb,k-j0);
+      auto D = F.block(j0,j0,jb,jb);
+      Eigen::LLT<MatrixXS> llt(D);
+      if(llt.info() != Eigen::Success)
+      {
+        success[s] = false;
+        return;
+      }
+      D.template triangularView<Eigen::Lower>() = llt.matrixLLT();
+      const int r = m-j0-jb;
+      if(r == 0)
+      {
+        continue;
+      }
+      auto B = F.block(j0+jb,j0,r,jb);
+      // B ← B L⁻ᵀ
+      for_each_panel((r+nb-1)/nb,double(r)*jb*jb,[&](const int i)
+      {
+        auto Bi = B.middleRows(i*nb,std::min(nb,r-i*nb));
+        D.template triangularView<Eigen::Lower>().transpose().
+          template solveInPlace<Eigen::OnTheRight>(Bi);
+      });
+      // Lower triangle of trailing matrix ← trailing matrix - B Bᵀ
+      for_each_panel((r+nb-1)/nb,double(r)*r*jb,[&](const int i)
+      {
+        const int c0 = i*nb;
+        const int w = std::min(nb,r-c0);
+        F.block(j0+jb+c0,j0+jb+c0,r-c0,w).noalias() -=
+          B.bottomRows(r-c0) * B.middleRows(c0,w).transpose();
+      });
+    }
+    m_L[s] = F.leftCols(k);
+    U[s] = F.bottomRightCorner(m-k,m-k);
+  };
+  for(const std::vector<int> & level : m_levels)
+  {
+    igl::parallel_for(
+      int(level.size()),[&](const int i){ factor_supernode(level[i]); },2);
+  }
+  m_info = std::all_of(success.begin(),success.end(),[](const char ok){ return ok; }) ?
+    Eigen::Success : Eigen::NumericalIssue;
+}
+
+template <typename Scalar>
+IGL_INLINE typename igl::SupernodalLLT<Scalar>::MatrixXS
+  igl::SupernodalLLT<Scalar>::solve(const MatrixXS & B) const
+{
+  assert(m_info == Eigen::Success && "Factorization should have succeeded");
+  assert(B.rows() == m_n && "B should have n rows");
+  MatrixXS X = m_P * B;
+  const int ns = num_supernodes();
+  int max_below = 0;
+  for(int s = 0;s<ns;s++)
+  {
+    max_below = std::max(max_below,
+      (m_rows_start[s+1]-m_rows_start[s])-(m_first[s+1]-m_first[s]));
+  }
+  MatrixXS Y(max_below,B.cols());
+  // L Y = P B
+  for(int s = 0;s<ns;s++)
+  {
+    const int f = m_first[s];
+    const int k = m_first[s+1]-f;
+    const int r = m_rows_start[s+1]-m_rows_start[s]-k;
+    const int * below = m_rows.data()+m_rows_start[s]+k;
+    auto Xs = X.middleRows(f,k);
+    m_L[s].topRows(k).template triangularView<Eigen::Lower>().solveInPlace(Xs);
+    if(r > 0)
+    {
+      Y.topRows(r).noalias() = m_L[s].bottomRows(r) * Xs;
+      for(int a = 0;a<r;a++) { X.row(below[a]) -= Y.row(a); }
+    }
+  }
+  // Lᵀ X = Y
+  for(int s = ns-1;s>=0;s--)
+  {
+    const int f = m_first[s];
+    const int k = m_first[s+1]-f;
+    const int r = m_rows_start[s+1]-m_rows_start[s]-k;
+    const int * below = m_rows.data()+m_rows_start[s]+k;
+    auto Xs = X.middleRows(f,k);
+    if(r > 0)
+    {
+      for(int a = 0;a<r;a++) { Y.row(a) = X.row(below[a]); }
+      Xs.noalias() -= m_L[s].bottomRows(r).transpose() * Y.topRows(r);
+    }
+    m_L[s].topRows(k).template triangularView<Eigen::Lower>().transpose().
+      solveInPlace(Xs);
+  }
+  return m_Pinv * X;
+}
+
+template <typename Scalar>
+IGL_INLINE Eigen::Index igl::SupernodalLLT<Scalar>::nonZeros() const
+{
+  Eigen::Index nnz = 0;
+  for(int s = 0;s<num_supernodes();s++)
+  {
+    const Eigen::Index k = m_first[s+1]-m_first[s];
+    const Eigen::Index m = m_rows_start[s+1]-m_rows_start[s];
+    nnz += k*m - k*(k-1)/2;
+  }
+  return nnz;
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template class igl::SupernodalLLT<double>;
+#endif
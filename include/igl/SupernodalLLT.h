@@ -0,0 +1,122 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SUPERNODAL_LLT_H
+#define IGL_SUPERNODAL_LLT_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <Eigen/Sparse>
+#include <vector>
+
+namespace igl
+{
+  // Sparse Cholesky factorization A = P' L L' P of a symmetric positive
+  // definite matrix using a multifrontal supernodal method: columns of L with
+  // (nearly) the same sparsity pattern are grouped into supernodes stored as
+  // dense blocks, so that the numerical work is done by dense matrix-matrix
+  // products rather than column-by-column as in Eigen::SimplicialLLT.
+  // Independent subtrees of the elimination tree and the dense updates of
+  // large fronts are processed in parallel with igl::parallel_for. The
+  // result does not depend on the number of threads.
+  //
+  // Only the lower triangle of A is used. The interface mirrors Eigen's
+  // sparse solvers so this can be swapped in for Eigen::SimplicialLLT.
+  //
+  // Templates:
+  //   Scalar  type of coefficients (e.g., double)
+  //
+  // Example:
+  //   igl::SupernodalLLT<double> llt;
+  //   llt.analyzePattern(A);
+  //   llt.factorize(A);
+  //   if(llt.info() != Eigen::Success) { ... }
+  //   Eigen::MatrixXd X = llt.solve(B);
+  template <typename Scalar>
+  class SupernodalLLT
+  {
+    public:
+      typedef Eigen::SparseMatrix<Scalar> SparseMatrixS;
+      typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+      SupernodalLLT():m_info(Eigen::InvalidInput),m_n(0){}
+      // Inputs:
+      //   A  n by n symmetric positive definite matrix
+      SupernodalLLT(const SparseMatrixS & A):SupernodalLLT(){ compute(A); }
+      // Analyze sparsity pattern and factor
+      //
+      // Inputs:
+      //   A  n by n symmetric positive definite matrix
+      IGL_INLINE SupernodalLLT & compute(const SparseMatrixS & A);
+      // Compute fill-reducing ordering, elimination tree and supernodes. Only
+      // depends on the sparsity pattern of A.
+      //
+      // Inputs:
+      //   A  n by n symmetric matrix
+      IGL_INLINE void analyzePattern(const SparseMatrixS & A);
+      // Numerical factorization reusing the last analyzePattern
+      //
+      // Inputs:
+      //   A  n by n symmetric positive definite matrix with the same sparsity
+      //     pattern as passed to analyzePattern
+      IGL_INLINE void factorize(const SparseMatrixS & A);
+      // Solve A X = B using the last factorization
+      //
+      // Inputs:
+      //   B  n by k right-hand sides
+      // Returns n by k solution X
+      IGL_INLINE MatrixXS solve(const MatrixXS & B) const;
+      // Returns Eigen::Success if the last factorization succeeded,
+      // Eigen::NumericalIssue if the matrix is not positive definite and
+      // Eigen::InvalidInput if nothing has been factored yet.
+      Eigen::ComputationInfo info() const { return m_info; }
+      Eigen::Index rows() const { return m_n; }
+      Eigen::Index cols() const { return m_n; }
+      // Number of supernodes
+      int num_supernodes() const
+      {
+        return m_first.empty() ? 0 : int(m_first.size())-1;
+      }
+      // Number of stored entries of L (including explicit zeros from merging
+      // supernodes)
+      IGL_INLINE Eigen::Index nonZeros() const;
+    private:
+      Eigen::ComputationInfo m_info;
+      int m_n;
+      // Fill-reducing ordering followed by a postordering of the elimination
+      // tree, and its inverse
+      Eigen::PermutationMatrix<Eigen::Dynamic,Eigen::Dynamic,int> m_P,m_Pinv;
+      // #supernodes+1 list so that columns m_first[s],...,m_first[s+1]-1 of L
+      // belong to supernode s
+      std::vector<int> m_first;
+      // #supernodes list of parent supernodes (-1 for roots)
+      std::vector<int> m_parent;
+      // #supernodes+1 offsets into m_rows
+      std::vector<int> m_rows_start;
+      // Sorted row indices of each supernode: its own columns followed by the
+      // rows below
+      std::vector<int> m_rows;
+      // Lists of supernodes whose fronts can be factored in parallel, from
+      // leaves to roots
+      std::vector<std::vector<int> > m_levels;
+      // #supernodes+1 offsets into m_children
+      std::vector<int> m_children_start;
+      std::vector<int> m_children;
+      // For each supernode the positions of the rows below its columns in its
+      // parent's front
+      std::vector<std::vector<int> > m_relative;
+      // For each entry of the lower triangle of P A P' (in the order built by
+      // selfadjointView::twistedBy) the row position in its supernode's front
+      std::vector<int> m_A_rows;
+      // #supernodes list of #rows by #columns dense blocks of L
+      std::vector<MatrixXS> m_L;
+  };
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "SupernodalLLT.cpp"
+#endif
+
+#endif
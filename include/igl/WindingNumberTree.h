@@ -31,8 +31,8 @@ namespace igl
         std::pair<const WindingNumberTree*,const WindingNumberTree*>, 
         typename DerivedV::Scalar>
           cached;
-      // This is only need to fill in references, it should never actually be touched
-      // and shouldn't cause race conditions. (This is a hack, but I think it's "safe")
+      // Unused: roots keep their own copy of the mesh in root_V. Kept for
+      // compatibility with code referring to it.
       static DerivedV dummyV;
     protected:
       WindingNumberMethod method;
@@ -46,7 +46,9 @@ namespace igl
         MatrixXF;
       //// List of boundary edges (recall edges are vertices in 2d)
       //const Eigen::MatrixXi boundary;
-      // Base mesh vertices
+      // Base mesh vertices owned by the root (unused by children)
+      DerivedV root_V;
+      // Base mesh vertices (the root's root_V)
       DerivedV & V;
       // Base mesh vertices with duplicates removed
       MatrixXS SV;
@@ -161,7 +163,8 @@ template <typename Point, typename DerivedV, typename DerivedF>
 inline igl::WindingNumberTree<Point,DerivedV,DerivedF>::WindingNumberTree():
   method(EXACT_WINDING_NUMBER_METHOD),
   parent(NULL),
-  V(dummyV),
+  root_V(),
+  V(root_V),
   SV(),
   F(),
   cap(),
@@ -176,7 +179,8 @@ inline igl::WindingNumberTree<Point,DerivedV,DerivedF>::WindingNumberTree(
   const Eigen::MatrixBase<DerivedF> & _F):
   method(EXACT_WINDING_NUMBER_METHOD),
   parent(NULL),
-  V(dummyV),
+  root_V(),
+  V(root_V),
   SV(),
   F(),
   cap(),
@@ -207,6 +211,7 @@ inline igl::WindingNumberTree<Point,DerivedV,DerivedF>::WindingNumberTree(
   const Eigen::MatrixBase<DerivedF> & _F):
   method(parent.method),
   parent(&parent),
+  root_V(),
   V(parent.V),
   SV(),
   F(_F),
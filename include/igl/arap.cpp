@@ -225,12 +225,7 @@ IGL_INLINE bool igl::arap_solve(
       fit_rotations_planar(S,R);
     }else
     {
-      fit_rotations(S,true,R);
-//#ifdef __SSE__ // fit_rotations_SSE will convert to float if necessary
-//      fit_rotations_SSE(S,R);
-//#else
-//      fit_rotations(S,true,R);
-//#endif
+      fit_rotations_batched(S,R);
     }
     //for(int k = 0;k<(data.CSM.rows()/dim);k++)
     //{
@@ -734,11 +734,7 @@ IGL_INLINE bool igl::arap_dof_update(
       fit_rotations_planar(S,R);
     }else
     {
-#ifdef __SSE__ // fit_rotations_SSE will convert to float if necessary
-      fit_rotations_SSE(S,R);
-#else
-      fit_rotations(S,false,R);
-#endif
+      fit_rotations_batched(S,R);
     }
 
 #ifdef EXTREME_VERBOSE
@@ -12,8 +12,12 @@
 #include "sortrows.h"
 #include "PI.h"
 #include "get_seconds.h"
+#include "parallel_for.h"
 #include <unordered_map>
 #include <algorithm>
+#include <numeric>
+#include <random>
+#include <cstdint>
 #include <vector>
 
 namespace igl
@@ -236,6 +240,299 @@ namespace igl
   }
 }
 
+// Helpers for BLUE_NOISE_METHOD_PARALLEL
+namespace igl
+{
+  // Map 3D subscripts (x,y,z) to a unique index that keeps the cells of each
+  // 4×4×4 block of the lattice contiguous: the high bits index the block (see
+  // blue_noise_key) and the low 6 bits index the cell within the block.
+  //
+  // Inputs:
+  //   w  side length of w×w×w integer cube lattice
+  //   x  subscript along x direction
+  //   y  subscript along y direction
+  //   z  subscript along z direction
+  // Returns index value
+  inline BlueNoiseKeyType blue_noise_blocked_key(
+    const BlueNoiseKeyType w,
+    const BlueNoiseKeyType x,
+    const BlueNoiseKeyType y,
+    const BlueNoiseKeyType z)
+  {
+    return
+      (blue_noise_key((w+3)>>2,x>>2,y>>2,z>>2)<<6) |
+      ((x&3) | ((y&3)<<2) | ((z&3)<<4));
+  }
+  // Flat open addressing (linear probing, Fibonacci hashing) map from
+  // non-negative keys to int values. -1 marks an empty slot.
+  class BlueNoiseFlatHash
+  {
+  public:
+    BlueNoiseFlatHash(const size_t capacity_hint):count(0)
+    {
+      size_t capacity = 16;
+      while(capacity < 2*capacity_hint) { capacity <<= 1; }
+      resize(capacity);
+    }
+    // Returns value of key k, first inserting k with value v if it's not yet
+    // present
+    int insert(const BlueNoiseKeyType k, const int v)
+    {
+      // Keep load factor below 1/2
+      if(2*(count+1) > slots.size())
+      {
+        const std::vector<Slot> old_slots(std::move(slots));
+        resize(2*old_slots.size());
+        for(const Slot & o : old_slots)
+        {
+          if(o.key >= 0)
+          {
+            size_t h = slot(o.key);
+            while(slots[h].key >= 0) { h = (h+1)&mask; }
+            slots[h] = o;
+          }
+        }
+      }
+      size_t h = slot(k);
+      while(true)
+      {
+        if(slots[h].key == k) { return slots[h].val; }
+        if(slots[h].key < 0)
+        {
+          slots[h].key = k;
+          slots[h].val = v;
+          count++;
+          return v;
+        }
+        h = (h+1)&mask;
+      }
+    }
+    // Returns value of key k or -1 if it's not present
+    int find(const BlueNoiseKeyType k) const
+    {
+      size_t h = slot(k);
+      while(true)
+      {
+        if(slots[h].key == k) { return slots[h].val; }
+        if(slots[h].key < 0) { return -1; }
+        h = (h+1)&mask;
+      }
+    }
+  private:
+    struct Slot
+    {
+      BlueNoiseKeyType key;
+      int val;
+    };
+    void resize(const size_t capacity)
+    {
+      const Slot empty = {-1,-1};
+      slots.assign(capacity,empty);
+      mask = capacity-1;
+      shift = 64;
+      for(size_t c = capacity;c>1;c>>=1) { shift--; }
+    }
+    size_t slot(const BlueNoiseKeyType k) const
+    {
+      return size_t((uint64_t(k)*UINT64_C(0x9E3779B97F4A7C15)) >> shift);
+    }
+    std::vector<Slot> slots;
+    size_t mask;
+    int shift;
+    size_t count;
+  };
+
+  // Phase-grouped parallel dart throwing [Wei 2008]. A cell has diagonal r so
+  // it holds at most one sample which can only conflict with samples in cells
+  // at most 2 away. Cells whose subscripts agree modulo 3 are at least 3 apart
+  // and are processed concurrently. The 27 phases are visited in random order.
+  // A visit to a cell gathers the already selected samples near the cell and
+  // then throws darts (the cell's candidates in random order) until one lands
+  // far enough from them. A cell's neighborhood only changes between phases so
+  // the result is maximal and independent of the number of threads.
+  //
+  // Inputs:
+  //   X  #X by 3 list of raw candidate positions (in random order)
+  //   Xs  #X by 3 list of corresponding integer cell subscripts
+  //   rr  Poisson disk radius squared
+  //   ss  cell side length squared
+  //   w  side length of w×w×w integer cube lattice (into which Xs subscripts)
+  //   expected_number_of_points  used to size the cell hash
+  // Outputs:
+  //   collected  list of indices into X of selected samples
+  template <
+    typename DerivedX,
+    typename DerivedXs>
+  inline void blue_noise_parallel(
+    const Eigen::MatrixBase<DerivedX> & X,
+    const Eigen::MatrixBase<DerivedXs> & Xs,
+    const double & rr,
+    const double & ss,
+    const int & w,
+    const double expected_number_of_points,
+    std::vector<int> & collected)
+  {
+    typedef typename DerivedX::Scalar Scalar;
+    const int nx = X.rows();
+    std::vector<BlueNoiseKeyType> K(nx);
+    igl::parallel_for(nx,[&](const int i)
+    {
+      K[i] = blue_noise_blocked_key(w,Xs(i,0),Xs(i,1),Xs(i,2));
+    },1000);
+    // Cell of each candidate
+    std::vector<int> C(nx);
+    std::vector<BlueNoiseKeyType> cell_keys;
+    {
+      BlueNoiseFlatHash H(4*expected_number_of_points);
+      for(int i = 0;i<nx;i++)
+      {
+        C[i] = H.insert(K[i],cell_keys.size());
+        if(C[i] == int(cell_keys.size())) { cell_keys.push_back(K[i]); }
+      }
+    }
+    std::vector<BlueNoiseKeyType>().swap(K);
+    const int m = cell_keys.size();
+    // Number cells in key order so that the cells of each block are
+    // contiguous and each phase sweeps through memory
+    {
+      std::vector<int> order(m);
+      std::iota(order.begin(),order.end(),0);
+      std::sort(order.begin(),order.end(),
+        [&](const int a,const int b){ return cell_keys[a] < cell_keys[b]; });
+      std::vector<int> R(m);
+      std::vector<BlueNoiseKeyType> sorted_keys(m);
+      for(int c = 0;c<m;c++)
+      {
+        R[order[c]] = c;
+        sorted_keys[c] = cell_keys[order[c]];
+      }
+      cell_keys.swap(sorted_keys);
+      igl::parallel_for(nx,[&](const int i){ C[i] = R[C[i]]; },1000);
+    }
+    // Cells of block b are block_start[b] … block_start[b+1]-1
+    std::vector<int> block_start;
+    BlueNoiseFlatHash blocks(expected_number_of_points);
+    for(int c = 0;c<m;c++)
+    {
+      if(c == 0 || (cell_keys[c]>>6) != (cell_keys[c-1]>>6))
+      {
+        blocks.insert(cell_keys[c]>>6,block_start.size());
+        block_start.push_back(c);
+      }
+    }
+    block_start.push_back(m);
+    // Bucket candidates by cell (preserving their random order) into a
+    // compressed list: candidates of cell c are I[start[c]] … I[start[c+1]-1]
+    std::vector<int> start(m+1,0);
+    for(int i = 0;i<nx;i++) { start[C[i]+1]++; }
+    std::partial_sum(start.begin(),start.end(),start.begin());
+    std::vector<int> I(nx);
+    {
+      std::vector<int> next(start.begin(),start.end()-1);
+      for(int i = 0;i<nx;i++) { I[next[C[i]]++] = i; }
+    }
+    std::vector<int>().swap(C);
+
+    // Cells split into phases
+    std::vector<std::vector<int> > phase_cells(27);
+    for(int c = 0;c<m;c++)
+    {
+      const int i = I[start[c]];
+      phase_cells[Xs(i,0)%3 + 3*(Xs(i,1)%3) + 9*(Xs(i,2)%3)].push_back(c);
+    }
+    // Selected candidate of each cell (or -1) and its position
+    std::vector<int> S(m,-1);
+    Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> SX(m,3);
+    // r² in units of s²
+    const double cell_rr = rr/ss;
+    const int wb = (w+3)>>2;
+    // Per-thread positions of samples near the current cell
+    std::vector<std::vector<Scalar> > near;
+    const auto visit = [&](const int c, std::vector<Scalar> & N)
+    {
+      int xc[3];
+      for(int a = 0;a<3;a++) { xc[a] = Xs(I[start[c]],a); }
+      N.clear();
+      // At most 2×2×2 blocks contain cells within 2 of this one
+      for(int bz = std::max(xc[2]-2,0)>>2;bz<=std::min(xc[2]+2,w-1)>>2;bz++)
+      for(int by = std::max(xc[1]-2,0)>>2;by<=std::min(xc[1]+2,w-1)>>2;by++)
+      for(int bx = std::max(xc[0]-2,0)>>2;bx<=std::min(xc[0]+2,w-1)>>2;bx++)
+      {
+        const int b = blocks.find(blue_noise_key(wb,bx,by,bz));
+        if(b < 0) { continue; }
+        for(int n = block_start[b];n<block_start[b+1];n++)
+        {
+          const int l = cell_keys[n]&63;
+          // Squared distance (in units of s) between cells
+          const int gx = std::max(std::abs(4*bx+(l&3)-xc[0])-1,0);
+          const int gy = std::max(std::abs(4*by+((l>>2)&3)-xc[1])-1,0);
+          const int gz = std::max(std::abs(4*bz+((l>>4)&3)-xc[2])-1,0);
+          // Only cells of other phases are this close, so S and SX are not
+          // being written for them
+          if(gx*gx+gy*gy+gz*gz < cell_rr && S[n] >= 0)
+          {
+            N.insert(N.end(),SX.row(n).data(),SX.row(n).data()+3);
+          }
+        }
+      }
+      for(int j = start[c];j<start[c+1];j++)
+      {
+        const int i = I[j];
+        bool far_enough = true;
+        for(size_t n = 0;n<N.size();n+=3)
+        {
+          const double dx = X(i,0)-N[n+0];
+          const double dy = X(i,1)-N[n+1];
+          const double dz = X(i,2)-N[n+2];
+          if(dx*dx+dy*dy+dz*dz < rr) { far_enough = false; break; }
+        }
+        if(far_enough)
+        {
+          S[c] = i;
+          SX.row(c) = X.row(i);
+          return;
+        }
+      }
+    };
+
+    std::vector<int> phases(27);
+    std::iota(phases.begin(),phases.end(),0);
+    std::shuffle(phases.begin(),phases.end(),std::minstd_rand(std::rand()));
+    for(const int p : phases)
+    {
+      const std::vector<int> & L = phase_cells[p];
+      // Cells in L are mutually too far apart to conflict: each only writes
+      // to its own entries of S and SX.
+      igl::parallel_for(
+        L.size(),
+        [&](const size_t nt){ near.resize(nt); },
+        [&](const size_t j, const size_t t){ visit(L[j],near[t]); },
+        [](const size_t){},
+        1000);
+    }
+    collected.clear();
+    collected.reserve(m);
+    for(int c = 0;c<m;c++) { if(S[c] >= 0) { collected.push_back(S[c]); } }
+  }
+}
+
+template <
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedB,
+  typename DerivedFI,
+  typename DerivedP>
+IGL_INLINE void igl::blue_noise(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const typename DerivedV::Scalar r,
+    Eigen::PlainObjectBase<DerivedB> & B,
+    Eigen::PlainObjectBase<DerivedFI> & FI,
+    Eigen::PlainObjectBase<DerivedP> & P)
+{
+  return blue_noise(V,F,r,BLUE_NOISE_METHOD_SERIAL,B,FI,P);
+}
+
 template <
   typename DerivedV,
   typename DerivedF,
@@ -246,6 +543,7 @@ IGL_INLINE void igl::blue_noise(
     const Eigen::MatrixBase<DerivedV> & V,
     const Eigen::MatrixBase<DerivedF> & F,
     const typename DerivedV::Scalar r,
+    const BlueNoiseMethod method,
     Eigen::PlainObjectBase<DerivedB> & B,
     Eigen::PlainObjectBase<DerivedFI> & FI,
     Eigen::PlainObjectBase<DerivedP> & P)
@@ -283,6 +581,15 @@ IGL_INLINE void igl::blue_noise(
   Eigen::Matrix<int,Eigen::Dynamic,3,Eigen::RowMajor> Xs =
     ((X.rowwise()-X.colwise().minCoeff())/s).template cast<int>();
   const int w = Xs.maxCoeff()+1;
+  // precompute r²
+  // Q: is this necessary?
+  const double rr = r*r;
+  std::vector<int> collected;
+  if(method == BLUE_NOISE_METHOD_PARALLEL)
+  {
+    blue_noise_parallel(
+      X,Xs,rr,double(s)*double(s),w,expected_number_of_points,collected);
+  }else
   {
     Eigen::VectorXi I;
     igl::sortrows(decltype(Xs)(Xs),true,Xs,I);
@@ -290,65 +597,61 @@ IGL_INLINE void igl::blue_noise(
     // These two could be spun off in their own thread.
     igl::slice(decltype(XB)(XB),I,1,XB);
     igl::slice(decltype(XFI)(XFI),I,1,XFI);
-  }
-  // Initialization
-  std::unordered_map<BlueNoiseKeyType,std::vector<int> > M;
-  std::unordered_map<BlueNoiseKeyType, int > S;
-  // attempted to seed
-  std::unordered_map<BlueNoiseKeyType, int > A;
-  // Q: Too many?
-  // A: Seems to help though.
-  M.reserve(Xs.rows());
-  S.reserve(Xs.rows());
-  for(int i = 0;i<Xs.rows();i++)
-  {
-    BlueNoiseKeyType k = blue_noise_key(w,Xs(i,0),Xs(i,1),Xs(i,2));
-    const auto Miter = M.find(k);
-    if(Miter  == M.end())
+    // Initialization
+    std::unordered_map<BlueNoiseKeyType,std::vector<int> > M;
+    std::unordered_map<BlueNoiseKeyType, int > S;
+    // attempted to seed
+    std::unordered_map<BlueNoiseKeyType, int > A;
+    // Q: Too many?
+    // A: Seems to help though.
+    M.reserve(Xs.rows());
+    S.reserve(Xs.rows());
+    for(int i = 0;i<Xs.rows();i++)
     {
-      M.insert({k,{i}});
-    }else
-    {
-      Miter->second.push_back(i);
+      BlueNoiseKeyType k = blue_noise_key(w,Xs(i,0),Xs(i,1),Xs(i,2));
+      const auto Miter = M.find(k);
+      if(Miter  == M.end())
+      {
+        M.insert({k,{i}});
+      }else
+      {
+        Miter->second.push_back(i);
+      }
+      S.emplace(k,-1);
+      A.emplace(k,false);
     }
-    S.emplace(k,-1);
-    A.emplace(k,false);
-  }
 
-  std::vector<int> active;
-  // precompute r²
-  // Q: is this necessary?
-  const double rr = r*r;
-  std::vector<int> collected;
-  collected.reserve(2.0*expected_number_of_points);
+    std::vector<int> active;
+    collected.reserve(2.0*expected_number_of_points);
 
-  auto Mouter = M.begin();
-  // Just take the first point as the initial seed
-  const auto initialize = [&]()->bool
-  {
-    while(true)
+    auto Mouter = M.begin();
+    // Just take the first point as the initial seed
+    const auto initialize = [&]()->bool
     {
-      if(Mouter == M.end())
-      {
-        return false;
-      }
-      const BlueNoiseKeyType k = Mouter->first;
-      // Haven't placed in this cell yet
-      if(S[k]<0)
+      while(true)
       {
-        if(activate(X,Xs,rr,-1,w,k,M,S,active)) return true;
+        if(Mouter == M.end())
+        {
+          return false;
+        }
+        const BlueNoiseKeyType k = Mouter->first;
+        // Haven't placed in this cell yet
+        if(S[k]<0)
+        {
+          if(activate(X,Xs,rr,-1,w,k,M,S,active)) return true;
+        }
+        Mouter++;
       }
-      Mouter++;
-    }
-    assert(false && "should not be reachable.");
-  };
+      assert(false && "should not be reachable.");
+    };
 
-  // important if mesh contains many connected components
-  while(initialize())
-  {
-    while(active.size()>0)
+    // important if mesh contains many connected components
+    while(initialize())
     {
-      step(X,Xs,rr,w,M,S,active,collected);
+      while(active.size()>0)
+      {
+        step(X,Xs,rr,w,M,S,active,collected);
+      }
     }
   }
   {
@@ -369,4 +672,6 @@ IGL_INLINE void igl::blue_noise(
 #ifdef IGL_STATIC_LIBRARY
 template void igl::blue_noise<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, -1, 3, 1, -1, 3>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::blue_noise<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::blue_noise<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<float, -1, 3, 1, -1, 3>::Scalar, igl::BlueNoiseMethod, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::blue_noise<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::Matrix<double, -1, -1, 0, -1, -1>::Scalar, igl::BlueNoiseMethod, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 #endif
@@ -11,6 +11,18 @@
 #include <Eigen/Core>
 namespace igl
 {
+  enum BlueNoiseMethod
+  {
+    // Bridson's advancing front dart throwing. Serial and reproducible
+    // (given the state of rand()).
+    BLUE_NOISE_METHOD_SERIAL = 0,
+    // Phase-grouped grid dart throwing [Wei 2008]: cells whose subscripts
+    // agree modulo 3 are too far apart to conflict, so the cells of each phase
+    // are filled in parallel. Deterministic regardless of the number of
+    // threads.
+    BLUE_NOISE_METHOD_PARALLEL = 1,
+    NUM_BLUE_NOISE_METHODS = 2
+  };
   // "Fast Poisson Disk Sampling in Arbitrary Dimensions" [Bridson 2007]
   //
   // For very dense samplings this is faster than (up to 2x) cyCodeBase's
@@ -40,6 +52,22 @@ namespace igl
       Eigen::PlainObjectBase<DerivedB> & B,
       Eigen::PlainObjectBase<DerivedFI> & FI,
       Eigen::PlainObjectBase<DerivedP> & P);
+  // Inputs:
+  //   method  which sampling method to use
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedB,
+    typename DerivedFI,
+    typename DerivedP>
+  IGL_INLINE void blue_noise(
+      const Eigen::MatrixBase<DerivedV> & V,
+      const Eigen::MatrixBase<DerivedF> & F,
+      const typename DerivedV::Scalar r,
+      const BlueNoiseMethod method,
+      Eigen::PlainObjectBase<DerivedB> & B,
+      Eigen::PlainObjectBase<DerivedFI> & FI,
+      Eigen::PlainObjectBase<DerivedP> & P);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -200,7 +200,7 @@ IGL_INLINE bool igl::collapse_edge(
   Eigen::VectorXi & EMAP,
   Eigen::MatrixXi & EF,
   Eigen::MatrixXi & EI,
-  igl::min_heap< std::tuple<double,int,int> > & Q,
+  igl::IndexedPriorityQueue<double> & Q,
   Eigen::VectorXi & EQ,
   Eigen::MatrixXd & C)
 {
@@ -224,7 +224,7 @@ IGL_INLINE bool igl::collapse_edge(
   Eigen::VectorXi & EMAP,
   Eigen::MatrixXi & EF,
   Eigen::MatrixXi & EI,
-  igl::min_heap< std::tuple<double,int,int> > & Q,
+  igl::IndexedPriorityQueue<double> & Q,
   Eigen::VectorXi & EQ,
   Eigen::MatrixXd & C)
 {
@@ -246,7 +246,7 @@ IGL_INLINE bool igl::collapse_edge(
   Eigen::VectorXi & EMAP,
   Eigen::MatrixXi & EF,
   Eigen::MatrixXi & EI,
-  igl::min_heap< std::tuple<double,int,int> > & Q,
+  igl::IndexedPriorityQueue<double> & Q,
   Eigen::VectorXi & EQ,
   Eigen::MatrixXd & C,
   int & e,
@@ -257,35 +257,23 @@ IGL_INLINE bool igl::collapse_edge(
 {
   using namespace Eigen;
   using namespace igl;
-  std::tuple<double,int,int> p;
-  while(true)
+  // Check if Q is empty
+  if(Q.empty())
   {
-    // Check if Q is empty
-    if(Q.empty())
-    {
-      // no edges to collapse
-      e = -1;
-      return false;
-    }
-    // pop from Q
-    p = Q.top();
-    if(std::get<0>(p) == std::numeric_limits<double>::infinity())
-    {
-      e = -1;
-      // min cost edge is infinite cost
-      return false;
-    }
-    Q.pop();
-    e = std::get<1>(p);
-    // Check if matches timestamp
-    if(std::get<2>(p) == EQ(e))
-    {
-      break;
-    }
-    // must be stale or dead.
-    assert(std::get<2>(p)  < EQ(e) || EQ(e) == -1);
-    // try again.
+    // no edges to collapse
+    e = -1;
+    return false;
+  }
+  if(Q.top_priority() == std::numeric_limits<double>::infinity())
+  {
+    e = -1;
+    // min cost edge is infinite cost
+    return false;
   }
+  // pop from Q
+  e = Q.top();
+  Q.pop();
+  assert(EQ(e) != -1);
 
   // Why is this computed up here?
   // If we just need original face neighbors of edge, could we gather that more
@@ -311,9 +299,12 @@ IGL_INLINE bool igl::collapse_edge(
   post_collapse(V,F,E,EMAP,EF,EI,Q,EQ,C,e,e1,e2,f1,f2,collapsed);
   if(collapsed)
   {
-    // Erase the two, other collapsed edges by marking their timestamps as -1
+    // Erase the two, other collapsed edges
+    Q.remove(e1);
+    Q.remove(e2);
     EQ(e1) = -1;
     EQ(e2) = -1;
+    EQ(e) = -1;
     // TODO: visits edges multiple times, ~150% more updates than should
     //
     // update local neighbors
@@ -356,8 +347,8 @@ IGL_INLINE bool igl::collapse_edge(
        cost_and_placement(ei,V,F,E,EMAP,EF,EI,cost,place);
        // Increment timestamp
        EQ(ei)++;
-       // Replace in queue
-       Q.emplace(cost,ei,EQ(ei));
+       // Update cost in queue
+       Q.update(ei,cost);
        C.row(ei) = place;
     }
   }else
@@ -366,8 +357,8 @@ IGL_INLINE bool igl::collapse_edge(
     // have given this un-collapsable edge inf cost already)
     // Increment timestamp
     EQ(e)++;
-    // Replace in queue
-    Q.emplace(std::numeric_limits<double>::infinity(),e,EQ(e));
+    // Reinsert in queue
+    Q.update(e,std::numeric_limits<double>::infinity());
   }
   return collapsed;
 }
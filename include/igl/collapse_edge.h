@@ -8,7 +8,7 @@
 #ifndef IGL_COLLAPSE_EDGE_H
 #define IGL_COLLAPSE_EDGE_H
 #include "igl_inline.h"
-#include "min_heap.h"
+#include "IndexedPriorityQueue.h"
 #include "decimate_callback_types.h"
 #include <Eigen/Core>
 #include <vector>
@@ -93,8 +93,10 @@ namespace igl
   //     **If the edges is collapsed** then this function will be called on all
   //     edges of all faces previously incident on the endpoints of the
   //     collapsed edge.
-  //   Q  queue containing pairs of costs and edge indices and insertion "time"
-  //   EQ  #E list of "time" of last time pushed into Q
+  //   Q  queue of edge indices keyed by cost of collapsing (Q.num_keys() ==
+  //     #E)
+  //   EQ  #E list of number of times the cost of each edge has been updated,
+  //     -1 if edge has been collapsed
   //   C  #E by dim list of stored placements
   IGL_INLINE bool collapse_edge(
     const decimate_cost_and_placement_callback & cost_and_placement,
@@ -104,7 +106,7 @@ namespace igl
     Eigen::VectorXi & EMAP,
     Eigen::MatrixXi & EF,
     Eigen::MatrixXi & EI,
-    igl::min_heap< std::tuple<double,int,int> > & Q,
+    igl::IndexedPriorityQueue<double> & Q,
     Eigen::VectorXi & EQ,
     Eigen::MatrixXd & C);
   // Inputs:
@@ -125,7 +127,7 @@ namespace igl
     Eigen::VectorXi & EMAP,
     Eigen::MatrixXi & EF,
     Eigen::MatrixXi & EI,
-    igl::min_heap< std::tuple<double,int,int> > & Q,
+    igl::IndexedPriorityQueue<double> & Q,
     Eigen::VectorXi & EQ,
     Eigen::MatrixXd & C);
   // Outputs:
@@ -145,7 +147,7 @@ namespace igl
     Eigen::VectorXi & EMAP,
     Eigen::MatrixXi & EF,
     Eigen::MatrixXi & EI,
-    igl::min_heap< std::tuple<double,int,int> > & Q,
+    igl::IndexedPriorityQueue<double> & Q,
     Eigen::VectorXi & EQ,
     Eigen::MatrixXd & C,
     int & e,
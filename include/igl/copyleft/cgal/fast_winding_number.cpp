@@ -24,15 +24,16 @@ IGL_INLINE void igl::copyleft::cgal::fast_winding_number(
   typedef typename Eigen::Matrix<real,Eigen::Dynamic,Eigen::Dynamic>
     RealMatrix;
         
-  std::vector<std::vector<int> > point_indices;
+  Eigen::Matrix<int,Eigen::Dynamic,1> point_order;
+  Eigen::Matrix<int,Eigen::Dynamic,2> CR;
   Eigen::Matrix<int,Eigen::Dynamic,8> CH;
   Eigen::Matrix<real,Eigen::Dynamic,3> CN;
   Eigen::Matrix<real,Eigen::Dynamic,1> W;
   Eigen::MatrixXi I;
   Eigen::Matrix<real,Eigen::Dynamic,1> A;
   
-  octree(P,point_indices,CH,CN,W);
-  knn(P,21,point_indices,CH,CN,W,I);
+  octree(P,point_order,CR,CH,CN,W);
+  knn(P,21,point_order,CR,CH,CN,W,I);
   point_areas(P,I,N,A);
   
   Eigen::Matrix<real,Eigen::Dynamic,Eigen::Dynamic> EC;
@@ -40,9 +41,9 @@ IGL_INLINE void igl::copyleft::cgal::fast_winding_number(
   Eigen::Matrix<real,Eigen::Dynamic,1> R;
   
   igl::fast_winding_number(
-    P,N,A,point_indices,CH,expansion_order,CM,R,EC);
+    P,N,A,point_order,CR,CH,expansion_order,CM,R,EC);
   igl::fast_winding_number(
-    P,N,A,point_indices,CH,CM,R,EC,Q,beta,WN);
+    P,N,A,point_order,CR,CH,CM,R,EC,Q,beta,WN);
 }
       
 template <
@@ -11,6 +11,7 @@
 // For error printing
 #include <cstdio>
 #include "cotmatrix_entries.h"
+#include "parallel_for.h"
 
 // Bug in unsupported/Eigen/SparseExtra needs iostream first
 #include <iostream>
@@ -20,21 +21,27 @@ IGL_INLINE void igl::cotmatrix(
   const Eigen::MatrixBase<DerivedV> & V, 
   const Eigen::MatrixBase<DerivedF> & F, 
   Eigen::SparseMatrix<Scalar>& L)
+{
+  sparse_cached_data data;
+  return cotmatrix(V,F,data,L);
+}
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::cotmatrix(
+  const Eigen::MatrixBase<DerivedV> & V, 
+  const Eigen::MatrixBase<DerivedF> & F, 
+  sparse_cached_data & data,
+  Eigen::SparseMatrix<Scalar>& L)
 {
   using namespace Eigen;
   using namespace std;
 
-  L.resize(V.rows(),V.rows());
   Matrix<int,Dynamic,2> edges;
   int simplex_size = F.cols();
   // 3 for triangles, 4 for tets
   assert(simplex_size == 3 || simplex_size == 4);
   if(simplex_size == 3)
   {
-    // This is important! it could decrease the comptuation time by a factor of 2
-    // Laplacian for a closed 2d manifold mesh will have on average 7 entries per
-    // row
-    L.reserve(10*V.rows());
     edges.resize(3,2);
     edges << 
       1,2,
@@ -42,7 +49,6 @@ IGL_INLINE void igl::cotmatrix(
       0,1;
   }else if(simplex_size == 4)
   {
-    L.reserve(17*V.rows());
     edges.resize(6,2);
     edges << 
       1,2,
@@ -58,24 +64,41 @@ IGL_INLINE void igl::cotmatrix(
   // Gather cotangents
   Matrix<Scalar,Dynamic,Dynamic> C;
   cotmatrix_entries(V,F,C);
-  
-  vector<Triplet<Scalar> > IJV;
-  IJV.reserve(F.rows()*edges.rows()*4);
-  // Loop over triangles
-  for(int i = 0; i < F.rows(); i++)
+
+  // Each edge of each element contributes 4 entries:
+  //   (source,dest,c) (dest,source,c) (source,source,-c) (dest,dest,-c)
+  const int ne = edges.rows();
+  if(data.I_outer.empty())
   {
-    // loop over edges of element
-    for(int e = 0;e<edges.rows();e++)
+    Matrix<typename DerivedF::Scalar,Dynamic,1> I(F.rows()*ne*4),J(F.rows()*ne*4);
+    parallel_for(F.rows(),[&](const int i)
     {
-      int source = F(i,edges(e,0));
-      int dest = F(i,edges(e,1));
-      IJV.push_back(Triplet<Scalar>(source,dest,C(i,e)));
-      IJV.push_back(Triplet<Scalar>(dest,source,C(i,e)));
-      IJV.push_back(Triplet<Scalar>(source,source,-C(i,e)));
-      IJV.push_back(Triplet<Scalar>(dest,dest,-C(i,e)));
-    }
+      for(int e = 0;e<ne;e++)
+      {
+        const int k = (i*ne+e)*4;
+        const typename DerivedF::Scalar source = F(i,edges(e,0));
+        const typename DerivedF::Scalar dest = F(i,edges(e,1));
+        I(k+0) = source; J(k+0) = dest;
+        I(k+1) = dest;   J(k+1) = source;
+        I(k+2) = source; J(k+2) = source;
+        I(k+3) = dest;   J(k+3) = dest;
+      }
+    },1000);
+    sparse_cached_precompute(I,J,V.rows(),V.rows(),data,L);
   }
-  L.setFromTriplets(IJV.begin(),IJV.end());
+  Matrix<Scalar,Dynamic,1> CV(F.rows()*ne*4);
+  parallel_for(F.rows(),[&](const int i)
+  {
+    for(int e = 0;e<ne;e++)
+    {
+      const int k = (i*ne+e)*4;
+      CV(k+0) = C(i,e);
+      CV(k+1) = C(i,e);
+      CV(k+2) = -C(i,e);
+      CV(k+3) = -C(i,e);
+    }
+  },1000);
+  sparse_cached(CV,data,L);
 }
 
 #include "massmatrix.h"
@@ -229,4 +252,6 @@ template void igl::cotmatrix<Eigen::Matrix<double, -1, -1, 1, -1, -1>, Eigen::Ma
 template void igl::cotmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 4, 0, -1, 4>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 4, 0, -1, 4> > const&, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::cotmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::cotmatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::cotmatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::sparse_cached_data&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::cotmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::sparse_cached_data&, Eigen::SparseMatrix<double, 0, int>&);
 #endif
@@ -8,6 +8,7 @@
 #ifndef IGL_COTMATRIX_H
 #define IGL_COTMATRIX_H
 #include "igl_inline.h"
+#include "sparse_cached.h"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
@@ -48,6 +49,20 @@ namespace igl
     const Eigen::MatrixBase<DerivedV> & V, 
     const Eigen::MatrixBase<DerivedF> & F, 
     Eigen::SparseMatrix<Scalar>& L);
+  // Cached version for repeated calls with the same elements F but changing
+  // positions V: the sparsity pattern of L is computed once and afterwards
+  // only its values are refreshed.
+  //
+  // Inputs/Outputs:
+  //   data  assembly of L for F: computed if empty, otherwise reused
+  //   L  #V by #V cotangent matrix. If data is not empty, L must be the output
+  //     of a previous call with the same data
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE void cotmatrix(
+    const Eigen::MatrixBase<DerivedV> & V, 
+    const Eigen::MatrixBase<DerivedF> & F, 
+    sparse_cached_data & data,
+    Eigen::SparseMatrix<Scalar>& L);
   // Cotangent Laplacian (and mass matrix) for polygon meshes according to
   // "Polygon Laplacian Made Simple" [Bunge et al. 2020]
   //
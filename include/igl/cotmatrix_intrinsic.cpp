@@ -7,6 +7,8 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "cotmatrix_intrinsic.h"
 #include "cotmatrix_entries.h"
+#include "parallel_for.h"
+#include "sparse_cached.h"
 #include <iostream>
 
 template <typename Derivedl, typename DerivedF, typename Scalar>
@@ -20,15 +22,10 @@ IGL_INLINE void igl::cotmatrix_intrinsic(
   // Cribbed from cotmatrix
 
   const int nverts = F.maxCoeff()+1;
-  L.resize(nverts,nverts);
   Matrix<int,Dynamic,2> edges;
   int simplex_size = F.cols();
   // 3 for triangles, 4 for tets
   assert(simplex_size == 3);
-  // This is important! it could decrease the comptuation time by a factor of 2
-  // Laplacian for a closed 2d manifold mesh will have on average 7 entries per
-  // row
-  L.reserve(10*nverts);
   edges.resize(3,2);
   edges << 
     1,2,
@@ -37,24 +34,28 @@ IGL_INLINE void igl::cotmatrix_intrinsic(
   // Gather cotangents
   Matrix<Scalar,Dynamic,Dynamic> C;
   cotmatrix_entries(l,C);
-  
-  vector<Triplet<Scalar> > IJV;
-  IJV.reserve(F.rows()*edges.rows()*4);
-  // Loop over triangles
-  for(int i = 0; i < F.rows(); i++)
+
+  // Each edge of each element contributes 4 entries:
+  //   (source,dest,c) (dest,source,c) (source,source,-c) (dest,dest,-c)
+  const int ne = edges.rows();
+  Matrix<typename DerivedF::Scalar,Dynamic,1> I(F.rows()*ne*4),J(F.rows()*ne*4);
+  Matrix<Scalar,Dynamic,1> CV(F.rows()*ne*4);
+  parallel_for(F.rows(),[&](const int i)
   {
-    // loop over edges of element
-    for(int e = 0;e<edges.rows();e++)
+    for(int e = 0;e<ne;e++)
     {
-      int source = F(i,edges(e,0));
-      int dest = F(i,edges(e,1));
-      IJV.push_back(Triplet<Scalar>(source,dest,C(i,e)));
-      IJV.push_back(Triplet<Scalar>(dest,source,C(i,e)));
-      IJV.push_back(Triplet<Scalar>(source,source,-C(i,e)));
-      IJV.push_back(Triplet<Scalar>(dest,dest,-C(i,e)));
+      const int k = (i*ne+e)*4;
+      const typename DerivedF::Scalar source = F(i,edges(e,0));
+      const typename DerivedF::Scalar dest = F(i,edges(e,1));
+      I(k+0) = source; J(k+0) = dest;   CV(k+0) = C(i,e);
+      I(k+1) = dest;   J(k+1) = source; CV(k+1) = C(i,e);
+      I(k+2) = source; J(k+2) = source; CV(k+2) = -C(i,e);
+      I(k+3) = dest;   J(k+3) = dest;   CV(k+3) = -C(i,e);
     }
-  }
-  L.setFromTriplets(IJV.begin(),IJV.end());
+  },1000);
+  sparse_cached_data data;
+  sparse_cached_precompute(I,J,nverts,nverts,data,L);
+  sparse_cached(CV,data,L);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -165,14 +165,10 @@ IGL_INLINE bool igl::decimate(
     }
   }
 
-  igl::min_heap<std::tuple<double,int,int> > Q;
-  // Could reserve with https://stackoverflow.com/a/29236236/148668
+  igl::IndexedPriorityQueue<double> Q;
   Eigen::VectorXi EQ = Eigen::VectorXi::Zero(E.rows());
   // If an edge were collapsed, we'd collapse it to these points:
   MatrixXd C(E.rows(),V.cols());
-  // Pushing into a vector then using constructor was slower. Maybe using
-  // std::move + make_heap would squeeze out something?
-  
   // Separating the cost/placement evaluation from the Q filling is a
   // performance hit for serial but faster if we can parallelize the
   // cost/placement.
@@ -188,10 +184,8 @@ IGL_INLINE bool igl::decimate(
     },
     10000
     );
-    for(int e = 0;e<E.rows();e++)
-    {
-      Q.emplace(costs(e),e,0);
-    }
+    // Heapify all at once
+    Q.init(costs);
   }
 
 
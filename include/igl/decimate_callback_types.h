@@ -8,7 +8,8 @@
 #ifndef IGL_DECIMATE_CALLBACK_TYPES_H
 #define IGL_DECIMATE_CALLBACK_TYPES_H
 #include <Eigen/Core>
-#include "min_heap.h"
+#include "IndexedPriorityQueue.h"
+#include <functional>
 namespace igl
 {
   // Function handles used to customize the `igl::decimate` command.
@@ -32,7 +33,7 @@ namespace igl
       const Eigen::VectorXi &                             ,/*EMAP*/
       const Eigen::MatrixXi &                             ,/*EF*/
       const Eigen::MatrixXi &                             ,/*EI*/
-      const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+      const igl::IndexedPriorityQueue<double> &           ,/*Q*/
       const Eigen::VectorXi &                             ,/*EQ*/
       const Eigen::MatrixXd &                             ,/*C*/
       const int                                           ,/*e*/
@@ -49,7 +50,7 @@ namespace igl
       const Eigen::VectorXi &                             ,/*EMAP*/
       const Eigen::MatrixXi &                             ,/*EF*/
       const Eigen::MatrixXi &                             ,/*EI*/
-      const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+      const igl::IndexedPriorityQueue<double> &           ,/*Q*/
       const Eigen::VectorXi &                             ,/*EQ*/
       const Eigen::MatrixXd &                             ,/*C*/
       const int                                            /*e*/
@@ -62,7 +63,7 @@ namespace igl
       const Eigen::VectorXi &                             ,/*EMAP*/
       const Eigen::MatrixXi &                             ,/*EF*/
       const Eigen::MatrixXi &                             ,/*EI*/
-      const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+      const igl::IndexedPriorityQueue<double> &           ,/*Q*/
       const Eigen::VectorXi &                             ,/*EQ*/
       const Eigen::MatrixXd &                             ,/*C*/
       const int                                           ,/*e*/
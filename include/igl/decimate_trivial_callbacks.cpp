@@ -18,7 +18,7 @@ IGL_INLINE void igl::decimate_trivial_callbacks(
     const Eigen::VectorXi &                             ,/*EMAP*/
     const Eigen::MatrixXi &                             ,/*EF*/
     const Eigen::MatrixXi &                             ,/*EI*/
-    const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+    const igl::IndexedPriorityQueue<double> &           ,/*Q*/
     const Eigen::VectorXi &                             ,/*EQ*/
     const Eigen::MatrixXd &                             ,/*C*/
     const int                                            /*e*/
@@ -30,7 +30,7 @@ IGL_INLINE void igl::decimate_trivial_callbacks(
     const Eigen::VectorXi &                             ,/*EMAP*/
     const Eigen::MatrixXi &                             ,/*EF*/
     const Eigen::MatrixXi &                             ,/*EI*/
-    const igl::min_heap< std::tuple<double,int,int> > & ,/*Q*/
+    const igl::IndexedPriorityQueue<double> &           ,/*Q*/
     const Eigen::VectorXi &                             ,/*EQ*/
     const Eigen::MatrixXd &                             ,/*C*/
     const int                                           ,/*e*/
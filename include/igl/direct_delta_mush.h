@@ -36,6 +36,21 @@ namespace igl {
     > & T, /* should eventually be templated more generally than double */
     const Eigen::MatrixBase<DerivedOmega> & Omega,
     Eigen::PlainObjectBase<DerivedU> & U);
+  // Inputs:
+  //   Omega  #V by #T*10 sparse list of precomputated matrix values, storing
+  //     for each vertex only the 10 values of each bone influencing it (see
+  //     direct_delta_mush_precomputation below)
+  template <
+    typename DerivedV,
+    typename ScalarOmega,
+    typename DerivedU>
+  IGL_INLINE void direct_delta_mush(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const std::vector<
+      Eigen::Affine3d, Eigen::aligned_allocator<Eigen::Affine3d>
+    > & T,
+    const Eigen::SparseMatrix<ScalarOmega,Eigen::RowMajor> & Omega,
+    Eigen::PlainObjectBase<DerivedU> & U);
 
   // Precomputation
   //
@@ -63,6 +78,31 @@ namespace igl {
     const typename DerivedV::Scalar kappa,
     const typename DerivedV::Scalar alpha,
     Eigen::PlainObjectBase<DerivedOmega> & Omega);
+  // Inputs:
+  //   epsilon  drop the values of bone j at vertex i if its smoothed weight
+  //     Omega(i,j*10+9) is at most epsilon in magnitude. For non-negative
+  //     weights, epsilon=0 exactly skips bones that don't influence a vertex.
+  // Outputs:
+  //   Omega  #V by #T*10 sparse list of precomputated matrix values
+  //
+  // The kept values are emitted straight from the smoothing, but the
+  // smoothing itself still solves for a dense #V by #T*10 matrix, so the
+  // savings are in the stored Omega and in direct_delta_mush.
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedW,
+    typename ScalarOmega>
+  IGL_INLINE void direct_delta_mush_precomputation(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<DerivedW> & W,
+    const int p,
+    const typename DerivedV::Scalar lambda,
+    const typename DerivedV::Scalar kappa,
+    const typename DerivedV::Scalar alpha,
+    const typename DerivedV::Scalar epsilon,
+    Eigen::SparseMatrix<ScalarOmega,Eigen::RowMajor> & Omega);
 } // namespace igl
 
 #ifndef IGL_STATIC_LIBRARY
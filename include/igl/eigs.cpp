@@ -11,7 +11,54 @@
 #include "sort.h"
 #include "slice.h"
 #include "massmatrix.h"
+#include "parallel_for.h"
+#include <algorithm>
 #include <iostream>
+#include <numeric>
+#include <vector>
+
+namespace igl
+{
+  namespace internal
+  {
+    template <
+      typename Atype,
+      typename Btype,
+      typename DerivedU,
+      typename DerivedS>
+    IGL_INLINE bool eigs_inverse_iteration(
+      const Eigen::SparseMatrix<Atype> & A,
+      const Eigen::SparseMatrix<Btype> & iB,
+      const size_t k,
+      const EigsType type,
+      Eigen::PlainObjectBase<DerivedU> & sU,
+      Eigen::PlainObjectBase<DerivedS> & sS);
+    template <
+      typename Atype,
+      typename Btype,
+      typename DerivedU,
+      typename DerivedS>
+    IGL_INLINE bool eigs_block_lanczos(
+      const Eigen::SparseMatrix<Atype> & A,
+      const Eigen::SparseMatrix<Btype> & iB,
+      const size_t k,
+      const EigsType type,
+      Eigen::PlainObjectBase<DerivedU> & sU,
+      Eigen::PlainObjectBase<DerivedS> & sS);
+    // B-orthonormalize the columns of Y against the first c (B-orthonormal)
+    // columns of V and against each other. Columns that are numerically
+    // dependent are dropped, so Y may lose columns. If given, VC =
+    // V(:,1:c)ᵀ B Y is used for the first projection instead of recomputing
+    // it.
+    template <typename Scalar>
+    IGL_INLINE void eigs_b_orthonormalize(
+      const Eigen::SparseMatrix<Scalar> & B,
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> & V,
+      const int c,
+      Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> & Y,
+      const Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> * VC = nullptr);
+  }
+}
 
 template <
   typename Atype,
@@ -19,6 +66,303 @@ template <
   typename DerivedU,
   typename DerivedS>
 IGL_INLINE bool igl::eigs(
+  const Eigen::SparseMatrix<Atype> & A,
+  const Eigen::SparseMatrix<Btype> & B,
+  const size_t k,
+  const EigsType type,
+  Eigen::PlainObjectBase<DerivedU> & sU,
+  Eigen::PlainObjectBase<DerivedS> & sS)
+{
+  return igl::eigs(A,B,k,type,EIGS_METHOD_BLOCK_LANCZOS,sU,sS);
+}
+
+template <
+  typename Atype,
+  typename Btype,
+  typename DerivedU,
+  typename DerivedS>
+IGL_INLINE bool igl::eigs(
+  const Eigen::SparseMatrix<Atype> & A,
+  const Eigen::SparseMatrix<Btype> & B,
+  const size_t k,
+  const EigsType type,
+  const EigsMethod method,
+  Eigen::PlainObjectBase<DerivedU> & sU,
+  Eigen::PlainObjectBase<DerivedS> & sS)
+{
+  switch(method)
+  {
+    default:
+      assert(false && "Unknown method");
+      return false;
+    case EIGS_METHOD_BLOCK_LANCZOS:
+      return internal::eigs_block_lanczos(A,B,k,type,sU,sS);
+    case EIGS_METHOD_INVERSE_ITERATION:
+      if(type != EIGS_TYPE_SM)
+      {
+        std::cerr<<"Error: inverse iteration only supports EIGS_TYPE_SM."<<std::endl;
+        return false;
+      }
+      return internal::eigs_inverse_iteration(A,B,k,type,sU,sS);
+  }
+}
+
+template <typename Scalar>
+IGL_INLINE void igl::internal::eigs_b_orthonormalize(
+  const Eigen::SparseMatrix<Scalar> & B,
+  const Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> & V,
+  const int c,
+  Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> & Y,
+  const Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> * VC)
+{
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+  // Twice is enough (block classical Gram-Schmidt followed by an
+  // orthonormalization of the block from its Gram matrix)
+  for(int pass = 0;pass<2 && Y.cols()>0;pass++)
+  {
+    MatrixXS BY = B*Y;
+    if(c>0)
+    {
+      const VectorXS before = Y.cwiseProduct(BY).colwise().sum().transpose();
+      if(pass == 0 && VC)
+      {
+        Y.noalias() -= V.leftCols(c)*(*VC);
+      }else
+      {
+        Y.noalias() -= V.leftCols(c)*(V.leftCols(c).transpose()*BY);
+      }
+      BY = B*Y;
+      // Drop columns that (numerically) lie in the span of V
+      const VectorXS after = Y.cwiseProduct(BY).colwise().sum().transpose();
+      int q = 0;
+      for(int j = 0;j<Y.cols();j++)
+      {
+        if(after(j) > 1e-24*before(j))
+        {
+          Y.col(q) = Y.col(j);
+          BY.col(q) = BY.col(j);
+          q++;
+        }
+      }
+      Y.conservativeResize(Eigen::NoChange,q);
+      BY.conservativeResize(Eigen::NoChange,q);
+      if(q == 0)
+      {
+        return;
+      }
+    }
+    // Unit columns so that the Gram matrix only measures dependence within
+    // the block
+    const VectorXS scale =
+      Y.cwiseProduct(BY).colwise().sum().transpose().cwiseSqrt().cwiseInverse();
+    Y = (Y*scale.asDiagonal()).eval();
+    BY = (BY*scale.asDiagonal()).eval();
+    const MatrixXS G = Y.transpose()*BY;
+    const Eigen::SelfAdjointEigenSolver<MatrixXS> es(G);
+    const auto & d = es.eigenvalues();
+    // Eigen values are ascending: drop the (numerically) null directions
+    int drop = 0;
+    while(drop<d.size() && !(d(drop) > 1e-14*d(d.size()-1)))
+    {
+      drop++;
+    }
+    const int q = Y.cols()-drop;
+    const MatrixXS Q =
+      es.eigenvectors().rightCols(q)*
+      d.tail(q).cwiseSqrt().cwiseInverse().asDiagonal();
+    Y = (Y*Q).eval();
+  }
+}
+
+template <
+  typename Atype,
+  typename Btype,
+  typename DerivedU,
+  typename DerivedS>
+IGL_INLINE bool igl::internal::eigs_block_lanczos(
+  const Eigen::SparseMatrix<Atype> & A,
+  const Eigen::SparseMatrix<Btype> & iB,
+  const size_t k,
+  const EigsType type,
+  Eigen::PlainObjectBase<DerivedU> & sU,
+  Eigen::PlainObjectBase<DerivedS> & sS)
+{
+  using namespace Eigen;
+  using namespace std;
+  typedef Atype Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixXS;
+  typedef Matrix<Scalar,Dynamic,1> VectorXS;
+  const int n = A.rows();
+  assert(A.cols() == n && "A should be square.");
+  assert(iB.rows() == n && "B should be match A's dims.");
+  assert(iB.cols() == n && "B should be square.");
+  assert(k <= size_t(n) && "k should be at most #A.");
+  if(k == 0)
+  {
+    sU.resize(n,0);
+    sS.resize(0,1);
+    return true;
+  }
+  // Rescale B for better numerics
+  const Scalar rescale = std::abs(iB.diagonal().maxCoeff());
+  const SparseMatrix<Scalar> B = iB.template cast<Scalar>()/rescale;
+
+  // Spectral transformation T = C⁻¹M, self-adjoint w.r.t. the B inner
+  // product, whose largest magnitude eigen values θ correspond to the wanted
+  // eigen values of (A,B):
+  //   SM: C = A-σB, M = B, θ = 1/(s-σ) with a small shift σ so that a
+  //       singular A (e.g., a Laplacian) can be factored. The shift must not
+  //       be too small either: the null space would then swamp every block.
+  //   LM: C = B, M = A, θ = s
+  // Either way C is factored exactly once.
+  const Scalar normA = VectorXS(A.cwiseAbs()*VectorXS::Ones(n)).maxCoeff();
+  const Scalar sigma = -1e-6*normA;
+  const SparseMatrix<Scalar> & M = type == EIGS_TYPE_SM ? B : A;
+  SimplicialLDLT<SparseMatrix<Scalar> > solver;
+  switch(type)
+  {
+    default:
+      assert(false && "Not supported");
+      return false;
+    case EIGS_TYPE_SM:
+      solver.compute(SparseMatrix<Scalar>(A-sigma*B));
+      break;
+    case EIGS_TYPE_LM:
+      solver.compute(B);
+      break;
+  }
+  switch(solver.info())
+  {
+    case Eigen::Success:
+      break;
+    case Eigen::NumericalIssue:
+      cerr<<"Error: Numerical issue."<<endl;
+      return false;
+    default:
+      cerr<<"Error: Other."<<endl;
+      return false;
+  }
+  const auto apply = [&](const MatrixXS & Y, MatrixXS & W)
+  {
+    const MatrixXS MY = M*Y;
+    W.resize(n,Y.cols());
+    igl::parallel_for(
+      Y.cols(),
+      [&](const int j){ W.col(j) = solver.solve(MY.col(j)); },
+      2);
+  };
+
+  // Thick restart block Lanczos: p Ritz vectors are kept across restarts and
+  // the basis is grown by blocks of b vectors (solved in parallel) up to m
+  // vectors, about twice as many as the number of wanted pairs
+  const int p = std::min<int>(n,k+std::max<int>(k/4,4));
+  const int b = std::min<int>(p,8);
+  const int m = std::max(std::min<int>(n,2*k+20),std::min<int>(n,p+b));
+  // Tolerance on the residual relative to ‖A‖ + |s|
+  const Scalar tol = 1e-10;
+  const int max_iter = 1000;
+
+  MatrixXS V(n,m+b);
+  MatrixXS H = MatrixXS::Zero(m+b,m+b);
+  // Ritz vectors and values kept from the previous restart
+  MatrixXS X(n,0);
+  VectorXS theta;
+  // Pending (next) Lanczos block
+  MatrixXS Q = MatrixXS::Random(n,b);
+  VectorXS S;
+  int iter;
+  for(iter = 0;iter<max_iter;iter++)
+  {
+    // Block Lanczos with full reorthogonalization: V = [X Q₀ Q₁ …] is
+    // B-orthonormal and H = VᵀB T V (upper triangle). The residuals of the
+    // Ritz vectors X lie in the span of Q₀ so H(X,X) = diag(θ).
+    const int r = X.cols();
+    V.leftCols(r) = X;
+    H.setZero();
+    H.topLeftCorner(r,r).diagonal() = theta;
+    int c = r;
+    eigs_b_orthonormalize(B,V,c,Q);
+    while(c<m)
+    {
+      if(Q.cols() == 0)
+      {
+        // Invariant subspace: continue with a fresh random block
+        Q = MatrixXS::Random(n,b);
+        eigs_b_orthonormalize(B,V,c,Q);
+        if(Q.cols() == 0)
+        {
+          break;
+        }
+      }
+      const int q = Q.cols();
+      V.middleCols(c,q) = Q;
+      MatrixXS W;
+      apply(Q,W);
+      // Blocks beyond the first super-diagonal vanish in exact arithmetic,
+      // but fully reorthogonalized values are kept
+      const MatrixXS VW = V.leftCols(c+q).transpose()*(B*W);
+      H.block(0,c,c+q,q) = VW;
+      c += q;
+      Q = W;
+      eigs_b_orthonormalize(B,V,c,Q,&VW);
+    }
+    // Rayleigh-Ritz: keep the p Ritz pairs with largest |θ|
+    const SelfAdjointEigenSolver<MatrixXS> es(
+      MatrixXS(H.topLeftCorner(c,c).template selfadjointView<Upper>()));
+    vector<int> order(c);
+    std::iota(order.begin(),order.end(),0);
+    std::stable_sort(order.begin(),order.end(),
+      [&](const int i, const int j)
+      {
+        return abs(es.eigenvalues()(i))>abs(es.eigenvalues()(j));
+      });
+    const int nr = std::min(p,c);
+    MatrixXS Z(c,nr);
+    theta.resize(nr);
+    for(int i = 0;i<nr;i++)
+    {
+      Z.col(i) = es.eigenvectors().col(order[i]);
+      theta(i) = es.eigenvalues()(order[i]);
+    }
+    X.noalias() = V.leftCols(c)*Z;
+    // Convergence of the wanted pairs on the original problem
+    const MatrixXS AX = A*X.leftCols(k);
+    const MatrixXS BX = B*X.leftCols(k);
+    S = AX.cwiseProduct(X.leftCols(k)).colwise().sum().transpose().cwiseQuotient(
+      BX.cwiseProduct(X.leftCols(k)).colwise().sum().transpose());
+    bool converged = true;
+    for(size_t i = 0;i<k && converged;i++)
+    {
+      const Scalar err = (AX.col(i)-S(i)*BX.col(i)).norm();
+      converged = err <= tol*(normA+abs(S(i)))*BX.col(i).norm();
+    }
+    if(converged)
+    {
+      break;
+    }
+  }
+  if(iter == max_iter)
+  {
+    cerr<<"Failed to converge."<<endl;
+    return false;
+  }
+  // finally sort
+  VectorXi I;
+  igl::sort(S,1,false,sS,I);
+  DerivedU U = X.leftCols(k);
+  igl::slice(U,I,2,sU);
+  sS /= rescale;
+  sU /= sqrt(rescale);
+  return true;
+}
+
+template <
+  typename Atype,
+  typename Btype,
+  typename DerivedU,
+  typename DerivedS>
+IGL_INLINE bool igl::internal::eigs_inverse_iteration(
   const Eigen::SparseMatrix<Atype> & A,
   const Eigen::SparseMatrix<Btype> & iB,
   const size_t k,
@@ -170,4 +514,5 @@ IGL_INLINE bool igl::eigs(
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template bool igl::eigs<double, double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::SparseMatrix<double, 0, int> const&, const size_t, igl::EigsType, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template bool igl::eigs<double, double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::SparseMatrix<double, 0, int> const&, Eigen::SparseMatrix<double, 0, int> const&, const size_t, igl::EigsType, igl::EigsMethod, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
@@ -13,6 +13,24 @@
 
 namespace igl
 {
+  enum EigsType
+  {
+    EIGS_TYPE_SM = 0,
+    EIGS_TYPE_LM = 1,
+    NUM_EIGS_TYPES = 2
+  };
+  enum EigsMethod
+  {
+    // Shift-invert block Lanczos: factor A (or B for EIGS_TYPE_LM) once and
+    // converge all k pairs together in a restarted, fully B-orthogonalized
+    // block Krylov subspace
+    EIGS_METHOD_BLOCK_LANCZOS = 0,
+    // Rayleigh quotient inverse iteration, one eigen pair at a time with
+    // explicit deflation. Refactors A at every iteration and only supports
+    // EIGS_TYPE_SM.
+    EIGS_METHOD_INVERSE_ITERATION = 1,
+    NUM_EIGS_METHODS = 2
+  };
   // Act like MATLAB's eigs function. Compute the first/last k eigen pairs of
   // the generalized eigen value problem:
   //
@@ -20,27 +38,18 @@ namespace igl
   //
   // Solutions are approximate and sorted. 
   //
-  // Ideally one should use ARPACK and the Eigen unsupported ARPACK module.
-  // This implementation does simple, naive power iterations.
-  //
   // Inputs:
   //   A  #A by #A symmetric matrix
   //   B  #A by #A symmetric positive-definite matrix
   //   k  number of eigen pairs to compute
-  //   type  whether to extract from the high or low end
+  //   type  whether to extract from the high or low end: EIGS_TYPE_SM finds
+  //     the eigen values of smallest magnitude, EIGS_TYPE_LM those of largest
+  //     magnitude
   // Outputs:
-  //   sU  #A by k list of sorted eigen vectors (descending)
+  //   sU  #A by k list of sorted eigen vectors (descending), B-orthonormal
   //   sS  k list of sorted eigen values (descending)
+  // Returns true iff successful
   //
-  // Known issues:
-  //   - only the 'sm' small magnitude eigen values are well supported
-  //   
-  enum EigsType
-  {
-    EIGS_TYPE_SM = 0,
-    EIGS_TYPE_LM = 1,
-    NUM_EIGS_TYPES = 2
-  };
   template <
     typename Atype,
     typename Btype,
@@ -53,6 +62,21 @@ namespace igl
     const EigsType type,
     Eigen::PlainObjectBase<DerivedU> & sU,
     Eigen::PlainObjectBase<DerivedS> & sS);
+  // Inputs:
+  //   method  solver used, see EigsMethod
+  template <
+    typename Atype,
+    typename Btype,
+    typename DerivedU,
+    typename DerivedS>
+  IGL_INLINE bool eigs(
+    const Eigen::SparseMatrix<Atype> & A,
+    const Eigen::SparseMatrix<Btype> & B,
+    const size_t k,
+    const EigsType type,
+    const EigsMethod method,
+    Eigen::PlainObjectBase<DerivedU> & sU,
+    Eigen::PlainObjectBase<DerivedS> & sS);
 }
 
 #ifndef IGL_STATIC_LIBRARY
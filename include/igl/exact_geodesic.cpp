@@ -13,6 +13,7 @@
 // Compiled into a single file by Zhongshi Jiang
 
 #include <igl/PI.h>
+#include <igl/parallel_for.h>
 #include <algorithm>
 #include <cassert>
 #include <cmath>
@@ -23,6 +24,7 @@
 #include <set>
 #include <vector>
 #include <memory>
+#include <mutex>
 namespace igl{
 namespace geodesic{
 
@@ -157,10 +159,11 @@ public:
 
 	~MemoryAllocator(){};
 
-	void clear()
+	void clear()		//forget all allocations but keep the blocks for reuse
 	{
-		reset(m_block_size,
-			  m_max_number_of_blocks);
+		m_current_block = 0;
+		m_current_position = 0;
+		m_deleted.clear();
 	}
 
 	void reset(unsigned block_size,
@@ -172,6 +175,7 @@ public:
 		assert(m_block_size > 0);
 		assert(m_max_number_of_blocks > 0);
 
+		m_current_block = 0;
 		m_current_position = 0;
 
 		m_storage.reserve(max_number_of_blocks);
@@ -189,11 +193,14 @@ public:
 		{
 			if(m_current_position + 1 >= m_block_size)
 			{
-				m_storage.push_back( std::vector<T>() );
-				m_storage.back().resize(m_block_size);
+				if(++m_current_block == m_storage.size())
+				{
+					m_storage.push_back( std::vector<T>() );
+					m_storage.back().resize(m_block_size);
+				}
 				m_current_position = 0;
 			}
-			result = & m_storage.back()[m_current_position];
+			result = & m_storage[m_current_block][m_current_position];
 			++m_current_position;
 		}
 		else
@@ -217,6 +224,7 @@ private:
 	std::vector<std::vector<T> > m_storage;
 	unsigned m_block_size;				//size of a single block
 	unsigned m_max_number_of_blocks;		//maximum allowed number of blocks
+	size_t m_current_block;				//block currently being filled
 	unsigned m_current_position;			//first unused element inside the current block
 
 	std::vector<pointer> m_deleted;			//pointers to deleted elemets
@@ -3170,9 +3178,34 @@ IGL_INLINE void igl::exact_geodesic(
   const Eigen::MatrixBase<DerivedVT> &VT,
   const Eigen::MatrixBase<DerivedFT> &FT,
   Eigen::PlainObjectBase<DerivedD> &D)
+{
+  const ExactGeodesic geodesic(V,F);
+  geodesic.distance(VS,FS,VT,FT,D);
+}
+
+struct igl::ExactGeodesic::Impl
+{
+  igl::geodesic::Mesh mesh;
+  // Propagation states not currently used by a query
+  std::mutex pool_mutex;
+  std::vector<std::unique_ptr<igl::geodesic::GeodesicAlgorithmExact> > pool;
+};
+
+IGL_INLINE igl::ExactGeodesic::ExactGeodesic():
+  m_impl(new Impl())
+{
+}
+
+IGL_INLINE igl::ExactGeodesic::~ExactGeodesic()
+{
+}
+
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::ExactGeodesic::precompute(
+  const Eigen::MatrixBase<DerivedV> &V,
+  const Eigen::MatrixBase<DerivedF> &F)
 {
   assert(V.cols() == 3 && F.cols() == 3 && "Only support 3D triangle mesh");
-  assert(VS.cols() <=1 && FS.cols() <= 1 && VT.cols() <= 1 && FT.cols() <=1 && "Only support one dimensional inputs");
   std::vector<typename DerivedV::Scalar> points(V.rows() * V.cols());
   std::vector<typename DerivedF::Scalar> faces(F.rows() * F.cols());
   for (int i = 0; i < points.size(); i++)
@@ -3183,11 +3216,26 @@ IGL_INLINE void igl::exact_geodesic(
   {
     faces[i] = F(i / 3, i % 3);
   }
+  // The propagation states point into the old mesh
+  m_impl.reset(new Impl());
+  m_impl->mesh.initialize_mesh_data(points, faces);
+}
 
-  igl::geodesic::Mesh mesh;
-  mesh.initialize_mesh_data(points, faces);
-  igl::geodesic::GeodesicAlgorithmExact exact_algorithm(&mesh);
-
+template <
+  typename DerivedVS,
+  typename DerivedFS,
+  typename DerivedVT,
+  typename DerivedFT,
+  typename DerivedD>
+IGL_INLINE void igl::ExactGeodesic::distance(
+  const Eigen::MatrixBase<DerivedVS> &VS,
+  const Eigen::MatrixBase<DerivedFS> &FS,
+  const Eigen::MatrixBase<DerivedVT> &VT,
+  const Eigen::MatrixBase<DerivedFT> &FT,
+  Eigen::PlainObjectBase<DerivedD> &D) const
+{
+  assert(VS.cols() <=1 && FS.cols() <= 1 && VT.cols() <= 1 && FT.cols() <=1 && "Only support one dimensional inputs");
+  igl::geodesic::Mesh & mesh = m_impl->mesh;
   std::vector<igl::geodesic::SurfacePoint> source(VS.rows() + FS.rows());
   std::vector<igl::geodesic::SurfacePoint> target(VT.rows() + FT.rows());
   for (int i = 0; i < VS.rows(); i++)
@@ -3196,7 +3244,7 @@ IGL_INLINE void igl::exact_geodesic(
   }
   for (int i = 0; i < FS.rows(); i++)
   {
-    source[i] = (igl::geodesic::SurfacePoint(&mesh.faces()[FS(i, 0)]));
+    source[VS.rows() + i] = (igl::geodesic::SurfacePoint(&mesh.faces()[FS(i, 0)]));
   }
 
   for (int i = 0; i < VT.rows(); i++)
@@ -3205,20 +3253,69 @@ IGL_INLINE void igl::exact_geodesic(
   }
   for (int i = 0; i < FT.rows(); i++)
   {
-    target[i] = (igl::geodesic::SurfacePoint(&mesh.faces()[FT(i, 0)]));
+    target[VT.rows() + i] = (igl::geodesic::SurfacePoint(&mesh.faces()[FT(i, 0)]));
+  }
+
+  // Borrow a propagation state from the pool (or make a new one)
+  std::unique_ptr<igl::geodesic::GeodesicAlgorithmExact> exact_algorithm;
+  {
+    std::lock_guard<std::mutex> lock(m_impl->pool_mutex);
+    if(!m_impl->pool.empty())
+    {
+      exact_algorithm = std::move(m_impl->pool.back());
+      m_impl->pool.pop_back();
+    }
+  }
+  if(!exact_algorithm)
+  {
+    exact_algorithm.reset(new igl::geodesic::GeodesicAlgorithmExact(&mesh));
   }
 
-  exact_algorithm.propagate(source);
-  std::vector<igl::geodesic::SurfacePoint> path;
+  exact_algorithm->propagate(source);
+  // Read distances off the propagated intervals rather than tracing back
+  // each path (same up to round-off, and much faster)
   D.resize(target.size(), 1);
   for (int i = 0; i < target.size(); i++)
   {
-    exact_algorithm.trace_back(target[i], path);
-    D(i) = igl::geodesic::length(path);
+    double d;
+    exact_algorithm->best_source(target[i], d);
+    // Unreachable targets have no path
+    D(i) = d < igl::geodesic::GEODESIC_INF/2.0 ? d : 0;
   }
+
+  std::lock_guard<std::mutex> lock(m_impl->pool_mutex);
+  m_impl->pool.push_back(std::move(exact_algorithm));
+}
+
+template <
+  typename DerivedVT,
+  typename DerivedFT,
+  typename DerivedD>
+IGL_INLINE void igl::ExactGeodesic::distance(
+  const std::vector<Eigen::VectorXi> &VS,
+  const std::vector<Eigen::VectorXi> &FS,
+  const Eigen::MatrixBase<DerivedVT> &VT,
+  const Eigen::MatrixBase<DerivedFT> &FT,
+  Eigen::PlainObjectBase<DerivedD> &D) const
+{
+  assert((VS.empty() || FS.empty() || FS.size() == VS.size()) &&
+    "VS and FS should each be empty or have one entry per source set");
+  const int num_sets = std::max(VS.size(),FS.size());
+  D.resize(VT.rows() + FT.rows(), num_sets);
+  // Each propagation is expensive, so parallelize over every source set
+  igl::parallel_for(num_sets,[&](const int s)
+  {
+    Eigen::VectorXd Ds;
+    distance(
+      VS.empty() ? Eigen::VectorXi() : VS[s],
+      FS.empty() ? Eigen::VectorXi() : FS[s],
+      VT,FT,Ds);
+    D.col(s) = Ds.template cast<typename DerivedD::Scalar>();
+  },1);
 }
 
 #ifdef IGL_STATIC_LIBRARY
 template void igl::exact_geodesic<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1>> const &, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1>> &);
 template void igl::exact_geodesic<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::ExactGeodesic::distance<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::vector<Eigen::Matrix<int, -1, 1, 0, -1, 1>, std::allocator<Eigen::Matrix<int, -1, 1, 0, -1, 1> > > const&, std::vector<Eigen::Matrix<int, -1, 1, 0, -1, 1>, std::allocator<Eigen::Matrix<int, -1, 1, 0, -1, 1> > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
 #endif
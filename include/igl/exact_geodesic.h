@@ -11,6 +11,8 @@
 
 #include "igl_inline.h"
 #include <Eigen/Core>
+#include <memory>
+#include <vector>
 
 namespace igl 
 {
@@ -46,6 +48,94 @@ namespace igl
       const Eigen::MatrixBase<DerivedVT> &VT,
       const Eigen::MatrixBase<DerivedFT> &FT,
       Eigen::PlainObjectBase<DerivedD> &D);
+
+  // Exact geodesic distances from many source sets on the same mesh. The mesh
+  // connectivity is built once, and the propagation state (per-edge interval
+  // lists and their memory pools) of each query is kept and reused by the
+  // next one. Queries are const and may be issued from several threads at
+  // once: each concurrent query uses its own propagation state.
+  //
+  // Example:
+  //   igl::ExactGeodesic geodesic(V,F);
+  //   Eigen::VectorXi VT = Eigen::VectorXi::LinSpaced(V.rows(),0,V.rows()-1);
+  //   // One column of distances per source set
+  //   Eigen::MatrixXd D;
+  //   geodesic.distance(VS_list,{},VT,Eigen::VectorXi(),D);
+  class ExactGeodesic
+  {
+    public:
+      IGL_INLINE ExactGeodesic();
+      IGL_INLINE ~ExactGeodesic();
+      ExactGeodesic(const ExactGeodesic &) = delete;
+      ExactGeodesic & operator=(const ExactGeodesic &) = delete;
+      // Inputs:
+      //   V  #V by 3 list of 3D vertex positions
+      //   F  #F by 3 list of mesh faces
+      template <typename DerivedV, typename DerivedF>
+      ExactGeodesic(
+        const Eigen::MatrixBase<DerivedV> &V,
+        const Eigen::MatrixBase<DerivedF> &F):
+        ExactGeodesic()
+      {
+        precompute(V,F);
+      }
+      // Build the mesh data structure, discarding any previous mesh and
+      // propagation states.
+      //
+      // Inputs:
+      //   V  #V by 3 list of 3D vertex positions
+      //   F  #F by 3 list of mesh faces
+      template <typename DerivedV, typename DerivedF>
+      IGL_INLINE void precompute(
+        const Eigen::MatrixBase<DerivedV> &V,
+        const Eigen::MatrixBase<DerivedF> &F);
+      // Inputs:
+      //   VS #VS by 1 vector specifying indices of source vertices
+      //   FS #FS by 1 vector specifying indices of source faces
+      //   VT #VT by 1 vector specifying indices of target vertices
+      //   FT #FT by 1 vector specifying indices of target faces
+      // Output:
+      //   D  #VT+#FT by 1 vector of geodesic distances of each target w.r.t.
+      //     the nearest one in the source set
+      template <
+        typename DerivedVS,
+        typename DerivedFS,
+        typename DerivedVT,
+        typename DerivedFT,
+        typename DerivedD>
+      IGL_INLINE void distance(
+        const Eigen::MatrixBase<DerivedVS> &VS,
+        const Eigen::MatrixBase<DerivedFS> &FS,
+        const Eigen::MatrixBase<DerivedVT> &VT,
+        const Eigen::MatrixBase<DerivedFT> &FT,
+        Eigen::PlainObjectBase<DerivedD> &D) const;
+      // Distances from several independent source sets, propagated in
+      // parallel.
+      //
+      // Inputs:
+      //   VS  #S list of source vertex index vectors (or empty if there are
+      //     no source vertices)
+      //   FS  #S list of source face index vectors (or empty if there are no
+      //     source faces)
+      //   VT #VT by 1 vector specifying indices of target vertices
+      //   FT #FT by 1 vector specifying indices of target faces
+      // Output:
+      //   D  #VT+#FT by #S matrix so that D(:,s) are the geodesic distances of
+      //     each target w.r.t. the nearest source in the sth set
+      template <
+        typename DerivedVT,
+        typename DerivedFT,
+        typename DerivedD>
+      IGL_INLINE void distance(
+        const std::vector<Eigen::VectorXi> &VS,
+        const std::vector<Eigen::VectorXi> &FS,
+        const Eigen::MatrixBase<DerivedVT> &VT,
+        const Eigen::MatrixBase<DerivedFT> &FT,
+        Eigen::PlainObjectBase<DerivedD> &D) const;
+    private:
+      struct Impl;
+      std::unique_ptr<Impl> m_impl;
+  };
 }
 
 #ifndef IGL_STATIC_LIBRARY
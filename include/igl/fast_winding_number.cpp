@@ -6,20 +6,65 @@
 #include <vector>
 #include <cassert>
 
+namespace igl
+{
+  namespace internal
+  {
+    // Point cloud precomputation and evaluation shared by the octree
+    // representations: cell_size(c) is the number of points in cell c and
+    // cell_point(c,j) is the index into P of its jth point.
+    template <
+      typename DerivedP, typename DerivedA, typename DerivedN,
+      typename CellSize, typename CellPoint, typename DerivedCH,
+      typename DerivedCM, typename DerivedR, typename DerivedEC>
+    IGL_INLINE void fast_winding_number(
+      const Eigen::MatrixBase<DerivedP>& P,
+      const Eigen::MatrixBase<DerivedN>& N,
+      const Eigen::MatrixBase<DerivedA>& A,
+      const CellSize & cell_size,
+      const CellPoint & cell_point,
+      const Eigen::MatrixBase<DerivedCH>& CH,
+      const int expansion_order,
+      Eigen::PlainObjectBase<DerivedCM>& CM,
+      Eigen::PlainObjectBase<DerivedR>& R,
+      Eigen::PlainObjectBase<DerivedEC>& EC);
+    template <
+      typename DerivedP, typename DerivedA, typename DerivedN,
+      typename CellSize, typename CellPoint, typename DerivedCH,
+      typename DerivedCM, typename DerivedR, typename DerivedEC,
+      typename DerivedQ, typename BetaType, typename DerivedWN>
+    IGL_INLINE void fast_winding_number(
+      const Eigen::MatrixBase<DerivedP>& P,
+      const Eigen::MatrixBase<DerivedN>& N,
+      const Eigen::MatrixBase<DerivedA>& A,
+      const CellSize & cell_size,
+      const CellPoint & cell_point,
+      const Eigen::MatrixBase<DerivedCH>& CH,
+      const Eigen::MatrixBase<DerivedCM>& CM,
+      const Eigen::MatrixBase<DerivedR>& R,
+      const Eigen::MatrixBase<DerivedEC>& EC,
+      const Eigen::MatrixBase<DerivedQ>& Q,
+      const BetaType beta,
+      Eigen::PlainObjectBase<DerivedWN>& WN);
+  }
+}
+
 template <
   typename DerivedP, 
   typename DerivedA, 
   typename DerivedN,
-  typename Index, 
+  typename CellSize,
+  typename CellPoint,
   typename DerivedCH, 
   typename DerivedCM, 
   typename DerivedR,
   typename DerivedEC>
-IGL_INLINE void igl::fast_winding_number(
+IGL_INLINE void igl::internal::fast_winding_number(
   const Eigen::MatrixBase<DerivedP>& P,
   const Eigen::MatrixBase<DerivedN>& N,
   const Eigen::MatrixBase<DerivedA>& A,
-  const std::vector<std::vector<Index> > & point_indices,
+  const CellSize & cell_size,
+  const CellPoint & cell_point,
   const Eigen::MatrixBase<DerivedCH>& CH,
   const int expansion_order,
   Eigen::PlainObjectBase<DerivedCM>& CM,
@@ -35,7 +80,7 @@ IGL_INLINE void igl::fast_winding_number(
 
   typedef Eigen::Matrix<real_p,1,3> RowVec3p;
 
-  int m = CH.size();
+  int m = CH.rows();
   int num_terms;
 
   assert(expansion_order < 3 && expansion_order >= 0 && "m must be less than n");
@@ -51,9 +96,7 @@ IGL_INLINE void igl::fast_winding_number(
   CM.resize(m,3);
   EC.resize(m,num_terms);
   EC.setZero(m,num_terms);
-  std::function< void(const int) > helper;
-  helper = [&helper,
-            &P,&N,&A,&expansion_order,&point_indices,&CH,&EC,&R,&CM]
+  const auto helper = [&P,&N,&A,&cell_size,&cell_point,&EC,&R,&CM]
   (const int index)-> void
   {
       Eigen::Matrix<real_cm,1,3> masscenter;
@@ -61,8 +104,8 @@ IGL_INLINE void igl::fast_winding_number(
       Eigen::Matrix<real_ec,1,3> zeroth_expansion;
       zeroth_expansion << 0,0,0;
       real_p areatotal = 0.0;
-      for(int j = 0; j < point_indices[index].size(); j++){
-          int curr_point_index = point_indices[index][j];
+      for(int j = 0; j < cell_size(index); j++){
+          int curr_point_index = cell_point(index,j);
         
           areatotal += A(curr_point_index);
           masscenter += A(curr_point_index)*P.row(curr_point_index);
@@ -76,9 +119,9 @@ IGL_INLINE void igl::fast_winding_number(
       real_r max_norm = 0;
       real_r curr_norm;
     
-      for(int i = 0; i < point_indices[index].size(); i++){
+      for(int i = 0; i < cell_size(index); i++){
           //Get max distance from center of mass:
-          int curr_point_index = point_indices[index][i];
+          int curr_point_index = cell_point(index,i);
           Eigen::Matrix<real_r,1,3> point =
               P.row(curr_point_index)-masscenter;
           curr_norm = point.norm();
@@ -108,22 +151,17 @@ IGL_INLINE void igl::fast_winding_number(
       }
     
       R(index) = max_norm;
-      if(CH(index,0) != -1)
-      {
-          for(int i = 0; i < 8; i++){
-              int child = CH(index,i);
-              helper(child);
-          }
-      }
   };
-  helper(0);
+  // Every cell's expansion only depends on its own points
+  igl::parallel_for(m,helper,1000);
 }
 
 template <
   typename DerivedP, 
   typename DerivedA, 
   typename DerivedN,
-  typename Index, 
+  typename CellSize,
+  typename CellPoint,
   typename DerivedCH, 
   typename DerivedCM, 
   typename DerivedR,
@@ -131,11 +169,12 @@ template <
   typename DerivedQ, 
   typename BetaType,
   typename DerivedWN>
-IGL_INLINE void igl::fast_winding_number(
+IGL_INLINE void igl::internal::fast_winding_number(
   const Eigen::MatrixBase<DerivedP>& P,
   const Eigen::MatrixBase<DerivedN>& N,
   const Eigen::MatrixBase<DerivedA>& A,
-  const std::vector<std::vector<Index> > & point_indices,
+  const CellSize & cell_size,
+  const CellPoint & cell_point,
   const Eigen::MatrixBase<DerivedCH>& CH,
   const Eigen::MatrixBase<DerivedCM>& CM,
   const Eigen::MatrixBase<DerivedR>& R,
@@ -240,7 +279,7 @@ IGL_INLINE void igl::fast_winding_number(
   std::function< real_wn(const RowVec & , const std::vector<int> &) > helper;
   helper = [&helper,
             &P,&N,&A,
-            &point_indices,&CH,
+            &cell_size,&cell_point,&CH,
             &CM,&R,&EC,&beta,
             &direct_eval,&expansion_eval]
   (const RowVec & query, const std::vector<int> & near_indices)-> real_wn
@@ -248,15 +287,15 @@ IGL_INLINE void igl::fast_winding_number(
     real_wn wn = 0;
     std::vector<int> new_near_indices;
     new_near_indices.reserve(8);
-    for(int i = 0; i < near_indices.size(); i++)
+    for(int i = 0; i < (int)near_indices.size(); i++)
     {
       int index = near_indices[i];
       //Leaf Case, Brute force
       if(CH(index,0) == -1)
       {
-        for(int j = 0; j < point_indices[index].size(); j++)
+        for(int j = 0; j < cell_size(index); j++)
         {
-          int curr_row = point_indices[index][j];
+          int curr_row = cell_point(index,j);
           wn += direct_eval(P.row(curr_row)-query,
                             N.row(curr_row)*A(curr_row));
         }
@@ -267,16 +306,16 @@ IGL_INLINE void igl::fast_winding_number(
         for(int child = 0; child < 8; child++)
         {
           int child_index = CH(index,child);
-          if(point_indices[child_index].size() > 0)
+          if(cell_size(child_index) > 0)
           {
             const RowVec CMciq = (CM.row(child_index)-query);
             if(CMciq.norm() > beta*R(child_index))
             {
               if(CH(child_index,0) == -1)
               {
-                for(int j=0;j<point_indices[child_index].size();j++)
+                for(int j=0;j<cell_size(child_index);j++)
                 {
-                  int curr_row = point_indices[child_index][j];
+                  int curr_row = cell_point(child_index,j);
                   wn += direct_eval(P.row(curr_row)-query,
                                     N.row(curr_row)*A(curr_row));
                 }
@@ -317,6 +356,124 @@ IGL_INLINE void igl::fast_winding_number(
   }
 }
 
+template <
+  typename DerivedP, 
+  typename DerivedA, 
+  typename DerivedN,
+  typename Index, 
+  typename DerivedCH, 
+  typename DerivedCM, 
+  typename DerivedR,
+  typename DerivedEC>
+IGL_INLINE void igl::fast_winding_number(
+  const Eigen::MatrixBase<DerivedP>& P,
+  const Eigen::MatrixBase<DerivedN>& N,
+  const Eigen::MatrixBase<DerivedA>& A,
+  const std::vector<std::vector<Index> > & point_indices,
+  const Eigen::MatrixBase<DerivedCH>& CH,
+  const int expansion_order,
+  Eigen::PlainObjectBase<DerivedCM>& CM,
+  Eigen::PlainObjectBase<DerivedR>& R,
+  Eigen::PlainObjectBase<DerivedEC>& EC)
+{
+  igl::internal::fast_winding_number(P,N,A,
+    [&point_indices](int c){ return int(point_indices[c].size()); },
+    [&point_indices](int c, int j){ return int(point_indices[c][j]); },
+    CH,expansion_order,CM,R,EC);
+}
+
+template <
+  typename DerivedP, 
+  typename DerivedA, 
+  typename DerivedN,
+  typename Derivedpoint_order, 
+  typename DerivedCR, 
+  typename DerivedCH, 
+  typename DerivedCM, 
+  typename DerivedR,
+  typename DerivedEC>
+IGL_INLINE void igl::fast_winding_number(
+  const Eigen::MatrixBase<DerivedP>& P,
+  const Eigen::MatrixBase<DerivedN>& N,
+  const Eigen::MatrixBase<DerivedA>& A,
+  const Eigen::MatrixBase<Derivedpoint_order>& point_order,
+  const Eigen::MatrixBase<DerivedCR>& CR,
+  const Eigen::MatrixBase<DerivedCH>& CH,
+  const int expansion_order,
+  Eigen::PlainObjectBase<DerivedCM>& CM,
+  Eigen::PlainObjectBase<DerivedR>& R,
+  Eigen::PlainObjectBase<DerivedEC>& EC)
+{
+  igl::internal::fast_winding_number(P,N,A,
+    [&CR](int c){ return int(CR(c,1)-CR(c,0)); },
+    [&point_order,&CR](int c, int j){ return int(point_order(CR(c,0)+j)); },
+    CH,expansion_order,CM,R,EC);
+}
+
+template <
+  typename DerivedP, 
+  typename DerivedA, 
+  typename DerivedN,
+  typename Index, 
+  typename DerivedCH, 
+  typename DerivedCM, 
+  typename DerivedR,
+  typename DerivedEC, 
+  typename DerivedQ, 
+  typename BetaType,
+  typename DerivedWN>
+IGL_INLINE void igl::fast_winding_number(
+  const Eigen::MatrixBase<DerivedP>& P,
+  const Eigen::MatrixBase<DerivedN>& N,
+  const Eigen::MatrixBase<DerivedA>& A,
+  const std::vector<std::vector<Index> > & point_indices,
+  const Eigen::MatrixBase<DerivedCH>& CH,
+  const Eigen::MatrixBase<DerivedCM>& CM,
+  const Eigen::MatrixBase<DerivedR>& R,
+  const Eigen::MatrixBase<DerivedEC>& EC,
+  const Eigen::MatrixBase<DerivedQ>& Q,
+  const BetaType beta,
+  Eigen::PlainObjectBase<DerivedWN>& WN)
+{
+  igl::internal::fast_winding_number(P,N,A,
+    [&point_indices](int c){ return int(point_indices[c].size()); },
+    [&point_indices](int c, int j){ return int(point_indices[c][j]); },
+    CH,CM,R,EC,Q,beta,WN);
+}
+
+template <
+  typename DerivedP, 
+  typename DerivedA, 
+  typename DerivedN,
+  typename Derivedpoint_order, 
+  typename DerivedCR, 
+  typename DerivedCH, 
+  typename DerivedCM, 
+  typename DerivedR,
+  typename DerivedEC, 
+  typename DerivedQ, 
+  typename BetaType,
+  typename DerivedWN>
+IGL_INLINE void igl::fast_winding_number(
+  const Eigen::MatrixBase<DerivedP>& P,
+  const Eigen::MatrixBase<DerivedN>& N,
+  const Eigen::MatrixBase<DerivedA>& A,
+  const Eigen::MatrixBase<Derivedpoint_order>& point_order,
+  const Eigen::MatrixBase<DerivedCR>& CR,
+  const Eigen::MatrixBase<DerivedCH>& CH,
+  const Eigen::MatrixBase<DerivedCM>& CM,
+  const Eigen::MatrixBase<DerivedR>& R,
+  const Eigen::MatrixBase<DerivedEC>& EC,
+  const Eigen::MatrixBase<DerivedQ>& Q,
+  const BetaType beta,
+  Eigen::PlainObjectBase<DerivedWN>& WN)
+{
+  igl::internal::fast_winding_number(P,N,A,
+    [&CR](int c){ return int(CR(c,1)-CR(c,0)); },
+    [&point_order,&CR](int c, int j){ return int(point_order(CR(c,0)+j)); },
+    CH,CM,R,EC,Q,beta,WN);
+}
+
 template <
   typename DerivedP, 
   typename DerivedA, 
@@ -335,19 +492,20 @@ IGL_INLINE void igl::fast_winding_number(
 {
   typedef typename DerivedWN::Scalar real;
   
-  std::vector<std::vector<int> > point_indices;
+  Eigen::Matrix<int,Eigen::Dynamic,1> point_order;
+  Eigen::Matrix<int,Eigen::Dynamic,2> CR;
   Eigen::Matrix<int,Eigen::Dynamic,8> CH;
   Eigen::Matrix<real,Eigen::Dynamic,3> CN;
   Eigen::Matrix<real,Eigen::Dynamic,1> W;
 
-  octree(P,point_indices,CH,CN,W);
+  octree(P,point_order,CR,CH,CN,W);
 
   Eigen::Matrix<real,Eigen::Dynamic,Eigen::Dynamic> EC;
   Eigen::Matrix<real,Eigen::Dynamic,3> CM;
   Eigen::Matrix<real,Eigen::Dynamic,1> R;
 
-  fast_winding_number(P,N,A,point_indices,CH,expansion_order,CM,R,EC);
-  fast_winding_number(P,N,A,point_indices,CH,CM,R,EC,Q,beta,WN);
+  fast_winding_number(P,N,A,point_order,CR,CH,expansion_order,CM,R,EC);
+  fast_winding_number(P,N,A,point_order,CR,CH,CM,R,EC,Q,beta,WN);
 }
 
 template <
@@ -476,9 +634,14 @@ template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>,
 template void igl::fast_winding_number<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 1, 0, -1, 1> >(igl::FastWindingNumberBVH const&, float, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 1, 0, -1, 1> >&);
 template void igl::fast_winding_number<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, igl::FastWindingNumberBVH&);
 
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 // tom did this manually. Unsure how to generate otherwise... sorry.
 template Eigen::Matrix<float, 1, 3, 1, 1, 3>::Scalar igl::fast_winding_number<Eigen::Matrix<float, 1, 3, 1, 1, 3> >(igl::FastWindingNumberBVH const&, float, Eigen::MatrixBase<Eigen::Matrix<float, 1, 3, 1, 1, 3> > const&);
 template void igl::fast_winding_number<Eigen::Matrix<float, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, int, igl::FastWindingNumberBVH&);
 template void igl::fast_winding_number<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, int, igl::FastWindingNumberBVH&);
 template Eigen::CwiseUnaryOp<Eigen::internal::scalar_cast_op<double, float>, Eigen::Matrix<double, 1, 3, 1, 1, 3> const>::Scalar igl::fast_winding_number<Eigen::CwiseUnaryOp<Eigen::internal::scalar_cast_op<double, float>, Eigen::Matrix<double, 1, 3, 1, 1, 3> const> >(igl::FastWindingNumberBVH const&, float, Eigen::MatrixBase<Eigen::CwiseUnaryOp<Eigen::internal::scalar_cast_op<double, float>, Eigen::Matrix<double, 1, 3, 1, 1, 3> const> > const&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, double, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, double, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::fast_winding_number<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, double, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
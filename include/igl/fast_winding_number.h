@@ -102,6 +102,94 @@ namespace igl
     const Eigen::MatrixBase<DerivedQ>& Q,
     const BetaType beta,
     Eigen::PlainObjectBase<DerivedWN>& WN);
+  // Same as above, using the flat octree output from igl::octree(P,I,CR,...)
+  //
+  // Inputs:
+  //   P  #P by 3 list of point locations
+  //   N  #P by 3 list of point normals
+  //   A  #P by 1 list of point areas
+  //   point_order  #P list of indices into P sorted in octree cell order
+  //   CR  #OctreeCells by 2 list of [begin,end) ranges into point_order of
+  //       each octree cell's points
+  //   CH  #OctreeCells by 8, where the ith row is the indices of
+  //       the ith octree cell's children
+  //   expansion_order    the order of the taylor expansion. We support 0,1,2.
+  // Outputs:
+  //   CM  #OctreeCells by 3 list of each cell's center of mass
+  //   R   #OctreeCells by 1 list of each cell's maximum distance of any point
+  //       to the center of mass
+  //   EC  #OctreeCells by #TaylorCoefficients list of expansion coefficients.
+  template <
+    typename DerivedP, 
+    typename DerivedA, 
+    typename DerivedN,
+    typename Derivedpoint_order, 
+    typename DerivedCR, 
+    typename DerivedCH, 
+    typename DerivedCM, 
+    typename DerivedR,
+    typename DerivedEC>
+  IGL_INLINE void fast_winding_number(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedN>& N,
+    const Eigen::MatrixBase<DerivedA>& A,
+    const Eigen::MatrixBase<Derivedpoint_order>& point_order,
+    const Eigen::MatrixBase<DerivedCR>& CR,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const int expansion_order,
+    Eigen::PlainObjectBase<DerivedCM>& CM,
+    Eigen::PlainObjectBase<DerivedR>& R,
+    Eigen::PlainObjectBase<DerivedEC>& EC);
+  // Evaluate the fast winding number for point data using the flat octree,
+  // having already done the precomputation (see above).
+  //
+  // Inputs:
+  //   P, N, A, point_order, CR, CH  as above
+  //   CM, R, EC  precomputation output from the overload above
+  //   Q  #Q by 3 list of query points for the winding number
+  //   beta  Barnes-Hut style accuracy term (see above)
+  // Outputs:
+  //   WN  #Q by 1 list of windinng number values at each query point
+  //
+  template <
+    typename DerivedP, 
+    typename DerivedA, 
+    typename DerivedN,
+    typename Derivedpoint_order, 
+    typename DerivedCR, 
+    typename DerivedCH, 
+    typename DerivedCM, 
+    typename DerivedR,
+    typename DerivedEC, 
+    typename DerivedQ, 
+    typename BetaType,
+    typename DerivedWN>
+  IGL_INLINE void fast_winding_number(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedN>& N,
+    const Eigen::MatrixBase<DerivedA>& A,
+    const Eigen::MatrixBase<Derivedpoint_order>& point_order,
+    const Eigen::MatrixBase<DerivedCR>& CR,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCM>& CM,
+    const Eigen::MatrixBase<DerivedR>& R,
+    const Eigen::MatrixBase<DerivedEC>& EC,
+    const Eigen::MatrixBase<DerivedQ>& Q,
+    const BetaType beta,
+    Eigen::PlainObjectBase<DerivedWN>& WN);
+  // Evaluate the fast winding number for point data, building the (flat)
+  // octree and precomputation internally.
+  //
+  // Inputs:
+  //   P  #P by 3 list of point locations
+  //   N  #P by 3 list of point normals
+  //   A  #P by 1 list of point areas
+  //   Q  #Q by 3 list of query points for the winding number
+  //   expansion_order    the order of the taylor expansion. We support 0,1,2.
+  //   beta  Barnes-Hut style accuracy term (see above)
+  // Outputs:
+  //   WN  #Q by 1 list of windinng number values at each query point
+  //
   template <
     typename DerivedP, 
     typename DerivedA, 
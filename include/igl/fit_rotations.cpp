@@ -12,6 +12,8 @@
 #include "polar_dec.h"
 #include "polar_svd.h"
 #include "C_STR.h"
+#include "parallel_for.h"
+#include <algorithm>
 #include <iostream>
 
 template <typename DerivedS, typename DerivedD>
@@ -110,6 +112,263 @@ IGL_INLINE void igl::fit_rotations_planar(
 }
 
 
+// Batched single precision 3x3 SVD kernels (see svd3x3_sse.cpp and
+// svd3x3_avx.cpp). With gcc/clang on x86 the AVX and AVX-512 kernels are
+// compiled for their instruction sets regardless of the compiler flags and
+// chosen at runtime. Otherwise only the instruction sets enabled at compile
+// time are used.
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+#  include <immintrin.h>
+#  define IGL_FIT_ROTATIONS_SSE
+#  if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define IGL_FIT_ROTATIONS_RUNTIME_DISPATCH
+#    define IGL_FIT_ROTATIONS_AVX __attribute__((target("avx")))
+#    define IGL_FIT_ROTATIONS_AVX512 __attribute__((target("avx512f")))
+#  else
+#    ifdef __AVX__
+#      define IGL_FIT_ROTATIONS_AVX
+#    endif
+#    ifdef __AVX512F__
+#      define IGL_FIT_ROTATIONS_AVX512
+#    endif
+#  endif
+#endif
+
+#ifdef IGL_FIT_ROTATIONS_SSE
+// Matrices are stored entry-major with W lanes: X[(i+3*j)*W+k] = X_k(i,j)
+#define IGL_FIT_ROTATIONS_LOAD(LOAD,W) \
+  Va11=LOAD(A+0*W); Va21=LOAD(A+1*W); Va31=LOAD(A+2*W); \
+  Va12=LOAD(A+3*W); Va22=LOAD(A+4*W); Va32=LOAD(A+5*W); \
+  Va13=LOAD(A+6*W); Va23=LOAD(A+7*W); Va33=LOAD(A+8*W);
+#define IGL_FIT_ROTATIONS_STORE(STORE,W) \
+  STORE(U+0*W,Vu11); STORE(U+1*W,Vu21); STORE(U+2*W,Vu31); \
+  STORE(U+3*W,Vu12); STORE(U+4*W,Vu22); STORE(U+5*W,Vu32); \
+  STORE(U+6*W,Vu13); STORE(U+7*W,Vu23); STORE(U+8*W,Vu33); \
+  STORE(V+0*W,Vv11); STORE(V+1*W,Vv21); STORE(V+2*W,Vv31); \
+  STORE(V+3*W,Vv12); STORE(V+4*W,Vv22); STORE(V+5*W,Vv32); \
+  STORE(V+6*W,Vv13); STORE(V+7*W,Vv23); STORE(V+8*W,Vv33);
+#define COMPUTE_U_AS_MATRIX
+#define COMPUTE_V_AS_MATRIX
+#undef USE_SCALAR_IMPLEMENTATION
+#undef USE_AVX_IMPLEMENTATION
+#define USE_SSE_IMPLEMENTATION
+#include "Singular_Value_Decomposition_Preamble.hpp"
+namespace igl
+{
+  namespace internal
+  {
+    // SVDs A_k = U_k S_k V_k' of 4 matrices
+    inline void svd3x3_lanes_sse(const float * A, float * U, float * V)
+    {
+#include "Singular_Value_Decomposition_Kernel_Declarations.hpp"
+      IGL_FIT_ROTATIONS_LOAD(_mm_loadu_ps,4)
+#include "Singular_Value_Decomposition_Main_Kernel_Body.hpp"
+      IGL_FIT_ROTATIONS_STORE(_mm_storeu_ps,4)
+    }
+  }
+}
+#undef USE_SSE_IMPLEMENTATION
+#ifdef IGL_FIT_ROTATIONS_AVX
+#define USE_AVX_IMPLEMENTATION
+#include "Singular_Value_Decomposition_Preamble.hpp"
+namespace igl
+{
+  namespace internal
+  {
+    // SVDs of 8 matrices
+    inline IGL_FIT_ROTATIONS_AVX void svd3x3_lanes_avx(
+      const float * A, float * U, float * V)
+    {
+#include "Singular_Value_Decomposition_Kernel_Declarations.hpp"
+      IGL_FIT_ROTATIONS_LOAD(_mm256_loadu_ps,8)
+#include "Singular_Value_Decomposition_Main_Kernel_Body.hpp"
+      IGL_FIT_ROTATIONS_STORE(_mm256_storeu_ps,8)
+    }
+  }
+}
+#endif
+#ifdef IGL_FIT_ROTATIONS_AVX512
+// The kernel has no AVX-512 code path: run the AVX one on 512-bit registers
+// using only AVX-512F instructions
+// _mm256_cmp_ps may itself be a macro
+#pragma push_macro("_mm256_cmp_ps")
+#undef _mm256_cmp_ps
+#define __m256 __m512
+#define _mm256_add_ps _mm512_add_ps
+#define _mm256_sub_ps _mm512_sub_ps
+#define _mm256_mul_ps _mm512_mul_ps
+#define _mm256_max_ps _mm512_max_ps
+#define _mm256_set1_ps _mm512_set1_ps
+#define _mm256_rsqrt_ps _mm512_rsqrt14_ps
+#define _mm256_and_ps(a,b) _mm512_castsi512_ps(_mm512_and_si512( \
+  _mm512_castps_si512(a),_mm512_castps_si512(b)))
+#define _mm256_xor_ps(a,b) _mm512_castsi512_ps(_mm512_xor_si512( \
+  _mm512_castps_si512(a),_mm512_castps_si512(b)))
+#define _mm256_cmp_ps(a,b,c) _mm512_castsi512_ps( \
+  _mm512_maskz_set1_epi32(_mm512_cmp_ps_mask(a,b,c),-1))
+#define _mm256_blendv_ps(a,b,m) _mm512_mask_blend_ps(_mm512_test_epi32_mask( \
+  _mm512_castps_si512(m),_mm512_castps_si512(m)),a,b)
+namespace igl
+{
+  namespace internal
+  {
+    // SVDs of 16 matrices
+    inline IGL_FIT_ROTATIONS_AVX512 void svd3x3_lanes_avx512(
+      const float * A, float * U, float * V)
+    {
+#include "Singular_Value_Decomposition_Kernel_Declarations.hpp"
+      IGL_FIT_ROTATIONS_LOAD(_mm512_loadu_ps,16)
+#include "Singular_Value_Decomposition_Main_Kernel_Body.hpp"
+      IGL_FIT_ROTATIONS_STORE(_mm512_storeu_ps,16)
+    }
+  }
+}
+#undef __m256
+#undef _mm256_add_ps
+#undef _mm256_sub_ps
+#undef _mm256_mul_ps
+#undef _mm256_max_ps
+#undef _mm256_set1_ps
+#undef _mm256_rsqrt_ps
+#undef _mm256_and_ps
+#undef _mm256_xor_ps
+#undef _mm256_cmp_ps
+#undef _mm256_blendv_ps
+#pragma pop_macro("_mm256_cmp_ps")
+#endif
+#undef USE_AVX_IMPLEMENTATION
+#undef IGL_FIT_ROTATIONS_LOAD
+#undef IGL_FIT_ROTATIONS_STORE
+#endif
+
+namespace igl
+{
+  namespace internal
+  {
+    // Widest number of lanes supported by the CPU
+    inline int fit_rotations_max_lanes()
+    {
+#if defined(IGL_FIT_ROTATIONS_RUNTIME_DISPATCH)
+      static const int lanes = []()
+      {
+        __builtin_cpu_init();
+        return
+          __builtin_cpu_supports("avx512f") ? 16 :
+          __builtin_cpu_supports("avx") ? 8 : 4;
+      }();
+      return lanes;
+#elif defined(IGL_FIT_ROTATIONS_AVX512)
+      return 16;
+#elif defined(IGL_FIT_ROTATIONS_AVX)
+      return 8;
+#elif defined(IGL_FIT_ROTATIONS_SSE)
+      return 4;
+#else
+      return 1;
+#endif
+    }
+
+    // Fit rotations to S in groups of W matrices using svd (W=1 uses the
+    // scalar polar_svd3x3)
+    template <int W, typename DerivedS, typename DerivedD>
+    inline void fit_rotations_lanes(
+      const Eigen::MatrixBase<DerivedS> & S,
+      void (*svd)(const float *, float *, float *),
+      Eigen::PlainObjectBase<DerivedD> & R)
+    {
+      const int nr = S.rows()/3;
+      const int num_groups = (nr+W-1)/W;
+      igl::parallel_for(num_groups,[&](const int g)
+      {
+        float A[9*W],U[9*W],V[9*W];
+        for(int k = 0;k<W;k++)
+        {
+          const int r = g*W+k;
+          for(int i = 0;i<3;i++)
+          {
+            for(int j = 0;j<3;j++)
+            {
+              // Pad the last group with identities
+              A[(i+3*j)*W+k] = r<nr ? float(S(i*nr+r,j)) : float(i==j);
+            }
+          }
+        }
+        if(W == 1)
+        {
+          Eigen::Matrix3f Ak,Rk;
+          for(int i = 0;i<9;i++)
+          {
+            Ak(i%3,i/3) = A[i];
+          }
+          polar_svd3x3(Ak,Rk);
+          R.block(0,g*3,3,3) = Rk.transpose().template cast<typename DerivedD::Scalar>();
+          return;
+        }
+        svd(A,U,V);
+        for(int k = 0;k<W && g*W+k<nr;k++)
+        {
+          const int r = g*W+k;
+          // R_k = U_k V_k', stored transposed as in fit_rotations
+          for(int i = 0;i<3;i++)
+          {
+            for(int j = 0;j<3;j++)
+            {
+              float rij = 0;
+              for(int l = 0;l<3;l++)
+              {
+                rij += U[(i+3*l)*W+k]*V[(j+3*l)*W+k];
+              }
+              R(j,r*3+i) = rij;
+            }
+          }
+        }
+      },std::max(1,256/W));
+    }
+  }
+}
+
+template <typename DerivedS, typename DerivedD>
+IGL_INLINE void igl::fit_rotations_batched(
+  const Eigen::MatrixBase<DerivedS> & S,
+  const int max_lanes,
+        Eigen::PlainObjectBase<DerivedD> & R)
+{
+  assert(S.cols() == 3);
+  const int nr = S.rows()/3;
+  assert(nr * 3 == S.rows());
+  R.resize(3,3*nr);
+  const int lanes = std::min(max_lanes,internal::fit_rotations_max_lanes());
+#ifdef IGL_FIT_ROTATIONS_AVX512
+  if(lanes >= 16)
+  {
+    return internal::fit_rotations_lanes<16>(
+      S,internal::svd3x3_lanes_avx512,R);
+  }
+#endif
+#ifdef IGL_FIT_ROTATIONS_AVX
+  if(lanes >= 8)
+  {
+    return internal::fit_rotations_lanes<8>(S,internal::svd3x3_lanes_avx,R);
+  }
+#endif
+#ifdef IGL_FIT_ROTATIONS_SSE
+  if(lanes >= 4)
+  {
+    return internal::fit_rotations_lanes<4>(S,internal::svd3x3_lanes_sse,R);
+  }
+#endif
+  internal::fit_rotations_lanes<1>(S,nullptr,R);
+}
+
+template <typename DerivedS, typename DerivedD>
+IGL_INLINE void igl::fit_rotations_batched(
+  const Eigen::MatrixBase<DerivedS> & S,
+        Eigen::PlainObjectBase<DerivedD> & R)
+{
+  fit_rotations_batched(S,16,R);
+}
+
+
 #ifdef __SSE__
 IGL_INLINE void igl::fit_rotations_SSE(
   const Eigen::MatrixXf & S, 
@@ -218,6 +477,10 @@ IGL_INLINE void igl::fit_rotations_AVX(
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
+template void igl::fit_rotations_batched<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::fit_rotations_batched<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::fit_rotations_batched<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, int, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
+template void igl::fit_rotations_batched<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
 template void igl::fit_rotations<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::fit_rotations_planar<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template void igl::fit_rotations_planar<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&);
@@ -44,6 +44,28 @@ namespace igl
   IGL_INLINE void fit_rotations_planar(
     const Eigen::PlainObjectBase<DerivedS> & S,
           Eigen::PlainObjectBase<DerivedD> & R);
+  // FIT_ROTATIONS_BATCHED Same as fit_rotations(S,true,R) for 3D, but the
+  // single precision 3x3 SVDs of 16 (AVX-512), 8 (AVX) or 4 (SSE) covariance
+  // matrices are computed at once by each SIMD instruction, using the widest
+  // instruction set supported by the CPU at runtime. Groups of matrices are
+  // processed in parallel.
+  //
+  // Inputs:
+  //   S  nr*3 by 3 stack of covariance matrices
+  //   max_lanes  maximum number of matrices per SIMD instruction (1, 4, 8 or
+  //     16). For example, 4 restricts to SSE and 1 to the scalar code.
+  // Outputs:
+  //   R  3 by 3 * nr list of rotations
+  //
+  template <typename DerivedS, typename DerivedD>
+  IGL_INLINE void fit_rotations_batched(
+    const Eigen::MatrixBase<DerivedS> & S,
+    const int max_lanes,
+          Eigen::PlainObjectBase<DerivedD> & R);
+  template <typename DerivedS, typename DerivedD>
+  IGL_INLINE void fit_rotations_batched(
+    const Eigen::MatrixBase<DerivedS> & S,
+          Eigen::PlainObjectBase<DerivedD> & R);
 #ifdef __SSE__
   IGL_INLINE void fit_rotations_SSE( const Eigen::MatrixXf & S, Eigen::MatrixXf & R);
   IGL_INLINE void fit_rotations_SSE( const Eigen::MatrixXd & S, Eigen::MatrixXd & R);
@@ -13,6 +13,8 @@
 #include "per_face_normals.h"
 #include "volume.h"
 #include "doublearea.h"
+#include "parallel_for.h"
+#include "sparse_cached.h"
 
 namespace igl {
 
@@ -92,8 +94,10 @@ IGL_INLINE void grad_tet(
       repmat([T(:,4);T(:,2);T(:,3);T(:,1)],3,1), ...
       repmat(A./(3*repmat(vol,4,1)),3,1).*N(:), ...
       3*m,n);*/
-  std::vector<Triplet<double> > G_t;
-  for (int i = 0; i < 4*m; i++) {
+  Eigen::VectorXi GI(3*4*m),GJ(3*4*m);
+  Eigen::Matrix<typename DerivedV::Scalar, Eigen::Dynamic, 1> GV(3*4*m);
+  igl::parallel_for(4*m,[&](const int i)
+  {
     int T_j; // j indexes : repmat([T(:,4);T(:,2);T(:,3);T(:,1)],3,1)
     switch (i/m) {
       case 0:
@@ -113,12 +117,16 @@ IGL_INLINE void grad_tet(
     int j_idx = T(i_idx,T_j);
 
     double val_before_n = A(i)/(3*vol(i_idx));
-    G_t.push_back(Triplet<double>(0*m+i_idx, j_idx, val_before_n * N(i,0)));
-    G_t.push_back(Triplet<double>(1*m+i_idx, j_idx, val_before_n * N(i,1)));
-    G_t.push_back(Triplet<double>(2*m+i_idx, j_idx, val_before_n * N(i,2)));
-  }
-  G.resize(3*m,n);
-  G.setFromTriplets(G_t.begin(), G_t.end());
+    for(int d = 0;d<3;d++)
+    {
+      GI(3*i+d) = d*m+i_idx;
+      GJ(3*i+d) = j_idx;
+      GV(3*i+d) = val_before_n * N(i,d);
+    }
+  },1000);
+  igl::sparse_cached_data data;
+  igl::sparse_cached_precompute(GI,GJ,3*m,n,data,G);
+  igl::sparse_cached(GV,data,G);
 }
 
 template <typename DerivedV, typename DerivedF>
@@ -137,7 +145,7 @@ IGL_INLINE void grad_tri(
   Eigen::Matrix<typename DerivedV::Scalar,Eigen::Dynamic,3>
     eperp21(m,3), eperp13(m,3);
 
-  for (int i=0;i<m;++i)
+  igl::parallel_for(m,[&](const int i)
   {
     // renaming indices of vertices of triangles for convenience
     int i1 = F(i,0);
@@ -189,23 +197,26 @@ IGL_INLINE void grad_tri(
     eperp13.row(i) = u.cross(v13);
     eperp13.row(i) = eperp13.row(i) / std::sqrt(eperp13.row(i).dot(eperp13.row(i)));
     eperp13.row(i) *= norm13 / dblA;
-  }
+  },1000);
 
   // create sparse gradient operator matrix
-  G.resize(dims*m,nv);
-  std::vector<Eigen::Triplet<typename DerivedV::Scalar> > Gijv;
-  Gijv.reserve(4*dims*m);
-  for(int f = 0;f<F.rows();f++)
+  Eigen::VectorXi GI(4*dims*m),GJ(4*dims*m);
+  Eigen::Matrix<typename DerivedV::Scalar,Eigen::Dynamic,1> GV(4*dims*m);
+  igl::parallel_for(m,[&](const int f)
   {
     for(int d = 0;d<dims;d++)
     {
-      Gijv.emplace_back(f+d*m,F(f,1), eperp13(f,d));
-      Gijv.emplace_back(f+d*m,F(f,0),-eperp13(f,d));
-      Gijv.emplace_back(f+d*m,F(f,2), eperp21(f,d));
-      Gijv.emplace_back(f+d*m,F(f,0),-eperp21(f,d));
+      const int k = 4*(f*dims+d);
+      GI.segment(k,4).setConstant(f+d*m);
+      GJ(k+0) = F(f,1); GV(k+0) =  eperp13(f,d);
+      GJ(k+1) = F(f,0); GV(k+1) = -eperp13(f,d);
+      GJ(k+2) = F(f,2); GV(k+2) =  eperp21(f,d);
+      GJ(k+3) = F(f,0); GV(k+3) = -eperp21(f,d);
     }
-  }
-  G.setFromTriplets(Gijv.begin(), Gijv.end());
+  },1000);
+  igl::sparse_cached_data data;
+  igl::sparse_cached_precompute(GI,GJ,dims*m,nv,data,G);
+  igl::sparse_cached(GV,data,G);
 }
 
 } // anonymous namespace
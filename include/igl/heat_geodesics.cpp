@@ -16,8 +16,8 @@
 #include "grad_intrinsic.h"
 #include "boundary_facets.h"
 #include "unique.h"
-#include "slice.h"
 #include "avg_edge_length.h"
+#include "parallel_for.h"
 
 
 template < typename DerivedV, typename DerivedF, typename Scalar >
@@ -102,69 +102,103 @@ IGL_INLINE void igl::heat_geodesics_solve(
   const Eigen::MatrixBase<Derivedgamma> & gamma,
   Eigen::PlainObjectBase<DerivedD> & D)
 {
+  // A batch of one source set
+  const std::vector<Eigen::VectorXi> gammas(1,gamma.template cast<int>());
+  Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> Ds;
+  heat_geodesics_solve(data,gammas,Ds);
+  D = Ds;
+}
+
+template < typename Scalar, typename Derivedgamma, typename DerivedD>
+IGL_INLINE void igl::heat_geodesics_solve(
+  const HeatGeodesicsData<Scalar> & data,
+  const std::vector<Derivedgamma> & gammas,
+  Eigen::PlainObjectBase<DerivedD> & D)
+{
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,1> VectorXS;
+  typedef Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> MatrixXS;
   // number of mesh vertices
   const int n = data.Grad.cols();
+  // number of source sets
+  const int k = gammas.size();
   // Set up delta at gamma
-  DerivedD u0 = DerivedD::Zero(n,1);
-  for(int g = 0;g<gamma.size();g++)
+  MatrixXS U0 = MatrixXS::Zero(n,k);
+  for(int s = 0;s<k;s++)
   {
-    u0(gamma(g)) = 1;
+    for(int g = 0;g<gammas[s].size();g++)
+    {
+      U0(gammas[s](g),s) = 1;
+    }
   }
   // Neumann solution
-  DerivedD u;
+  MatrixXS U;
   igl::min_quad_with_fixed_solve(
-    data.Neumann,u0,DerivedD(),DerivedD(),u);
+    data.Neumann,U0,MatrixXS::Zero(0,k).eval(),MatrixXS(),U);
   if(data.b.size()>0)
   {
     // Average Dirichelt and Neumann solutions
-    DerivedD uD;
+    MatrixXS UD;
     igl::min_quad_with_fixed_solve(
-      data.Dirichlet,u0,DerivedD::Zero(data.b.size()).eval(),DerivedD(),uD);
-    u += uD;
-    u *= 0.5;
+      data.Dirichlet,U0,MatrixXS::Zero(data.b.size(),k).eval(),MatrixXS(),UD);
+    U += UD;
+    U *= 0.5;
   }
-  DerivedD grad_u = data.Grad*u;
   const int m = data.Grad.rows()/data.ng;
-  for(int i = 0;i<m;i++)
+  MatrixXS div_X(n,k);
+  igl::parallel_for(k,[&](const int s)
   {
-    // It is very important to use a stable norm calculation here. If the
-    // triangle is far from a source, then the floating point values in the
-    // gradient can be _very_ small (e.g., 1e-300). The standard/naive norm
-    // calculation will suffer from underflow. Dividing by the max value is more
-    // stable. (Eigen implements this as stableNorm or blueNorm).
-    Scalar norm = 0;
-    Scalar ma = 0;
-    for(int d = 0;d<data.ng;d++) {ma = std::max(ma,std::fabs(grad_u(d*m+i)));}
-    for(int d = 0;d<data.ng;d++)
+    VectorXS grad_u = data.Grad*U.col(s);
+    for(int i = 0;i<m;i++)
     {
-      const Scalar gui = grad_u(d*m+i) / ma;
-      norm += gui*gui;
+      // It is very important to use a stable norm calculation here. If the
+      // triangle is far from a source, then the floating point values in the
+      // gradient can be _very_ small (e.g., 1e-300). The standard/naive norm
+      // calculation will suffer from underflow. Dividing by the max value is
+      // more stable. (Eigen implements this as stableNorm or blueNorm).
+      Scalar norm = 0;
+      Scalar ma = 0;
+      for(int d = 0;d<data.ng;d++) {ma = std::max(ma,std::fabs(grad_u(d*m+i)));}
+      for(int d = 0;d<data.ng;d++)
+      {
+        const Scalar gui = grad_u(d*m+i) / ma;
+        norm += gui*gui;
+      }
+      norm = ma*sqrt(norm);
+      // These are probably over kill; ma==0 should be enough
+      if(ma == 0 || norm == 0 || norm!=norm)
+      {
+        for(int d = 0;d<data.ng;d++) { grad_u(d*m+i) = 0; }
+      }else
+      {
+        for(int d = 0;d<data.ng;d++) { grad_u(d*m+i) /= norm; }
+      }
     }
-    norm = ma*sqrt(norm);
-    // These are probably over kill; ma==0 should be enough
-    if(ma == 0 || norm == 0 || norm!=norm)
+    div_X.col(s) = -data.Div*grad_u;
+  },1);
+  MatrixXS Ds;
+  igl::min_quad_with_fixed_solve(
+    data.Poisson,(-div_X).eval(),MatrixXS::Zero(0,k).eval(),
+    MatrixXS::Zero(1,k).eval(),Ds);
+  igl::parallel_for(k,[&](const int s)
+  {
+    Scalar Dgamma = 0;
+    for(int g = 0;g<gammas[s].size();g++)
     {
-      for(int d = 0;d<data.ng;d++) { grad_u(d*m+i) = 0; }
-    }else
+      Dgamma += Ds(gammas[s](g),s);
+    }
+    Ds.col(s).array() -= Dgamma/gammas[s].size();
+    if(Ds.col(s).mean() < 0)
     {
-      for(int d = 0;d<data.ng;d++) { grad_u(d*m+i) /= norm; }
+      Ds.col(s) *= -1;
     }
-  }
-  const DerivedD div_X = -data.Div*grad_u;
-  const DerivedD Beq = (DerivedD(1,1)<<0).finished();
-  igl::min_quad_with_fixed_solve(data.Poisson,(-div_X).eval(),DerivedD(),Beq,D);
-  DerivedD Dgamma;
-  igl::slice(D,gamma,Dgamma);
-  D.array() -= Dgamma.mean();
-  if(D.mean() < 0)
-  {
-    D = -D;
-  }
+  },1);
+  D = Ds;
 }
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 template void igl::heat_geodesics_solve<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(igl::HeatGeodesicsData<double> const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::heat_geodesics_solve<double, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::HeatGeodesicsData<double> const&, std::vector<Eigen::Matrix<int, -1, 1, 0, -1, 1>, std::allocator<Eigen::Matrix<int, -1, 1, 0, -1, 1> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
 template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, igl::HeatGeodesicsData<double>&);
 template bool igl::heat_geodesics_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::HeatGeodesicsData<double>&);
 #endif
@@ -11,6 +11,7 @@
 #include "min_quad_with_fixed.h"
 #include <Eigen/Sparse>
 #include <Eigen/Sparse>
+#include <vector>
 namespace igl
 {
   template <typename Scalar>
@@ -60,6 +61,21 @@ namespace igl
     const HeatGeodesicsData<Scalar> & data,
     const Eigen::MatrixBase<Derivedgamma> & gamma,
     Eigen::PlainObjectBase<DerivedD> & D);
+  // Compute fast approximate geodesic distances to many independent sets of
+  // source vertices at once. Each set is a column of the right-hand sides of
+  // the prefactored solves, and the gradient normalization and divergence are
+  // computed in parallel over the sets.
+  //
+  // Inputs: 
+  //   data  precomputation data (see heat_geodesics_precompute)
+  //   gammas  #gammas list of lists of indices into V of source vertices
+  // Outputs:
+  //   D  #V by #gammas list of distances, D(:,s) distances to gammas[s]
+  template < typename Scalar, typename Derivedgamma, typename DerivedD>
+  IGL_INLINE void heat_geodesics_solve(
+    const HeatGeodesicsData<Scalar> & data,
+    const std::vector<Derivedgamma> & gammas,
+    Eigen::PlainObjectBase<DerivedD> & D);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -80,6 +80,66 @@ namespace igl
     const Eigen::MatrixBase<DerivedCN>& CN,
     const Eigen::MatrixBase<DerivedW>& W,
     Eigen::PlainObjectBase<DerivedI> & I);
+  // Same as above, using the flat octree output from igl::octree(P,I,CR,...)
+  //
+  // Inputs:
+  //   P  #P by 3 list of point locations
+  //   k  number of neighbors to find
+  //   point_order  #P list of indices into P sorted in octree cell order
+  //   CR     #OctreeCells by 2 list of [begin,end) ranges into point_order
+  //          of each octree cell's points
+  //   CH     #OctreeCells by 8, where the ith row is the indices of
+  //          the ith octree cell's children
+  //   CN     #OctreeCells by 3, where the ith row is a 3d row vector
+  //          representing the position of the ith cell's center
+  //   W      #OctreeCells, a vector where the ith entry is the width
+  //          of the ith octree cell
+  // Outputs:
+  //   I  #P by k list of k-nearest-neighbor indices into P
+  template <
+    typename DerivedP,
+    typename Derivedpoint_order,
+    typename DerivedCR,
+    typename DerivedCH,
+    typename DerivedCN,
+    typename DerivedW,
+    typename DerivedI>
+  IGL_INLINE void knn(
+    const Eigen::MatrixBase<DerivedP>& P,
+    size_t k,
+    const Eigen::MatrixBase<Derivedpoint_order>& point_order,
+    const Eigen::MatrixBase<DerivedCR>& CR,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedI> & I);
+  // Inputs:
+  //   P  #P by 3 list of point locations for which which we want the neighbors of
+  //   V  #V by 3 list of point locations for which may be neighbors 
+  //   k  number of neighbors to find
+  //   point_order  #V list of indices into V sorted in octree cell order
+  //   CR, CH, CN, W  flat octree of V (see above)
+  // Outputs:
+  //   I  #P by k list of k-nearest-neighbor indices into V
+  template <
+    typename DerivedP,
+    typename DerivedV,
+    typename Derivedpoint_order,
+    typename DerivedCR,
+    typename DerivedCH,
+    typename DerivedCN,
+    typename DerivedW,
+    typename DerivedI>
+  IGL_INLINE void knn(
+    const Eigen::MatrixBase<DerivedP>& P,
+    const Eigen::MatrixBase<DerivedV>& V,
+    size_t k,
+    const Eigen::MatrixBase<Derivedpoint_order>& point_order,
+    const Eigen::MatrixBase<DerivedCR>& CR,
+    const Eigen::MatrixBase<DerivedCH>& CH,
+    const Eigen::MatrixBase<DerivedCN>& CN,
+    const Eigen::MatrixBase<DerivedW>& W,
+    Eigen::PlainObjectBase<DerivedI> & I);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "knn.cpp"
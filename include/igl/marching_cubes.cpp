@@ -7,12 +7,15 @@
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "marching_cubes.h"
 #include "march_cube.h"
+#include "parallel_for.h"
 
 // Adapted from public domain code at
 // http://paulbourke.net/geometry/polygonise/marchingsource.cpp
 
 #include <unordered_map>
+#include <algorithm>
 #include <iostream>
+#include <vector>
 
 template <typename DerivedS, typename DerivedGV, typename DerivedV, typename DerivedF>
 IGL_INLINE void igl::marching_cubes(
@@ -29,61 +32,134 @@ IGL_INLINE void igl::marching_cubes(
   typedef unsigned Index;
   // use same order as a2fVertexOffset
   const unsigned ioffset[8] = {0,1,1+nx,nx,nx*ny,1+nx*ny,1+nx+nx*ny,nx+nx*ny};
-
-
-  std::unordered_map<int64_t,int> E2V;
-  V.resize(std::pow(nx*ny*nz,2./3.),3);
-  F.resize(std::pow(nx*ny*nz,2./3.),3);
-  Index n = 0;
-  Index m = 0;
+  if(nx < 2 || ny < 2 || nz < 2)
+  {
+    V.resize(0,3);
+    F.resize(0,3);
+    return;
+  }
 
   const auto xyz2i = [&nx,&ny,&nz]
     (const int & x, const int & y, const int & z)->unsigned
   {
     return x+nx*(y+ny*(z));
   };
-  const auto cube = 
-    [
-      &GV,&S,&V,&n,&F,&m,&isovalue,
-      &E2V,&xyz2i,&ioffset
-    ]
-    (const int x, const int y, const int z)
-  {
-    const unsigned i = xyz2i(x,y,z);
 
-    //Make a local copy of the values at the cube's corners
-    static Eigen::Matrix<Scalar,8,1> cS;
-    static Eigen::Matrix<Index,8,1> cI;
-    //Find which vertices are inside of the surface and which are outside
-    for(int c = 0; c < 8; c++)
+  // March over slabs of z-layers of cubes in parallel. Each slab has its own
+  // E2V,V,F. Vertices on edges lying in the bottom plane of a slab are also
+  // created by the slab below: the serial loop would have created them there
+  // first. Numbering the other vertices of each slab after those of the slabs
+  // below reproduces the output of a serial march exactly.
+  struct Slab
+  {
+    std::unordered_map<int64_t,int> E2V;
+    DerivedV V;
+    DerivedF F;
+    Index n = 0;
+    Index m = 0;
+    // Local to global vertex indices and, for vertices created by the slab
+    // below, their index there (-1 otherwise)
+    std::vector<int> L2G,below;
+    Index num_shared = 0;
+  };
+  // Slabs of at least 8 layers, enough of them to balance uneven slabs
+  // across threads
+  const int num_slabs = std::max(1,std::min<int>(256,(nz-1)/8));
+  std::vector<Slab> slabs(num_slabs);
+  const auto slab_z = [&](const int s)->int
+  {
+    return (int64_t(s)*(nz-1))/num_slabs;
+  };
+  const Index guess = std::pow(nx*ny*nz,2./3.)/num_slabs;
+  igl::parallel_for(num_slabs,[&](const int s)
+  {
+    Slab & slab = slabs[s];
+    slab.V.resize(guess,3);
+    slab.F.resize(guess,3);
+    // march over all cubes (loop order chosen to match memory)
+    for(int z=slab_z(s);z<slab_z(s+1);z++)
     {
-      const unsigned ic = i + ioffset[c];
-      cI(c) = ic;
-      cS(c) = S(ic);
+      for(int y=0;y<ny-1;y++)
+      {
+        for(int x=0;x<nx-1;x++)
+        {
+          const unsigned i = xyz2i(x,y,z);
+          //Make a local copy of the values at the cube's corners
+          Eigen::Matrix<Scalar,8,1> cS;
+          Eigen::Matrix<Index,8,1> cI;
+          //Find which vertices are inside of the surface and which are outside
+          for(int c = 0; c < 8; c++)
+          {
+            const unsigned ic = i + ioffset[c];
+            cI(c) = ic;
+            cS(c) = S(ic);
+          }
+          march_cube(GV,cS,cI,isovalue,slab.V,slab.n,slab.F,slab.m,slab.E2V);
+        }
+      }
     }
-
-  march_cube(GV,cS,cI,isovalue,V,n,F,m,E2V);
-
-  };
-
-  // march over all cubes (loop order chosen to match memory)
-  //
-  // Should be possible to parallelize safely if threads are "well separated".
-  // Like red-black Gauss Seidel. Probably each thread need's their own E2V,V,F,
-  // and then merge at the end. Annoying part are the edges lying on the
-  // interface between chunks.
-  for(int z=0;z<nz-1;z++)
+  },1);
+  igl::parallel_for(num_slabs,[&](const int s)
   {
-    for(int y=0;y<ny-1;y++)
+    // Find vertices on edges in the bottom plane
+    Slab & slab = slabs[s];
+    slab.below.resize(slab.n,-1);
+    if(s > 0)
     {
-      for(int x=0;x<nx-1;x++)
+      const int64_t z0 = slab_z(s);
+      for(const auto & kv : slab.E2V)
       {
-        cube(x,y,z);
+        const int64_t i = kv.first & 0xffffffff;
+        const int64_t j = kv.first >> 32;
+        if(i/(nx*ny) == z0 && j/(nx*ny) == z0)
+        {
+          slab.below[kv.second] = slabs[s-1].E2V.at(kv.first);
+          slab.num_shared++;
+        }
       }
     }
+  },1);
+  // Number vertices and faces
+  std::vector<Index> voffset(num_slabs+1,0),foffset(num_slabs+1,0);
+  for(int s = 0;s<num_slabs;s++)
+  {
+    voffset[s+1] = voffset[s] + slabs[s].n - slabs[s].num_shared;
+    foffset[s+1] = foffset[s] + slabs[s].m;
   }
-  V.conservativeResize(n,3);
-  F.conservativeResize(m,3);
+  V.resize(voffset[num_slabs],3);
+  F.resize(foffset[num_slabs],3);
+  igl::parallel_for(num_slabs,[&](const int s)
+  {
+    Slab & slab = slabs[s];
+    slab.L2G.resize(slab.n);
+    Index g = voffset[s];
+    for(Index v = 0;v<slab.n;v++)
+    {
+      if(slab.below[v] < 0)
+      {
+        slab.L2G[v] = g;
+        V.row(g++) = slab.V.row(v);
+      }
+    }
+  },1);
+  igl::parallel_for(num_slabs,[&](const int s)
+  {
+    Slab & slab = slabs[s];
+    for(Index v = 0;v<slab.n;v++)
+    {
+      if(slab.below[v] >= 0)
+      {
+        slab.L2G[v] = slabs[s-1].L2G[slab.below[v]];
+      }
+    }
+    for(Index f = 0;f<slab.m;f++)
+    {
+      for(int c = 0;c<3;c++)
+      {
+        F(foffset[s]+f,c) = slab.L2G[slab.F(f,c)];
+      }
+    }
+  },1);
 }
 
 template <
@@ -9,7 +9,8 @@
 #include "massmatrix_intrinsic.h"
 #include "edge_lengths.h"
 #include "normalize_row_sums.h"
-#include "sparse.h"
+#include "parallel_for.h"
+#include "sparse_cached.h"
 #include "doublearea.h"
 #include "repmat.h"
 #include <Eigen/Geometry>
@@ -21,6 +22,18 @@ IGL_INLINE void igl::massmatrix(
   const Eigen::MatrixBase<DerivedF> & F, 
   const MassMatrixType type,
   Eigen::SparseMatrix<Scalar>& M)
+{
+  sparse_cached_data data;
+  return massmatrix(V,F,type,data,M);
+}
+
+template <typename DerivedV, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::massmatrix(
+  const Eigen::MatrixBase<DerivedV> & V, 
+  const Eigen::MatrixBase<DerivedF> & F, 
+  const MassMatrixType type,
+  sparse_cached_data & data,
+  Eigen::SparseMatrix<Scalar>& M)
 {
   using namespace Eigen;
   using namespace std;
@@ -45,22 +58,15 @@ IGL_INLINE void igl::massmatrix(
     // edge lengths numbered same as opposite vertices
     Matrix<Scalar,Dynamic,3> l;
     igl::edge_lengths(V,F,l);
-    return massmatrix_intrinsic(l,F,type,M);
+    return massmatrix_intrinsic(l,F,type,F.maxCoeff()+1,data,M);
   }else if(simplex_size == 4)
   {
-    Matrix<typename DerivedF::Scalar,Dynamic,1> MI;
-    Matrix<typename DerivedF::Scalar,Dynamic,1> MJ;
     Matrix<Scalar,Dynamic,1> MV;
     assert(V.cols() == 3);
     assert(eff_type == MASSMATRIX_TYPE_BARYCENTRIC);
-    MI.resize(m*4,1); MJ.resize(m*4,1); MV.resize(m*4,1);
-    MI.block(0*m,0,m,1) = F.col(0);
-    MI.block(1*m,0,m,1) = F.col(1);
-    MI.block(2*m,0,m,1) = F.col(2);
-    MI.block(3*m,0,m,1) = F.col(3);
-    MJ = MI;
+    MV.resize(m*4,1);
     // loop over tets
-    for(int i = 0;i<m;i++)
+    parallel_for(m,[&](const int i)
     {
       // http://en.wikipedia.org/wiki/Tetrahedron#Volume
       Matrix<Scalar,3,1> v0m3,v1m3,v2m3;
@@ -72,8 +78,17 @@ IGL_INLINE void igl::massmatrix(
       MV(i+1*m) = v/4.0;
       MV(i+2*m) = v/4.0;
       MV(i+3*m) = v/4.0;
+    },1000);
+    if(data.I_outer.empty())
+    {
+      Matrix<typename DerivedF::Scalar,Dynamic,1> MI(m*4,1);
+      MI.block(0*m,0,m,1) = F.col(0);
+      MI.block(1*m,0,m,1) = F.col(1);
+      MI.block(2*m,0,m,1) = F.col(2);
+      MI.block(3*m,0,m,1) = F.col(3);
+      sparse_cached_precompute(MI,MI,n,n,data,M);
     }
-    sparse(MI,MJ,MV,n,n,M);
+    sparse_cached(MV,data,M);
   }else
   {
     // Unsupported simplex size
@@ -93,4 +108,6 @@ template void igl::massmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Mat
 template void igl::massmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, igl::sparse_cached_data&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType, igl::sparse_cached_data&, Eigen::SparseMatrix<double, 0, int>&);
 #endif
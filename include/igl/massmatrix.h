@@ -8,6 +8,7 @@
 #ifndef IGL_MASSMATRIX_H
 #define IGL_MASSMATRIX_H
 #include "igl_inline.h"
+#include "sparse_cached.h"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
@@ -50,6 +51,21 @@ namespace igl
     const Eigen::MatrixBase<DerivedF> & F, 
     const MassMatrixType type,
     Eigen::SparseMatrix<Scalar>& M);
+  // Cached version for repeated calls with the same elements F but changing
+  // positions V: the sparsity pattern of M is computed once and afterwards
+  // only its values are refreshed.
+  //
+  // Inputs/Outputs:
+  //   data  assembly of M for F: computed if empty, otherwise reused
+  //   M  #V by #V mass matrix. If data is not empty, M must be the output of
+  //     a previous call with the same data
+  template <typename DerivedV, typename DerivedF, typename Scalar>
+  IGL_INLINE void massmatrix(
+    const Eigen::MatrixBase<DerivedV> & V, 
+    const Eigen::MatrixBase<DerivedF> & F, 
+    const MassMatrixType type,
+    sparse_cached_data & data,
+    Eigen::SparseMatrix<Scalar>& M);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -8,7 +8,7 @@
 #include "massmatrix_intrinsic.h"
 #include "edge_lengths.h"
 #include "normalize_row_sums.h"
-#include "sparse.h"
+#include "sparse_cached.h"
 #include "doublearea.h"
 #include "repmat.h"
 #include <Eigen/Geometry>
@@ -33,6 +33,19 @@ IGL_INLINE void igl::massmatrix_intrinsic(
   const MassMatrixType type,
   const int n,
   Eigen::SparseMatrix<Scalar>& M)
+{
+  sparse_cached_data data;
+  return massmatrix_intrinsic(l,F,type,n,data,M);
+}
+
+template <typename Derivedl, typename DerivedF, typename Scalar>
+IGL_INLINE void igl::massmatrix_intrinsic(
+  const Eigen::MatrixBase<Derivedl> & l, 
+  const Eigen::MatrixBase<DerivedF> & F, 
+  const MassMatrixType type,
+  const int n,
+  sparse_cached_data & data,
+  Eigen::SparseMatrix<Scalar>& M)
 {
   using namespace Eigen;
   using namespace std;
@@ -47,19 +60,13 @@ IGL_INLINE void igl::massmatrix_intrinsic(
   assert(F.cols() == 3 && "only triangles supported");
   Matrix<Scalar,Dynamic,1> dblA;
   doublearea(l,0.,dblA);
-  Matrix<typename DerivedF::Scalar,Dynamic,1> MI;
-  Matrix<typename DerivedF::Scalar,Dynamic,1> MJ;
   Matrix<Scalar,Dynamic,1> MV;
 
   switch(eff_type)
   {
     case MASSMATRIX_TYPE_BARYCENTRIC:
       // diagonal entries for each face corner
-      MI.resize(m*3,1); MJ.resize(m*3,1); MV.resize(m*3,1);
-      MI.block(0*m,0,m,1) = F.col(0);
-      MI.block(1*m,0,m,1) = F.col(1);
-      MI.block(2*m,0,m,1) = F.col(2);
-      MJ = MI;
+      MV.resize(m*3,1);
       repmat(dblA,3,1,MV);
       MV.array() /= 6.0;
       break;
@@ -67,11 +74,7 @@ IGL_INLINE void igl::massmatrix_intrinsic(
       {
         // diagonal entries for each face corner
         // http://www.alecjacobson.com/weblog/?p=874
-        MI.resize(m*3,1); MJ.resize(m*3,1); MV.resize(m*3,1);
-        MI.block(0*m,0,m,1) = F.col(0);
-        MI.block(1*m,0,m,1) = F.col(1);
-        MI.block(2*m,0,m,1) = F.col(2);
-        MJ = MI;
+        MV.resize(m*3,1);
 
         // Holy shit this needs to be cleaned up and optimized
         Matrix<Scalar,Dynamic,3> cosines(m,3);
@@ -116,7 +119,15 @@ IGL_INLINE void igl::massmatrix_intrinsic(
     default:
       assert(false && "Unknown Mass matrix eff_type");
   }
-  sparse(MI,MJ,MV,n,n,M);
+  if(data.I_outer.empty())
+  {
+    Matrix<typename DerivedF::Scalar,Dynamic,1> MI(m*3,1);
+    MI.block(0*m,0,m,1) = F.col(0);
+    MI.block(1*m,0,m,1) = F.col(1);
+    MI.block(2*m,0,m,1) = F.col(2);
+    sparse_cached_precompute(MI,MI,n,n,data,M);
+  }
+  sparse_cached(MV,data,M);
 }
 
 #ifdef IGL_STATIC_LIBRARY
@@ -125,4 +136,8 @@ template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>,
 template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
 template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::MassMatrixType, int, igl::sparse_cached_data&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, igl::MassMatrixType, int, igl::sparse_cached_data&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 4, 0, -1, 4>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 4, 0, -1, 4> > const&, igl::MassMatrixType, int, igl::sparse_cached_data&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::massmatrix_intrinsic<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, igl::MassMatrixType, int, igl::sparse_cached_data&, Eigen::SparseMatrix<double, 0, int>&);
 #endif
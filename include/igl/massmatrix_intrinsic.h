@@ -9,6 +9,7 @@
 #define IGL_MASSMATRIX_INTRINSIC_H
 #include "igl_inline.h"
 #include "massmatrix.h"
+#include "sparse_cached.h"
 
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
@@ -45,6 +46,20 @@ namespace igl
     const MassMatrixType type,
     const int n,
     Eigen::SparseMatrix<Scalar>& M);
+  // Cached version for repeated calls with the same F but changing l
+  //
+  // Inputs/Outputs:
+  //   data  assembly of M for F: computed if empty, otherwise reused
+  //   M  n by n mass matrix. If data is not empty, M must be the output of a
+  //     previous call with the same data
+  template <typename Derivedl, typename DerivedF, typename Scalar>
+  IGL_INLINE void massmatrix_intrinsic(
+    const Eigen::MatrixBase<Derivedl> & l, 
+    const Eigen::MatrixBase<DerivedF> & F, 
+    const MassMatrixType type,
+    const int n,
+    sparse_cached_data & data,
+    Eigen::SparseMatrix<Scalar>& M);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -21,7 +21,7 @@ IGL_INLINE void igl::max_faces_stopping_condition(
     const Eigen::VectorXi &,
     const Eigen::MatrixXi &,
     const Eigen::MatrixXi &,
-    const igl::min_heap< std::tuple<double,int,int> > & ,
+    const igl::IndexedPriorityQueue<double> &           ,
     const Eigen::VectorXi &                             ,
     const Eigen::MatrixXd &,
     const int,
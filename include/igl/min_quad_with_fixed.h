@@ -16,6 +16,8 @@
 // Bug in unsupported/Eigen/SparseExtra needs iostream first
 #include <iostream>
 #include <unsupported/Eigen/SparseExtra>
+#include <functional>
+#include "SupernodalLLT.h"
 
 namespace igl
 {
@@ -43,13 +45,15 @@ namespace igl
   //   Y  list of fixed values corresponding to known rows in Z
   //   Aeq  m by n list of linear equality constraint coefficients
   //   pd flag specifying whether A(unknown,unknown) is positive definite
+  //   data.cholesky_backend  sparse Cholesky used for positive definite
+  //     systems (see min_quad_with_fixed_data)
   // Outputs:
   //   data  factorization struct with all necessary information to solve
   //     using min_quad_with_fixed_solve
   // Returns true on success, false on error
   //
   // Benchmark: For a harmonic solve on a mesh with 325K facets, matlab 2.2
-  // secs, igl/min_quad_with_fixed.h 7.1 secs
+  // secs, igl/min_quad_with_fixed.h 7.1 secs (with Eigen::SimplicialLLT)
   //
   template <typename T, typename Derivedknown>
   IGL_INLINE bool min_quad_with_fixed_precompute(
@@ -192,8 +196,31 @@ struct igl::min_quad_with_fixed_data
     QR_LLT = 3,
     NUM_SOLVER_TYPES = 4
   } solver_type;
+  // Sparse Cholesky used for the LLT and QR_LLT solver types. Set before
+  // calling min_quad_with_fixed_precompute.
+  enum CholeskyBackend
+  {
+    // Eigen::SimplicialLLT (default)
+    SIMPLICIAL_CHOLESKY = 0,
+    // igl::SupernodalLLT (multithreaded, faster on large systems; results
+    // agree with SIMPLICIAL_CHOLESKY up to roundoff)
+    SUPERNODAL_CHOLESKY = 1,
+    // custom_factorize and custom_solve
+    CUSTOM_CHOLESKY = 2,
+    NUM_CHOLESKY_BACKENDS = 3
+  } cholesky_backend = SIMPLICIAL_CHOLESKY;
+  // Custom Cholesky backend (e.g., wrapping Eigen::CholmodSupernodalLLT or
+  // Eigen::PardisoLLT):
+  //   custom_factorize(A)  factor a symmetric positive definite matrix,
+  //     returning false on error
+  //   custom_solve(B)  returns X so that A X = B for the last factored A
+  std::function<bool(const Eigen::SparseMatrix<T> &)> custom_factorize;
+  std::function<
+    Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic>(
+      const Eigen::Matrix<T,Eigen::Dynamic,Eigen::Dynamic> &)> custom_solve;
   // Solvers
   Eigen::SimplicialLLT <Eigen::SparseMatrix<T > > llt;
+  igl::SupernodalLLT<T> supernodal_llt;
   Eigen::SimplicialLDLT<Eigen::SparseMatrix<T > > ldlt;
   Eigen::SparseLU<Eigen::SparseMatrix<T, Eigen::ColMajor>, Eigen::COLAMDOrdering<int> >   lu;
   // QR factorization
@@ -42,6 +42,45 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
 #ifdef MIN_QUAD_WITH_FIXED_CPP_DEBUG
   cout<<"    pre"<<endl;
 #endif
+  // Factor a positive definite matrix with the chosen Cholesky backend
+  const auto cholesky_compute = [&data](const SparseMatrix<T> & M)->bool
+  {
+    Eigen::ComputationInfo info = Eigen::Success;
+    switch(data.cholesky_backend)
+    {
+      case min_quad_with_fixed_data<T>::SIMPLICIAL_CHOLESKY:
+        data.llt.compute(M);
+        info = data.llt.info();
+        break;
+      case min_quad_with_fixed_data<T>::SUPERNODAL_CHOLESKY:
+        data.supernodal_llt.compute(M);
+        info = data.supernodal_llt.info();
+        break;
+      case min_quad_with_fixed_data<T>::CUSTOM_CHOLESKY:
+        assert(data.custom_factorize && data.custom_solve &&
+          "custom_factorize and custom_solve should be set");
+        if(!data.custom_factorize(M))
+        {
+          cerr<<"Error: Custom factorization failed."<<endl;
+          return false;
+        }
+        break;
+      default:
+        cerr<<"Error: invalid Cholesky backend"<<endl;
+        return false;
+    }
+    switch(info)
+    {
+      case Eigen::Success:
+        return true;
+      case Eigen::NumericalIssue:
+        cerr<<"Error: Numerical issue."<<endl;
+        return false;
+      default:
+        cerr<<"Error: Other."<<endl;
+        return false;
+    }
+  };
   // number of rows
   int n = A.rows();
   // cache problem size
@@ -219,17 +258,9 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
 #ifdef MIN_QUAD_WITH_FIXED_CPP_DEBUG
     cout<<"    llt"<<endl;
 #endif
-      data.llt.compute(Auu);
-      switch(data.llt.info())
+      if(!cholesky_compute(Auu))
       {
-        case Eigen::Success:
-          break;
-        case Eigen::NumericalIssue:
-          cerr<<"Error: Numerical issue."<<endl;
-          return false;
-        default:
-          cerr<<"Error: Other."<<endl;
-          return false;
+        return false;
       }
       data.solver_type = min_quad_with_fixed_data<T>::LLT;
     }else
@@ -350,17 +381,9 @@ IGL_INLINE bool igl::min_quad_with_fixed_precompute(
       cout<<"    factorize"<<endl;
 #endif
       // QRAuu should always be PD
-      data.llt.compute(QRAuu);
-      switch(data.llt.info())
+      if(!cholesky_compute(QRAuu))
       {
-        case Eigen::Success:
-          break;
-        case Eigen::NumericalIssue:
-          cerr<<"Error: Numerical issue."<<endl;
-          return false;
-        default:
-          cerr<<"Error: Other."<<endl;
-          return false;
+        return false;
       }
       data.solver_type = min_quad_with_fixed_data<T>::QR_LLT;
     }
@@ -403,6 +426,19 @@ IGL_INLINE bool igl::min_quad_with_fixed_solve(
   using namespace Eigen;
   typedef Matrix<T,Dynamic,1> VectorXT;
   typedef Matrix<T,Dynamic,Dynamic> MatrixXT;
+  // Solve with the Cholesky backend used during precomputation
+  const auto cholesky_solve = [&data](const MatrixXT & B)->MatrixXT
+  {
+    switch(data.cholesky_backend)
+    {
+      case min_quad_with_fixed_data<T>::SUPERNODAL_CHOLESKY:
+        return data.supernodal_llt.solve(B);
+      case min_quad_with_fixed_data<T>::CUSTOM_CHOLESKY:
+        return data.custom_solve(B);
+      default:
+        return data.llt.solve(B);
+    }
+  };
   // number of known rows
   int kr = data.known.size();
   if(kr!=0)
@@ -457,7 +493,7 @@ IGL_INLINE bool igl::min_quad_with_fixed_solve(
     switch(data.solver_type)
     {
       case igl::min_quad_with_fixed_data<T>::LLT:
-        sol = data.llt.solve(NB);
+        sol.derived() = cholesky_solve(NB);
         break;
       case igl::min_quad_with_fixed_data<T>::LDLT:
         sol = data.ldlt.solve(NB);
@@ -507,7 +543,7 @@ IGL_INLINE bool igl::min_quad_with_fixed_solve(
     MatrixXT QRB;
     QRB = -data.AeqTQ2T * (data.Auu * lambda_0) + data.AeqTQ2T * NB;
     Derivedsol lambda;
-    lambda = data.llt.solve(QRB);
+    lambda = cholesky_solve(QRB);
     // prepare output
     Derivedsol solu;
     solu = data.AeqTQ2 * lambda + lambda_0;
@@ -1,7 +1,94 @@
 #include "octree.h"
+#include "parallel_for.h"
+#include "default_num_threads.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
 #include <vector>
 #include <queue>
 
+namespace igl
+{
+  namespace internal
+  {
+    // Spread the lowest 21 bits of x so that there are two zero bits between
+    // consecutive bits.
+    inline std::uint64_t octree_spread_bits(std::uint64_t x)
+    {
+      x &= 0x1fffff;
+      x = (x | x << 32) & 0x1f00000000ffffull;
+      x = (x | x << 16) & 0x1f0000ff0000ffull;
+      x = (x | x << 8) & 0x100f00f00f00f00full;
+      x = (x | x << 4) & 0x10c30c30c30c30c3ull;
+      x = (x | x << 2) & 0x1249249249249249ull;
+      return x;
+    }
+
+    // Stable parallel least-significant-digit radix sort of (key,value)
+    // pairs, one byte per pass. Passes whose digit is the same for every key
+    // are skipped.
+    template <typename Value>
+    inline void octree_radix_sort(
+      std::vector<std::uint64_t> & keys,
+      std::vector<Value> & values)
+    {
+      const size_t n = keys.size();
+      const size_t block_size = 1<<14;
+      const size_t num_blocks = std::max<size_t>(1,std::min<size_t>(
+        igl::default_num_threads(),(n+block_size-1)/block_size));
+      const size_t per_block = (n+num_blocks-1)/num_blocks;
+      std::vector<std::uint64_t> keys_tmp(n);
+      std::vector<Value> values_tmp(n);
+      std::vector<size_t> counts(num_blocks*256);
+      for(int shift = 0;shift<64;shift += 8)
+      {
+        std::fill(counts.begin(),counts.end(),0);
+        igl::parallel_for(num_blocks,[&](const size_t b)
+        {
+          size_t * count = counts.data()+256*b;
+          const size_t end = std::min(n,(b+1)*per_block);
+          for(size_t i = b*per_block;i<end;i++)
+          {
+            count[(keys[i]>>shift)&0xff]++;
+          }
+        },2);
+        // Exclusive prefix sum, digit major so that the sort is stable
+        size_t offset = 0;
+        bool trivial = false;
+        for(int d = 0;d<256;d++)
+        {
+          size_t total = 0;
+          for(size_t b = 0;b<num_blocks;b++)
+          {
+            const size_t c = counts[256*b+d];
+            counts[256*b+d] = offset;
+            offset += c;
+            total += c;
+          }
+          trivial = trivial || total == n;
+        }
+        if(trivial)
+        {
+          continue;
+        }
+        igl::parallel_for(num_blocks,[&](const size_t b)
+        {
+          size_t * offset = counts.data()+256*b;
+          const size_t end = std::min(n,(b+1)*per_block);
+          for(size_t i = b*per_block;i<end;i++)
+          {
+            const size_t j = offset[(keys[i]>>shift)&0xff]++;
+            keys_tmp[j] = keys[i];
+            values_tmp[j] = values[i];
+          }
+        },2);
+        keys.swap(keys_tmp);
+        values.swap(values_tmp);
+      }
+    }
+  }
+}
+
 namespace igl {
   template <typename DerivedP, typename IndexType, typename DerivedCH,
     typename DerivedCN, typename DerivedW>
@@ -168,9 +255,151 @@ namespace igl {
   }
 }
 
+template <typename DerivedP, typename DerivedI, typename DerivedCR,
+  typename DerivedCH, typename DerivedCN, typename DerivedW>
+IGL_INLINE void igl::octree(const Eigen::MatrixBase<DerivedP>& P,
+  Eigen::PlainObjectBase<DerivedI>& I,
+  Eigen::PlainObjectBase<DerivedCR>& CR,
+  Eigen::PlainObjectBase<DerivedCH>& CH,
+  Eigen::PlainObjectBase<DerivedCN>& CN,
+  Eigen::PlainObjectBase<DerivedW>& W)
+{
+  typedef typename DerivedI::Scalar IndexType;
+  typedef typename DerivedCR::Scalar RangeType;
+  typedef typename DerivedCH::Scalar ChildrenType;
+  typedef typename DerivedCN::Scalar CentersType;
+  typedef typename DerivedW::Scalar WidthsType;
+  typedef typename DerivedP::Scalar PointScalar;
+  typedef Eigen::Matrix<PointScalar, 1, 3> RowVector3PType;
+  // Number of bits per coordinate in the Morton codes
+  const int BITS = 21;
+
+  const size_t n = P.rows();
+  // Root cell: the minimum AABB cube, as above
+  RowVector3PType aabb_center(0,0,0);
+  WidthsType aabb_width = 0;
+  if(n > 0)
+  {
+    const RowVector3PType backleftbottom = P.colwise().minCoeff();
+    const RowVector3PType frontrighttop = P.colwise().maxCoeff();
+    aabb_center = (backleftbottom+frontrighttop)/PointScalar(2.0);
+    aabb_width = (frontrighttop - backleftbottom).maxCoeff();
+  }
+
+  // Morton code of each point's position on a 2^21 grid over the root cell
+  std::vector<std::uint64_t> codes(n);
+  std::vector<IndexType> order(n);
+  {
+    const double corner[3] = {
+      double(aabb_center(0))-0.5*double(aabb_width),
+      double(aabb_center(1))-0.5*double(aabb_width),
+      double(aabb_center(2))-0.5*double(aabb_width)};
+    const double scale =
+      aabb_width > 0 ? double(std::uint64_t(1)<<BITS)/double(aabb_width) : 0;
+    const double max_q = double((std::uint64_t(1)<<BITS)-1);
+    igl::parallel_for(n,[&](const size_t i)
+    {
+      std::uint64_t code = 0;
+      for(int d = 0;d<3;d++)
+      {
+        const double q = std::min(max_q,std::max(0.0,
+          std::floor((double(P(i,d))-corner[d])*scale)));
+        code |= internal::octree_spread_bits(std::uint64_t(q))<<d;
+      }
+      codes[i] = code;
+      order[i] = IndexType(i);
+    },1000);
+  }
+  internal::octree_radix_sort(codes,order);
+
+  // Split level by level. Children of the cells on one level are allocated
+  // in blocks of 8 and form the next level.
+  std::vector<size_t> cr = {0,n};
+  std::vector<size_t> first_child;
+  std::vector<size_t> levels = {0,1};
+  for(int depth = 0;levels[depth] < levels[depth+1];depth++)
+  {
+    const size_t level_begin = levels[depth];
+    const size_t level_end = levels[depth+1];
+    first_child.resize(level_end+1);
+    first_child[level_begin] = level_end;
+    for(size_t c = level_begin;c<level_end;c++)
+    {
+      const size_t begin = cr[2*c+0];
+      const size_t end = cr[2*c+1];
+      const bool split =
+        end > begin+1 && depth < BITS && codes[begin] != codes[end-1];
+      first_child[c+1] = first_child[c] + (split?8:0);
+    }
+    const size_t m = first_child[level_end];
+    cr.resize(2*m);
+    const int shift = 3*(BITS-1-depth);
+    igl::parallel_for(level_end-level_begin,[&](const size_t k)
+    {
+      const size_t c = level_begin+k;
+      if(first_child[c+1] == first_child[c])
+      {
+        return;
+      }
+      size_t begin = cr[2*c+0];
+      const size_t end = cr[2*c+1];
+      for(int i = 0;i<8;i++)
+      {
+        // Points are sorted, so the ith octant's points are contiguous
+        const size_t child_end = std::partition_point(
+          codes.begin()+begin,codes.begin()+end,
+          [&](const std::uint64_t code){ return int((code>>shift)&7) <= i; })
+          - codes.begin();
+        cr[2*(first_child[c]+i)+0] = begin;
+        cr[2*(first_child[c]+i)+1] = child_end;
+        begin = child_end;
+      }
+    },1000);
+    levels.push_back(m);
+  }
+
+  // Fill the outputs top down
+  const size_t m = levels.back();
+  I = Eigen::Map<const Eigen::Matrix<IndexType,Eigen::Dynamic,1> >(
+    order.data(),n);
+  CR.resize(m,2);
+  CH.resize(m,8);
+  CN.resize(m,3);
+  W.resize(m,1);
+  CN.row(0) = aabb_center.template cast<CentersType>();
+  W(0) = aabb_width;
+  for(size_t depth = 0;depth+1<levels.size();depth++)
+  {
+    const size_t level_begin = levels[depth];
+    igl::parallel_for(levels[depth+1]-level_begin,[&](const size_t k)
+    {
+      const size_t c = level_begin+k;
+      CR(c,0) = RangeType(cr[2*c+0]);
+      CR(c,1) = RangeType(cr[2*c+1]);
+      if(first_child[c+1] == first_child[c])
+      {
+        CH.row(c).setConstant(-1);
+        return;
+      }
+      const CentersType h = W(c)/4;
+      for(int i = 0;i<8;i++)
+      {
+        const size_t ci = first_child[c]+i;
+        CH(c,i) = ChildrenType(ci);
+        CN(ci,0) = CN(c,0) + ((i&1)?h:-h);
+        CN(ci,1) = CN(c,1) + ((i&2)?h:-h);
+        CN(ci,2) = CN(c,2) + ((i&4)?h:-h);
+        W(ci) = W(c)/2;
+      }
+    },1000);
+  }
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
 template void igl::octree<Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 template void igl::octree<Eigen::Matrix<double, -1, -1, 0, -1, -1>, int, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::vector<int, std::allocator<int> >, std::allocator<std::vector<int, std::allocator<int> > > >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::octree<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 8, 0, -1, 8>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
+template void igl::octree<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&);
 #endif
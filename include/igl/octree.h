@@ -52,6 +52,37 @@ namespace igl
     Eigen::PlainObjectBase<DerivedCH>& CH,
     Eigen::PlainObjectBase<DerivedCN>& CN,
     Eigen::PlainObjectBase<DerivedW>& W);
+  // Flat variant of the octree above. Points are sorted along a Morton
+  // (z-order) curve with a parallel radix sort, so that the points of every
+  // cell are contiguous in that order and each cell stores only a [begin,end)
+  // range into the permutation I instead of its own list of indices. Cells
+  // are numbered breadth first. Children, centers and widths follow the same
+  // rules as above, except that cells whose points all share the same
+  // (21-bit per axis) Morton code are not split further, so duplicate points
+  // end up in the same leaf.
+  //
+  // Inputs:
+  //   P  #P by 3 list of point locations
+  //
+  // Outputs:
+  //   I   #P list of indices into P sorted in cell order: the points of the
+  //       ith cell are P.row(I(j)) for CR(i,0) <= j < CR(i,1)
+  //   CR  #OctreeCells by 2 list of [begin,end) ranges into I
+  //   CH  #OctreeCells by 8, where the ith row is the indices of
+  //       the ith octree cell's children
+  //   CN  #OctreeCells by 3, where the ith row is a 3d row vector
+  //       representing the position of the ith cell's center
+  //   W   #OctreeCells, a vector where the ith entry is the width
+  //       of the ith octree cell
+  //
+  template <typename DerivedP, typename DerivedI, typename DerivedCR,
+  typename DerivedCH, typename DerivedCN, typename DerivedW>
+  IGL_INLINE void octree(const Eigen::MatrixBase<DerivedP>& P,
+    Eigen::PlainObjectBase<DerivedI>& I,
+    Eigen::PlainObjectBase<DerivedCR>& CR,
+    Eigen::PlainObjectBase<DerivedCH>& CH,
+    Eigen::PlainObjectBase<DerivedCN>& CN,
+    Eigen::PlainObjectBase<DerivedW>& W);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -59,4 +90,4 @@ namespace igl
 #endif
 
 #endif
-
+
@@ -29,6 +29,11 @@ namespace igl
   // available on the current hardware to parallelize this for loop so long as
   // loop_size<min_parallel, otherwise it will just use a serial for loop.
   //
+  // Iterations are run by a persistent pool of igl::default_num_threads()
+  // threads (including the calling thread) which balance uneven iterations by
+  // stealing work from each other. parallel_for may be called from within
+  // func: the nested loop is run by the same pool.
+  //
   // Inputs:
   //   loop_size  number of iterations. I.e. for(int i = 0;i<loop_size;i++) ...
   //   func  function handle taking iteration index as only argument to compute
@@ -93,10 +98,220 @@ namespace igl
 
 #include <cmath>
 #include <cassert>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
 #include <thread>
 #include <vector>
 #include <algorithm>
 
+namespace igl
+{
+  namespace internal
+  {
+    // Persistent pool of worker threads behind igl::parallel_for. Workers are
+    // started on first use and sleep while there is nothing to do, so the cost
+    // of a parallel_for call is a wake up rather than creating and joining
+    // threads.
+    //
+    // Each loop is a job whose range is initially split evenly among all
+    // num_threads() threads. A thread processes its own range front to back a
+    // few iterations at a time and once it runs out steals the back half of
+    // another thread's remaining range, so uneven iterations are balanced
+    // dynamically. The calling thread works on its own job instead of
+    // blocking. Calls made from inside a job (nested parallel_for) are jobs
+    // of their own run by the same threads: no extra threads are ever
+    // started.
+    class ThreadPool
+    {
+    public:
+      // (begin,end,t) processes iterations [begin,end) as thread t
+      typedef std::function<void(size_t,size_t,size_t)> ChunkFunction;
+      // Inputs:
+      //   num_threads  total number of threads working on each job (including
+      //     the calling thread)
+      inline ThreadPool(const size_t num_threads);
+      inline ~ThreadPool();
+      // Pool used by igl::parallel_for with igl::default_num_threads() threads
+      static inline ThreadPool & instance();
+      inline size_t num_threads() const { return m_num_threads; }
+      // Process iterations [0,n), blocking until all are done.
+      //
+      // Inputs:
+      //   n  number of iterations
+      //   chunk  function called on disjoint ranges covering [0,n) with a
+      //     thread id t < num_threads() which is unique among concurrent calls
+      //     for this job
+      inline void run(const size_t n, const ChunkFunction & chunk);
+    private:
+      struct Slot
+      {
+        std::mutex mutex;
+        size_t begin;
+        size_t end;
+      };
+      struct Job
+      {
+        const ChunkFunction * chunk;
+        // Number of iterations claimed at once by a thread from its own range
+        size_t grain;
+        // num_threads() remaining ranges, indexed by thread id
+        std::unique_ptr<Slot[]> slots;
+        // Number of workers currently in work() (guarded by m_mutex)
+        size_t num_workers;
+      };
+      // Work on job as thread t until no iterations are left to claim
+      inline void work(Job & job, const size_t t);
+      inline void worker_loop(const size_t t);
+      // Remove job from list of jobs (if still there), requires lock on m_mutex
+      inline void retire(Job * job);
+      // Thread id of the calling thread: 1,...,num_threads()-1 for workers, 0
+      // for all other threads
+      static inline size_t & thread_id();
+      const size_t m_num_threads;
+      std::vector<std::thread> m_workers;
+      std::mutex m_mutex;
+      std::condition_variable m_wake;
+      std::condition_variable m_done;
+      // Jobs with iterations possibly left to claim
+      std::vector<Job *> m_jobs;
+      bool m_stop;
+    };
+  }
+}
+
+inline igl::internal::ThreadPool::ThreadPool(const size_t num_threads):
+  m_num_threads(std::max(num_threads,(size_t)1)),
+  m_stop(false)
+{
+  m_workers.reserve(m_num_threads-1);
+  for(size_t t = 1;t<m_num_threads;t++)
+  {
+    m_workers.emplace_back(&ThreadPool::worker_loop,this,t);
+  }
+}
+
+inline igl::internal::ThreadPool::~ThreadPool()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_wake.notify_all();
+  for(std::thread & worker : m_workers) { worker.join(); }
+}
+
+inline igl::internal::ThreadPool & igl::internal::ThreadPool::instance()
+{
+  // Thread-safe, lazy initialization
+  static ThreadPool pool(igl::default_num_threads());
+  return pool;
+}
+
+inline size_t & igl::internal::ThreadPool::thread_id()
+{
+  static thread_local size_t id = 0;
+  return id;
+}
+
+inline void igl::internal::ThreadPool::run(
+  const size_t n,
+  const ChunkFunction & chunk)
+{
+  if(n == 0) return;
+  Job job;
+  job.chunk = &chunk;
+  job.grain = std::max(n/(16*m_num_threads),(size_t)1);
+  job.slots.reset(new Slot[m_num_threads]);
+  job.num_workers = 0;
+  for(size_t t = 0;t<m_num_threads;t++)
+  {
+    job.slots[t].begin = (n/m_num_threads)*t + std::min(t,n%m_num_threads);
+    job.slots[t].end = (n/m_num_threads)*(t+1) + std::min(t+1,n%m_num_threads);
+  }
+  if(m_num_threads > 1)
+  {
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_jobs.push_back(&job);
+    }
+    m_wake.notify_all();
+  }
+  // The calling thread never has to wait for a worker to start: it will
+  // steal everything that is not claimed by others.
+  work(job,thread_id());
+  if(m_num_threads > 1)
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    retire(&job);
+    // Wait for workers still finishing their last chunk
+    m_done.wait(lock,[&job]{ return job.num_workers == 0; });
+  }
+}
+
+inline void igl::internal::ThreadPool::work(Job & job, const size_t t)
+{
+  Slot & own = job.slots[t];
+  while(true)
+  {
+    size_t begin,end;
+    {
+      std::lock_guard<std::mutex> lock(own.mutex);
+      begin = own.begin;
+      end = std::min(own.begin+job.grain,own.end);
+      own.begin = end;
+    }
+    if(begin < end)
+    {
+      (*job.chunk)(begin,end,t);
+      continue;
+    }
+    // Own range is empty: steal back half of first non-empty range
+    bool stolen = false;
+    for(size_t k = 1;k<m_num_threads && !stolen;k++)
+    {
+      Slot & victim = job.slots[(t+k)%m_num_threads];
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      const size_t remaining = victim.end - victim.begin;
+      if(remaining == 0) continue;
+      begin = remaining <= job.grain ? victim.begin : victim.begin+remaining/2;
+      end = victim.end;
+      victim.end = begin;
+      stolen = true;
+    }
+    if(!stolen) return;
+    std::lock_guard<std::mutex> lock(own.mutex);
+    own.begin = begin;
+    own.end = end;
+  }
+}
+
+inline void igl::internal::ThreadPool::retire(Job * job)
+{
+  const auto it = std::find(m_jobs.begin(),m_jobs.end(),job);
+  if(it != m_jobs.end()) { m_jobs.erase(it); }
+}
+
+inline void igl::internal::ThreadPool::worker_loop(const size_t t)
+{
+  thread_id() = t;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while(true)
+  {
+    m_wake.wait(lock,[this]{ return m_stop || !m_jobs.empty(); });
+    if(m_stop) return;
+    // Newest job first: most likely a nested loop blocking an outer one
+    Job * job = m_jobs.back();
+    job->num_workers++;
+    lock.unlock();
+    work(*job,t);
+    lock.lock();
+    // Nothing left to claim: keep others from joining
+    retire(job);
+    if(--job->num_workers == 0) { m_done.notify_all(); }
+  }
+}
+
 template<typename Index, typename FunctionType >
 inline bool igl::parallel_for(
   const Index loop_size,
@@ -141,40 +356,16 @@ inline bool igl::parallel_for(
     return false;
   }else
   {
-    // Size of a slice for the range functions
-    Index slice =
-      std::max(
-        (Index)std::round((loop_size+1)/static_cast<double>(nthreads)),(Index)1);
-
+    internal::ThreadPool & pool = internal::ThreadPool::instance();
     // [Helper] Inner loop
-    const auto & range = [&func](const Index k1, const Index k2, const size_t t)
+    const auto & range = [&func](const size_t k1, const size_t k2, const size_t t)
     {
-      for(Index k = k1; k < k2; k++) func(k,t);
+      for(Index k = (Index)k1; k < (Index)k2; k++) func(k,t);
     };
-    prep_func(nthreads);
-    // Create pool and launch jobs
-    std::vector<std::thread> pool;
-    pool.reserve(nthreads);
-    // Inner range extents
-    Index i1 = 0;
-    Index i2 = std::min(0 + slice, loop_size);
-    {
-      size_t t = 0;
-      for (; t+1 < nthreads && i1 < loop_size; ++t)
-      {
-        pool.emplace_back(range, i1, i2, t);
-        i1 = i2;
-        i2 = std::min(i2 + slice, loop_size);
-      }
-      if (i1 < loop_size)
-      {
-        pool.emplace_back(range, i1, loop_size, t);
-      }
-    }
-    // Wait for jobs to finish
-    for (std::thread &t : pool) if (t.joinable()) t.join();
+    prep_func(pool.num_threads());
+    pool.run((size_t)loop_size,range);
     // Accumulate across threads
-    for(size_t t = 0;t<nthreads;t++)
+    for(size_t t = 0;t<pool.num_threads();t++)
     {
       accum_func(t);
     }
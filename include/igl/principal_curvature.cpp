@@ -10,19 +10,21 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
-#include <queue>
-#include <list>
 #include <cmath>
 #include <limits>
 
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
 #include <Eigen/SparseCholesky>
 
 // Lib IGL includes
-#include <igl/adjacency_list.h>
 #include <igl/per_face_normals.h>
 #include <igl/per_vertex_normals.h>
 #include <igl/avg_edge_length.h>
 #include <igl/vertex_triangle_adjacency.h>
+#include <igl/parallel_for.h>
 
 typedef enum
 {
@@ -40,13 +42,15 @@ class CurvatureCalculator
 {
 public:
   /* Row number i represents the i-th vertex, whose columns are:
-   curv[i][0] : K1
-   curv[i][1] : K2
-   curvDir[i][0] : PD1
-   curvDir[i][1] : PD2
+   curv(i,0) : K1
+   curv(i,1) : K2
+   curvDir.row(i).head<3>() : PD1
+   curvDir.row(i).tail<3>() : PD2
+   and which is only valid if vertexComputed[i]
    */
-  std::vector< std::vector<double> > curv;
-  std::vector< std::vector<Eigen::Vector3d> > curvDir;
+  Eigen::Matrix<double,Eigen::Dynamic,2,Eigen::RowMajor> curv;
+  Eigen::Matrix<double,Eigen::Dynamic,6,Eigen::RowMajor> curvDir;
+  std::vector<char> vertexComputed;
   bool curvatureComputed;
   class Quadric
   {
@@ -105,7 +109,13 @@ public:
     }
 
 
-    IGL_INLINE static Quadric fit(const std::vector<Eigen::Vector3d> &VV)
+    // A and b are buffers for the least squares system, reused with svd
+    // across calls
+    IGL_INLINE static Quadric fit(
+      const std::vector<Eigen::Vector3d> &VV,
+      Eigen::MatrixXd & A,
+      Eigen::MatrixXd & b,
+      Eigen::JacobiSVD<Eigen::MatrixXd> & svd)
     {
       assert(VV.size() >= 5);
       if (VV.size() < 5)
@@ -114,9 +124,9 @@ public:
         exit(0);
       }
 
-      Eigen::MatrixXd A(VV.size(),5);
-      Eigen::MatrixXd b(VV.size(),1);
-      Eigen::MatrixXd sol(5,1);
+      A.resize(VV.size(),5);
+      b.resize(VV.size(),1);
+      Eigen::Matrix<double,5,1> sol;
 
       for(unsigned int c=0; c < VV.size(); ++c)
       {
@@ -133,24 +143,45 @@ public:
         b(c) = n;
       }
 
-      sol=A.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV).solve(b);
+      sol=svd.compute(A,Eigen::ComputeThinU | Eigen::ComputeThinV).solve(b);
 
       return Quadric(sol(0),sol(1),sol(2),sol(3),sol(4));
     }
   };
 
+  // Per-thread buffers reused across the vertices processed by that thread
+  class Scratch
+  {
+  public:
+    std::vector<int> vv;
+    std::vector<int> vvtmp;
+    // visited[j] == i iff vertex j was visited while processing vertex i
+    std::vector<int> visited;
+    std::vector<std::pair<int,int> > queue;
+    std::vector<std::pair<int,double> > candidates;
+    std::vector<Eigen::Vector3d> points;
+    Eigen::MatrixXd A;
+    Eigen::MatrixXd b;
+    Eigen::JacobiSVD<Eigen::MatrixXd> svd;
+  };
+
 public:
 
-  Eigen::MatrixXd vertices;
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> vertices;
   // Face list of current mesh    (#F x 3) or (#F x 4)
   // The i-th row contains the indices of the vertices that forms the i-th face in ccw order
   Eigen::MatrixXi faces;
 
-  std::vector<std::vector<int> > vertex_to_vertices;
-  std::vector<std::vector<int> > vertex_to_faces;
-  std::vector<std::vector<int> > vertex_to_faces_index;
-  Eigen::MatrixXd face_normals;
-  Eigen::MatrixXd vertex_normals;
+  // Sorted neighbors of vertex i are
+  // vertex_to_vertices[vertex_to_vertices_start[i] … vertex_to_vertices_start[i+1]-1]
+  std::vector<int> vertex_to_vertices;
+  std::vector<int> vertex_to_vertices_start;
+  // Incident faces of vertex i (ascending) are
+  // vertex_to_faces(vertex_to_faces_start(i) … vertex_to_faces_start(i+1)-1)
+  Eigen::VectorXi vertex_to_faces;
+  Eigen::VectorXi vertex_to_faces_start;
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> face_normals;
+  Eigen::Matrix<double,Eigen::Dynamic,3,Eigen::RowMajor> vertex_normals;
 
   /* Size of the neighborhood */
   double sphereRadius;
@@ -177,15 +208,16 @@ public:
   IGL_INLINE void init(const Eigen::MatrixXd& V, const Eigen::MatrixXi& F);
 
   IGL_INLINE void finalEigenStuff(int, const std::vector<Eigen::Vector3d>&, Quadric&);
-  IGL_INLINE void fitQuadric(const Eigen::Vector3d&, const std::vector<Eigen::Vector3d>& ref, const std::vector<int>& , Quadric *);
+  IGL_INLINE void fitQuadric(const Eigen::Vector3d&, const std::vector<Eigen::Vector3d>& ref, const std::vector<int>& , Quadric *, Scratch&);
   IGL_INLINE void applyProjOnPlane(const Eigen::Vector3d&, const std::vector<int>&, std::vector<int>&);
-  IGL_INLINE void getSphere(const int, const double, std::vector<int>&, int min);
-  IGL_INLINE void getKRing(const int, const double,std::vector<int>&);
+  IGL_INLINE void getSphere(const int, const double, std::vector<int>&, int min, Scratch&);
+  IGL_INLINE void getKRing(const int, const double,std::vector<int>&, Scratch&);
   IGL_INLINE Eigen::Vector3d project(const Eigen::Vector3d&, const Eigen::Vector3d&, const Eigen::Vector3d&);
   IGL_INLINE void computeReferenceFrame(int, const Eigen::Vector3d&, std::vector<Eigen::Vector3d>&);
   IGL_INLINE void getAverageNormal(int, const std::vector<int>&, Eigen::Vector3d&);
   IGL_INLINE void getProjPlane(int, const std::vector<int>&, Eigen::Vector3d&);
   IGL_INLINE void applyMontecarlo(const std::vector<int>&,std::vector<int>*);
+  IGL_INLINE bool computeVertexCurvature(int, Scratch&);
   IGL_INLINE void computeCurvature();
   IGL_INLINE void printCurvature(const std::string& outpath);
   IGL_INLINE double getAverageEdge();
@@ -325,15 +357,63 @@ IGL_INLINE void CurvatureCalculator::init(const Eigen::MatrixXd& V, const Eigen:
 //  vertices = vertices.array() * (1.0/igl::avg_edge_length(V,F));
 
   faces = F;
-  igl::adjacency_list(F, vertex_to_vertices);
-  igl::vertex_triangle_adjacency(V, F, vertex_to_faces, vertex_to_faces_index);
-  igl::per_face_normals(V, F, face_normals);
-  igl::per_vertex_normals(V, F, face_normals, vertex_normals);
+
+  // Sorted and unique neighbors of each vertex (as igl::adjacency_list) in
+  // compressed form
+  const int n = V.rows();
+  std::vector<int> count(n+1,0);
+  for(int i = 0;i<F.rows();i++)
+  {
+    for(int j = 0;j<F.cols();j++)
+    {
+      count[F(i,j)+1] += 2;
+    }
+  }
+  std::partial_sum(count.begin(),count.end(),count.begin());
+  std::vector<int> all(count[n]);
+  {
+    std::vector<int> next(count.begin(),count.end()-1);
+    for(int i = 0;i<F.rows();i++)
+    {
+      for(int j = 0;j<F.cols();j++)
+      {
+        const int s = F(i,j);
+        const int d = F(i,(j+1)%F.cols());
+        all[next[s]++] = d;
+        all[next[d]++] = s;
+      }
+    }
+  }
+  std::vector<int> degree(n+1,0);
+  igl::parallel_for(n,[&](const int i)
+  {
+    std::sort(all.begin()+count[i],all.begin()+count[i+1]);
+    degree[i+1] = std::unique(all.begin()+count[i],all.begin()+count[i+1])-
+      (all.begin()+count[i]);
+  },1000);
+  vertex_to_vertices_start.resize(n+1);
+  std::partial_sum(degree.begin(),degree.end(),vertex_to_vertices_start.begin());
+  vertex_to_vertices.resize(vertex_to_vertices_start[n]);
+  igl::parallel_for(n,[&](const int i)
+  {
+    std::copy(
+      all.begin()+count[i],
+      all.begin()+count[i]+degree[i+1],
+      vertex_to_vertices.begin()+vertex_to_vertices_start[i]);
+  },1000);
+
+  igl::vertex_triangle_adjacency(F, n, vertex_to_faces, vertex_to_faces_start);
+  Eigen::MatrixXd FN,VN;
+  igl::per_face_normals(V, F, FN);
+  igl::per_vertex_normals(V, F, FN, VN);
+  face_normals = FN;
+  vertex_normals = VN;
 }
 
-IGL_INLINE void CurvatureCalculator::fitQuadric(const Eigen::Vector3d& v, const std::vector<Eigen::Vector3d>& ref, const std::vector<int>& vv, Quadric *q)
+IGL_INLINE void CurvatureCalculator::fitQuadric(const Eigen::Vector3d& v, const std::vector<Eigen::Vector3d>& ref, const std::vector<int>& vv, Quadric *q, Scratch& scratch)
 {
-  std::vector<Eigen::Vector3d> points;
+  std::vector<Eigen::Vector3d>& points = scratch.points;
+  points.clear();
   points.reserve (vv.size());
 
   for (unsigned int i = 0; i < vv.size(); ++i) {
@@ -355,7 +435,7 @@ IGL_INLINE void CurvatureCalculator::fitQuadric(const Eigen::Vector3d& v, const
   }
   else
   {
-    *q = Quadric::fit (points);
+    *q = Quadric::fit (points, scratch.A, scratch.b, scratch.svd);
   }
 }
 
@@ -424,48 +504,43 @@ IGL_INLINE void CurvatureCalculator::finalEigenStuff(int i, const std::vector<Ei
 
   if (c_val[0] > c_val[1])
   {
-    curv[i]=std::vector<double>(2);
-    curv[i][0]=c_val(0);
-    curv[i][1]=c_val(1);
-    curvDir[i]=std::vector<Eigen::Vector3d>(2);
-    curvDir[i][0]=v1global;
-    curvDir[i][1]=v2global;
+    curv(i,0)=c_val(0);
+    curv(i,1)=c_val(1);
+    curvDir.row(i) << v1global.transpose(), v2global.transpose();
   }
   else
   {
-    curv[i]=std::vector<double>(2);
-    curv[i][0]=c_val(1);
-    curv[i][1]=c_val(0);
-    curvDir[i]=std::vector<Eigen::Vector3d>(2);
-    curvDir[i][0]=v2global;
-    curvDir[i][1]=v1global;
+    curv(i,0)=c_val(1);
+    curv(i,1)=c_val(0);
+    curvDir.row(i) << v2global.transpose(), v1global.transpose();
   }
+  vertexComputed[i]=true;
   // ---- end Eigen stuff
 }
 
-IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, std::vector<int>&vv)
+IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, std::vector<int>&vv, Scratch& scratch)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<std::pair<int,int> > queue;
-  std::vector<bool> visited(bufsize, false);
+  // First in first out queue: vertices are never pushed twice, so the
+  // entries before `front` can simply stay in the buffer
+  std::vector<std::pair<int,int> >& queue = scratch.queue;
+  std::vector<int>& visited = scratch.visited;
+  queue.clear();
   queue.push_back(std::pair<int,int>(start,0));
-  visited[start]=true;
-  while (!queue.empty())
+  visited[start]=start;
+  for (size_t front=0; front<queue.size(); ++front)
   {
-    int toVisit=queue.front().first;
-    int distance=queue.front().second;
-    queue.pop_front();
+    int toVisit=queue[front].first;
+    int distance=queue[front].second;
     vv.push_back(toVisit);
     if (distance<(int)r)
     {
-      for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); ++i)
+      for (int i=vertex_to_vertices_start[toVisit]; i<vertex_to_vertices_start[toVisit+1]; ++i)
       {
-        int neighbor=vertex_to_vertices[toVisit][i];
-        if (!visited[neighbor])
+        int neighbor=vertex_to_vertices[i];
+        if (visited[neighbor]!=start)
         {
           queue.push_back(std::pair<int,int> (neighbor,distance+1));
-          visited[neighbor]=true;
+          visited[neighbor]=start;
         }
       }
     }
@@ -473,50 +548,56 @@ IGL_INLINE void CurvatureCalculator::getKRing(const int start, const double r, s
 }
 
 
-IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, std::vector<int> &vv, int min)
+IGL_INLINE void CurvatureCalculator::getSphere(const int start, const double r, std::vector<int> &vv, int min, Scratch& scratch)
 {
-  int bufsize=vertices.rows();
-  vv.reserve(bufsize);
-  std::list<int> queue;
-  std::vector<bool> visited(bufsize, false);
-  queue.push_back(start);
-  visited[start]=true;
+  // First in first out queue (see getKRing)
+  std::vector<std::pair<int,int> >& queue = scratch.queue;
+  std::vector<int>& visited = scratch.visited;
+  queue.clear();
+  queue.push_back(std::pair<int,int>(start,0));
+  visited[start]=start;
   Eigen::Vector3d me=vertices.row(start);
-  std::priority_queue<std::pair<int, double>, std::vector<std::pair<int, double> >, comparer > extra_candidates;
-  while (!queue.empty())
+  // Heap with the same push/pop sequence as a std::priority_queue
+  std::vector<std::pair<int, double> >& extra_candidates = scratch.candidates;
+  extra_candidates.clear();
+  for (size_t front=0; front<queue.size(); ++front)
   {
-    int toVisit=queue.front();
-    queue.pop_front();
+    int toVisit=queue[front].first;
     vv.push_back(toVisit);
-    for (unsigned int i=0; i<vertex_to_vertices[toVisit].size(); ++i)
+    for (int i=vertex_to_vertices_start[toVisit]; i<vertex_to_vertices_start[toVisit+1]; ++i)
     {
-      int neighbor=vertex_to_vertices[toVisit][i];
-      if (!visited[neighbor])
+      int neighbor=vertex_to_vertices[i];
+      if (visited[neighbor]!=start)
       {
         Eigen::Vector3d neigh=vertices.row(neighbor);
         double distance=(me-neigh).norm();
         if (distance<r)
-          queue.push_back(neighbor);
+          queue.push_back(std::pair<int,int>(neighbor,0));
         else if ((int)vv.size()<min)
-          extra_candidates.push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+        {
+          extra_candidates.push_back(std::pair<int,double>(neighbor,distance));
+          std::push_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+        }
+        visited[neighbor]=start;
       }
     }
   }
   while (!extra_candidates.empty() && (int)vv.size()<min)
   {
-    std::pair<int, double> cand=extra_candidates.top();
-    extra_candidates.pop();
+    std::pair<int, double> cand=extra_candidates.front();
+    std::pop_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+    extra_candidates.pop_back();
     vv.push_back(cand.first);
-    for (unsigned int i=0; i<vertex_to_vertices[cand.first].size(); ++i)
+    for (int i=vertex_to_vertices_start[cand.first]; i<vertex_to_vertices_start[cand.first+1]; ++i)
     {
-      int neighbor=vertex_to_vertices[cand.first][i];
-      if (!visited[neighbor])
+      int neighbor=vertex_to_vertices[i];
+      if (visited[neighbor]!=start)
       {
         Eigen::Vector3d neigh=vertices.row(neighbor);
         double distance=(me-neigh).norm();
-        extra_candidates.push(std::pair<int,double>(neighbor,distance));
-        visited[neighbor]=true;
+        extra_candidates.push_back(std::pair<int,double>(neighbor,distance));
+        std::push_heap(extra_candidates.begin(),extra_candidates.end(),comparer());
+        visited[neighbor]=start;
       }
     }
   }
@@ -530,7 +611,7 @@ IGL_INLINE Eigen::Vector3d CurvatureCalculator::project(const Eigen::Vector3d& v
 IGL_INLINE void CurvatureCalculator::computeReferenceFrame(int i, const Eigen::Vector3d& normal, std::vector<Eigen::Vector3d>& ref )
 {
 
-  Eigen::Vector3d longest_v=Eigen::Vector3d(vertices.row(vertex_to_vertices[i][0]));
+  Eigen::Vector3d longest_v=Eigen::Vector3d(vertices.row(vertex_to_vertices[vertex_to_vertices_start[i]]));
 
   longest_v=(project(vertices.row(i),longest_v,normal)-Eigen::Vector3d(vertices.row(i))).normalized();
 
@@ -566,9 +647,9 @@ IGL_INLINE void CurvatureCalculator::getProjPlane(int j, const std::vector<int>&
 
   if (localMode)
   {
-    for (unsigned int i=0; i<vertex_to_faces.at(j).size(); ++i)
+    for (int i=vertex_to_faces_start(j); i<vertex_to_faces_start(j+1); ++i)
     {
-      Eigen::Vector3d faceNormal=face_normals.row(vertex_to_faces.at(j).at(i));
+      Eigen::Vector3d faceNormal=face_normals.row(vertex_to_faces(i));
       a += faceNormal[0];
       b += faceNormal[1];
       c += faceNormal[2];
@@ -645,96 +726,122 @@ IGL_INLINE void CurvatureCalculator::applyMontecarlo(const std::vector<int>& vin
   }
 }
 
-IGL_INLINE void CurvatureCalculator::computeCurvature()
+IGL_INLINE bool CurvatureCalculator::computeVertexCurvature(int i, Scratch& scratch)
 {
-  //CHECK che esista la mesh
-  const size_t vertices_count=vertices.rows();
+  std::vector<int>& vv = scratch.vv;
+  std::vector<int>& vvtmp = scratch.vvtmp;
+  Eigen::Vector3d normal;
+  vv.clear();
+  vvtmp.clear();
+  if (scratch.visited.size() != (size_t)vertices.rows())
+    scratch.visited.assign(vertices.rows(),-1);
+  Eigen::Vector3d me=vertices.row(i);
+  switch (st)
+  {
+    case SPHERE_SEARCH:
+      getSphere(i,scaledRadius,vv,6,scratch);
+      break;
+    case K_RING_SEARCH:
+      getKRing(i,kRing,vv,scratch);
+      break;
+    default:
+      fprintf(stderr,"Error: search type not recognized");
+      return false;
+  }
 
-  if (vertices_count ==0)
-    return;
+  if (vv.size()<6)
+  {
+    //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
+    return true;
+  }
 
-  curvDir=std::vector< std::vector<Eigen::Vector3d> >(vertices_count);
-  curv=std::vector<std::vector<double> >(vertices_count);
 
+  if (projectionPlaneCheck)
+  {
+    vvtmp.reserve (vv.size ());
+    applyProjOnPlane (vertex_normals.row(i), vv, vvtmp);
+    if (vvtmp.size() >= 6 && vvtmp.size()<vv.size())
+      vv = vvtmp;
+  }
 
 
-  scaledRadius=getAverageEdge()*sphereRadius;
+  switch (nt)
+  {
+    case AVERAGE:
+      getAverageNormal(i,vv,normal);
+      break;
+    case PROJ_PLANE:
+      getProjPlane(i,vv,normal);
+      break;
+    default:
+      fprintf(stderr,"Error: normal type not recognized");
+      return false;
+  }
+  if (vv.size()<6)
+  {
+    //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
+    return true;
+  }
+  if (montecarlo)
+  {
+    if(montecarloN<6)
+      return false;
+    vvtmp.reserve(vv.size());
+    applyMontecarlo(vv,&vvtmp);
+    vv=vvtmp;
+  }
 
-  std::vector<int> vv;
-  std::vector<int> vvtmp;
-  Eigen::Vector3d normal;
+  if (vv.size()<6)
+    return false;
+  std::vector<Eigen::Vector3d> ref(3);
+  computeReferenceFrame(i,normal,ref);
 
-  //double time_spent;
-  //double searchtime=0, ref_time=0, fit_time=0, final_time=0;
+  Quadric q;
+  fitQuadric (me, ref, vv, &q, scratch);
+  finalEigenStuff(i,ref,q);
+  return true;
+}
 
-  for (size_t i=0; i<vertices_count; ++i)
-  {
-    vv.clear();
-    vvtmp.clear();
-    Eigen::Vector3d me=vertices.row(i);
-    switch (st)
-    {
-      case SPHERE_SEARCH:
-        getSphere(i,scaledRadius,vv,6);
-        break;
-      case K_RING_SEARCH:
-        getKRing(i,kRing,vv);
-        break;
-      default:
-        fprintf(stderr,"Error: search type not recognized");
-        return;
-    }
+IGL_INLINE void CurvatureCalculator::computeCurvature()
+{
+  //CHECK che esista la mesh
+  const size_t vertices_count=vertices.rows();
 
-    if (vv.size()<6)
-    {
-      //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
-      continue;
-    }
+  if (vertices_count ==0)
+    return;
 
+  curvDir.setZero(vertices_count,6);
+  curv.setZero(vertices_count,2);
+  vertexComputed.assign(vertices_count,false);
 
-    if (projectionPlaneCheck)
-    {
-      vvtmp.reserve (vv.size ());
-      applyProjOnPlane (vertex_normals.row(i), vv, vvtmp);
-      if (vvtmp.size() >= 6 && vvtmp.size()<vv.size())
-        vv = vvtmp;
-    }
 
 
-    switch (nt)
-    {
-      case AVERAGE:
-        getAverageNormal(i,vv,normal);
-        break;
-      case PROJ_PLANE:
-        getProjPlane(i,vv,normal);
-        break;
-      default:
-        fprintf(stderr,"Error: normal type not recognized");
-        return;
-    }
-    if (vv.size()<6)
-    {
-      //std::cerr << "Could not compute curvature of radius " << scaledRadius << std::endl;
-      continue;
-    }
-    if (montecarlo)
+  scaledRadius=getAverageEdge()*sphereRadius;
+
+  if (montecarlo)
+  {
+    // Sampling calls rand(), so keep the serial order. A vertex that cannot
+    // be sampled stops the whole computation.
+    Scratch scratch;
+    for (size_t i=0; i<vertices_count; ++i)
     {
-      if(montecarloN<6)
+      if (!computeVertexCurvature(i,scratch))
         break;
-      vvtmp.reserve(vv.size());
-      applyMontecarlo(vv,&vvtmp);
-      vv=vvtmp;
     }
-
-    if (vv.size()<6)
-      return;
-    std::vector<Eigen::Vector3d> ref(3);
-    computeReferenceFrame(i,normal,ref);
-
-    Quadric q;
-    fitQuadric (me, ref, vv, &q);
-    finalEigenStuff(i,ref,q);
+  }
+  else
+  {
+    // Vertices are independent: each thread reuses its own buffers
+    std::vector<Scratch> scratch;
+    igl::parallel_for(
+      vertices_count,
+      [&scratch](const size_t nt){ scratch.resize(nt); },
+      [this,&scratch](const size_t i, const size_t t)
+      {
+        computeVertexCurvature(i,scratch[t]);
+      },
+      [](const size_t){},
+      100);
   }
 
   lastRadius=sphereRadius;
@@ -760,8 +867,8 @@ IGL_INLINE void CurvatureCalculator::printCurvature(const std::string& outpath)
   of << vertices_count << endl;
   for (int i=0; i<vertices_count; ++i)
   {
-    of << curv[i][0] << " " << curv[i][1] << " " << curvDir[i][0][0] << " " << curvDir[i][0][1] << " " << curvDir[i][0][2] << " " <<
-    curvDir[i][1][0] << " " << curvDir[i][1][1] << " " << curvDir[i][1][2] << endl;
+    of << curv(i,0) << " " << curv(i,1) << " " << curvDir(i,0) << " " << curvDir(i,1) << " " << curvDir(i,2) << " " <<
+    curvDir(i,3) << " " << curvDir(i,4) << " " << curvDir(i,5) << endl;
   }
 
   of.close();
@@ -819,10 +926,10 @@ IGL_INLINE void igl::principal_curvature(
   // Copy it back
   for (unsigned i=0; i<V.rows(); ++i)
   {
-    if (!cc.curv[i].empty())
+    if (cc.vertexComputed[i])
     {
-      PD1.row(i) << cc.curvDir[i][0][0], cc.curvDir[i][0][1], cc.curvDir[i][0][2];
-      PD2.row(i) << cc.curvDir[i][1][0], cc.curvDir[i][1][1], cc.curvDir[i][1][2];
+      PD1.row(i) << cc.curvDir(i,0), cc.curvDir(i,1), cc.curvDir(i,2);
+      PD2.row(i) << cc.curvDir(i,3), cc.curvDir(i,4), cc.curvDir(i,5);
       PD1.row(i).normalize();
       PD2.row(i).normalize();
 
@@ -832,8 +939,8 @@ IGL_INLINE void igl::principal_curvature(
         PD2.row(i) << 0,0,0;
       }
 
-      PV1(i) = cc.curv[i][0];
-      PV2(i) = cc.curv[i][1];
+      PV1(i) = cc.curv(i,0);
+      PV2(i) = cc.curv(i,1);
 
       if (PD1.row(i) * PD2.row(i).transpose() > 10e-6)
       {
@@ -902,8 +1009,9 @@ IGL_INLINE void igl::principal_curvature(
   // Copy it back
   for (unsigned i=0; i<V.rows(); ++i)
   {
-    PD1.row(i) << cc.curvDir[i][0][0], cc.curvDir[i][0][1], cc.curvDir[i][0][2];
-    PD2.row(i) << cc.curvDir[i][1][0], cc.curvDir[i][1][1], cc.curvDir[i][1][2];
+    // Vertices whose curvature could not be computed are all zeros
+    PD1.row(i) << cc.curvDir(i,0), cc.curvDir(i,1), cc.curvDir(i,2);
+    PD2.row(i) << cc.curvDir(i,3), cc.curvDir(i,4), cc.curvDir(i,5);
     PD1.row(i).normalize();
     PD2.row(i).normalize();
 
@@ -913,8 +1021,8 @@ IGL_INLINE void igl::principal_curvature(
       PD2.row(i) << 0,0,0;
     }
 
-    PV1(i) = cc.curv[i][0];
-    PV2(i) = cc.curv[i][1];
+    PV1(i) = cc.curv(i,0);
+    PV2(i) = cc.curv(i,1);
 
     if (PD1.row(i) * PD2.row(i).transpose() > 10e-6)
     {
@@ -6,6 +6,10 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "ray_mesh_intersect.h"
+#include "AABB.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
 extern "C"
 {
@@ -80,6 +84,205 @@ IGL_INLINE bool igl::ray_mesh_intersect(
   }
 }
 
+namespace igl
+{
+  namespace internal
+  {
+    // Reciprocal of a ray direction, avoiding 0*inf = NaN in slab tests
+    inline Eigen::Vector3d ray_mesh_intersect_inv_dir(const Eigen::Vector3d & dir)
+    {
+      Eigen::Vector3d inv_dir;
+      for(int d = 0;d<3;d++)
+      {
+        inv_dir(d) = 1./(std::abs(dir(d)) < std::numeric_limits<double>::min() ?
+          std::copysign(std::numeric_limits<double>::min(),dir(d)) : dir(d));
+      }
+      return inv_dir;
+    }
+    // Parametric distance at which a ray enters a box (0 if it starts
+    // inside), or infinity if it misses. Allows for roundoff so that no box
+    // containing a hit face is culled.
+    template <typename Scalar>
+    inline double ray_mesh_intersect_box_entry(
+      const Eigen::AlignedBox<Scalar,3> & box,
+      const Eigen::Vector3d & s,
+      const Eigen::Vector3d & inv_dir)
+    {
+      const double slack = 1+4*std::numeric_limits<double>::epsilon();
+      double t_near = 0;
+      double t_far = std::numeric_limits<double>::infinity();
+      for(int d = 0;d<3;d++)
+      {
+        const double t1 = (double(box.min()(d))-s(d))*inv_dir(d);
+        const double t2 = (double(box.max()(d))-s(d))*inv_dir(d);
+        t_near = std::max(t_near,std::min(t1,t2));
+        t_far = std::min(t_far,std::max(t1,t2));
+      }
+      return t_near <= t_far*slack ?
+        t_near : std::numeric_limits<double>::infinity();
+    }
+  }
+}
+
+template <
+  typename Derivedsource,
+  typename Deriveddir,
+  typename DerivedV,
+  typename DerivedF>
+IGL_INLINE bool igl::ray_mesh_intersect(
+  const Eigen::MatrixBase<Derivedsource> & s,
+  const Eigen::MatrixBase<Deriveddir> & dir,
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const igl::AABB<DerivedV,3> & tree,
+  std::vector<igl::Hit> & hits)
+{
+  using namespace Eigen;
+  using namespace std;
+  // Should be but can't be const
+  Vector3d s_d = s.template cast<double>();
+  Vector3d dir_d = dir.template cast<double>();
+  hits.clear();
+  if(tree.m_primitive == -1 && tree.m_left == NULL)
+  {
+    // Empty tree
+    return false;
+  }
+  const Vector3d inv_dir = internal::ray_mesh_intersect_inv_dir(dir_d);
+  std::vector<const AABB<DerivedV,3> *> stack(1,&tree);
+  while(!stack.empty())
+  {
+    const AABB<DerivedV,3> * node = stack.back();
+    stack.pop_back();
+    if(internal::ray_mesh_intersect_box_entry(node->m_box,s_d,inv_dir) ==
+      std::numeric_limits<double>::infinity())
+    {
+      continue;
+    }
+    if(!node->is_leaf())
+    {
+      stack.push_back(node->m_right);
+      stack.push_back(node->m_left);
+      continue;
+    }
+    // Same test as brute force version
+    const int f = node->m_primitive;
+    RowVector3d v0 = V.row(F(f,0)).template cast<double>();
+    RowVector3d v1 = V.row(F(f,1)).template cast<double>();
+    RowVector3d v2 = V.row(F(f,2)).template cast<double>();
+    double t,u,v;
+    if(intersect_triangle1(
+      s_d.data(), dir_d.data(), v0.data(), v1.data(), v2.data(), &t, &u, &v) &&
+      t>0)
+    {
+      hits.push_back({(int)f,(int)-1,(float)u,(float)v,(float)t});
+    }
+  }
+  // Brute force version finds hits in order of faces. Sorting the same list
+  // with the same (unstable) sort reproduces its order of hits with equal t.
+  std::sort(
+    hits.begin(),
+    hits.end(),
+    [](const Hit & a, const Hit & b)->bool{ return a.id < b.id;});
+  std::sort(
+    hits.begin(),
+    hits.end(),
+    [](const Hit & a, const Hit & b)->bool{ return a.t < b.t;});
+  return hits.size() > 0;
+}
+
+template <
+  typename Derivedsource,
+  typename Deriveddir,
+  typename DerivedV,
+  typename DerivedF>
+IGL_INLINE bool igl::ray_mesh_intersect(
+  const Eigen::MatrixBase<Derivedsource> & s,
+  const Eigen::MatrixBase<Deriveddir> & dir,
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const igl::AABB<DerivedV,3> & tree,
+  igl::Hit & hit)
+{
+  using namespace Eigen;
+  using namespace std;
+  const double inf = std::numeric_limits<double>::infinity();
+  // Should be but can't be const
+  Vector3d s_d = s.template cast<double>();
+  Vector3d dir_d = dir.template cast<double>();
+  if(tree.m_primitive == -1 && tree.m_left == NULL)
+  {
+    // Empty tree
+    return false;
+  }
+  const Vector3d inv_dir = internal::ray_mesh_intersect_inv_dir(dir_d);
+  // Nearest box first, skipping boxes entered beyond the closest hit so far
+  bool found = false;
+  // Hits store t as float: boxes entered before the next float after hit.t
+  // may still contain an equally close hit (with a smaller face index)
+  double t_cull = inf;
+  typedef std::pair<const AABB<DerivedV,3> *,double> NodeEntry;
+  std::vector<NodeEntry> stack;
+  {
+    const double t_root =
+      internal::ray_mesh_intersect_box_entry(tree.m_box,s_d,inv_dir);
+    if(t_root < inf)
+    {
+      stack.emplace_back(&tree,t_root);
+    }
+  }
+  while(!stack.empty())
+  {
+    const NodeEntry entry = stack.back();
+    stack.pop_back();
+    if(entry.second > t_cull)
+    {
+      continue;
+    }
+    const AABB<DerivedV,3> * node = entry.first;
+    if(!node->is_leaf())
+    {
+      NodeEntry near_child(node->m_left,
+        internal::ray_mesh_intersect_box_entry(node->m_left->m_box,s_d,inv_dir));
+      NodeEntry far_child(node->m_right,
+        internal::ray_mesh_intersect_box_entry(node->m_right->m_box,s_d,inv_dir));
+      if(far_child.second < near_child.second)
+      {
+        std::swap(near_child,far_child);
+      }
+      if(far_child.second < inf && far_child.second <= t_cull)
+      {
+        stack.push_back(far_child);
+      }
+      if(near_child.second < inf && near_child.second <= t_cull)
+      {
+        stack.push_back(near_child);
+      }
+      continue;
+    }
+    // Same test as brute force version
+    const int f = node->m_primitive;
+    RowVector3d v0 = V.row(F(f,0)).template cast<double>();
+    RowVector3d v1 = V.row(F(f,1)).template cast<double>();
+    RowVector3d v2 = V.row(F(f,2)).template cast<double>();
+    double t,u,v;
+    if(intersect_triangle1(
+      s_d.data(), dir_d.data(), v0.data(), v1.data(), v2.data(), &t, &u, &v) &&
+      t>0)
+    {
+      const float ft = (float)t;
+      if(!found || ft < hit.t || (ft == hit.t && f < hit.id))
+      {
+        found = true;
+        hit = {(int)f,(int)-1,(float)u,(float)v,ft};
+        t_cull = double(std::nextafter(ft,std::numeric_limits<float>::infinity()))*
+          (1+4*std::numeric_limits<double>::epsilon());
+      }
+    }
+  }
+  return found;
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
 // generated by autoexplicit.sh
@@ -87,4 +290,9 @@ template bool igl::ray_mesh_intersect<Eigen::Matrix<float, 3, 1, 0, 3, 1>, Eigen
 template bool igl::ray_mesh_intersect<Eigen::Matrix<float, 3, 1, 0, 3, 1>, Eigen::Matrix<float, 3, 1, 0, 3, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, 3, 1, 0, 3, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 3, 1, 0, 3, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, std::vector<igl::Hit, std::allocator<igl::Hit> >&);
 template bool igl::ray_mesh_intersect<Eigen::Matrix<float, 3, 1, 0, 3, 1>, Eigen::Matrix<float, 3, 1, 0, 3, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, 3, 1, 0, 3, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 3, 1, 0, 3, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::Hit&);
 template bool igl::ray_mesh_intersect<Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Block<Eigen::Matrix<int, -1, -1, 0, -1, -1> const, 1, -1, false> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Block<Eigen::Matrix<int, -1, -1, 0, -1, -1> const, 1, -1, false> > const&, igl::Hit&);
+template bool igl::ray_mesh_intersect<Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, std::vector<igl::Hit, std::allocator<igl::Hit> >&);
+template bool igl::ray_mesh_intersect<Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, igl::Hit&);
+template bool igl::ray_mesh_intersect<Eigen::Matrix<float, 3, 1, 0, 3, 1>, Eigen::Matrix<float, 3, 1, 0, 3, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, 3, 1, 0, 3, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, 3, 1, 0, 3, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::AABB<Eigen::Matrix<double, -1, -1, 0, -1, -1>, 3> const&, igl::Hit&);
+template bool igl::ray_mesh_intersect<Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, std::vector<igl::Hit, std::allocator<igl::Hit> >&);
+template bool igl::ray_mesh_intersect<Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, 1, 3, 1, 1, 3>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, igl::Hit&);
 #endif
@@ -11,6 +11,8 @@
 #include "Hit.h"
 #include <Eigen/Core>
 #include <vector>
+// Forward declaration
+namespace igl { template <typename DerivedV, int DIM> class AABB; }
 namespace igl
 {
   // Shoot a ray against a mesh (V,F) and collect all hits. If you have many
@@ -51,6 +53,41 @@ namespace igl
     const Eigen::MatrixBase<DerivedV> & V,
     const Eigen::MatrixBase<DerivedF> & F,
     igl::Hit & hit);
+  // Shoot a ray against a mesh (V,F) using a precomputed bounding volume
+  // hierarchy so that only faces whose boxes are hit by the ray are tested.
+  // Hits (and their order) are exactly those of the brute force versions
+  // above.
+  //
+  // Inputs:
+  //   tree  bounding volume hierarchy of (V,F), see AABB::init
+  template <
+    typename Derivedsource,
+    typename Deriveddir,
+    typename DerivedV, 
+    typename DerivedF> 
+  IGL_INLINE bool ray_mesh_intersect(
+    const Eigen::MatrixBase<Derivedsource> & source,
+    const Eigen::MatrixBase<Deriveddir> & dir,
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const igl::AABB<DerivedV,3> & tree,
+    std::vector<igl::Hit> & hits);
+  // Outputs:
+  //   hit  closest hit (ties broken by smaller face index), set only if it
+  //     exists. Boxes entered beyond the closest hit so far are not visited.
+  // Returns true if there was a hit
+  template <
+    typename Derivedsource,
+    typename Deriveddir,
+    typename DerivedV, 
+    typename DerivedF> 
+  IGL_INLINE bool ray_mesh_intersect(
+    const Eigen::MatrixBase<Derivedsource> & source,
+    const Eigen::MatrixBase<Deriveddir> & dir,
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const igl::AABB<DerivedV,3> & tree,
+    igl::Hit & hit);
 }
 #ifndef IGL_STATIC_LIBRARY
 #  include "ray_mesh_intersect.cpp"
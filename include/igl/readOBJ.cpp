@@ -13,12 +13,710 @@
 #include "polygon_corners.h"
 #include "polygons_to_triangles.h"
 
+#include "MappedFile.h"
+#include "default_num_threads.h"
+#include "parallel_for.h"
+
 #include <iostream>
 #include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <cstdint>
+#include <climits>
 #include <fstream>
 #include <sstream>
 #include <iterator>
 
+// Helpers for reading a memory mapped .obj file directly into Eigen matrices.
+// The file is split into newline-aligned chunks. A first pass counts the
+// elements of each chunk so that the outputs can be sized exactly and each
+// chunk knows where its rows start; a second pass parses the chunks in
+// parallel writing straight into the outputs.
+namespace igl
+{
+  namespace internal
+  {
+    enum OBJLineType
+    {
+      OBJ_LINE_EMPTY = 0,
+      OBJ_LINE_V = 1,
+      OBJ_LINE_VT = 2,
+      OBJ_LINE_VN = 3,
+      OBJ_LINE_F = 4,
+      // comments, groups, materials, ...
+      OBJ_LINE_IGNORED = 5,
+      OBJ_LINE_UNKNOWN = 6
+    };
+    // Flags of the format of a face corner
+    enum OBJCornerFormat
+    {
+      OBJ_CORNER_TC = 1,
+      OBJ_CORNER_N = 2
+    };
+    inline bool obj_is_space(const char c)
+    {
+      return c==' ' || c=='\t' || c=='\r' || c=='\v' || c=='\f';
+    }
+    inline const char * obj_skip_space(const char * p, const char * end)
+    {
+      while(p<end && obj_is_space(*p)) { p++; }
+      return p;
+    }
+    inline const char * obj_token_end(const char * p, const char * end)
+    {
+      while(p<end && *p!='\n' && !obj_is_space(*p)) { p++; }
+      return p;
+    }
+    inline const char * obj_line_end(const char * p, const char * end)
+    {
+      const void * q = memchr(p,'\n',end-p);
+      return q ? static_cast<const char *>(q) : end;
+    }
+    // Whether c may start a floating point number (including nan and inf)
+    inline bool obj_is_number_start(const char c)
+    {
+      return (c>='0' && c<='9') || c=='-' || c=='+' || c=='.' ||
+        c=='n' || c=='N' || c=='i' || c=='I';
+    }
+    // Classify line by its first word
+    //
+    // Inputs:
+    //   p  pointer to first non-space character of the line
+    //   line_end  end of the line
+    // Outputs:
+    //   p  pointer right after the first word
+    // Returns type of line
+    inline OBJLineType obj_line_type(const char *& p, const char * line_end)
+    {
+      const char * t = p;
+      p = obj_token_end(p,line_end);
+      const size_t n = p-t;
+      if(n == 0) { return OBJ_LINE_EMPTY; }
+      if(n == 1 && t[0]=='v') { return OBJ_LINE_V; }
+      if(n == 1 && t[0]=='f') { return OBJ_LINE_F; }
+      if(n == 2 && t[0]=='v' && t[1]=='t') { return OBJ_LINE_VT; }
+      if(n == 2 && t[0]=='v' && t[1]=='n') { return OBJ_LINE_VN; }
+      if(t[0]=='#' || t[0]=='g' || t[0]=='s' ||
+        (n == 6 && strncmp(t,"usemtl",6)==0) ||
+        (n == 6 && strncmp(t,"mtllib",6)==0))
+      {
+        return OBJ_LINE_IGNORED;
+      }
+      return OBJ_LINE_UNKNOWN;
+    }
+    // Number of whitespace separated words, stopping at the first word that
+    // cannot be a number if numbers_only is true
+    inline int obj_count_words(
+      const char * p,
+      const char * line_end,
+      const bool numbers_only)
+    {
+      int count = 0;
+      while((p = obj_skip_space(p,line_end)) < line_end)
+      {
+        if(numbers_only && !obj_is_number_start(*p)) { break; }
+        count++;
+        p = obj_token_end(p,line_end);
+      }
+      return count;
+    }
+    // Parse a floating point number ending at a word boundary. Numbers with at
+    // most 19 significant digits and a small decimal exponent are converted
+    // with a single correctly rounded multiplication or division (Clinger's
+    // fast path), anything else is handed to strtod, so the result is always
+    // the same as strtod's.
+    //
+    // Inputs:
+    //   p  pointer to first character of the number
+    //   end  end of the buffer
+    // Outputs:
+    //   p  pointer right after the number
+    //   x  parsed value
+    // Returns true on success, false if the word is not a number
+    inline bool obj_parse_double(const char *& p, const char * end, double & x)
+    {
+      static const double pow10[] = {
+        1e0,1e1,1e2,1e3,1e4,1e5,1e6,1e7,1e8,1e9,1e10,1e11,1e12,1e13,1e14,
+        1e15,1e16,1e17,1e18,1e19,1e20,1e21,1e22};
+      const char * q = p;
+      bool negative = false;
+      if(q<end && (*q=='-' || *q=='+'))
+      {
+        negative = *q=='-';
+        q++;
+      }
+      uint64_t m = 0;
+      int significant = 0;
+      int exponent = 0;
+      bool any_digit = false;
+      bool exact = true;
+      const auto digit = [&](const int d, const bool fraction)
+      {
+        any_digit = true;
+        if(significant < 19)
+        {
+          m = 10*m + d;
+          if(m>0) { significant++; }
+          if(fraction) { exponent--; }
+        }else
+        {
+          if(d != 0) { exact = false; }
+          if(!fraction) { exponent++; }
+        }
+      };
+      for(;q<end && *q>='0' && *q<='9';q++) { digit(*q-'0',false); }
+      if(q<end && *q=='.')
+      {
+        for(q++;q<end && *q>='0' && *q<='9';q++) { digit(*q-'0',true); }
+      }
+      if(any_digit && q<end && (*q=='e' || *q=='E'))
+      {
+        const char * e = q+1;
+        bool e_negative = false;
+        if(e<end && (*e=='-' || *e=='+'))
+        {
+          e_negative = *e=='-';
+          e++;
+        }
+        if(e<end && *e>='0' && *e<='9')
+        {
+          int e_value = 0;
+          for(;e<end && *e>='0' && *e<='9';e++)
+          {
+            if(e_value < 100000) { e_value = 10*e_value + (*e-'0'); }
+          }
+          exponent += e_negative ? -e_value : e_value;
+          q = e;
+        }
+      }
+      if(any_digit && exact && (q==end || *q=='\n' || obj_is_space(*q)) &&
+        m <= (uint64_t(1)<<53) && exponent >= -22 && exponent <= 22)
+      {
+        x = double(m);
+        x = exponent < 0 ? x/pow10[-exponent] : x*pow10[exponent];
+        x = negative ? -x : x;
+        p = q;
+        return true;
+      }
+      // Slow path: copy the word so that strtod cannot read past end
+      const char * word_end = obj_token_end(p,end);
+      char buffer[128];
+      const size_t n = word_end-p;
+      if(n == 0 || n >= sizeof(buffer)) { return false; }
+      memcpy(buffer,p,n);
+      buffer[n] = '\0';
+      char * buffer_end;
+      x = strtod(buffer,&buffer_end);
+      if(buffer_end != buffer+n) { return false; }
+      p = word_end;
+      return true;
+    }
+    // Parse a (signed) integer
+    //
+    // Inputs:
+    //   p  pointer to first character of the integer
+    //   end  end of the buffer
+    // Outputs:
+    //   p  pointer right after the integer
+    //   i  parsed value
+    // Returns true on success, false if there are no digits
+    inline bool obj_parse_long(const char *& p, const char * end, long & i)
+    {
+      const char * q = p;
+      bool negative = false;
+      if(q<end && (*q=='-' || *q=='+'))
+      {
+        negative = *q=='-';
+        q++;
+      }
+      if(q==end || *q<'0' || *q>'9') { return false; }
+      long value = 0;
+      for(;q<end && *q>='0' && *q<='9';q++) { value = 10*value + (*q-'0'); }
+      i = negative ? -value : value;
+      p = q;
+      return true;
+    }
+    // Parse a face corner "i", "i/t", "i//n" or "i/t/n"
+    //
+    // Inputs:
+    //   p  pointer to first character of the corner
+    //   end  end of the buffer
+    // Outputs:
+    //   p  pointer to the end of the word
+    //   i,t,n  parsed (unshifted) indices
+    // Returns flags of OBJCornerFormat, or -1 if the corner is invalid
+    inline int obj_parse_corner(
+      const char *& p,
+      const char * end,
+      long & i,
+      long & t,
+      long & n)
+    {
+      if(!obj_parse_long(p,end,i))
+      {
+        return -1;
+      }
+      int format = 0;
+      if(p<end && *p=='/')
+      {
+        p++;
+        if(p<end && *p=='/')
+        {
+          p++;
+          if(obj_parse_long(p,end,n)) { format = OBJ_CORNER_N; }
+        }else if(obj_parse_long(p,end,t))
+        {
+          format = OBJ_CORNER_TC;
+          if(p<end && *p=='/')
+          {
+            p++;
+            if(obj_parse_long(p,end,n)) { format |= OBJ_CORNER_N; }
+          }
+        }
+      }
+      p = obj_token_end(p,end);
+      return format;
+    }
+    // Newline-aligned piece of a .obj file
+    struct OBJChunk
+    {
+      const char * begin = nullptr;
+      const char * end = nullptr;
+      // Counts from the first pass
+      int num_lines = 0;
+      int num_v = 0;
+      int num_vt = 0;
+      int num_vn = 0;
+      int num_f = 0;
+      int64_t num_corners = 0;
+      // Ranges of the numbers of coordinates and face degrees
+      int v_min = INT_MAX, v_max = 0;
+      int vt_min = INT_MAX, vt_max = 0;
+      int f_min = INT_MAX, f_max = 0;
+      // OBJCornerFormat of the first corner of the first face
+      int first_face_format = 0;
+      // Unknown lines (line number within chunk and pointer to line)
+      std::vector<std::pair<int,const char *> > unknown;
+      // Offsets of this chunk's elements in the outputs
+      int line_offset = 0;
+      int v_offset = 0;
+      int vt_offset = 0;
+      int vn_offset = 0;
+      int f_offset = 0;
+      int64_t corner_offset = 0;
+      // First error: line within chunk (-1 if none) and message format taking
+      // the line number
+      int error_line = -1;
+      const char * error = nullptr;
+      // Set if a face is missing texture coordinates or normals that are
+      // being read
+      bool missing_tc = false;
+      bool missing_n = false;
+    };
+    // First pass: count elements of a chunk and check numbers of coordinates
+    inline void obj_count_chunk(OBJChunk & chunk)
+    {
+      const char * end = chunk.end;
+      for(const char * line = chunk.begin;line<end;chunk.num_lines++)
+      {
+        const char * line_end = obj_line_end(line,end);
+        const char * p = obj_skip_space(line,line_end);
+        const OBJLineType type = obj_line_type(p,line_end);
+        const auto error = [&](const char * message)
+        {
+          if(chunk.error_line == -1)
+          {
+            chunk.error_line = chunk.num_lines;
+            chunk.error = message;
+          }
+        };
+        switch(type)
+        {
+          case OBJ_LINE_V:
+          {
+            const int count = obj_count_words(p,line_end,true);
+            if(count < 3)
+            {
+              error("Error: readOBJ() vertex on line %d should have at least 3 "
+                "coordinates");
+            }
+            chunk.v_min = std::min(chunk.v_min,count);
+            chunk.v_max = std::max(chunk.v_max,count);
+            chunk.num_v++;
+            break;
+          }
+          case OBJ_LINE_VT:
+          {
+            const int count = std::min(obj_count_words(p,line_end,true),3);
+            if(count < 2)
+            {
+              error("Error: readOBJ() texture coords on line %d should have 2 "
+                "or 3 coordinates");
+            }
+            chunk.vt_min = std::min(chunk.vt_min,count);
+            chunk.vt_max = std::max(chunk.vt_max,count);
+            chunk.num_vt++;
+            break;
+          }
+          case OBJ_LINE_VN:
+            if(obj_count_words(p,line_end,true) < 3)
+            {
+              error("Error: readOBJ() normal on line %d should have 3 "
+                "coordinates");
+            }
+            chunk.num_vn++;
+            break;
+          case OBJ_LINE_F:
+          {
+            const int count = obj_count_words(p,line_end,false);
+            if(count == 0)
+            {
+              error("Error: readOBJ() face on line %d has invalid format\n");
+            }
+            if(chunk.num_f == 0 && count > 0)
+            {
+              const char * q = obj_skip_space(p,line_end);
+              long i,t,n;
+              chunk.first_face_format =
+                std::max(obj_parse_corner(q,line_end,i,t,n),0);
+            }
+            chunk.f_min = std::min(chunk.f_min,count);
+            chunk.f_max = std::max(chunk.f_max,count);
+            chunk.num_corners += count;
+            chunk.num_f++;
+            break;
+          }
+          case OBJ_LINE_UNKNOWN:
+            chunk.unknown.emplace_back(chunk.num_lines,line);
+            break;
+          default:
+            break;
+        }
+        line = line_end + 1;
+      }
+    }
+    // Resize M to rows by cols, or to an empty matrix as list_to_matrix does
+    template <typename Derived>
+    IGL_INLINE void obj_resize(
+      const int rows,
+      const int cols,
+      Eigen::PlainObjectBase<Derived> & M)
+    {
+      if(rows == 0)
+      {
+        M.resize(
+          Derived::RowsAtCompileTime>=0?Derived::RowsAtCompileTime:0,
+          Derived::ColsAtCompileTime>=0?Derived::ColsAtCompileTime:0);
+      }else
+      {
+        M.resize(rows,cols);
+      }
+    }
+    // Read a .obj file into Eigen matrices without intermediate lists
+    //
+    // Inputs:
+    //   str  path to .obj file
+    // Outputs:
+    //   V  #V by dim list of vertex positions
+    //   TC  #TC by 2|3 list of texture coordinates (untouched if there are
+    //     none, may be nullptr)
+    //   CN  #CN by 3 list of normals (untouched if there are none, may be
+    //     nullptr)
+    //   F  #F by degree list of face indices into V, or if C is not null the
+    //     #I list of polygon corners
+    //   FTC  #F by degree list of face indices into TC (untouched if the
+    //     first face has none, may be nullptr)
+    //   FN  #F by degree list of face indices into CN (untouched if the
+    //     first face has none, may be nullptr)
+    //   C  #F+1 list of cumulative polygon sizes or nullptr
+    // Returns true on success, false on errors
+    template <
+      typename DerivedV,
+      typename DerivedTC,
+      typename DerivedCN,
+      typename DerivedF,
+      typename DerivedFTC,
+      typename DerivedFN,
+      typename DerivedC>
+    IGL_INLINE bool readOBJ_mapped(
+      const std::string & str,
+      Eigen::PlainObjectBase<DerivedV> & V,
+      Eigen::PlainObjectBase<DerivedTC> * TC,
+      Eigen::PlainObjectBase<DerivedCN> * CN,
+      Eigen::PlainObjectBase<DerivedF> & F,
+      Eigen::PlainObjectBase<DerivedFTC> * FTC,
+      Eigen::PlainObjectBase<DerivedFN> * FN,
+      Eigen::PlainObjectBase<DerivedC> * C)
+    {
+      igl::MappedFile file;
+      if(!file.open(str))
+      {
+        fprintf(stderr,"IOError: %s could not be opened...\n",str.c_str());
+        return false;
+      }
+      const char * data = file.data();
+      const char * data_end = file.data() + file.size();
+      // At least 1MB per chunk
+      const size_t min_chunk_size = 1<<20;
+      const int num_chunks = int(std::max<size_t>(1,std::min<size_t>(
+        igl::default_num_threads(),file.size()/min_chunk_size)));
+      std::vector<OBJChunk> chunks(num_chunks);
+      for(int c = 0;c<num_chunks;c++)
+      {
+        chunks[c].begin = c == 0 ? data : chunks[c-1].end;
+        const char * split = data + file.size()/num_chunks*(c+1);
+        chunks[c].end = c+1 == num_chunks ? data_end :
+          std::min(obj_line_end(std::max(split,chunks[c].begin),data_end)+1,
+            data_end);
+      }
+      igl::parallel_for(
+        num_chunks,[&chunks](const int c){ obj_count_chunk(chunks[c]); },2);
+
+      // Offsets and totals
+      OBJChunk total;
+      for(OBJChunk & chunk : chunks)
+      {
+        chunk.line_offset = total.num_lines;
+        chunk.v_offset = total.num_v;
+        chunk.vt_offset = total.num_vt;
+        chunk.vn_offset = total.num_vn;
+        chunk.f_offset = total.num_f;
+        chunk.corner_offset = total.num_corners;
+        for(const auto & unknown : chunk.unknown)
+        {
+          const char * line_end = obj_line_end(unknown.second,data_end);
+          fprintf(stderr,
+            "Warning: readOBJ() ignored non-comment line %d:\n  %.*s\n",
+            chunk.line_offset+unknown.first+1,
+            int(line_end-unknown.second),unknown.second);
+        }
+        if(chunk.error_line != -1)
+        {
+          fprintf(stderr,chunk.error,chunk.line_offset+chunk.error_line+1);
+          return false;
+        }
+        if(total.num_f == 0 && chunk.num_f > 0)
+        {
+          total.first_face_format = chunk.first_face_format;
+        }
+        total.num_lines += chunk.num_lines;
+        total.num_v += chunk.num_v;
+        total.num_vt += chunk.num_vt;
+        total.num_vn += chunk.num_vn;
+        total.num_f += chunk.num_f;
+        total.num_corners += chunk.num_corners;
+        total.v_min = std::min(total.v_min,chunk.v_min);
+        total.v_max = std::max(total.v_max,chunk.v_max);
+        total.vt_min = std::min(total.vt_min,chunk.vt_min);
+        total.vt_max = std::max(total.vt_max,chunk.vt_max);
+        total.f_min = std::min(total.f_min,chunk.f_min);
+        total.f_max = std::max(total.f_max,chunk.f_max);
+      }
+
+      // Size outputs
+      const char * format = "Failed to cast %s to matrix: min (%d) != max (%d)\n";
+      if(total.v_min != total.v_max && total.num_v > 0)
+      {
+        printf(format,"V",total.v_min,total.v_max);
+        return false;
+      }
+      obj_resize(total.num_v,total.v_max,V);
+      if(C)
+      {
+        F.resize(
+          DerivedF::RowsAtCompileTime==1 ? 1 : total.num_corners,
+          DerivedF::RowsAtCompileTime==1 ? total.num_corners : 1);
+        C->resize(total.num_f+1);
+        (*C)(total.num_f) = typename DerivedC::Scalar(total.num_corners);
+      }else
+      {
+        if(total.f_min != total.f_max && total.num_f > 0)
+        {
+          printf(format,"F",total.f_min,total.f_max);
+          return false;
+        }
+        obj_resize(total.num_f,total.f_max,F);
+      }
+      if(CN && total.num_vn > 0)
+      {
+        CN->resize(total.num_vn,3);
+      }
+      if(TC && total.num_vt > 0)
+      {
+        if(total.vt_min != total.vt_max)
+        {
+          printf(format,"TC",total.vt_min,total.vt_max);
+          return false;
+        }
+        TC->resize(total.num_vt,total.vt_max);
+      }
+      const bool read_ftc = FTC && total.first_face_format & OBJ_CORNER_TC;
+      const bool read_fn = FN && total.first_face_format & OBJ_CORNER_N;
+      if(read_ftc) { FTC->resize(total.num_f,total.f_max); }
+      if(read_fn) { FN->resize(total.num_f,total.f_max); }
+
+      // Second pass: parse chunks directly into outputs
+      typedef typename DerivedV::Scalar VScalar;
+      typedef typename DerivedF::Scalar FScalar;
+      const auto parse_chunk = [&](OBJChunk & chunk)
+      {
+        const char * end = chunk.end;
+        int line_no = 0;
+        int v = chunk.v_offset;
+        int vt = chunk.vt_offset;
+        int vn = chunk.vn_offset;
+        int f = chunk.f_offset;
+        int64_t corner = chunk.corner_offset;
+        const auto error = [&](const char * message)
+        {
+          chunk.error_line = line_no;
+          chunk.error = message;
+        };
+        for(const char * line = chunk.begin;line<end;line_no++)
+        {
+          const char * line_end = obj_line_end(line,end);
+          const char * p = obj_skip_space(line,line_end);
+          const OBJLineType type = obj_line_type(p,line_end);
+          line = line_end + 1;
+          switch(type)
+          {
+            case OBJ_LINE_V:
+            {
+              double x;
+              for(int j = 0;j<V.cols();j++)
+              {
+                p = obj_skip_space(p,line_end);
+                if(!obj_parse_double(p,line_end,x))
+                {
+                  error("Error: readOBJ() vertex on line %d has invalid "
+                    "coordinates\n");
+                  return;
+                }
+                V(v,j) = VScalar(x);
+              }
+              v++;
+              break;
+            }
+            case OBJ_LINE_VT:
+            case OBJ_LINE_VN:
+            {
+              const bool is_vt = type == OBJ_LINE_VT;
+              const int cols = is_vt ? total.vt_max : 3;
+              double x[3];
+              for(int j = 0;j<cols;j++)
+              {
+                p = obj_skip_space(p,line_end);
+                if(!obj_parse_double(p,line_end,x[j]))
+                {
+                  error(is_vt ?
+                    "Error: readOBJ() texture coords on line %d are invalid\n":
+                    "Error: readOBJ() normal on line %d is invalid\n");
+                  return;
+                }
+              }
+              if(is_vt && TC)
+              {
+                for(int j = 0;j<cols;j++)
+                {
+                  (*TC)(vt,j) = typename DerivedTC::Scalar(x[j]);
+                }
+              }else if(!is_vt && CN)
+              {
+                for(int j = 0;j<3;j++)
+                {
+                  (*CN)(vn,j) = typename DerivedCN::Scalar(x[j]);
+                }
+              }
+              (is_vt ? vt : vn)++;
+              break;
+            }
+            case OBJ_LINE_F:
+            {
+              const auto shift = [](const long i, const int count)->long
+              {
+                return i<0 ? i+count : i-1;
+              };
+              int k = 0;
+              int tc_count = 0,n_count = 0;
+              if(C) { (*C)(f) = typename DerivedC::Scalar(corner); }
+              for(;(p = obj_skip_space(p,line_end)) < line_end;k++)
+              {
+                long i,t,n;
+                const int corner_format = obj_parse_corner(p,line_end,i,t,n);
+                if(corner_format == -1)
+                {
+                  error("Error: readOBJ() face on line %d has invalid element "
+                    "format\n");
+                  return;
+                }
+                if(C)
+                {
+                  F(corner+k) = FScalar(shift(i,v));
+                }else
+                {
+                  F(f,k) = FScalar(shift(i,v));
+                }
+                if(corner_format & OBJ_CORNER_TC)
+                {
+                  tc_count++;
+                  if(read_ftc)
+                  {
+                    (*FTC)(f,k) = typename DerivedFTC::Scalar(shift(t,vt));
+                  }
+                }
+                if(corner_format & OBJ_CORNER_N)
+                {
+                  n_count++;
+                  if(read_fn)
+                  {
+                    (*FN)(f,k) = typename DerivedFN::Scalar(shift(n,vn));
+                  }
+                }
+              }
+              if((tc_count != 0 && tc_count != k) || (n_count != 0 && n_count != k))
+              {
+                error("Error: readOBJ() face on line %d has invalid format\n");
+                return;
+              }
+              chunk.missing_tc |= read_ftc && tc_count == 0;
+              chunk.missing_n |= read_fn && n_count == 0;
+              corner += k;
+              f++;
+              break;
+            }
+            default:
+              break;
+          }
+        }
+      };
+      igl::parallel_for(
+        num_chunks,[&](const int c){ parse_chunk(chunks[c]); },2);
+      for(const OBJChunk & chunk : chunks)
+      {
+        if(chunk.error_line != -1)
+        {
+          fprintf(stderr,chunk.error,chunk.line_offset+chunk.error_line+1);
+          return false;
+        }
+      }
+      for(const OBJChunk & chunk : chunks)
+      {
+        if(chunk.missing_tc)
+        {
+          printf(format,"FTC",0,total.f_max);
+          return false;
+        }
+        if(chunk.missing_n)
+        {
+          printf(format,"FN",0,total.f_max);
+          return false;
+        }
+      }
+      return true;
+    }
+  }
+}
+
 template <typename Scalar, typename Index>
 IGL_INLINE bool igl::readOBJ(
   const std::string obj_file_name,
@@ -303,69 +1001,9 @@ IGL_INLINE bool igl::readOBJ(
   Eigen::PlainObjectBase<DerivedFTC>& FTC,
   Eigen::PlainObjectBase<DerivedFN>& FN)
 {
-  std::vector<std::vector<double> > vV,vTC,vN;
-  std::vector<std::vector<int> > vF,vFTC,vFN;
-  bool success = igl::readOBJ(str,vV,vTC,vN,vF,vFTC,vFN);
-  if(!success)
-  {
-    // readOBJ(str,vV,vTC,vN,vF,vFTC,vFN) should have already printed an error
-    // message to stderr
-    return false;
-  }
-  bool V_rect = igl::list_to_matrix(vV,V);
-  const char * format = "Failed to cast %s to matrix: min (%d) != max (%d)\n";
-  if(!V_rect)
-  {
-    printf(format,"V",igl::min_size(vV),igl::max_size(vV));
-    return false;
-  }
-  bool F_rect = igl::list_to_matrix(vF,F);
-  if(!F_rect)
-  {
-    printf(format,"F",igl::min_size(vF),igl::max_size(vF));
-    return false;
-  }
-  if(!vN.empty())
-  {
-    bool VN_rect = igl::list_to_matrix(vN,CN);
-    if(!VN_rect)
-    {
-      printf(format,"CN",igl::min_size(vN),igl::max_size(vN));
-      return false;
-    }
-  }
-
-  if(!vFN.empty() && !vFN[0].empty())
-  {
-    bool FN_rect = igl::list_to_matrix(vFN,FN);
-    if(!FN_rect)
-    {
-      printf(format,"FN",igl::min_size(vFN),igl::max_size(vFN));
-      return false;
-    }
-  }
-
-  if(!vTC.empty())
-  {
-
-    bool T_rect = igl::list_to_matrix(vTC,TC);
-    if(!T_rect)
-    {
-      printf(format,"TC",igl::min_size(vTC),igl::max_size(vTC));
-      return false;
-    }
-  }
-  if(!vFTC.empty()&& !vFTC[0].empty())
-  {
-
-    bool FTC_rect = igl::list_to_matrix(vFTC,FTC);
-    if(!FTC_rect)
-    {
-      printf(format,"FTC",igl::min_size(vFTC),igl::max_size(vFTC));
-      return false;
-    }
-  }
-  return true;
+  return igl::internal::readOBJ_mapped(
+    str,V,&TC,&CN,F,&FTC,&FN,
+    static_cast<Eigen::PlainObjectBase<Eigen::VectorXi> *>(nullptr));
 }
 
 template <typename DerivedV, typename DerivedF>
@@ -374,28 +1012,12 @@ IGL_INLINE bool igl::readOBJ(
   Eigen::PlainObjectBase<DerivedV>& V,
   Eigen::PlainObjectBase<DerivedF>& F)
 {
-  std::vector<std::vector<double> > vV,vTC,vN;
-  std::vector<std::vector<int> > vF,vFTC,vFN;
-  bool success = igl::readOBJ(str,vV,vTC,vN,vF,vFTC,vFN);
-  if(!success)
-  {
-    // readOBJ(str,vV,vTC,vN,vF,vFTC,vFN) should have already printed an error
-    // message to stderr
-    return false;
-  }
-  bool V_rect = igl::list_to_matrix(vV,V);
-  if(!V_rect)
-  {
-    // igl::list_to_matrix(vV,V) already printed error message to std err
-    return false;
-  }
-  bool F_rect = igl::list_to_matrix(vF,F);
-  if(!F_rect)
-  {
-    // igl::list_to_matrix(vF,F) already printed error message to std err
-    return false;
-  }
-  return true;
+  typedef Eigen::PlainObjectBase<Eigen::MatrixXd> * NoMatrix;
+  typedef Eigen::PlainObjectBase<Eigen::MatrixXi> * NoIndices;
+  return igl::internal::readOBJ_mapped(
+    str,V,NoMatrix(nullptr),NoMatrix(nullptr),F,
+    NoIndices(nullptr),NoIndices(nullptr),
+    static_cast<Eigen::PlainObjectBase<Eigen::VectorXi> *>(nullptr));
 }
 
 template <typename DerivedV, typename DerivedI, typename DerivedC>
@@ -405,22 +1027,11 @@ IGL_INLINE bool igl::readOBJ(
   Eigen::PlainObjectBase<DerivedI>& I,
   Eigen::PlainObjectBase<DerivedC>& C)
 {
-  // we should flip this so that the base implementation uses arrays.
-  std::vector<std::vector<double> > vV,vTC,vN;
-  std::vector<std::vector<int> > vF,vFTC,vFN;
-  bool success = igl::readOBJ(str,vV,vTC,vN,vF,vFTC,vFN);
-  if(!success)
-  {
-    // readOBJ(str,vV,vTC,vN,vF,vFTC,vFN) should have already printed an error
-    // message to stderr
-    return false;
-  }
-  if(!igl::list_to_matrix(vV,V))
-  {
-    return false;
-  }
-  igl::polygon_corners(vF,I,C);
-  return true;
+  typedef Eigen::PlainObjectBase<Eigen::MatrixXd> * NoMatrix;
+  typedef Eigen::PlainObjectBase<Eigen::MatrixXi> * NoIndices;
+  return igl::internal::readOBJ_mapped(
+    str,V,NoMatrix(nullptr),NoMatrix(nullptr),I,
+    NoIndices(nullptr),NoIndices(nullptr),&C);
 }
 
 
@@ -7,6 +7,10 @@
 
 #include "tinyply.h"
 #include "file_utils.h"
+#include "MappedFile.h"
+#include "parallel_for.h"
+#include <cstring>
+#include <limits>
 
 
 namespace igl
@@ -138,6 +142,421 @@ IGL_INLINE bool tinyply_tristrips_to_faces(
   }
 }
 
+namespace internal
+{
+  // Byte layout of one property in the records of a binary PLY element
+  struct PLYPropertyLayout
+  {
+    std::string name;
+    tinyply::Type type;
+    // Offset of the (first item of the) property in the record
+    size_t offset;
+    bool is_list;
+    // Type of the size of a list property
+    tinyply::Type list_type;
+    // Number of items of a list property (the same for every record)
+    size_t list_count;
+  };
+
+  // Byte layout of a binary PLY element whose records all have the same size
+  struct PLYElementLayout
+  {
+    std::string name;
+    const char * data;
+    size_t count;
+    size_t stride;
+    std::vector<PLYPropertyLayout> properties;
+    const PLYPropertyLayout * find(const std::string & name) const
+    {
+      for(const auto & p : properties)
+      {
+        if(p.name == name)
+        {
+          return &p;
+        }
+      }
+      return nullptr;
+    }
+  };
+
+  // Read a (list size) integer of the given type
+  IGL_INLINE bool ply_read_size(
+    const tinyply::Type type,
+    const char * p,
+    size_t & size)
+  {
+    switch(type)
+    {
+#define IGL_PLY_READ_SIZE(T) { T t; std::memcpy(&t,p,sizeof(T)); size = size_t(t); return true; }
+      case tinyply::Type::INT8: IGL_PLY_READ_SIZE(int8_t)
+      case tinyply::Type::UINT8: IGL_PLY_READ_SIZE(uint8_t)
+      case tinyply::Type::INT16: IGL_PLY_READ_SIZE(int16_t)
+      case tinyply::Type::UINT16: IGL_PLY_READ_SIZE(uint16_t)
+      case tinyply::Type::INT32: IGL_PLY_READ_SIZE(int32_t)
+      case tinyply::Type::UINT32: IGL_PLY_READ_SIZE(uint32_t)
+#undef IGL_PLY_READ_SIZE
+      default: return false;
+    }
+  }
+
+  // Lay out the elements of a binary PLY payload. Fails if a list property
+  // does not have the same length in every record of its element, or if the
+  // payload is too short.
+  IGL_INLINE bool ply_element_layouts(
+    const std::vector<tinyply::PlyElement> & elements,
+    const char * data,
+    const char * data_end,
+    std::vector<PLYElementLayout> & layouts)
+  {
+    layouts.clear();
+    for(const auto & e : elements)
+    {
+      PLYElementLayout layout;
+      layout.name = e.name;
+      layout.data = data;
+      layout.count = e.size;
+      size_t offset = 0;
+      for(const auto & p : e.properties)
+      {
+        PLYPropertyLayout property{
+          p.name,p.propertyType,offset,p.isList,p.listType,0};
+        if(p.isList)
+        {
+          const size_t size_bytes = tinyply::PropertyTable[p.listType].stride;
+          if(e.size == 0 ||
+            size_t(data_end-data) < offset+size_bytes ||
+            !ply_read_size(p.listType,data+offset,property.list_count) ||
+            property.list_count > size_t(data_end-data))
+          {
+            return false;
+          }
+          property.offset = offset+size_bytes;
+          offset += size_bytes;
+          offset += property.list_count*tinyply::PropertyTable[p.propertyType].stride;
+        }else
+        {
+          offset += tinyply::PropertyTable[p.propertyType].stride;
+        }
+        layout.properties.push_back(property);
+      }
+      layout.stride = offset;
+      if(layout.stride == 0 ||
+        size_t(data_end-data)/layout.stride < layout.count)
+      {
+        return false;
+      }
+      // Check that every record has the same list lengths as the first
+      for(const auto & p : layout.properties)
+      {
+        if(!p.is_list)
+        {
+          continue;
+        }
+        const size_t size_offset =
+          p.offset - tinyply::PropertyTable[p.list_type].stride;
+        for(size_t i = 0;i<layout.count;i++)
+        {
+          size_t list_count;
+          if(!ply_read_size(
+            p.list_type,data+i*layout.stride+size_offset,list_count) ||
+            list_count != p.list_count)
+          {
+            return false;
+          }
+        }
+      }
+      data += layout.stride*layout.count;
+      layouts.push_back(layout);
+    }
+    return true;
+  }
+
+  // Gather (type,offset) columns of the records of an element into M,
+  // converting to M's scalar type. Runs that exactly match the memory
+  // layout of M are copied in one go.
+  template <typename T, typename Derived>
+  IGL_INLINE void ply_column_to_matrix(
+    const PLYElementLayout & element,
+    const size_t offset,
+    const Eigen::Index col,
+    Eigen::PlainObjectBase<Derived> & M)
+  {
+    typedef typename Derived::Scalar Scalar;
+    const char * data = element.data + offset;
+    const size_t stride = element.stride;
+    igl::parallel_for(element.count,[&](const size_t i)
+    {
+      T t;
+      std::memcpy(&t,data+i*stride,sizeof(T));
+      M(i,col) = static_cast<Scalar>(t);
+    },100000);
+  }
+
+  template <typename Derived>
+  IGL_INLINE bool ply_columns_to_matrix(
+    const PLYElementLayout & element,
+    const std::vector<std::pair<tinyply::Type,size_t> > & columns,
+    Eigen::PlainObjectBase<Derived> & M)
+  {
+    typedef typename Derived::Scalar Scalar;
+    M.resize(element.count,columns.size());
+    if(columns.empty())
+    {
+      return true;
+    }
+    // Records are exactly the rows of M
+    bool contiguous =
+      (Derived::IsRowMajor || columns.size() == 1) &&
+      element.stride == columns.size()*sizeof(Scalar);
+    for(size_t c = 0;contiguous && c<columns.size();c++)
+    {
+      contiguous =
+        tinyply::PropertyTable[columns[c].first].stride == sizeof(Scalar) &&
+        columns[c].second == c*sizeof(Scalar) &&
+        columns[c].first == columns[0].first &&
+        (columns[c].first == tinyply::Type::FLOAT32 ||
+         columns[c].first == tinyply::Type::FLOAT64 ?
+           !std::numeric_limits<Scalar>::is_integer :
+           std::numeric_limits<Scalar>::is_integer &&
+           std::numeric_limits<Scalar>::is_signed ==
+           (columns[c].first == tinyply::Type::INT8 ||
+            columns[c].first == tinyply::Type::INT16 ||
+            columns[c].first == tinyply::Type::INT32));
+    }
+    if(contiguous)
+    {
+      std::memcpy(M.data(),element.data,element.count*element.stride);
+      return true;
+    }
+    for(size_t c = 0;c<columns.size();c++)
+    {
+      const size_t offset = columns[c].second;
+      switch(columns[c].first)
+      {
+        case tinyply::Type::INT8:
+          ply_column_to_matrix<int8_t>(element,offset,c,M); break;
+        case tinyply::Type::UINT8:
+          ply_column_to_matrix<uint8_t>(element,offset,c,M); break;
+        case tinyply::Type::INT16:
+          ply_column_to_matrix<int16_t>(element,offset,c,M); break;
+        case tinyply::Type::UINT16:
+          ply_column_to_matrix<uint16_t>(element,offset,c,M); break;
+        case tinyply::Type::INT32:
+          ply_column_to_matrix<int32_t>(element,offset,c,M); break;
+        case tinyply::Type::UINT32:
+          ply_column_to_matrix<uint32_t>(element,offset,c,M); break;
+        case tinyply::Type::FLOAT32:
+          ply_column_to_matrix<float>(element,offset,c,M); break;
+        case tinyply::Type::FLOAT64:
+          ply_column_to_matrix<double>(element,offset,c,M); break;
+        default:
+          return false;
+      }
+    }
+    return true;
+  }
+
+  // Fill M with the given columns of an element, or empty it
+  template <typename Derived>
+  IGL_INLINE void ply_fill(
+    const PLYElementLayout * element,
+    const std::vector<std::pair<tinyply::Type,size_t> > & columns,
+    Eigen::PlainObjectBase<Derived> & M)
+  {
+    if(!element || columns.empty() ||
+      !ply_columns_to_matrix(*element,columns,M))
+    {
+      M.resize(0,0);
+    }
+  }
+
+  // Read a binary little endian PLY file straight from memory into the
+  // outputs (see readPLY). Returns false without touching the outputs if the
+  // file is not binary little endian or its layout is not supported (e.g.,
+  // variable length lists or triangle strips), in which case the caller
+  // should fall back to the general reader.
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedE,
+    typename DerivedN,
+    typename DerivedUV,
+    typename DerivedVD,
+    typename DerivedFD,
+    typename DerivedED
+    >
+  IGL_INLINE bool readPLY_binary_little_endian(
+    const char * data,
+    const size_t size,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedE> & E,
+    Eigen::PlainObjectBase<DerivedN> & N,
+    Eigen::PlainObjectBase<DerivedUV> & UV,
+    Eigen::PlainObjectBase<DerivedVD> & VD,
+    std::vector<std::string> & Vheader,
+    Eigen::PlainObjectBase<DerivedFD> & FD,
+    std::vector<std::string> & Fheader,
+    Eigen::PlainObjectBase<DerivedED> & ED,
+    std::vector<std::string> & Eheader,
+    std::vector<std::string> & comments)
+  {
+    typedef std::vector<std::pair<tinyply::Type,size_t> > Columns;
+    const uint16_t one = 1;
+    if(*reinterpret_cast<const char*>(&one) != 1 || size == 0)
+    {
+      return false;
+    }
+    tinyply::PlyFile file;
+    std::vector<PLYElementLayout> layouts;
+    {
+      file_memory_stream stream(data,size);
+      try
+      {
+        if(!file.parse_header(stream))
+        {
+          return false;
+        }
+      }catch(const std::exception &)
+      {
+        return false;
+      }
+      const std::streamoff header_size = stream.tellg();
+      if(header_size <= 0 ||
+        std::string(data,header_size).find("format binary_little_endian") ==
+          std::string::npos ||
+        !ply_element_layouts(
+          file.get_elements(),data+header_size,data+size,layouts))
+      {
+        return false;
+      }
+    }
+    const auto find_element = [&layouts](const std::string & name)
+      ->const PLYElementLayout *
+    {
+      for(const auto & e : layouts)
+      {
+        if(e.name == name)
+        {
+          return &e;
+        }
+      }
+      return nullptr;
+    };
+    // Columns of the properties with the given names, or none if any is
+    // missing
+    const auto find_columns = [](
+      const PLYElementLayout * element,
+      const std::vector<std::string> & names)->Columns
+    {
+      Columns columns;
+      for(const auto & name : names)
+      {
+        const PLYPropertyLayout * p = element ? element->find(name) : nullptr;
+        if(!p || p->is_list)
+        {
+          return Columns();
+        }
+        columns.emplace_back(p->type,p->offset);
+      }
+      return columns;
+    };
+    // Columns of every scalar property not in std, failing on extra lists
+    const auto other_columns = [](
+      const PLYElementLayout * element,
+      const std::set<std::string> & std_names,
+      Columns & columns,
+      std::vector<std::string> & header)->bool
+    {
+      columns.clear();
+      header.clear();
+      if(!element)
+      {
+        return true;
+      }
+      for(const auto & p : element->properties)
+      {
+        if(std_names.count(p.name))
+        {
+          continue;
+        }
+        if(p.is_list)
+        {
+          return false;
+        }
+        columns.emplace_back(p.type,p.offset);
+        header.push_back(p.name);
+      }
+      return true;
+    };
+
+    const std::set<std::string> vertex_std{ "x","y","z", "nx","ny","nz",  "u","v",  "texture_u", "texture_v", "s", "t"};
+    const std::set<std::string> face_std  { "vertex_index", "vertex_indices"};
+    const std::set<std::string> edge_std  { "vertex1", "vertex2"};
+
+    const PLYElementLayout * vertex = find_element("vertex");
+    const PLYElementLayout * face = find_element("face");
+    const PLYElementLayout * edge = find_element("edge");
+    if(!face && find_element("tristrips"))
+    {
+      return false;
+    }
+    Columns vertex_columns,face_columns,edge_columns;
+    std::vector<std::string> vertex_header,face_header,edge_header;
+    if(
+      !other_columns(vertex,vertex_std,vertex_columns,vertex_header) ||
+      !other_columns(face,face_std,face_columns,face_header) ||
+      !other_columns(edge,edge_std,edge_columns,edge_header))
+    {
+      return false;
+    }
+    Columns face_indices;
+    if(face)
+    {
+      const PLYPropertyLayout * p = face->find("vertex_indices");
+      if(!p || !p->is_list)
+      {
+        p = face->find("vertex_index");
+      }
+      if(p && p->is_list)
+      {
+        const size_t stride = tinyply::PropertyTable[p->type].stride;
+        for(size_t j = 0;j<p->list_count;j++)
+        {
+          face_indices.emplace_back(p->type,p->offset+j*stride);
+        }
+      }
+    }
+    Columns texcoords = find_columns(vertex,{"texture_u","texture_v"});
+    if(texcoords.empty())
+    {
+      texcoords = find_columns(vertex,{"u","v"});
+    }
+    if(texcoords.empty())
+    {
+      texcoords = find_columns(vertex,{"s","t"});
+    }
+
+    // Now that the layout is known to be supported, fill the outputs
+    for(const auto & c : file.get_comments())
+    {
+      comments.push_back(c);
+    }
+    ply_fill(vertex,find_columns(vertex,{"x","y","z"}),V);
+    ply_fill(vertex,find_columns(vertex,{"nx","ny","nz"}),N);
+    ply_fill(vertex,texcoords,UV);
+    ply_fill(face,face_indices,F);
+    ply_fill(edge,find_columns(edge,{"vertex1","vertex2"}),E);
+    ply_fill(vertex,vertex_columns,VD);
+    ply_fill(face,face_columns,FD);
+    ply_fill(edge,edge_columns,ED);
+    Vheader = vertex_header;
+    Fheader = face_header;
+    Eheader = edge_header;
+    return true;
+  }
+}
+
 template <
   typename DerivedV,
   typename DerivedF,
@@ -171,6 +590,12 @@ IGL_INLINE bool readPLY(
   {
     std::vector<uint8_t> fileBufferBytes;
     read_file_binary(fp,fileBufferBytes);
+    if(internal::readPLY_binary_little_endian(
+      (const char*)fileBufferBytes.data(),fileBufferBytes.size(),
+      V,F,E,N,UV,VD,Vheader,FD,Fheader,ED,Eheader,comments))
+    {
+      return true;
+    }
     file_memory_stream stream((char*)fileBufferBytes.data(), fileBufferBytes.size());
     return readPLY(stream,V,F,E,N,UV,VD,Vheader,FD,Fheader,ED,Eheader,comments);
   }
@@ -447,7 +872,7 @@ IGL_INLINE bool readPLY(
   else
   {
     FD.resize(faces->count, _face_header.size());
-    tinyply_buffer_to_matrix(*_face_data, FD, faces->count, 1);
+    tinyply_buffer_to_matrix(*_face_data, FD, faces->count, _face_header.size());
   }
 
   /// convert edge data:
@@ -495,14 +920,22 @@ IGL_INLINE bool readPLY(
   )
 {
 
-  std::ifstream ply_stream(ply_file, std::ios::binary);
-  if (ply_stream.fail())
+  igl::MappedFile file;
+  if (!file.open(ply_file))
   {
       std::cerr << "ReadPLY: Error opening file " << ply_file << std::endl;
       return false;
   }
+  // Binary little endian files are read straight from the mapped file
+  if(internal::readPLY_binary_little_endian(
+    file.data(),file.size(),
+    V,F,E,N,UV,VD,VDheader,FD,FDheader,ED,EDheader,comments))
+  {
+    return true;
+  }
   try
   {
+    file_memory_stream ply_stream(file.data(),file.size());
     return readPLY(ply_stream, V, F, E, N, UV, VD, VDheader, FD,FDheader, ED, EDheader, comments );
   } catch (const std::exception& e) {
     std::cerr << "ReadPLY error: " << ply_file << e.what() << std::endl;
@@ -638,4 +1071,6 @@ template bool igl::readPLY<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matri
 
 template bool igl::readPLY<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > >&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > >&);
 template bool igl::readPLY<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > >&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > >&);
+template bool igl::readPLY<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> >(std::string const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<unsigned int, -1, 3, 1, -1, 3> >&);
+template bool igl::readPLY<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(std::string const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::vector<std::string, std::allocator<std::string> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, std::vector<std::string, std::allocator<std::string> >&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, std::vector<std::string, std::allocator<std::string> >&, std::vector<std::string, std::allocator<std::string> >&);
 #endif
@@ -56,7 +56,7 @@ IGL_INLINE bool readPLY(
     std::istream & ply_stream,
     Eigen::PlainObjectBase<DerivedV> & V,
     Eigen::PlainObjectBase<DerivedF> & F,
-    Eigen::PlainObjectBase<DerivedF> & E,
+    Eigen::PlainObjectBase<DerivedE> & E,
     Eigen::PlainObjectBase<DerivedN> & N,
     Eigen::PlainObjectBase<DerivedUV> & UV,
 
@@ -10,7 +10,14 @@
 #include "unique_rows.h"
 #include "colon.h"
 #include "slice.h"
+#include "parallel_for.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
 #include <functional>
+#include <vector>
 
 template <
   typename DerivedV, 
@@ -24,7 +31,232 @@ IGL_INLINE void igl::remove_duplicate_vertices(
   Eigen::PlainObjectBase<DerivedSVI>& SVI,
   Eigen::PlainObjectBase<DerivedSVJ>& SVJ)
 {
-  if(epsilon > 0)
+  remove_duplicate_vertices(
+    V,epsilon,REMOVE_DUPLICATE_VERTICES_METHOD_ROUND,SV,SVI,SVJ);
+}
+
+template <
+  typename DerivedV, 
+  typename DerivedSV, 
+  typename DerivedSVI, 
+  typename DerivedSVJ>
+IGL_INLINE void igl::remove_duplicate_vertices(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const double epsilon,
+  const RemoveDuplicateVerticesMethod method,
+  Eigen::PlainObjectBase<DerivedSV>& SV,
+  Eigen::PlainObjectBase<DerivedSVI>& SVI,
+  Eigen::PlainObjectBase<DerivedSVJ>& SVJ)
+{
+  if(method == REMOVE_DUPLICATE_VERTICES_METHOD_WELD)
+  {
+    typedef std::uint64_t Hash;
+    const int n = V.rows();
+    const int dim = V.cols();
+    // Cells of side 2*epsilon so that vertices within epsilon of each other
+    // lie in the same cell or in the neighboring cells across the faces
+    // closest to either vertex. With epsilon=0 the "cell" is the exact
+    // position.
+    const double h = 2.*epsilon;
+    const auto cell = [&](const int i,const int d)->Hash
+    {
+      const double x = double(V(i,d))+0.0;
+      if(epsilon > 0)
+      {
+        return Hash(std::int64_t(std::floor(x/h)));
+      }
+      Hash bits;
+      std::memcpy(&bits,&x,sizeof(bits));
+      return bits;
+    };
+    // Cell hashes are linear in the cell coordinates so that the hashes of
+    // neighboring cells are a constant offset away, followed by a mixing step
+    // when choosing a bucket.
+    std::vector<Hash> P(dim);
+    for(int d = 0;d<dim;d++)
+    {
+      // splitmix64 of d+1
+      Hash z = Hash(d+1)*0x9E3779B97F4A7C15ull;
+      z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ull;
+      z = (z ^ (z >> 27))*0x94D049BB133111EBull;
+      P[d] = (z ^ (z >> 31)) | 1ull;
+    }
+    const int num_neighbors = epsilon > 0 ? 1<<dim : 1;
+    int num_buckets = 1;
+    while(num_buckets < n) { num_buckets *= 2; }
+    const Hash mask = Hash(num_buckets-1);
+    const auto bucket = [&mask](Hash h)->int
+    {
+      h ^= h >> 31;
+      h *= 0xBF58476D1CE4E5B9ull;
+      h ^= h >> 29;
+      return int(h & mask);
+    };
+    // Counting sort of vertices into buckets
+    std::vector<Hash> H(n);
+    std::vector<std::atomic<int> > B(num_buckets+1);
+    parallel_for(num_buckets+1,[&B](const int b){ B[b].store(0); },1000);
+    parallel_for(n,[&](const int i)
+    {
+      Hash h = 0;
+      for(int d = 0;d<dim;d++)
+      {
+        h += cell(i,d)*P[d];
+      }
+      H[i] = h;
+      B[bucket(h)+1].fetch_add(1,std::memory_order_relaxed);
+    },1000);
+    for(int b = 0;b<num_buckets;b++)
+    {
+      B[b+1].store(B[b+1].load()+B[b].load());
+    }
+    // Bit per non-empty bucket: small enough to stay in cache, so that
+    // looking up empty neighboring cells is cheap
+    std::vector<std::uint64_t> occupied((num_buckets+63)/64,0);
+    parallel_for(int(occupied.size()),[&](const int w)
+    {
+      for(int b = 64*w;b<std::min(64*(w+1),num_buckets);b++)
+      {
+        occupied[w] |= std::uint64_t(B[b+1].load()>B[b].load()) << (b%64);
+      }
+    },1000);
+    // Vertex indices, positions and hashes in bucket order so that scanning a
+    // bucket reads contiguous memory
+    std::vector<int> O(n);
+    std::vector<double> X(size_t(n)*dim);
+    {
+      std::vector<std::atomic<int> > next(num_buckets);
+      parallel_for(num_buckets,[&](const int b){ next[b].store(B[b].load()); },1000);
+      parallel_for(n,[&](const int i)
+      {
+        O[next[bucket(H[i])].fetch_add(1,std::memory_order_relaxed)] = i;
+      },1000);
+      parallel_for(n,[&](const int k)
+      {
+        const int i = O[k];
+        for(int d = 0;d<dim;d++)
+        {
+          X[size_t(k)*dim+d] = double(V(i,d));
+        }
+      },1000);
+    }
+    {
+      std::vector<Hash> HO(n);
+      parallel_for(n,[&](const int k){ HO[k] = H[O[k]]; },1000);
+      H.swap(HO);
+    }
+    // Concurrent union-find over positions in bucket order in which the root
+    // of each set is the position of its smallest vertex index
+    std::vector<std::atomic<int> > parent(n);
+    parallel_for(n,[&parent](const int k){ parent[k].store(k); },1000);
+    const auto find = [&parent](int k)->int
+    {
+      int p;
+      while((p = parent[k].load()) != k)
+      {
+        const int g = parent[p].load();
+        if(g != p)
+        {
+          // Path halving
+          parent[k].compare_exchange_weak(p,g);
+        }
+        k = g;
+      }
+      return k;
+    };
+    const auto unite = [&parent,&find,&O](int k,int l)
+    {
+      while(true)
+      {
+        k = find(k);
+        l = find(l);
+        if(k == l)
+        {
+          return;
+        }
+        if(O[k] > O[l])
+        {
+          std::swap(k,l);
+        }
+        int expected = l;
+        if(parent[l].compare_exchange_strong(expected,k))
+        {
+          return;
+        }
+      }
+    };
+    const double epsilon2 = epsilon*epsilon;
+    parallel_for(n,[&](const int k)
+    {
+      const int i = O[k];
+      const double * xi = &X[size_t(k)*dim];
+      // Which half of its cell vertex i lies in along each coordinate
+      int upper = 0;
+      if(epsilon > 0)
+      {
+        for(int d = 0;d<dim;d++)
+        {
+          const double x = xi[d]/h;
+          upper |= int(x-std::floor(x) >= 0.5) << d;
+        }
+      }
+      for(int m = 0;m<num_neighbors;m++)
+      {
+        Hash offset = 0;
+        for(int d = 0;d<dim;d++)
+        {
+          if(m>>d & 1)
+          {
+            offset += upper>>d & 1 ? P[d] : Hash(0)-P[d];
+          }
+        }
+        const int b = bucket(H[k]+offset);
+        if(!(occupied[b/64] >> (b%64) & 1))
+        {
+          continue;
+        }
+        const int end = B[b+1].load(std::memory_order_relaxed);
+        for(int l = B[b].load(std::memory_order_relaxed);l<end;l++)
+        {
+          // Each pair is considered once (buckets may also hold vertices from
+          // other cells, these simply fail the distance test)
+          if(O[l] <= i)
+          {
+            continue;
+          }
+          const double * xl = &X[size_t(l)*dim];
+          double dist2 = 0;
+          for(int d = 0;d<dim;d++)
+          {
+            dist2 += (xi[d]-xl[d])*(xi[d]-xl[d]);
+          }
+          if(dist2 <= epsilon2)
+          {
+            unite(k,l);
+          }
+        }
+      }
+    },1000);
+    // Number sets in order of their smallest index
+    SVJ.resize(n,1);
+    parallel_for(n,[&](const int k){ SVJ(O[k]) = O[find(k)]; },1000);
+    std::vector<typename DerivedSVI::Scalar> vSVI;
+    for(int i = 0;i<n;i++)
+    {
+      if(SVJ(i) == i)
+      {
+        SVJ(i) = vSVI.size();
+        vSVI.push_back(i);
+      }else
+      {
+        SVJ(i) = SVJ(SVJ(i));
+      }
+    }
+    SVI.resize(vSVI.size(),1);
+    std::copy(vSVI.begin(),vSVI.end(),SVI.data());
+    SV.resize(SVI.size(),dim);
+    parallel_for(SVI.size(),[&](const Eigen::Index s){ SV.row(s) = V.row(SVI(s)); },1000);
+  }else if(epsilon > 0)
   {
     DerivedV rV,rSV;
     round((V/(epsilon)).eval(),rV);
@@ -51,10 +283,31 @@ IGL_INLINE void igl::remove_duplicate_vertices(
   Eigen::PlainObjectBase<DerivedSVI>& SVI,
   Eigen::PlainObjectBase<DerivedSVJ>& SVJ,
   Eigen::PlainObjectBase<DerivedSF>& SF)
+{
+  remove_duplicate_vertices(
+    V,F,epsilon,REMOVE_DUPLICATE_VERTICES_METHOD_ROUND,SV,SVI,SVJ,SF);
+}
+
+template <
+  typename DerivedV, 
+  typename DerivedF,
+  typename DerivedSV, 
+  typename DerivedSVI, 
+  typename DerivedSVJ,
+  typename DerivedSF>
+IGL_INLINE void igl::remove_duplicate_vertices(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const Eigen::MatrixBase<DerivedF>& F,
+  const double epsilon,
+  const RemoveDuplicateVerticesMethod method,
+  Eigen::PlainObjectBase<DerivedSV>& SV,
+  Eigen::PlainObjectBase<DerivedSVI>& SVI,
+  Eigen::PlainObjectBase<DerivedSVJ>& SVJ,
+  Eigen::PlainObjectBase<DerivedSF>& SF)
 {
   using namespace Eigen;
   using namespace std;
-  remove_duplicate_vertices(V,epsilon,SV,SVI,SVJ);
+  remove_duplicate_vertices(V,epsilon,method,SV,SVI,SVJ);
   SF.resizeLike(F);
   for(int f = 0;f<F.rows();f++)
   {
@@ -67,6 +320,8 @@ IGL_INLINE void igl::remove_duplicate_vertices(
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
+template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, double, igl::RemoveDuplicateVerticesMethod, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&);
+template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, igl::RemoveDuplicateVerticesMethod, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 // generated by autoexplicit.sh
 template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, 2, 0, -1, 2>, Eigen::Matrix<int, -1, 2, 0, -1, 2>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 2, 0, -1, 2> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 2, 0, -1, 2> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 // generated by autoexplicit.sh
@@ -84,4 +339,6 @@ template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, -1, 0, -1
 template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 0, -1, 3> >&);
 template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 template void igl::remove_duplicate_vertices<Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 3, 1, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> >&);
+template void igl::remove_duplicate_vertices<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, igl::RemoveDuplicateVerticesMethod, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::remove_duplicate_vertices<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, double, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 #endif
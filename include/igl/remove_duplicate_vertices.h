@@ -11,6 +11,18 @@
 #include <Eigen/Dense>
 namespace igl
 {
+  enum RemoveDuplicateVerticesMethod
+  {
+    // Round V/epsilon to integers and keep unique rows (sorted
+    // lexicographically). Near duplicates on either side of a rounding
+    // boundary are not merged.
+    REMOVE_DUPLICATE_VERTICES_METHOD_ROUND = 0,
+    // Weld every pair of vertices within Euclidean distance epsilon
+    // (transitively) using a parallel spatial hash grid. Unique vertices keep
+    // the order of their first occurrence in V.
+    REMOVE_DUPLICATE_VERTICES_METHOD_WELD = 1,
+    NUM_REMOVE_DUPLICATE_VERTICES_METHODS = 2
+  };
   // REMOVE_DUPLICATE_VERTICES Remove duplicate vertices upto a uniqueness
   // tolerance (epsilon)
   //
@@ -40,6 +52,31 @@ namespace igl
     Eigen::PlainObjectBase<DerivedSV>& SV,
     Eigen::PlainObjectBase<DerivedSVI>& SVI,
     Eigen::PlainObjectBase<DerivedSVJ>& SVJ);
+  // Inputs:
+  //   V  #V by dim list of vertex positions
+  //   epsilon  uniqueness tolerance, see RemoveDuplicateVerticesMethod
+  //   method  method used to find duplicates
+  // Outputs:
+  //   SV  #SV by dim new list of vertex positions
+  //   SVI #SV by 1 list of indices so SV = V(SVI,:) 
+  //   SVJ #V by 1 list of indices so V ~ SV(SVJ,:)
+  //
+  // Example:
+  //   // Weld a triangle soup read from an STL file
+  //   igl::remove_duplicate_vertices(
+  //     V,F,1e-7,igl::REMOVE_DUPLICATE_VERTICES_METHOD_WELD,SV,SVI,SVJ,SF);
+  template <
+    typename DerivedV, 
+    typename DerivedSV, 
+    typename DerivedSVI, 
+    typename DerivedSVJ>
+  IGL_INLINE void remove_duplicate_vertices(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const double epsilon,
+    const RemoveDuplicateVerticesMethod method,
+    Eigen::PlainObjectBase<DerivedSV>& SV,
+    Eigen::PlainObjectBase<DerivedSVI>& SVI,
+    Eigen::PlainObjectBase<DerivedSVJ>& SVJ);
   // Wrapper that also remaps given faces (F) --> (SF) so that SF index SV
   template <
     typename DerivedV, 
@@ -56,6 +93,22 @@ namespace igl
     Eigen::PlainObjectBase<DerivedSVI>& SVI,
     Eigen::PlainObjectBase<DerivedSVJ>& SVJ,
     Eigen::PlainObjectBase<DerivedSF>& SF);
+  template <
+    typename DerivedV, 
+    typename DerivedF,
+    typename DerivedSV, 
+    typename DerivedSVI, 
+    typename DerivedSVJ,
+    typename DerivedSF>
+  IGL_INLINE void remove_duplicate_vertices(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const Eigen::MatrixBase<DerivedF>& F,
+    const double epsilon,
+    const RemoveDuplicateVerticesMethod method,
+    Eigen::PlainObjectBase<DerivedSV>& SV,
+    Eigen::PlainObjectBase<DerivedSVI>& SVI,
+    Eigen::PlainObjectBase<DerivedSVJ>& SVJ,
+    Eigen::PlainObjectBase<DerivedSF>& SF);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -83,27 +83,60 @@ IGL_INLINE void igl::shape_diameter_function(
   const int num_samples,
   Eigen::PlainObjectBase<DerivedS> & S)
 {
-  const auto & shoot_ray = [&aabb,&V,&F](
-    const Eigen::Vector3f& _s,
-    const Eigen::Vector3f& dir)->double
+  using namespace Eigen;
+  typedef typename DerivedV::Scalar Scalar;
+  typedef Matrix<Scalar,Dynamic,Dynamic> MatrixXS;
+  const int n = P.rows();
+  // Resize output
+  S.resize(n,1);
+  const MatrixXf D = random_dir_stratified(num_samples).cast<float>();
+  // Trace the rays of a block of points at a time with the batched
+  // AABB::intersect_ray: rays of the same point are stored consecutively so
+  // that they are traced together in coherent packets.
+  const int max_rays = 1<<16;
+  const int block_size = std::max(1,max_rays/std::max(num_samples,1));
+  MatrixXS origins,dirs,UV;
+  Matrix<Scalar,Dynamic,1> T;
+  VectorXi I;
+  for(int p0 = 0;p0<n;p0+=block_size)
   {
-    Eigen::Vector3f s = _s+1e-4*dir;
-    igl::Hit hit;
-    if(aabb.intersect_ray(
-      V,
-      F,
-      s  .cast<typename DerivedV::Scalar>().eval(),
-      dir.cast<typename DerivedV::Scalar>().eval(),
-      hit))
+    const int m = std::min(block_size,n-p0);
+    origins.resize(m*num_samples,3);
+    dirs.resize(m*num_samples,3);
+    parallel_for(m,[&](const int pi)
     {
-      return hit.t;
-    }else
+      const Vector3f origin = P.row(p0+pi).template cast<float>();
+      const Vector3f normal = N.row(p0+pi).template cast<float>();
+      for(int s = 0;s<num_samples;s++)
+      {
+        Vector3f d = D.row(s);
+        // Shoot _inward_
+        if(d.dot(normal) > 0)
+        {
+          // reverse ray
+          d *= -1;
+        }
+        const Vector3f o = origin+1e-4*d;
+        origins.row(pi*num_samples+s) = o.cast<Scalar>();
+        dirs.row(pi*num_samples+s) = d.cast<Scalar>();
+      }
+    },1000);
+    aabb.intersect_ray(V,F,origins,dirs,I,T,UV);
+    parallel_for(m,[&](const int pi)
     {
-      return std::numeric_limits<double>::infinity();
-    }
-  };
-  return shape_diameter_function(shoot_ray,P,N,num_samples,S);
-
+      int num_hits = 0;
+      double total_distance = 0;
+      for(int s = 0;s<num_samples;s++)
+      {
+        if(I(pi*num_samples+s) != -1)
+        {
+          total_distance += T(pi*num_samples+s);
+          num_hits++;
+        }
+      }
+      S(p0+pi) = total_distance/(double)num_hits;
+    },1000);
+  }
 }
 
 template <
@@ -16,68 +16,37 @@
 #include "fast_winding_number.h"
 
 
-template <
-  typename DerivedP,
-  typename DerivedV,
-  typename DerivedF,
-  typename DerivedS,
-  typename DerivedI,
-  typename DerivedC,
-  typename DerivedN>
-IGL_INLINE void igl::signed_distance(
-  const Eigen::MatrixBase<DerivedP> & P,
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::SignedDistance<DerivedV,DerivedF>::init(
   const Eigen::MatrixBase<DerivedV> & V,
-  const Eigen::MatrixBase<DerivedF> & F,
-  const SignedDistanceType sign_type,
-  const typename DerivedV::Scalar lower_bound,
-  const typename DerivedV::Scalar upper_bound,
-  Eigen::PlainObjectBase<DerivedS> & S,
-  Eigen::PlainObjectBase<DerivedI> & I,
-  Eigen::PlainObjectBase<DerivedC> & C,
-  Eigen::PlainObjectBase<DerivedN> & N)
+  const Eigen::MatrixBase<DerivedF> & F)
 {
-  using namespace Eigen;
-  using namespace std;
-
-  const int dim = V.cols();
-
   assert((V.cols() == 3||V.cols() == 2) && "V should have 3d or 2d positions");
-  assert((P.cols() == 3||P.cols() == 2) && "P should have 3d or 2d positions");
-  assert(V.cols() == P.cols() && "V should have same dimension as P");
-
-  if (sign_type == SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER){
-    assert(V.cols() == 3 && "V should be 3D for fast winding number");
-  }
-
-  // Only unsigned distance is supported for non-triangles
-  if(sign_type != SIGNED_DISTANCE_TYPE_UNSIGNED)
-  {
-    assert(F.cols() == dim && "F should have co-dimension 0 simplices");
-  }
-  typedef Eigen::Matrix<typename DerivedV::Scalar,1,3> RowVector3S;
-
+  m_V = V;
+  m_F = F;
   // Prepare distance computation
-  AABB<DerivedV,3> tree3;
-  AABB<DerivedV,2> tree2;
-  switch(dim)
+  m_tree3 = AABB<DerivedV,3>();
+  m_tree2 = AABB<DerivedV,2>();
+  switch(m_V.cols())
   {
     default:
     case 3:
-      tree3.init(V,F);
+      m_tree3.init(m_V,m_F);
       break;
     case 2:
-      tree2.init(V,F);
+      m_tree2.init(m_V,m_F);
       break;
   }
+  m_sign.reset(new SignData());
+}
 
-  // Need to be Dynamic columns to work with both 2d and 3d
-  Eigen::Matrix<typename DerivedV::Scalar,Eigen::Dynamic,Eigen::Dynamic> FN,VN,EN;
-  Eigen::Matrix<typename DerivedF::Scalar,Eigen::Dynamic,2> E;
-  Eigen::Matrix<typename DerivedF::Scalar,Eigen::Dynamic,1> EMAP;
-  WindingNumberAABB<RowVector3S,DerivedV,DerivedF> hier3;
-  igl::FastWindingNumberBVH fwn_bvh;
-  Eigen::VectorXf W;
-
+template <typename DerivedV, typename DerivedF>
+IGL_INLINE void igl::SignedDistance<DerivedV,DerivedF>::precompute(
+  const SignedDistanceType sign_type) const
+{
+  assert(m_sign && "init should be called first");
+  const int dim = m_V.cols();
+  SignData & sign = *m_sign;
   switch(sign_type)
   {
     default:
@@ -91,8 +60,11 @@ IGL_INLINE void igl::signed_distance(
       {
         default:
         case 3:
-          hier3.set_mesh(V,F);
-          hier3.grow();
+          std::call_once(sign.winding_number_flag,[&]()
+          {
+            sign.hier3.set_mesh(m_V,m_F);
+            sign.hier3.grow();
+          });
           break;
         case 2:
           // no precomp, no hierarchy
@@ -100,44 +72,90 @@ IGL_INLINE void igl::signed_distance(
       }
       break;
     case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
-      // assert above ensures dim == 3
-      igl::fast_winding_number(V.template cast<float>().eval(), F, 2, fwn_bvh);
-
+      assert(dim == 3 && "V should be 3D for fast winding number");
+      std::call_once(sign.fast_winding_number_flag,[&]()
+      {
+        igl::fast_winding_number(
+          m_V.template cast<float>().eval(), m_F, 2, sign.fwn_bvh);
+      });
+      break;
     case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
-      switch(dim)
+      std::call_once(sign.pseudonormal_flag,[&]()
       {
-        default:
-        case 3:
-          // "Signed Distance Computation Using the Angle Weighted Pseudonormal"
-          // [Bærentzen & Aanæs 2005]
-          per_face_normals(V,F,FN);
-          per_vertex_normals(V,F,PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE,FN,VN);
-          per_edge_normals(
-            V,F,PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM,FN,EN,E,EMAP);
-          break;
-        case 2:
-          FN.resize(F.rows(),2);
-          VN = DerivedV::Zero(V.rows(),2);
-          for(int e = 0;e<F.rows();e++)
-          {
-            // rotate edge vector
-            FN(e,0) =  (V(F(e,1),1)-V(F(e,0),1));
-            FN(e,1) = -(V(F(e,1),0)-V(F(e,0),0));
-            FN.row(e).normalize();
-            // add to vertex normal
-            VN.row(F(e,1)) += FN.row(e);
-            VN.row(F(e,0)) += FN.row(e);
-          }
-          // normalize to average
-          VN.rowwise().normalize();
-          break;
-      }
-      N.resize(P.rows(),dim);
+        switch(dim)
+        {
+          default:
+          case 3:
+            // "Signed Distance Computation Using the Angle Weighted
+            // Pseudonormal" [Bærentzen & Aanæs 2005]
+            per_face_normals(m_V,m_F,sign.FN);
+            per_vertex_normals(
+              m_V,m_F,PER_VERTEX_NORMALS_WEIGHTING_TYPE_ANGLE,sign.FN,sign.VN);
+            per_edge_normals(
+              m_V,m_F,PER_EDGE_NORMALS_WEIGHTING_TYPE_UNIFORM,sign.FN,sign.EN,
+              sign.E,sign.EMAP);
+            break;
+          case 2:
+            sign.FN.resize(m_F.rows(),2);
+            sign.VN = DerivedV::Zero(m_V.rows(),2);
+            for(int e = 0;e<m_F.rows();e++)
+            {
+              // rotate edge vector
+              sign.FN(e,0) =  (m_V(m_F(e,1),1)-m_V(m_F(e,0),1));
+              sign.FN(e,1) = -(m_V(m_F(e,1),0)-m_V(m_F(e,0),0));
+              sign.FN.row(e).normalize();
+              // add to vertex normal
+              sign.VN.row(m_F(e,1)) += sign.FN.row(e);
+              sign.VN.row(m_F(e,0)) += sign.FN.row(e);
+            }
+            // normalize to average
+            sign.VN.rowwise().normalize();
+            break;
+        }
+      });
       break;
   }
+}
+
+template <typename DerivedV, typename DerivedF>
+template <
+  typename DerivedP,
+  typename DerivedS,
+  typename DerivedI,
+  typename DerivedC,
+  typename DerivedN>
+IGL_INLINE void igl::SignedDistance<DerivedV,DerivedF>::signed_distance(
+  const Eigen::MatrixBase<DerivedP> & P,
+  const SignedDistanceType sign_type,
+  const Scalar lower_bound,
+  const Scalar upper_bound,
+  Eigen::PlainObjectBase<DerivedS> & S,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedC> & C,
+  Eigen::PlainObjectBase<DerivedN> & N) const
+{
+  const DerivedV & V = m_V;
+  const DerivedF & F = m_F;
+  const int dim = V.cols();
+
+  assert((P.cols() == 3||P.cols() == 2) && "P should have 3d or 2d positions");
+  assert(V.cols() == P.cols() && "V should have same dimension as P");
+
+  // Only unsigned distance is supported for non-triangles
+  if(sign_type != SIGNED_DISTANCE_TYPE_UNSIGNED)
+  {
+    assert(F.cols() == dim && "F should have co-dimension 0 simplices");
+  }
+
+  precompute(sign_type);
+  const SignData & sign = *m_sign;
+  if(sign_type == SIGNED_DISTANCE_TYPE_PSEUDONORMAL ||
+    sign_type == SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER)
+  {
+    N.resize(P.rows(),dim);
+  }
   //
   // convert to bounds on (unsiged) squared distances
-  typedef typename DerivedV::Scalar Scalar; 
   const Scalar max_abs = std::max(std::abs(lower_bound),std::abs(upper_bound));
   const Scalar up_sqr_d = std::pow(max_abs,2.0);
   const Scalar low_sqr_d = 
@@ -151,7 +169,7 @@ IGL_INLINE void igl::signed_distance(
   //for(int p = 0;p<P.rows();p++)
   {
     RowVector3S q3;
-    Eigen::Matrix<typename DerivedV::Scalar,1,2>  q2;
+    Eigen::Matrix<Scalar,1,2>  q2;
     switch(P.cols())
     {
       default:
@@ -162,15 +180,15 @@ IGL_INLINE void igl::signed_distance(
         q2 = P.row(p).head(2);
         break;
     }
-    typename DerivedV::Scalar s=1,sqrd=0;
-    Eigen::Matrix<typename DerivedV::Scalar,1,Eigen::Dynamic>  c;
-    Eigen::Matrix<typename DerivedV::Scalar,1,3> c3;
-    Eigen::Matrix<typename DerivedV::Scalar,1,2>  c2;
+    Scalar s=1,sqrd=0;
+    Eigen::Matrix<Scalar,1,Eigen::Dynamic>  c;
+    Eigen::Matrix<Scalar,1,3> c3;
+    Eigen::Matrix<Scalar,1,2>  c2;
     int i=-1;
     // in all cases compute squared unsiged distances
     sqrd = dim==3?
-      tree3.squared_distance(V,F,q3,low_sqr_d,up_sqr_d,i,c3):
-      tree2.squared_distance(V,F,q2,low_sqr_d,up_sqr_d,i,c2);
+      m_tree3.squared_distance(V,F,q3,low_sqr_d,up_sqr_d,i,c3):
+      m_tree2.squared_distance(V,F,q2,low_sqr_d,up_sqr_d,i,c2);
     if(sqrd >= up_sqr_d || sqrd < low_sqr_d)
     {
       // Out of bounds gets a nan (nans on grids can be flood filled later using
@@ -190,14 +208,13 @@ IGL_INLINE void igl::signed_distance(
         case SIGNED_DISTANCE_TYPE_DEFAULT:
         case SIGNED_DISTANCE_TYPE_WINDING_NUMBER:
         {
-          Scalar w = 0;
           if(dim == 3)
           {
-            s = 1.-2.*hier3.winding_number(q3.transpose());
+            s = 1.-2.*sign.hier3.winding_number(q3.transpose());
           }else
           {
-            assert(!V.derived().IsRowMajor);
-            assert(!F.derived().IsRowMajor);
+            assert(!V.IsRowMajor);
+            assert(!F.IsRowMajor);
             s = 1.-2.*winding_number(V,F,q2);
           }
           break;
@@ -205,7 +222,8 @@ IGL_INLINE void igl::signed_distance(
         case SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER:
         {
           //assert above ensured 3D
-          Scalar w = fast_winding_number(fwn_bvh, 2, q3.template cast<float>().eval());         
+          Scalar w = fast_winding_number(
+            sign.fwn_bvh, 2, q3.template cast<float>().eval());
           s = 1.-2.*std::abs(w);  
 
           break;
@@ -213,12 +231,13 @@ IGL_INLINE void igl::signed_distance(
         case SIGNED_DISTANCE_TYPE_PSEUDONORMAL:
         {
           RowVector3S n3;
-          Eigen::Matrix<typename DerivedV::Scalar,1,2>  n2;
+          Eigen::Matrix<Scalar,1,2>  n2;
           dim==3 ?
-            pseudonormal_test(V,F,FN,VN,EN,EMAP,q3,i,c3,s,n3):
+            pseudonormal_test(
+              V,F,sign.FN,sign.VN,sign.EN,sign.EMAP,q3,i,c3,s,n3):
             // This should use (V,F,FN), not (V,E,EN) since E is auxiliary for
             // 3D case, not the input "F"acets.
-            pseudonormal_test(V,F,FN,VN,q2,i,c2,s,n2);
+            pseudonormal_test(V,F,sign.FN,sign.VN,q2,i,c2,s,n2);
           Eigen::Matrix<typename DerivedN::Scalar,1,Eigen::Dynamic>  n;
           (dim==3 ? n = n3.template cast<typename DerivedN::Scalar>() : n = n2.template cast<typename DerivedN::Scalar>());
           N.row(p) = n.template cast<typename DerivedN::Scalar>();
@@ -233,6 +252,50 @@ IGL_INLINE void igl::signed_distance(
   ,10000);
 }
 
+template <typename DerivedV, typename DerivedF>
+template <
+  typename DerivedP,
+  typename DerivedS,
+  typename DerivedI,
+  typename DerivedC,
+  typename DerivedN>
+IGL_INLINE void igl::SignedDistance<DerivedV,DerivedF>::signed_distance(
+  const Eigen::MatrixBase<DerivedP> & P,
+  const SignedDistanceType sign_type,
+  Eigen::PlainObjectBase<DerivedS> & S,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedC> & C,
+  Eigen::PlainObjectBase<DerivedN> & N) const
+{
+  Scalar lower = std::numeric_limits<Scalar>::min();
+  Scalar upper = std::numeric_limits<Scalar>::max();
+  return signed_distance(P,sign_type,lower,upper,S,I,C,N);
+}
+
+template <
+  typename DerivedP,
+  typename DerivedV,
+  typename DerivedF,
+  typename DerivedS,
+  typename DerivedI,
+  typename DerivedC,
+  typename DerivedN>
+IGL_INLINE void igl::signed_distance(
+  const Eigen::MatrixBase<DerivedP> & P,
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedF> & F,
+  const SignedDistanceType sign_type,
+  const typename DerivedV::Scalar lower_bound,
+  const typename DerivedV::Scalar upper_bound,
+  Eigen::PlainObjectBase<DerivedS> & S,
+  Eigen::PlainObjectBase<DerivedI> & I,
+  Eigen::PlainObjectBase<DerivedC> & C,
+  Eigen::PlainObjectBase<DerivedN> & N)
+{
+  const SignedDistance<DerivedV,DerivedF> engine(V,F);
+  engine.signed_distance(P,sign_type,lower_bound,upper_bound,S,I,C,N);
+}
+
 template <
   typename DerivedP,
   typename DerivedV,
@@ -520,6 +583,9 @@ IGL_INLINE typename DerivedV::Scalar igl::signed_distance_fast_winding_number(
 
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
+template class igl::SignedDistance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >;
+template void igl::SignedDistance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >::signed_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, igl::SignedDistanceType, double, double, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
+template void igl::SignedDistance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >::signed_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, igl::SignedDistanceType, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&) const;
 // generated by autoexplicit.sh
 template void igl::signed_distance<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, 3, 1, -1, 3>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, 3, 0, -1, 3>, Eigen::Matrix<double, -1, 3, 0, -1, 3> >(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 3, 1, -1, 3> > const&, igl::SignedDistanceType, Eigen::Matrix<double, -1, 3, 1, -1, 3>::Scalar, Eigen::Matrix<double, -1, 3, 1, -1, 3>::Scalar, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 3, 0, -1, 3> >&);
 // generated by autoexplicit.sh
@@ -13,6 +13,8 @@
 #include "WindingNumberAABB.h"
 #include "fast_winding_number.h"
 #include <Eigen/Core>
+#include <memory>
+#include <mutex>
 #include <vector>
 namespace igl
 {
@@ -312,6 +314,119 @@ namespace igl
     const AABB<DerivedV,3> & tree,
     const igl::FastWindingNumberBVH & fwn_bvh
   );
+
+  // Signed distance query engine for a fixed mesh. The AABB tree is built once
+  // by init and the structures needed to determine the sign (winding number
+  // hierarchy, fast winding number BVH or pseudonormals) are built the first
+  // time a sign_type needs them, so repeated queries only pay for the queries.
+  // Queries are const and may be called concurrently from multiple threads.
+  //
+  // Templates:
+  //   DerivedV  type of vertex positions (e.g., Eigen::MatrixXd)
+  //   DerivedF  type of facet indices (e.g., Eigen::MatrixXi)
+  //
+  // Example:
+  //   igl::SignedDistance<Eigen::MatrixXd,Eigen::MatrixXi> sd(V,F);
+  //   for(...)
+  //   {
+  //     sd.signed_distance(P,igl::SIGNED_DISTANCE_TYPE_WINDING_NUMBER,S,I,C,N);
+  //   }
+  template <typename DerivedV, typename DerivedF>
+  class SignedDistance
+  {
+    public:
+      typedef typename DerivedV::Scalar Scalar;
+      SignedDistance(){}
+      // Inputs:
+      //   V  #V by 3|2 list of vertex positions
+      //   F  #F by ss list of triangle (or edge if 2d) indices
+      SignedDistance(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedF> & F)
+      {
+        init(V,F);
+      }
+      // Copy mesh and build AABB tree, discarding any previously built
+      // structures
+      //
+      // Inputs:
+      //   V  #V by 3|2 list of vertex positions
+      //   F  #F by ss list of triangle (or edge if 2d) indices, ss should be
+      //     equal to V.cols() unless only SIGNED_DISTANCE_TYPE_UNSIGNED is used
+      IGL_INLINE void init(
+        const Eigen::MatrixBase<DerivedV> & V,
+        const Eigen::MatrixBase<DerivedF> & F);
+      // Build the structures needed by sign_type now rather than during the
+      // first query using it
+      //
+      // Inputs:
+      //   sign_type  method for computing distance _sign_
+      IGL_INLINE void precompute(const SignedDistanceType sign_type) const;
+      // Computes signed distance to the mesh. See igl::signed_distance above.
+      //
+      // Inputs:
+      //   P  #P by 3|2 list of query point positions
+      //   sign_type  method for computing distance _sign_ S
+      //   lower_bound  lower bound of distances needed
+      //   upper_bound  lower bound of distances needed
+      // Outputs:
+      //   S  #P list of smallest signed distances
+      //   I  #P list of facet indices corresponding to smallest distances
+      //   C  #P by 3|2 list of closest points
+      //   N  #P by 3|2 list of closest normals (only set if
+      //     sign_type=SIGNED_DISTANCE_TYPE_PSEUDONORMAL)
+      template <
+        typename DerivedP,
+        typename DerivedS,
+        typename DerivedI,
+        typename DerivedC,
+        typename DerivedN>
+      IGL_INLINE void signed_distance(
+        const Eigen::MatrixBase<DerivedP> & P,
+        const SignedDistanceType sign_type,
+        const Scalar lower_bound,
+        const Scalar upper_bound,
+        Eigen::PlainObjectBase<DerivedS> & S,
+        Eigen::PlainObjectBase<DerivedI> & I,
+        Eigen::PlainObjectBase<DerivedC> & C,
+        Eigen::PlainObjectBase<DerivedN> & N) const;
+      // Computes signed distance to the mesh, with default bounds
+      template <
+        typename DerivedP,
+        typename DerivedS,
+        typename DerivedI,
+        typename DerivedC,
+        typename DerivedN>
+      IGL_INLINE void signed_distance(
+        const Eigen::MatrixBase<DerivedP> & P,
+        const SignedDistanceType sign_type,
+        Eigen::PlainObjectBase<DerivedS> & S,
+        Eigen::PlainObjectBase<DerivedI> & I,
+        Eigen::PlainObjectBase<DerivedC> & C,
+        Eigen::PlainObjectBase<DerivedN> & N) const;
+      const DerivedV & V() const { return m_V; }
+      const DerivedF & F() const { return m_F; }
+    private:
+      typedef Eigen::Matrix<Scalar,1,3> RowVector3S;
+      // Structures for determining the sign, each built at most once
+      struct SignData
+      {
+        std::once_flag winding_number_flag;
+        std::once_flag fast_winding_number_flag;
+        std::once_flag pseudonormal_flag;
+        WindingNumberAABB<RowVector3S,DerivedV,DerivedF> hier3;
+        igl::FastWindingNumberBVH fwn_bvh;
+        // Need to be Dynamic columns to work with both 2d and 3d
+        Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic> FN,VN,EN;
+        Eigen::Matrix<typename DerivedF::Scalar,Eigen::Dynamic,2> E;
+        Eigen::Matrix<typename DerivedF::Scalar,Eigen::Dynamic,1> EMAP;
+      };
+      DerivedV m_V;
+      DerivedF m_F;
+      AABB<DerivedV,3> m_tree3;
+      AABB<DerivedV,2> m_tree2;
+      std::unique_ptr<SignData> m_sign;
+  };
 }
 
 #ifndef IGL_STATIC_LIBRARY
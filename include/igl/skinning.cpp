@@ -0,0 +1,164 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#include "skinning.h"
+#include "parallel_for.h"
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+#include <algorithm>
+#include <cassert>
+
+template <typename DerivedV, typename DerivedW, typename Scalar>
+IGL_INLINE void igl::skinning_precompute(
+  const Eigen::MatrixBase<DerivedV> & V,
+  const Eigen::MatrixBase<DerivedW> & W,
+  const int k,
+  SkinningData<Scalar> & data)
+{
+  assert(V.cols() == 3 && "Only 3D embeddings allowed");
+  assert(V.rows() == W.rows());
+  assert(W.cols() > 0 && "At least one handle required");
+  const int n = V.rows();
+  data.m = W.cols();
+  data.k = std::max(std::min(k,data.m),1);
+  data.V = V.template cast<Scalar>();
+  data.I.setZero(n,data.k);
+  data.W.setZero(n,data.k);
+  // Per-thread list of handle indices to partially sort
+  std::vector<std::vector<int> > J;
+  igl::parallel_for(
+    n,
+    [&](const size_t nt){ J.resize(nt,std::vector<int>(data.m)); },
+    [&](const int i, const size_t t)
+    {
+      std::vector<int> & Jt = J[t];
+      for(int c = 0;c<data.m;c++) { Jt[c] = c; }
+      // Largest weights first (ties broken by handle index)
+      std::partial_sort(Jt.begin(),Jt.begin()+data.k,Jt.end(),
+        [&](const int a, const int b)
+        { return W(i,a) > W(i,b) || (W(i,a) == W(i,b) && a < b); });
+      typename DerivedW::Scalar kept = 0;
+      for(int j = 0;j<data.k;j++)
+      {
+        data.I(i,j) = Jt[j];
+        kept += W(i,Jt[j]);
+      }
+      const typename DerivedW::Scalar all = W.row(i).sum();
+      const typename DerivedW::Scalar scale = kept == 0 ? 1 : all/kept;
+      for(int j = 0;j<data.k;j++)
+      {
+        data.W(i,j) = Scalar(scale*W(i,Jt[j]));
+      }
+    },
+    [](const size_t){},
+    1000);
+}
+
+template <typename Scalar, typename DerivedT, typename DerivedU>
+IGL_INLINE void igl::skinning_lbs(
+  const SkinningData<Scalar> & data,
+  const Eigen::MatrixBase<DerivedT> & T,
+  Eigen::PlainObjectBase<DerivedU> & U)
+{
+  typedef Eigen::Matrix<Scalar,4,4> Matrix4S;
+  typedef Eigen::Matrix<Scalar,4,1> Vector4S;
+  assert(T.rows() == 4*data.m);
+  assert(T.cols() == 3);
+  // Transformation of each handle padded to 4×4 so that blending and applying
+  // are whole packet operations
+  std::vector<Matrix4S,Eigen::aligned_allocator<Matrix4S> > A(data.m);
+  for(int c = 0;c<data.m;c++)
+  {
+    A[c].setZero();
+    A[c].template topRows<3>() =
+      T.template block<4,3>(4*c,0).transpose().template cast<Scalar>();
+  }
+  const int n = data.V.rows();
+  const int k = data.k;
+  U.resize(n,3);
+  igl::parallel_for(n,[&](const int i)
+  {
+    const int * Ii = data.I.data()+i*k;
+    const Scalar * Wi = data.W.data()+i*k;
+    // Blend transformations then apply once
+    Matrix4S M = Wi[0]*A[Ii[0]];
+    for(int j = 1;j<k;j++)
+    {
+      M.noalias() += Wi[j]*A[Ii[j]];
+    }
+    const Vector4S v(data.V(i,0),data.V(i,1),data.V(i,2),1);
+    const Vector4S u = M*v;
+    U.row(i) =
+      u.template head<3>().transpose().template cast<typename DerivedU::Scalar>();
+  },1000);
+}
+
+template <
+  typename Scalar,
+  typename Q,
+  typename QAlloc,
+  typename T,
+  typename DerivedU>
+IGL_INLINE void igl::skinning_dqs(
+  const SkinningData<Scalar> & data,
+  const std::vector<Q,QAlloc> & vQ,
+  const std::vector<T> & vT,
+  Eigen::PlainObjectBase<DerivedU> & U)
+{
+  typedef Eigen::Matrix<Scalar,8,1> Vector8S;
+  typedef Eigen::Matrix<Scalar,3,1> Vector3S;
+  assert(data.m == (int)vQ.size());
+  assert(data.m == (int)vT.size());
+  // Dual quaternion of each handle: real part coefficients (x,y,z,w) followed
+  // by dual part coefficients
+  std::vector<Vector8S,Eigen::aligned_allocator<Vector8S> > QD(data.m);
+  for(int c = 0;c<data.m;c++)
+  {
+    const Q & q = vQ[c];
+    const T & t = vT[c];
+    QD[c] <<
+      q.x(), q.y(), q.z(), q.w(),
+       0.5*( t(0)*q.w() + t(1)*q.z() - t(2)*q.y()),
+       0.5*(-t(0)*q.z() + t(1)*q.w() + t(2)*q.x()),
+       0.5*( t(0)*q.y() - t(1)*q.x() + t(2)*q.w()),
+      -0.5*( t(0)*q.x() + t(1)*q.y() + t(2)*q.z());
+  }
+  const int n = data.V.rows();
+  const int k = data.k;
+  U.resize(n,3);
+  igl::parallel_for(n,[&](const int i)
+  {
+    const int * Ii = data.I.data()+i*k;
+    const Scalar * Wi = data.W.data()+i*k;
+    Vector8S b = Wi[0]*QD[Ii[0]];
+    for(int j = 1;j<k;j++)
+    {
+      b.noalias() += Wi[j]*QD[Ii[j]];
+    }
+    b *= Scalar(1)/b.template head<4>().norm();
+    // See algorithm 1 in "Geometric skinning with approximate dual quaternion
+    // blending" by Kavan et al
+    const Vector3S v = data.V.row(i).transpose();
+    const Vector3S d0 = b.template segment<3>(0);
+    const Vector3S de = b.template segment<3>(4);
+    const Scalar a0 = b(3);
+    const Scalar ae = b(7);
+    const Vector3S u =
+      v + 2*d0.cross(d0.cross(v) + a0*v) + 2*(a0*de - ae*d0 + d0.cross(de));
+    U.row(i) = u.transpose().template cast<typename DerivedU::Scalar>();
+  },1000);
+}
+
+#ifdef IGL_STATIC_LIBRARY
+// Explicit template instantiation
+template void igl::skinning_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, igl::SkinningData<double>&);
+template void igl::skinning_precompute<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, float>(Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, int, igl::SkinningData<float>&);
+template void igl::skinning_lbs<double, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::SkinningData<double> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::skinning_lbs<float, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, 3, 1, -1, 3> >(igl::SkinningData<float> const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> >&);
+template void igl::skinning_dqs<double, Eigen::Quaternion<double, 0>, Eigen::aligned_allocator<Eigen::Quaternion<double, 0> >, Eigen::Matrix<double, 3, 1, 0, 3, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(igl::SkinningData<double> const&, std::vector<Eigen::Quaternion<double, 0>, Eigen::aligned_allocator<Eigen::Quaternion<double, 0> > > const&, std::vector<Eigen::Matrix<double, 3, 1, 0, 3, 1>, std::allocator<Eigen::Matrix<double, 3, 1, 0, 3, 1> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&);
+template void igl::skinning_dqs<float, Eigen::Quaternion<double, 0>, Eigen::aligned_allocator<Eigen::Quaternion<double, 0> >, Eigen::Matrix<double, 3, 1, 0, 3, 1>, Eigen::Matrix<float, -1, 3, 1, -1, 3> >(igl::SkinningData<float> const&, std::vector<Eigen::Quaternion<double, 0>, Eigen::aligned_allocator<Eigen::Quaternion<double, 0> > > const&, std::vector<Eigen::Matrix<double, 3, 1, 0, 3, 1>, std::allocator<Eigen::Matrix<double, 3, 1, 0, 3, 1> > > const&, Eigen::PlainObjectBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> >&);
+#endif
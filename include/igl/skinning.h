@@ -0,0 +1,89 @@
+// This file is part of libigl, a simple c++ geometry processing library.
+//
+// Copyright (C) 2026 Alec Jacobson <alecjacobson@gmail.com>
+//
+// This Source Code Form is subject to the terms of the Mozilla Public License
+// v. 2.0. If a copy of the MPL was not distributed with this file, You can
+// obtain one at http://mozilla.org/MPL/2.0/.
+#ifndef IGL_SKINNING_H
+#define IGL_SKINNING_H
+#include "igl_inline.h"
+#include <Eigen/Core>
+#include <vector>
+namespace igl
+{
+  // Compact per-vertex influence table for repeatedly evaluating linear blend
+  // skinning and dual quaternion skinning of the same mesh and weights. Use
+  // Scalar=float for output that can be uploaded directly to the GPU.
+  template <typename Scalar>
+  struct SkinningData
+  {
+    // Number of influences per vertex
+    int k = 0;
+    // Number of handles
+    int m = 0;
+    // #V by 3 list of rest positions
+    Eigen::Matrix<Scalar,Eigen::Dynamic,3,Eigen::RowMajor> V;
+    // #V by k list of handle indices of each vertex's k largest weights
+    Eigen::Matrix<int,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> I;
+    // #V by k list of corresponding weights (0 for padding)
+    Eigen::Matrix<Scalar,Eigen::Dynamic,Eigen::Dynamic,Eigen::RowMajor> W;
+  };
+  // Precompute the influence table: keep each vertex's k largest weights,
+  // rescaled so that they have the same sum as the full row of W.
+  //
+  // Inputs:
+  //   V  #V by 3 list of rest positions
+  //   W  #V by #handles list of weights (#handles > 0)
+  //   k  maximum number of influences per vertex (e.g., 4 or 8)
+  // Outputs:
+  //   data  precomputation data (see skinning_lbs, skinning_dqs)
+  template <typename DerivedV, typename DerivedW, typename Scalar>
+  IGL_INLINE void skinning_precompute(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedW> & W,
+    const int k,
+    SkinningData<Scalar> & data);
+  // Linear blend skinning using precomputed influences. Equivalent to
+  //
+  //     U = M*T
+  //
+  // with M from lbs_matrix(V,W,M) if no vertex has more than k nonzero
+  // weights.
+  //
+  // Inputs:
+  //   data  precomputation data (see skinning_precompute)
+  //   T  #handles*4 by 3 stack of transposed transformation matrices
+  // Outputs:
+  //   U  #V by 3 list of new positions
+  template <typename Scalar, typename DerivedT, typename DerivedU>
+  IGL_INLINE void skinning_lbs(
+    const SkinningData<Scalar> & data,
+    const Eigen::MatrixBase<DerivedT> & T,
+    Eigen::PlainObjectBase<DerivedU> & U);
+  // Dual quaternion skinning using precomputed influences. Equivalent to
+  // dqs(V,W,vQ,vT,U) if no vertex has more than k nonzero weights.
+  //
+  // Inputs:
+  //   data  precomputation data (see skinning_precompute)
+  //   vQ  #handles list of rotation quaternions
+  //   vT  #handles list of translation vectors
+  // Outputs:
+  //   U  #V by 3 list of new positions
+  template <
+    typename Scalar,
+    typename Q,
+    typename QAlloc,
+    typename T,
+    typename DerivedU>
+  IGL_INLINE void skinning_dqs(
+    const SkinningData<Scalar> & data,
+    const std::vector<Q,QAlloc> & vQ,
+    const std::vector<T> & vT,
+    Eigen::PlainObjectBase<DerivedU> & U);
+}
+
+#ifndef IGL_STATIC_LIBRARY
+#  include "skinning.cpp"
+#endif
+#endif
@@ -44,6 +44,47 @@
 #include <Eigen/CholmodSupport>
 #endif
 
+struct igl::SLIMData::Solver
+{
+#ifndef CHOLMOD
+  Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > ldlt;
+#else
+  Eigen::CholmodSimplicialLDLT<Eigen::SparseMatrix<double> > ldlt;
+#endif
+  // Size and number of non-zeros of the analyzed matrix (-1 if none)
+  Eigen::Index rows = -1;
+  Eigen::Index nnz = -1;
+};
+
+IGL_INLINE igl::SLIMData::SolverPtr::SolverPtr() {}
+
+IGL_INLINE igl::SLIMData::SolverPtr::SolverPtr(const SolverPtr &) {}
+
+IGL_INLINE igl::SLIMData::SolverPtr::SolverPtr(SolverPtr && that):
+  ptr(std::move(that.ptr)) {}
+
+IGL_INLINE igl::SLIMData::SolverPtr &
+igl::SLIMData::SolverPtr::operator=(const SolverPtr & that)
+{
+  if (this != &that)
+    ptr.reset();
+  return *this;
+}
+
+IGL_INLINE igl::SLIMData::SolverPtr &
+igl::SLIMData::SolverPtr::operator=(SolverPtr && that)
+{
+  ptr = std::move(that.ptr);
+  return *this;
+}
+
+IGL_INLINE igl::SLIMData::SolverPtr::~SolverPtr() {}
+
+IGL_INLINE void igl::SLIMData::SolverPtr::reset()
+{
+  ptr.reset();
+}
+
 namespace igl
 {
   namespace slim
@@ -122,24 +163,37 @@ namespace igl
       // solve
       Eigen::VectorXd Uc;
 #ifndef CHOLMOD
-      if (s.dim == 2)
+      // seems like CG performs much worse for 2D and way better for 3D
+      const bool use_cg = s.dim == 3 || s.iterative_solve;
+#else
+      const bool use_cg = s.iterative_solve;
+#endif
+      bool solved = false;
+      if (use_cg)
       {
-        SimplicialLDLT<Eigen::SparseMatrix<double> > solver;
-        Uc = solver.compute(L).solve(s.rhs);
-      }
-      else
-      { // seems like CG performs much worse for 2D and way better for 3D
         Eigen::VectorXd guess(uv.rows() * s.dim);
         for (int i = 0; i < s.v_num; i++) for (int j = 0; j < s.dim; j++) guess(uv.rows() * j + i) = uv(i, j); // flatten vector
         ConjugateGradient<Eigen::SparseMatrix<double>, Lower | Upper> cg;
         cg.setTolerance(1e-8);
         cg.compute(L);
         Uc = cg.solveWithGuess(s.rhs, guess);
+        // Fall back to factorizing if the warm-started solve did not converge
+        solved = cg.info() == Eigen::Success || !s.iterative_solve;
+      }
+      if (!solved)
+      {
+        if (!s.solver.ptr)
+          s.solver.ptr.reset(new igl::SLIMData::Solver());
+        igl::SLIMData::Solver & solver = *s.solver.ptr;
+        if (solver.rows != L.rows() || solver.nnz != L.nonZeros())
+        {
+          solver.ldlt.analyzePattern(L);
+          solver.rows = L.rows();
+          solver.nnz = L.nonZeros();
+        }
+        solver.ldlt.factorize(L);
+        Uc = solver.ldlt.solve(s.rhs);
       }
-#else
-        CholmodSimplicialLDLT<Eigen::SparseMatrix<double> > solver;
-        Uc = solver.compute(L).solve(s.rhs);
-#endif
       for (int i = 0; i < s.dim; i++)
         uv.col(i) = Uc.block(i * s.v_n, 0, s.v_n, 1);
 
@@ -780,6 +834,8 @@ IGL_INLINE void igl::slim_precompute(
   assert (F.cols() == 3 || F.cols() == 4);
 
   igl::slim::pre_calc(data);
+  data.solver.reset();
+  data.iterative_solve = false;
   data.energy = igl::slim::compute_energy(data,data.V_o) / data.mesh_area;
 }
 
@@ -801,6 +857,9 @@ IGL_INLINE Eigen::MatrixXd igl::slim_solve(igl::SLIMData &data, int iter_num)
 
     data.energy = igl::flip_avoiding_line_search(data.F, data.V_o, dest_res, compute_energy,
                                                  data.energy * data.mesh_area) / data.mesh_area;
+
+    if (old_energy - data.energy < data.iterative_switch_tolerance * old_energy)
+      data.iterative_solve = true;
   }
   return data.V_o;
 }
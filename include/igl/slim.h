@@ -12,6 +12,7 @@
 #include "MappingEnergyType.h"
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <memory>
 
 // This option makes the iterations faster (all except the first) by caching the 
 // sparsity pattern of the matrix involved in the assembly. It should be on if you plan to do many iterations, off if you have to change the matrix structure at every iteration.
@@ -40,6 +41,10 @@ struct SLIMData
 
   double exp_factor; // used for exponential energies, ignored otherwise
   bool mesh_improvement_3d; // only supported for 3d
+  // Once an iteration decreases the energy by less than this fraction, solve
+  // the 2d linear systems by conjugate gradient warm-started at the current
+  // map instead of refactorizing (0: always factorize)
+  double iterative_switch_tolerance = 0;
 
   // Output
   Eigen::MatrixXd V_o; // #V by dim list of mesh vertex positions (dim = 2 for parametrization, 3 otherwise)
@@ -62,6 +67,24 @@ struct SLIMData
   bool first_solve;
   bool has_pre_calc = false;
   int dim;
+  // Linear solver kept across iterations: the sparsity pattern of the system
+  // matrix never changes so its symbolic factorization is computed once.
+  // Copies never share it: a copy starts without a solver and re-analyzes on
+  // its first solve
+  struct Solver;
+  struct SolverPtr
+  {
+    IGL_INLINE SolverPtr();
+    IGL_INLINE SolverPtr(const SolverPtr &);
+    IGL_INLINE SolverPtr(SolverPtr &&);
+    IGL_INLINE SolverPtr & operator=(const SolverPtr &);
+    IGL_INLINE SolverPtr & operator=(SolverPtr &&);
+    IGL_INLINE ~SolverPtr();
+    // Drop the factorization so that the next solve analyzes from scratch
+    IGL_INLINE void reset();
+    std::unique_ptr<Solver> ptr;
+  } solver;
+  bool iterative_solve = false;
 
   #ifdef SLIM_CACHED
   Eigen::SparseMatrix<double> A;
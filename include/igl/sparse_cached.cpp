@@ -6,6 +6,7 @@
 // v. 2.0. If a copy of the MPL was not distributed with this file, You can
 // obtain one at http://mozilla.org/MPL/2.0/.
 #include "sparse_cached.h"
+#include "parallel_for.h"
 
 #include <iostream>
 #include <vector>
@@ -13,6 +14,7 @@
 #include <unordered_map>
 #include <map>
 #include <utility>
+#include <algorithm>
 
 template <typename DerivedI, typename Scalar>
 IGL_INLINE void igl::sparse_cached_precompute(
@@ -115,6 +117,88 @@ IGL_INLINE void igl::sparse_cached(
     *(X.valuePtr() + data[i]) += V[i];
 }
 
+template <typename DerivedI, typename DerivedJ, typename Scalar>
+IGL_INLINE void igl::sparse_cached_precompute(
+  const Eigen::MatrixBase<DerivedI> & I,
+  const Eigen::MatrixBase<DerivedJ> & J,
+  const int m,
+  const int n,
+  sparse_cached_data & data,
+  Eigen::SparseMatrix<Scalar>& X)
+{
+  assert(I.size() == J.size());
+  const int nv = I.size();
+  // Bucket contributions by column (stable counting sort)
+  std::vector<int> col_start(n+1,0);
+  for(int k = 0;k<nv;k++)
+  {
+    assert(I(k) >= 0 && I(k) < m);
+    assert(J(k) >= 0 && J(k) < n);
+    col_start[J(k)+1]++;
+  }
+  for(int j = 0;j<n;j++) { col_start[j+1] += col_start[j]; }
+  data.I_v.resize(nv);
+  {
+    std::vector<int> next(col_start.begin(),col_start.end()-1);
+    for(int k = 0;k<nv;k++) { data.I_v[next[J(k)]++] = k; }
+  }
+  // Sort each column by row (stably so contributions stay in input order)
+  // and count its distinct rows
+  std::vector<int> outer(n+1,0);
+  igl::parallel_for(n,[&](const int j)
+  {
+    const auto begin = data.I_v.begin()+col_start[j];
+    const auto end = data.I_v.begin()+col_start[j+1];
+    std::stable_sort(begin,end,[&I](const int a, const int b){ return I(a)<I(b); });
+    for(auto c = begin;c != end;c++)
+    {
+      if(c == begin || I(*c) != I(*(c-1))) { outer[j+1]++; }
+    }
+  },1000);
+  for(int j = 0;j<n;j++) { outer[j+1] += outer[j]; }
+  const int nnz = outer[n];
+  X.resize(m,n);
+  X.makeCompressed();
+  X.resizeNonZeros(nnz);
+  std::copy(outer.begin(),outer.end(),X.outerIndexPtr());
+  data.I_outer.resize(nnz+1);
+  igl::parallel_for(n,[&](const int j)
+  {
+    int s = outer[j];
+    for(int c = col_start[j];c<col_start[j+1];c++)
+    {
+      if(c == col_start[j] || I(data.I_v[c]) != I(data.I_v[c-1]))
+      {
+        X.innerIndexPtr()[s] = I(data.I_v[c]);
+        X.valuePtr()[s] = 0;
+        data.I_outer[s] = c;
+        s++;
+      }
+    }
+  },1000);
+  data.I_outer[nnz] = nv;
+}
+
+template <typename DerivedV, typename Scalar>
+IGL_INLINE void igl::sparse_cached(
+  const Eigen::MatrixBase<DerivedV>& V,
+  const sparse_cached_data & data,
+  Eigen::SparseMatrix<Scalar>& X)
+{
+  assert((Eigen::Index)data.I_outer.size() == X.nonZeros()+1);
+  assert((Eigen::Index)data.I_v.size() == V.size());
+  Scalar * values = X.valuePtr();
+  igl::parallel_for(X.nonZeros(),[&](const int s)
+  {
+    // First value is assigned, rest are added (like setFromTriplets)
+    Scalar v = V(data.I_v[data.I_outer[s]]);
+    for(int c = data.I_outer[s]+1;c<data.I_outer[s+1];c++)
+    {
+      v += V(data.I_v[c]);
+    }
+    values[s] = v;
+  },10000);
+}
 
 #ifdef IGL_STATIC_LIBRARY
 #if EIGEN_VERSION_AT_LEAST(3,3,0)
@@ -124,4 +208,6 @@ IGL_INLINE void igl::sparse_cached(
   template void igl::sparse_cached<double>(std::vector<Eigen::Triplet<double, Eigen::SparseMatrix<double, 0, int>::Index>, std::allocator<Eigen::Triplet<double, Eigen::SparseMatrix<double, 0, int>::Index> > > const&, Eigen::Matrix<int, -1, 1, 0, -1, 1> const&, Eigen::SparseMatrix<double, 0, int>&);
   template void igl::sparse_cached_precompute<double>(std::vector<Eigen::Triplet<double, Eigen::SparseMatrix<double, 0, int>::Index>, std::allocator<Eigen::Triplet<double, Eigen::SparseMatrix<double, 0, int>::Index> > > const&, Eigen::Matrix<int, -1, 1, 0, -1, 1>&, Eigen::SparseMatrix<double, 0, int>&);
 #endif
+template void igl::sparse_cached_precompute<Eigen::Matrix<int, -1, 1, 0, -1, 1>, Eigen::Matrix<int, -1, 1, 0, -1, 1>, double>(Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, 1, 0, -1, 1> > const&, int, int, igl::sparse_cached_data&, Eigen::SparseMatrix<double, 0, int>&);
+template void igl::sparse_cached<Eigen::Matrix<double, -1, 1, 0, -1, 1>, double>(Eigen::MatrixBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> > const&, igl::sparse_cached_data const&, Eigen::SparseMatrix<double, 0, int>&);
 #endif
@@ -11,6 +11,7 @@
 #define EIGEN_YES_I_KNOW_SPARSE_MODULE_IS_NOT_STABLE_YET
 #include <Eigen/Dense>
 #include <Eigen/Sparse>
+#include <vector>
 namespace igl
 {
   // Build a sparse matrix from list of indices and values (I,J,V), similarly to 
@@ -75,7 +76,61 @@ namespace igl
     const Eigen::VectorXi& data,
     Eigen::SparseMatrix<Scalar>& X
     );
-  
+
+  // Precomputed assembly of a sparse matrix from a fixed list of indices
+  // (I,J): the contributions of V to each non-zero of X are grouped together
+  // so that values can be (re)assembled in parallel and without conflicts.
+  struct sparse_cached_data
+  {
+    // For each non-zero of X, points to the beginning of its contributions
+    // in I_v (nnz+1 entries)
+    std::vector<int> I_outer;
+    // Flattened lists of indices into V (I,J) of contributions to each
+    // non-zero of X, in increasing order
+    std::vector<int> I_v;
+  };
+
+  // Compute the sparsity pattern of X directly from the index lists (without
+  // forming triplets). X is compressed and its values are set to zero.
+  //
+  // Inputs:
+  //   I  nnz vector of row indices of non zeros entries in X
+  //   J  nnz vector of column indices of non zeros entries in X
+  //   m  number of rows
+  //   n  number of cols
+  // Outputs:
+  //   data  precomputed assembly
+  //   X  m by n matrix with sparsity pattern of (I,J)
+  //
+  // Example:
+  //   igl::sparse_cached_data data;
+  //   Eigen::SparseMatrix<double> X;
+  //   igl::sparse_cached_precompute(I,J,m,n,data,X);
+  //   // whenever V changes
+  //   igl::sparse_cached(V,data,X);
+  template <typename DerivedI, typename DerivedJ, typename Scalar>
+  IGL_INLINE void sparse_cached_precompute(
+    const Eigen::MatrixBase<DerivedI> & I,
+    const Eigen::MatrixBase<DerivedJ> & J,
+    const int m,
+    const int n,
+    sparse_cached_data & data,
+    Eigen::SparseMatrix<Scalar>& X);
+  // Set the values of X in parallel. Duplicates are summed in the same order
+  // as Eigen's setFromTriplets so that the result is bit-identical to
+  // igl::sparse(I,J,V,m,n,X).
+  //
+  // Inputs:
+  //   V  nnz vector of values (in the order of I,J)
+  //   data  precomputed assembly for (I,J)
+  //   X  m by n matrix output of sparse_cached_precompute with the same data
+  // Outputs:
+  //   X  m by n matrix with updated values
+  template <typename DerivedV, typename Scalar>
+  IGL_INLINE void sparse_cached(
+    const Eigen::MatrixBase<DerivedV>& V,
+    const sparse_cached_data & data,
+    Eigen::SparseMatrix<Scalar>& X);
 }
 
 #ifndef IGL_STATIC_LIBRARY
@@ -1,9 +1,26 @@
 #include "sparse_voxel_grid.h"
 
+#include "parallel_for.h"
 #include <unordered_map>
 #include <array>
 #include <vector>
 
+namespace igl
+{
+  namespace internal
+  {
+    struct IndexRowVectorHash {
+      std::size_t operator()(const Eigen::RowVector3i& key) const {
+        std::size_t seed = 0;
+        std::hash<int> hasher;
+        for (int i = 0; i < 3; i++) {
+          seed ^= hasher(key[i]) + 0x9e3779b9 + (seed<<6) + (seed>>2); // Copied from boost::hash_combine
+        }
+        return seed;
+      }
+    };
+  }
+}
 
 template <typename DerivedP0, typename Func, typename DerivedS, typename DerivedV, typename DerivedI>
 IGL_INLINE void igl::sparse_voxel_grid(const Eigen::MatrixBase<DerivedP0>& p0,
@@ -20,17 +37,7 @@ IGL_INLINE void igl::sparse_voxel_grid(const Eigen::MatrixBase<DerivedP0>& p0,
   typedef Eigen::Matrix<ScalarV, 1, 3> VertexRowVector;
   typedef Eigen::Matrix<ScalarI, 1, 8> IndexRowVector;
 
-
-  struct IndexRowVectorHash {
-    std::size_t operator()(const Eigen::RowVector3i& key) const {
-      std::size_t seed = 0;
-      std::hash<int> hasher;
-      for (int i = 0; i < 3; i++) {
-        seed ^= hasher(key[i]) + 0x9e3779b9 + (seed<<6) + (seed>>2); // Copied from boost::hash_combine
-      }
-      return seed;
-    }
-  };
+  typedef igl::internal::IndexRowVectorHash IndexRowVectorHash;
 
   auto sgn = [](ScalarS val) -> int {
     return (ScalarS(0) < val) - (val < ScalarS(0));
@@ -192,8 +199,179 @@ IGL_INLINE void igl::sparse_voxel_grid(const Eigen::MatrixBase<DerivedP0>& p0,
 }
 
 
+template <typename DerivedP0, typename BatchFunc, typename DerivedS, typename DerivedV, typename DerivedI>
+IGL_INLINE void igl::sparse_voxel_grid_batched(const Eigen::MatrixBase<DerivedP0>& p0,
+                                               const BatchFunc& batchFunc,
+                                               const double eps,
+                                               const int expected_number_of_cubes,
+                                               Eigen::PlainObjectBase<DerivedS>& CS,
+                                               Eigen::PlainObjectBase<DerivedV>& CV,
+                                               Eigen::PlainObjectBase<DerivedI>& CI)
+{
+  typedef typename DerivedV::Scalar ScalarV;
+  typedef typename DerivedS::Scalar ScalarS;
+  typedef typename DerivedI::Scalar ScalarI;
+  typedef Eigen::Matrix<ScalarV, 1, 3> VertexRowVector;
+  typedef Eigen::Matrix<ScalarV, Eigen::Dynamic, 3> MatrixX3V;
+  typedef Eigen::Matrix<ScalarS, Eigen::Dynamic, 1> VectorXS;
+  typedef igl::internal::IndexRowVectorHash IndexRowVectorHash;
+
+  auto sgn = [](ScalarS val) -> int {
+    return (ScalarS(0) < val) - (val < ScalarS(0));
+  };
+
+  const ScalarV half_eps = 0.5 * eps;
+  // Offsets of the cube corners in y-x-z order in units of half_eps (see
+  // above; the z basis vector points along -z)
+  const std::array<Eigen::RowVector3i, 8> corners = {{
+    Eigen::RowVector3i( 1, 1,-1), Eigen::RowVector3i( 1, 1, 1),
+    Eigen::RowVector3i(-1, 1, 1), Eigen::RowVector3i(-1, 1,-1),
+    Eigen::RowVector3i( 1,-1,-1), Eigen::RowVector3i( 1,-1, 1),
+    Eigen::RowVector3i(-1,-1, 1), Eigen::RowVector3i(-1,-1,-1) }};
+
+  // Cubes and corners evaluated so far, keyed by their coordinates in units
+  // of eps and half_eps
+  std::unordered_map<Eigen::RowVector3i, int, IndexRowVectorHash> seen, corner_index;
+  seen.reserve(2 * expected_number_of_cubes);
+  corner_index.reserve(4 * expected_number_of_cubes);
+  std::vector<VertexRowVector> corner_V;
+  std::vector<ScalarS> corner_S;
+  // Corners of the valid cubes
+  std::vector<std::array<int, 8> > cubes;
+  cubes.reserve(expected_number_of_cubes);
+
+  std::vector<Eigen::RowVector3i> level(1, Eigen::RowVector3i(0, 0, 0)), next;
+  seen[level[0]] = 0;
+  std::vector<std::array<int, 8> > level_corners;
+  while (level.size() > 0)
+  {
+    // Gather the corners not evaluated yet
+    level_corners.resize(level.size());
+    const int old_num_corners = corner_V.size();
+    for (int l = 0; l < (int)level.size(); l++)
+    {
+      const VertexRowVector ctr = p0 + eps*level[l].cast<ScalarV>(); // R^3 center of this cube
+      for (int c = 0; c < 8; c++)
+      {
+        const Eigen::RowVector3i key = 2*level[l] + corners[c];
+        const auto inserted = corner_index.emplace(key, corner_V.size());
+        if (inserted.second)
+        {
+          corner_V.push_back(ctr + half_eps*corners[c].cast<ScalarV>());
+        }
+        level_corners[l][c] = inserted.first->second;
+      }
+    }
+    // Evaluate them at once
+    const int num_new = corner_V.size() - old_num_corners;
+    MatrixX3V P(num_new, 3);
+    for (int i = 0; i < num_new; i++) { P.row(i) = corner_V[old_num_corners + i]; }
+    VectorXS S;
+    batchFunc(P, S);
+    assert(S.size() == num_new);
+    corner_S.insert(corner_S.end(), S.data(), S.data() + num_new);
+
+    // Keep the cubes intersecting the surface and visit their neighbors
+    next.clear();
+    for (int l = 0; l < (int)level.size(); l++)
+    {
+      bool validCube = false;
+      const int sign = sgn(corner_S[level_corners[l][0]]);
+      for (int c = 1; c < 8; c++) {
+        if (sign != sgn(corner_S[level_corners[l][c]])) {
+          validCube = true;
+          break;
+        }
+      }
+      if (!validCube) {
+        continue;
+      }
+      cubes.push_back(level_corners[l]);
+      for (int dz = -1; dz <= 1; dz++)
+      {
+        for (int dy = -1; dy <= 1; dy++)
+        {
+          for (int dx = -1; dx <= 1; dx++)
+          {
+            const Eigen::RowVector3i nkey = level[l] + Eigen::RowVector3i(dx, dy, dz);
+            if (seen.emplace(nkey, 0).second)
+            {
+              next.push_back(nkey);
+            }
+          }
+        }
+      }
+    }
+    level.swap(next);
+  }
+
+  // Keep only the corners of valid cubes, in order of first use
+  std::vector<int> remap(corner_V.size(), -1);
+  int num_corners = 0;
+  for (const auto & cube : cubes)
+  {
+    for (int c = 0; c < 8; c++)
+    {
+      if (remap[cube[c]] < 0) { remap[cube[c]] = num_corners++; }
+    }
+  }
+  CV.resize(num_corners, 3);
+  CS.resize(num_corners, 1);
+  CI.resize(cubes.size(), 8);
+  for (int i = 0; i < (int)corner_V.size(); i++)
+  {
+    if (remap[i] >= 0)
+    {
+      CV.row(remap[i]) = corner_V[i];
+      CS(remap[i]) = corner_S[i];
+    }
+  }
+  for (int i = 0; i < (int)cubes.size(); i++)
+  {
+    for (int c = 0; c < 8; c++)
+    {
+      CI(i, c) = ScalarI(remap[cubes[i][c]]);
+    }
+  }
+}
+
+template <typename DerivedP0, typename Func, typename DerivedS, typename DerivedV, typename DerivedI>
+IGL_INLINE void igl::sparse_voxel_grid(const Eigen::MatrixBase<DerivedP0>& p0,
+                                       const Func& scalarFunc,
+                                       const double eps,
+                                       const int expected_number_of_cubes,
+                                       const bool parallel,
+                                       Eigen::PlainObjectBase<DerivedS>& CS,
+                                       Eigen::PlainObjectBase<DerivedV>& CV,
+                                       Eigen::PlainObjectBase<DerivedI>& CI)
+{
+  if (!parallel)
+  {
+    return sparse_voxel_grid(p0, scalarFunc, eps, expected_number_of_cubes, CS, CV, CI);
+  }
+  typedef typename DerivedV::Scalar ScalarV;
+  typedef typename DerivedS::Scalar ScalarS;
+  typedef Eigen::Matrix<ScalarV, 1, 3> VertexRowVector;
+  sparse_voxel_grid_batched(
+    p0,
+    [&scalarFunc](
+      const Eigen::Matrix<ScalarV, Eigen::Dynamic, 3> & P,
+      Eigen::Matrix<ScalarS, Eigen::Dynamic, 1> & S)
+    {
+      S.resize(P.rows());
+      igl::parallel_for(P.rows(), [&](const int i)
+      {
+        const VertexRowVector p = P.row(i);
+        S(i) = scalarFunc(p);
+      }, 64);
+    },
+    eps, expected_number_of_cubes, CS, CV, CI);
+}
+
 #ifdef IGL_STATIC_LIBRARY
 // Explicit template instantiation
+template void igl::sparse_voxel_grid<Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, double, int, bool, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
+template void igl::sparse_voxel_grid_batched<Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<void (Eigen::Matrix<double, -1, 3, 0, -1, 3> const&, Eigen::Matrix<double, -1, 1, 0, -1, 1>&)>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<void (Eigen::Matrix<double, -1, 3, 0, -1, 3> const&, Eigen::Matrix<double, -1, 1, 0, -1, 1>&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> >&);
 // generated by autoexplicit.sh
 template void igl::sparse_voxel_grid<Eigen::Matrix<double, 1, 3, 1, 1, 3>, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)>, Eigen::Matrix<double, -1, 1, 0, -1, 1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, 8, 0, -1, 8> >(Eigen::MatrixBase<Eigen::Matrix<double, 1, 3, 1, 1, 3> > const&, std::function<double (Eigen::Matrix<double, 1, 3, 1, 1, 3> const&)> const&, double, int, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, 1, 0, -1, 1> >&, Eigen::PlainObjectBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> >&, Eigen::PlainObjectBase<Eigen::Matrix<int, -1, 8, 0, -1, 8> >&);
 template void igl::sparse_voxel_grid<class Eigen::Matrix<double, -1, -1, 0, -1, -1>, class std::function<double(class Eigen::Matrix<double, -1, -1, 0, -1, -1> const &)>, class Eigen::Matrix<double, -1, 1, 0, -1, 1>, class Eigen::Matrix<double, -1, -1, 0, -1, -1>, class Eigen::Matrix<int, -1, -1, 0, -1, -1> >(class Eigen::MatrixBase<class Eigen::Matrix<double, -1, -1, 0, -1, -1> > const &, class std::function<double(class Eigen::Matrix<double, -1, -1, 0, -1, -1> const &)> const &, double, int, class Eigen::PlainObjectBase<class Eigen::Matrix<double, -1, 1, 0, -1, 1> > &, class Eigen::PlainObjectBase<class Eigen::Matrix<double, -1, -1, 0, -1, -1> > &, class Eigen::PlainObjectBase<class Eigen::Matrix<int, -1, -1, 0, -1, -1> > &);
@@ -45,6 +45,51 @@ namespace igl
     Eigen::PlainObjectBase<DerivedS>& CS,
     Eigen::PlainObjectBase<DerivedV>& CV,
     Eigen::PlainObjectBase<DerivedI>& CI);
+  // Grow the cubes level by level (breadth first): all corners of the cubes
+  // neighboring the previous level that have not been evaluated yet are
+  // evaluated at once. The cubes are the same as above but listed in a
+  // different order.
+  //
+  // Inputs:
+  //   batchFunc  function evaluating the scalar function at many points:
+  //     batchFunc(P,S) with P a #P by 3 Eigen::Matrix<ScalarV,Eigen::Dynamic,3>
+  //     of points and S the #P Eigen::Matrix<ScalarS,Eigen::Dynamic,1> of
+  //     their values, where ScalarV and ScalarS are the scalar types of CV and
+  //     CS
+  //
+  template <
+    typename DerivedP0, 
+    typename BatchFunc, 
+    typename DerivedS, 
+    typename DerivedV, 
+    typename DerivedI>
+  IGL_INLINE void sparse_voxel_grid_batched(
+    const Eigen::MatrixBase<DerivedP0>& p0,
+    const BatchFunc& batchFunc,
+    const double eps,
+    const int expected_number_of_cubes,
+    Eigen::PlainObjectBase<DerivedS>& CS,
+    Eigen::PlainObjectBase<DerivedV>& CV,
+    Eigen::PlainObjectBase<DerivedI>& CI);
+  // Inputs:
+  //   parallel  whether to grow the cubes level by level (see
+  //     sparse_voxel_grid_batched) evaluating scalarFunc in parallel. Then
+  //     scalarFunc must be safe to call from several threads at once.
+  template <
+    typename DerivedP0, 
+    typename Func, 
+    typename DerivedS, 
+    typename DerivedV, 
+    typename DerivedI>
+  IGL_INLINE void sparse_voxel_grid(
+    const Eigen::MatrixBase<DerivedP0>& p0,
+    const Func& scalarFunc,
+    const double eps,
+    const int expected_number_of_cubes,
+    const bool parallel,
+    Eigen::PlainObjectBase<DerivedS>& CS,
+    Eigen::PlainObjectBase<DerivedV>& CV,
+    Eigen::PlainObjectBase<DerivedI>& CI);
 
 }
 
@@ -1,5 +1,8 @@
 #include "writePLY.h"
+#include <algorithm>
+#include <cstring>
 #include <fstream>
+#include <functional>
 
 #include "tinyply.h"
 
@@ -17,6 +20,175 @@ namespace igl
   template <> tinyply::Type IGL_INLINE tynyply_type<double>(){ return tinyply::Type::FLOAT64; }
 
 
+namespace internal
+{
+  // Append the ith row of M to a record at p, returning the end of the row
+  template <typename Derived>
+  IGL_INLINE char * ply_put_row(
+    char * p,
+    const Eigen::MatrixBase<Derived> & M,
+    const Eigen::Index i)
+  {
+    typedef typename Derived::Scalar Scalar;
+    for(Eigen::Index c = 0;c<M.cols();c++)
+    {
+      const Scalar s = M(i,c);
+      std::memcpy(p,&s,sizeof(Scalar));
+      p += sizeof(Scalar);
+    }
+    return p;
+  }
+
+  template <typename Scalar>
+  IGL_INLINE void ply_put_properties(
+    std::ostream & os,
+    const std::vector<std::string> & names)
+  {
+    for(const auto & name : names)
+    {
+      os << "property " << tinyply::PropertyTable[tynyply_type<Scalar>()].str
+         << " " << name << "\n";
+    }
+  }
+
+  // Write a binary little endian PLY file record by record through a fixed
+  // size buffer, rather than first copying every property into a separate
+  // buffer (see writePLY). The header matches what tinyply writes.
+  template <
+    typename DerivedV,
+    typename DerivedF,
+    typename DerivedE,
+    typename DerivedN,
+    typename DerivedUV,
+    typename DerivedVD,
+    typename DerivedFD,
+    typename DerivedED
+  >
+  IGL_INLINE bool writePLY_binary_little_endian(
+    std::ostream & ply_stream,
+    const Eigen::MatrixBase<DerivedV> & V,
+    const Eigen::MatrixBase<DerivedF> & F,
+    const Eigen::MatrixBase<DerivedE> & E,
+    const Eigen::MatrixBase<DerivedN> & N,
+    const Eigen::MatrixBase<DerivedUV> & UV,
+    const Eigen::MatrixBase<DerivedVD> & VD,
+    const std::vector<std::string> & VDheader,
+    const Eigen::MatrixBase<DerivedFD> & FD,
+    const std::vector<std::string> & FDheader,
+    const Eigen::MatrixBase<DerivedED> & ED,
+    const std::vector<std::string> & EDheader,
+    const std::vector<std::string> & comments)
+  {
+    typedef typename DerivedV::Scalar VScalar;
+    typedef typename DerivedN::Scalar NScalar;
+    typedef typename DerivedUV::Scalar UVScalar;
+    typedef typename DerivedF::Scalar FScalar;
+    typedef typename DerivedE::Scalar EScalar;
+    typedef typename DerivedVD::Scalar VDScalar;
+    typedef typename DerivedFD::Scalar FDScalar;
+    typedef typename DerivedED::Scalar EDScalar;
+    const bool has_N = N.rows() > 0;
+    const bool has_UV = UV.rows() > 0;
+    const bool has_VD = VD.cols() > 0;
+    const bool has_FD = FD.cols() > 0;
+    const bool has_E = E.rows() > 0;
+    const bool has_ED = has_E && ED.cols() > 0;
+    if(
+      (has_N && (N.rows() != V.rows() || N.cols() != 3)) ||
+      (has_UV && (UV.rows() != V.rows() || UV.cols() != 2)) ||
+      (has_VD && (VD.rows() != V.rows() || VD.cols() != VDheader.size())) ||
+      (has_FD && (FD.rows() != F.rows() || FD.cols() != FDheader.size())) ||
+      (has_E && E.cols() != 2) ||
+      (has_ED && (ED.rows() != E.rows() || ED.cols() != EDheader.size())) ||
+      F.cols() > 255)
+    {
+      std::cerr << "writePLY: unexpected dimensions " << std::endl;
+      return false;
+    }
+
+    ply_stream.imbue(std::locale("C"));
+    ply_stream << "ply\nformat binary_little_endian 1.0\n";
+    for(const auto & comment : comments)
+    {
+      ply_stream << "comment " << comment << "\n";
+    }
+    ply_stream << "element vertex " << V.rows() << "\n";
+    ply_put_properties<VScalar>(ply_stream,{"x","y","z"});
+    if(has_N) { ply_put_properties<NScalar>(ply_stream,{"nx","ny","nz"}); }
+    if(has_UV) { ply_put_properties<UVScalar>(ply_stream,{"u","v"}); }
+    if(has_VD) { ply_put_properties<VDScalar>(ply_stream,VDheader); }
+    ply_stream << "element face " << F.rows() << "\n";
+    ply_stream << "property list uchar "
+      << tinyply::PropertyTable[tynyply_type<FScalar>()].str
+      << " vertex_indices\n";
+    if(has_FD) { ply_put_properties<FDScalar>(ply_stream,FDheader); }
+    if(has_E)
+    {
+      ply_stream << "element edge " << E.rows() << "\n";
+      ply_put_properties<EScalar>(ply_stream,{"vertex1","vertex2"});
+      if(has_ED) { ply_put_properties<EDScalar>(ply_stream,EDheader); }
+    }
+    ply_stream << "end_header\n";
+
+    // Records are gathered into a buffer of about 1MB at a time
+    const size_t buffer_size = 1<<20;
+    std::vector<char> buffer;
+    const auto write_records = [&](
+      const Eigen::Index count,
+      const size_t record_size,
+      const std::function<char*(char*,Eigen::Index)> & put_record)
+    {
+      buffer.resize(std::max(buffer_size,record_size));
+      const Eigen::Index per_buffer = buffer.size()/record_size;
+      for(Eigen::Index begin = 0;begin<count;begin += per_buffer)
+      {
+        const Eigen::Index end = std::min(count,begin+per_buffer);
+        char * p = buffer.data();
+        for(Eigen::Index i = begin;i<end;i++)
+        {
+          p = put_record(p,i);
+        }
+        ply_stream.write(buffer.data(),p-buffer.data());
+      }
+    };
+    write_records(V.rows(),
+      3*sizeof(VScalar) +
+      (has_N ? 3*sizeof(NScalar) : 0) +
+      (has_UV ? 2*sizeof(UVScalar) : 0) +
+      (has_VD ? VD.cols()*sizeof(VDScalar) : 0),
+      [&](char * p, const Eigen::Index i)
+      {
+        p = ply_put_row(p,V,i);
+        if(has_N) { p = ply_put_row(p,N,i); }
+        if(has_UV) { p = ply_put_row(p,UV,i); }
+        if(has_VD) { p = ply_put_row(p,VD,i); }
+        return p;
+      });
+    write_records(F.rows(),
+      1 + F.cols()*sizeof(FScalar) +
+      (has_FD ? FD.cols()*sizeof(FDScalar) : 0),
+      [&](char * p, const Eigen::Index i)
+      {
+        *p++ = char(F.cols());
+        p = ply_put_row(p,F,i);
+        if(has_FD) { p = ply_put_row(p,FD,i); }
+        return p;
+      });
+    if(has_E)
+    {
+      write_records(E.rows(),
+        2*sizeof(EScalar) + (has_ED ? ED.cols()*sizeof(EDScalar) : 0),
+        [&](char * p, const Eigen::Index i)
+        {
+          p = ply_put_row(p,E,i);
+          if(has_ED) { p = ply_put_row(p,ED,i); }
+          return p;
+        });
+    }
+    return ply_stream.good();
+  }
+}
+
 template <
   typename DerivedV,
   typename DerivedF,
@@ -73,6 +245,15 @@ bool writePLY(
       std::cerr << "writePLY: unexpected dimensions " << std::endl;
       return false;
     }
+    // Binary files are streamed straight from the matrices
+    const uint16_t one = 1;
+    if(encoding == FileEncoding::Binary &&
+      *reinterpret_cast<const char*>(&one) == 1)
+    {
+      return internal::writePLY_binary_little_endian(
+        ply_stream,V,F,E,N,UV,VD,VDheader,FD,FDheader,ED,EDheader,comments);
+    }
+
     tinyply::PlyFile file;
 
     _v.resize(V.size());
@@ -141,13 +322,13 @@ bool writePLY(
 
     if(ED.cols()>0)
     {
-        assert(ED.rows()==F.rows());
+        assert(ED.rows()==E.rows());
         assert(ED.cols() == EDheader.size());
 
         _ed.resize(ED.size());
         Eigen::Map<Eigen::Matrix<EDScalar, Eigen::Dynamic, Eigen::Dynamic, Eigen::RowMajor > >( &_ed[0], ED.rows(), ED.cols() ) = ED;
 
-        file.add_properties_to_element("face", FDheader,
+        file.add_properties_to_element("edge", EDheader,
             tynyply_type<EDScalar>(), ED.rows(), reinterpret_cast<uint8_t*>( &_ed[0] ), tinyply::Type::INVALID, 0);
     }
 
@@ -416,4 +597,6 @@ template bool igl::writePLY<Eigen::Matrix<double, 8, 3, 0, 8, 3>, Eigen::Matrix<
 template bool igl::writePLY<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
 template bool igl::writePLY<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > const&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > const&, igl::FileEncoding);
 template bool igl::writePLY<Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(std::basic_string<char, std::char_traits<char>, std::allocator<char> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > const&, std::vector<std::basic_string<char, std::char_traits<char>, std::allocator<char> >, std::allocator<std::basic_string<char, std::char_traits<char>, std::allocator<char> > > > const&, igl::FileEncoding);
+template bool igl::writePLY<Eigen::Matrix<float, -1, 3, 1, -1, 3>, Eigen::Matrix<int, -1, -1, 0, -1, -1> >(std::string const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, 3, 1, -1, 3> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&);
+template bool igl::writePLY<Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<int, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<double, -1, -1, 0, -1, -1>, Eigen::Matrix<float, -1, -1, 0, -1, -1> >(std::string const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<int, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::string, std::allocator<std::string> > const&, Eigen::MatrixBase<Eigen::Matrix<double, -1, -1, 0, -1, -1> > const&, std::vector<std::string, std::allocator<std::string> > const&, Eigen::MatrixBase<Eigen::Matrix<float, -1, -1, 0, -1, -1> > const&, std::vector<std::string, std::allocator<std::string> > const&, std::vector<std::string, std::allocator<std::string> > const&, igl::FileEncoding);
 #endif
@@ -0,0 +1,332 @@
+#include <test_common.h>
+#include <igl/AABB.h>
+#include <igl/barycenter.h>
+#include <igl/colon.h>
+#include <igl/parallel_for.h>
+#include <igl/random_dir.h>
+#include <igl/sort.h>
+#include <limits>
+#include <random>
+
+namespace
+{
+  // Compare serializations on the rows reachable from the root (the rest are
+  // left uninitialized by AABB::serialize)
+  void assert_same_tree(
+    const igl::AABB<Eigen::MatrixXd,3> & A,
+    const igl::AABB<Eigen::MatrixXd,3> & B)
+  {
+    Eigen::MatrixXd A_mins,A_maxs,B_mins,B_maxs;
+    Eigen::VectorXi A_elements,B_elements;
+    A.serialize(A_mins,A_maxs,A_elements);
+    B.serialize(B_mins,B_maxs,B_elements);
+    REQUIRE(A_elements.size() == B_elements.size());
+    std::vector<int> Q(1,0);
+    while(!Q.empty())
+    {
+      const int i = Q.back();
+      Q.pop_back();
+      REQUIRE(A_elements(i) == B_elements(i));
+      REQUIRE(A_mins.row(i) == B_mins.row(i));
+      REQUIRE(A_maxs.row(i) == B_maxs.row(i));
+      if(A_elements(i) == -1)
+      {
+        Q.push_back(2*i+1);
+        Q.push_back(2*i+2);
+      }
+    }
+  }
+
+  int depth(const igl::AABB<Eigen::MatrixXd,3> & tree)
+  {
+    return 1+std::max(
+      tree.m_left ? depth(*tree.m_left) : 0,
+      tree.m_right ? depth(*tree.m_right) : 0);
+  }
+}
+
+TEST_CASE("AABB: parallel_init", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::torus(120,80,V,F);
+
+  // Serial reference build, sorting all barycenter coordinates at once
+  Eigen::MatrixXd BC;
+  igl::barycenter(V,F,BC);
+  Eigen::MatrixXi SI(BC.rows(),BC.cols());
+  {
+    Eigen::MatrixXd _;
+    Eigen::MatrixXi IS;
+    igl::sort(BC,1,true,_,IS);
+    for(int i = 0;i<IS.rows();i++)
+    {
+      for(int d = 0;d<IS.cols();d++)
+      {
+        SI(IS(i,d),d) = i;
+      }
+    }
+  }
+  const Eigen::VectorXi allI = igl::colon<int>(0,F.rows()-1);
+  igl::AABB<Eigen::MatrixXd,3> serial;
+  serial.init(V,F,SI,allI,1);
+
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  assert_same_tree(serial,tree);
+  for(const unsigned int num_threads : {2,3,8})
+  {
+    igl::AABB<Eigen::MatrixXd,3> parallel;
+    parallel.init(V,F,SI,allI,num_threads);
+    assert_same_tree(serial,parallel);
+  }
+}
+
+TEST_CASE("AABB: surface_area_heuristic", "[igl]")
+{
+  // Small detailed torus sitting on a huge ground quad and next to a long
+  // thin sliver: mixes very large and very small triangles
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  {
+    Eigen::MatrixXd TV;
+    Eigen::MatrixXi TF;
+    test_common::torus(80,60,TV,TF);
+    Eigen::MatrixXd GV(7,3);
+    GV<<
+      -100,-100,-0.3,
+       100,-100,-0.3,
+       100, 100,-0.3,
+      -100, 100,-0.3,
+      -50,   2,  0,
+       50,   2,  0,
+       50,   2,  0.01;
+    Eigen::MatrixXi GF(3,3);
+    GF<<0,1,2, 0,2,3, 4,5,6;
+    V.resize(TV.rows()+GV.rows(),3);
+    V<<TV,GV;
+    F.resize(TF.rows()+GF.rows(),3);
+    F<<TF,GF.array()+TV.rows();
+  }
+  igl::AABB<Eigen::MatrixXd,3> median,sah;
+  median.init(V,F);
+  sah.init(V,F,igl::AABB<Eigen::MatrixXd,3>::SURFACE_AREA_HEURISTIC);
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(-1.5,1.5);
+  int median_visited = 0;
+  int sah_visited = 0;
+  for(int q = 0;q<500;q++)
+  {
+    const Eigen::RowVector3d p(dist(gen),dist(gen),dist(gen));
+    {
+      int median_i,sah_i;
+      Eigen::RowVector3d median_c,sah_c;
+      const double inf = std::numeric_limits<double>::infinity();
+      const double median_sqr_d = median.squared_distance(
+        V,F,p,0.,inf,median_i,median_c,median_visited);
+      const double sah_sqr_d = sah.squared_distance(
+        V,F,p,0.,inf,sah_i,sah_c,sah_visited);
+      REQUIRE(median_sqr_d == Approx(sah_sqr_d).margin(1e-15));
+    }
+    {
+      const Eigen::RowVector3d dir(dist(gen),dist(gen),dist(gen));
+      const double inf = std::numeric_limits<double>::infinity();
+      igl::Hit median_hit,sah_hit;
+      const bool median_ret = median.intersect_ray(
+        V,F,p,dir,inf,median_hit,median_visited);
+      const bool sah_ret = sah.intersect_ray(
+        V,F,p,dir,inf,sah_hit,sah_visited);
+      REQUIRE(median_ret == sah_ret);
+      if(median_ret)
+      {
+        REQUIRE(median_hit.id == sah_hit.id);
+        REQUIRE(median_hit.t == sah_hit.t);
+      }
+    }
+  }
+  INFO("median visited: "<<median_visited<<", SAH visited: "<<sah_visited);
+  CHECK(sah_visited < median_visited);
+}
+
+TEST_CASE("AABB: surface_area_heuristic degenerate", "[igl]")
+{
+  const int n = 2000;
+  Eigen::MatrixXd V(3*n,3);
+  Eigen::MatrixXi F(n,3);
+  for(const bool coincident : {true,false})
+  {
+    for(int f = 0;f<n;f++)
+    {
+      // Exponentially spaced along x: binning always peels off one triangle
+      const double x = coincident ? 0 : std::pow(1.2,f);
+      V.row(3*f+0) << x,0,0;
+      V.row(3*f+1) << x+1,0,0;
+      V.row(3*f+2) << x,1,0;
+      F.row(f) << 3*f+0,3*f+1,3*f+2;
+    }
+    igl::AABB<Eigen::MatrixXd,3> sah;
+    sah.init(V,F,igl::AABB<Eigen::MatrixXd,3>::SURFACE_AREA_HEURISTIC);
+    CAPTURE(coincident);
+    REQUIRE(depth(sah) <= 64);
+    Eigen::MatrixXd P = V.topRows(n);
+    Eigen::VectorXd sqrD;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C;
+    sah.squared_distance(V,F,P,sqrD,I,C);
+    REQUIRE(sqrD.maxCoeff() == 0);
+  }
+}
+
+TEST_CASE("AABB: intersect_ray_batch", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::torus(60,40,V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  // Random rays, groups of rays sharing an origin and axis-aligned rays
+  // (zero direction coordinates)
+  std::mt19937 gen(0);
+  std::normal_distribution<double> dist;
+  const int num_rays = 1003;
+  Eigen::MatrixXd origin(num_rays,3),dir(num_rays,3);
+  for(int r = 0;r<num_rays;r++)
+  {
+    if(r%10 == 0 || r == 0)
+    {
+      origin.row(r) << 0.5*dist(gen),0.5*dist(gen),0.5*dist(gen);
+    }else
+    {
+      origin.row(r) = origin.row(r-1);
+    }
+    dir.row(r) << dist(gen),dist(gen),dist(gen);
+    if(r%7 == 0)
+    {
+      dir(r,r%3) = 0;
+      dir(r,(r+1)%3) = 0;
+    }
+  }
+  Eigen::VectorXi I;
+  Eigen::VectorXd T;
+  Eigen::MatrixXd UV;
+  tree.intersect_ray(V,F,origin,dir,I,T,UV);
+  REQUIRE(I.size() == num_rays);
+  int num_hits = 0;
+  for(int r = 0;r<num_rays;r++)
+  {
+    igl::Hit hit;
+    const Eigen::RowVector3d o = origin.row(r);
+    const Eigen::RowVector3d d = dir.row(r);
+    if(tree.intersect_ray(V,F,o,d,hit))
+    {
+      num_hits++;
+      REQUIRE(T(r) == hit.t);
+      // Ties (e.g., on an edge) may be broken differently
+      const auto point = [&](const int f, const double u, const double v)
+      {
+        return Eigen::RowVector3d(
+          V.row(F(f,0))*(1.-u-v)+V.row(F(f,1))*u+V.row(F(f,2))*v);
+      };
+      test_common::assert_near(
+        point(I(r),UV(r,0),UV(r,1)),point(hit.id,hit.u,hit.v),1e-6);
+    }else
+    {
+      REQUIRE(I(r) == -1);
+      REQUIRE(T(r) == std::numeric_limits<double>::infinity());
+    }
+  }
+  REQUIRE(num_hits > 0);
+  REQUIRE(num_hits < num_rays);
+}
+
+TEST_CASE("AABB: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::torus(500,400,V,F);
+  // Ambient occlusion style rays: many (stratified) directions from each of
+  // few origins
+  const int num_origins = 500;
+  const int num_samples = 64;
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> vertex(0,V.rows()-1);
+  const Eigen::MatrixXd D = igl::random_dir_stratified(num_samples);
+  Eigen::MatrixXd origin(num_origins*num_samples,3);
+  Eigen::MatrixXd dir(num_origins*num_samples,3);
+  for(int p = 0;p<num_origins;p++)
+  {
+    const Eigen::RowVector3d o = V.row(vertex(gen));
+    for(int s = 0;s<num_samples;s++)
+    {
+      origin.row(p*num_samples+s) = o;
+      dir.row(p*num_samples+s) = D.row(s);
+    }
+  }
+
+  BENCHMARK("init")
+  {
+    igl::AABB<Eigen::MatrixXd,3> tree;
+    tree.init(V,F);
+    return tree.m_box.volume();
+  };
+  BENCHMARK("init (surface area heuristic)")
+  {
+    igl::AABB<Eigen::MatrixXd,3> tree;
+    tree.init(V,F,igl::AABB<Eigen::MatrixXd,3>::SURFACE_AREA_HEURISTIC);
+    return tree.m_box.volume();
+  };
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  // Coherent camera rays: parallel rays through a grid of pixels
+  const int w = 200;
+  Eigen::MatrixXd camera_origin(w*w,3),camera_dir(w*w,3);
+  for(int i = 0;i<w;i++)
+  {
+    for(int j = 0;j<w;j++)
+    {
+      camera_origin.row(i*w+j) << -1.5+3.*i/w,-1.5+3.*j/w,2;
+      camera_dir.row(i*w+j) << 0.1,0.05,-1;
+    }
+  }
+  const auto one_at_a_time = [&](
+    const Eigen::MatrixXd & origin,
+    const Eigen::MatrixXd & dir)->int
+  {
+    Eigen::VectorXi I(origin.rows());
+    igl::parallel_for(origin.rows(),[&](const int r)
+    {
+      igl::Hit hit;
+      const Eigen::RowVector3d o = origin.row(r);
+      const Eigen::RowVector3d d = dir.row(r);
+      I(r) = tree.intersect_ray(V,F,o,d,hit) ? hit.id : -1;
+    },1000);
+    return I.sum();
+  };
+  const auto batched = [&](
+    const Eigen::MatrixXd & origin,
+    const Eigen::MatrixXd & dir)->int
+  {
+    Eigen::VectorXi I;
+    Eigen::VectorXd T;
+    Eigen::MatrixXd UV;
+    tree.intersect_ray(V,F,origin,dir,I,T,UV);
+    return I.sum();
+  };
+  BENCHMARK("intersect_ray AO rays (one ray at a time)")
+  {
+    return one_at_a_time(origin,dir);
+  };
+  BENCHMARK("intersect_ray AO rays (batched)")
+  {
+    return batched(origin,dir);
+  };
+  BENCHMARK("intersect_ray camera rays (one ray at a time)")
+  {
+    return one_at_a_time(camera_origin,camera_dir);
+  };
+  BENCHMARK("intersect_ray camera rays (batched)")
+  {
+    return batched(camera_origin,camera_dir);
+  };
+}
@@ -0,0 +1,228 @@
+#include <test_common.h>
+#include <igl/AABB.h>
+#include <igl/FlatAABB.h>
+#include <igl/triangulated_grid.h>
+#include <igl/barycenter.h>
+#include <random>
+
+namespace
+{
+  size_t pointer_tree_footprint(const igl::AABB<Eigen::MatrixXd,3> & tree)
+  {
+    size_t bytes = sizeof(tree);
+    if(tree.m_left) { bytes += pointer_tree_footprint(*tree.m_left); }
+    if(tree.m_right) { bytes += pointer_tree_footprint(*tree.m_right); }
+    return bytes;
+  }
+}
+
+TEST_CASE("FlatAABB: squared_distance", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::torus(40,30,V,F);
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(-1.5,1.5);
+  Eigen::MatrixXd P(500,3);
+  for(int i = 0;i<P.size();i++) { P(i) = dist(gen); }
+
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  Eigen::VectorXd sqrD;
+  Eigen::VectorXi I;
+  Eigen::MatrixXd C;
+  tree.squared_distance(V,F,P,sqrD,I,C);
+
+  for(const int leaf_size : {1,4,16})
+  {
+    igl::FlatAABB<Eigen::MatrixXd,3> flat;
+    flat.init(V,F,leaf_size);
+    Eigen::VectorXd flat_sqrD;
+    Eigen::VectorXi flat_I;
+    Eigen::MatrixXd flat_C;
+    flat.squared_distance(V,F,P,flat_sqrD,flat_I,flat_C);
+    test_common::assert_near(flat_sqrD,sqrD,1e-15);
+    test_common::assert_near(flat_C,C,1e-12);
+  }
+}
+
+TEST_CASE("FlatAABB: intersect_ray", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::torus(40,30,V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::FlatAABB<Eigen::MatrixXd,3> flat;
+  flat.init(V,F);
+  std::mt19937 gen(0);
+  std::normal_distribution<double> dist;
+  for(int r = 0;r<200;r++)
+  {
+    const Eigen::RowVector3d origin(0.5*dist(gen),0.5*dist(gen),0.5*dist(gen));
+    const Eigen::RowVector3d dir(dist(gen),dist(gen),dist(gen));
+    igl::Hit hit,flat_hit;
+    const bool ret = tree.intersect_ray(V,F,origin,dir,hit);
+    const bool flat_ret = flat.intersect_ray(V,F,origin,dir,flat_hit);
+    REQUIRE(ret == flat_ret);
+    if(ret)
+    {
+      REQUIRE(hit.id == flat_hit.id);
+      REQUIRE(hit.t == flat_hit.t);
+    }
+    std::vector<igl::Hit> hits,flat_hits;
+    tree.intersect_ray(V,F,origin,dir,hits);
+    flat.intersect_ray(V,F,origin,dir,flat_hits);
+    REQUIRE(hits.size() == flat_hits.size());
+    const auto by_t = [](const igl::Hit & a, const igl::Hit & b){ return a.t<b.t; };
+    std::sort(hits.begin(),hits.end(),by_t);
+    std::sort(flat_hits.begin(),flat_hits.end(),by_t);
+    for(size_t h = 0;h<hits.size();h++)
+    {
+      REQUIRE(hits[h].id == flat_hits[h].id);
+    }
+  }
+}
+
+TEST_CASE("FlatAABB: find", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(20,20,V,F);
+  igl::FlatAABB<Eigen::MatrixXd,2> flat;
+  flat.init(V,F);
+  Eigen::MatrixXd BC;
+  igl::barycenter(V,F,BC);
+  for(int f = 0;f<F.rows();f++)
+  {
+    const Eigen::RowVectorXd q = BC.row(f);
+    const std::vector<int> found = flat.find(V,F,q,true);
+    REQUIRE(found.size() == 1);
+    REQUIRE(found[0] == f);
+  }
+}
+
+TEST_CASE("FlatAABB: serialize", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::torus(20,15,V,F);
+  Eigen::MatrixXd bb_mins,bb_maxs;
+  Eigen::VectorXi elements;
+  {
+    // Pointer tree -> flat tree with single primitive leaves
+    igl::AABB<Eigen::MatrixXd,3> tree;
+    tree.init(V,F);
+    tree.serialize(bb_mins,bb_maxs,elements);
+    igl::FlatAABB<Eigen::MatrixXd,3> flat;
+    flat.init(V,F,bb_mins,bb_maxs,elements);
+    REQUIRE(flat.size() == 2*F.rows()-1);
+    Eigen::MatrixXd flat_bb_mins,flat_bb_maxs;
+    Eigen::VectorXi flat_elements;
+    flat.serialize(flat_bb_mins,flat_bb_maxs,flat_elements);
+    REQUIRE(flat_elements.size() == elements.size());
+    // Unused rows of igl::AABB::serialize are left uninitialized, so only
+    // compare rows reachable from the root
+    std::vector<int> Q(1,0);
+    while(!Q.empty())
+    {
+      const int i = Q.back();
+      Q.pop_back();
+      REQUIRE(flat_elements(i) == elements(i));
+      REQUIRE(flat_bb_mins.row(i) == bb_mins.row(i));
+      REQUIRE(flat_bb_maxs.row(i) == bb_maxs.row(i));
+      if(elements(i) == -1)
+      {
+        Q.push_back(2*i+1);
+        Q.push_back(2*i+2);
+      }
+    }
+  }
+  {
+    // Flat tree -> serialization -> flat tree with same multi-primitive leaves
+    igl::FlatAABB<Eigen::MatrixXd,3> flat;
+    flat.init(V,F,8);
+    flat.serialize(bb_mins,bb_maxs,elements);
+    igl::FlatAABB<Eigen::MatrixXd,3> copy;
+    copy.init(V,F,bb_mins,bb_maxs,elements);
+    REQUIRE(copy.size() == flat.size());
+    REQUIRE(copy.m_elements == flat.m_elements);
+    for(int n = 0;n<flat.size();n++)
+    {
+      REQUIRE(copy.m_nodes[n].m_offset == flat.m_nodes[n].m_offset);
+      REQUIRE(copy.m_nodes[n].m_count == flat.m_nodes[n].m_count);
+      REQUIRE(copy.m_nodes[n].m_box.min() == flat.m_nodes[n].m_box.min());
+      REQUIRE(copy.m_nodes[n].m_box.max() == flat.m_nodes[n].m_box.max());
+    }
+  }
+}
+
+TEST_CASE("FlatAABB: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::torus(500,400,V,F);
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> dist(-1.5,1.5);
+  Eigen::MatrixXd P(10000,3);
+  for(int i = 0;i<P.size();i++) { P(i) = dist(gen); }
+
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  igl::FlatAABB<Eigen::MatrixXd,3> flat;
+  flat.init(V,F);
+  const size_t tree_bytes = pointer_tree_footprint(tree);
+  const size_t flat_bytes = flat.memory_footprint();
+  INFO("igl::AABB bytes: "<<tree_bytes<<", igl::FlatAABB bytes: "<<flat_bytes);
+  CHECK(flat_bytes < tree_bytes);
+
+  BENCHMARK("igl::AABB::init")
+  {
+    igl::AABB<Eigen::MatrixXd,3> tree;
+    tree.init(V,F);
+    return tree.m_box.volume();
+  };
+  BENCHMARK("igl::FlatAABB::init")
+  {
+    igl::FlatAABB<Eigen::MatrixXd,3> flat;
+    flat.init(V,F);
+    return flat.size();
+  };
+  BENCHMARK("igl::AABB::squared_distance")
+  {
+    Eigen::VectorXd sqrD;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C;
+    tree.squared_distance(V,F,P,sqrD,I,C);
+    return sqrD.sum();
+  };
+  BENCHMARK("igl::FlatAABB::squared_distance")
+  {
+    Eigen::VectorXd sqrD;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C;
+    flat.squared_distance(V,F,P,sqrD,I,C);
+    return sqrD.sum();
+  };
+  const Eigen::RowVector3d origin(0,0,0);
+  BENCHMARK("igl::AABB::intersect_ray")
+  {
+    int hits = 0;
+    for(int r = 0;r<10000;r++)
+    {
+      igl::Hit hit;
+      hits += tree.intersect_ray(V,F,origin,P.row(r),hit);
+    }
+    return hits;
+  };
+  BENCHMARK("igl::FlatAABB::intersect_ray")
+  {
+    int hits = 0;
+    for(int r = 0;r<10000;r++)
+    {
+      igl::Hit hit;
+      hits += flat.intersect_ray(V,F,origin,P.row(r),hit);
+    }
+    return hits;
+  };
+}
@@ -0,0 +1,70 @@
+#include <test_common.h>
+#include <igl/IndexedPriorityQueue.h>
+#include <algorithm>
+#include <random>
+
+TEST_CASE("IndexedPriorityQueue: random", "[igl]")
+{
+  const int n = 200;
+  // Few distinct priorities to exercise ties
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> key(0,n-1);
+  std::uniform_int_distribution<int> priority(0,20);
+  std::uniform_int_distribution<int> op(0,3);
+  Eigen::VectorXd P(n);
+  for(int i = 0;i<n;i++) { P(i) = priority(gen); }
+  igl::IndexedPriorityQueue<double> Q;
+  Q.init(P);
+  REQUIRE(Q.num_keys() == n);
+  REQUIRE(Q.size() == n);
+  // Reference: -1 if not in queue
+  std::vector<double> R(P.data(),P.data()+n);
+  std::vector<bool> in(n,true);
+  const auto reference_top = [&]()->int
+  {
+    int t = -1;
+    for(int i = 0;i<n;i++)
+    {
+      if(in[i] && (t == -1 || R[i] < R[t])) { t = i; }
+    }
+    return t;
+  };
+  for(int iter = 0;iter<20000;iter++)
+  {
+    const int i = key(gen);
+    switch(op(gen))
+    {
+      case 0:
+      case 1:
+        R[i] = priority(gen);
+        in[i] = true;
+        Q.update(i,R[i]);
+        break;
+      case 2:
+        in[i] = false;
+        Q.remove(i);
+        break;
+      case 3:
+        if(!Q.empty())
+        {
+          in[Q.top()] = false;
+          Q.pop();
+        }
+        break;
+    }
+    REQUIRE(Q.size() == std::count(in.begin(),in.end(),true));
+    REQUIRE(Q.contains(i) == in[i]);
+    if(in[i]) { REQUIRE(Q.priority(i) == R[i]); }
+    const int t = reference_top();
+    REQUIRE(Q.empty() == (t == -1));
+    if(t != -1)
+    {
+      // Ties are broken by smaller key
+      REQUIRE(Q.top() == t);
+      REQUIRE(Q.top_priority() == R[t]);
+    }
+  }
+  Q.clear();
+  REQUIRE(Q.empty());
+  for(int i = 0;i<n;i++) { REQUIRE(!Q.contains(i)); }
+}
@@ -0,0 +1,61 @@
+#include <test_common.h>
+#include <igl/SupernodalLLT.h>
+#include <igl/cotmatrix.h>
+#include <igl/massmatrix.h>
+#include <igl/triangulated_grid.h>
+#include <Eigen/SparseCholesky>
+#include <random>
+
+TEST_CASE("SupernodalLLT: grid", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(60,40,V,F);
+  Eigen::SparseMatrix<double> L,M;
+  igl::cotmatrix(V,F,L);
+  igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_VORONOI,M);
+  const Eigen::SparseMatrix<double> A = M - 0.1*L;
+  const Eigen::MatrixXd B = Eigen::MatrixXd::Random(A.rows(),3);
+  igl::SupernodalLLT<double> llt;
+  llt.compute(A);
+  REQUIRE(llt.info() == Eigen::Success);
+  REQUIRE(llt.num_supernodes() < A.rows());
+  const Eigen::SimplicialLLT<Eigen::SparseMatrix<double> > simplicial(A);
+  test_common::assert_near(llt.solve(B),simplicial.solve(B),1e-10);
+  // Same pattern, new values
+  const Eigen::SparseMatrix<double> A2 = M - 10.*L;
+  llt.factorize(A2);
+  REQUIRE(llt.info() == Eigen::Success);
+  const Eigen::MatrixXd X = llt.solve(B);
+  test_common::assert_near(Eigen::MatrixXd(A2*X),B,1e-12);
+  // Not positive definite
+  llt.compute(L);
+  REQUIRE(llt.info() == Eigen::NumericalIssue);
+}
+
+TEST_CASE("SupernodalLLT: random", "[igl]")
+{
+  // Random sparsity patterns with fill, only lower triangle given
+  std::mt19937 gen(0);
+  for(const int n : {1,2,17,300})
+  {
+    std::uniform_int_distribution<int> index(0,n-1);
+    std::vector<Eigen::Triplet<double> > IJV;
+    for(int k = 0;k<3*n;k++)
+    {
+      const int i = index(gen);
+      const int j = index(gen);
+      IJV.emplace_back(std::max(i,j),std::min(i,j),-1.);
+    }
+    // Diagonally dominant
+    for(int i = 0;i<n;i++) { IJV.emplace_back(i,i,3.*n+1.); }
+    Eigen::SparseMatrix<double> A(n,n);
+    A.setFromTriplets(IJV.begin(),IJV.end());
+    const Eigen::MatrixXd B = Eigen::MatrixXd::Random(n,2);
+    const igl::SupernodalLLT<double> llt(A);
+    REQUIRE(llt.info() == Eigen::Success);
+    const Eigen::MatrixXd X = llt.solve(B);
+    const Eigen::MatrixXd AX = A.selfadjointView<Eigen::Lower>()*X;
+    test_common::assert_near(AX,B,1e-12);
+  }
+}
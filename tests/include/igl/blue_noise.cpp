@@ -12,6 +12,25 @@
 #include <igl/knn.h>
 #include <igl/octree.h>
 #include <igl/slice.h>
+#include <string>
+
+namespace
+{
+  // Distance from each sample to its nearest neighbor
+  Eigen::VectorXd nearest_neighbor_distances(const Eigen::MatrixXd & P)
+  {
+    std::vector<std::vector<int> > point_indices;
+    Eigen::MatrixXi CH;
+    Eigen::MatrixXd CN;
+    Eigen::VectorXd W;
+    igl::octree(P,point_indices,CH,CN,W);
+    Eigen::MatrixXi I;
+    igl::knn(P,2,point_indices,CH,CN,W,I);
+    Eigen::MatrixXd P2;
+    igl::slice(P,I.col(1).eval(),1,P2);
+    return (P-P2).rowwise().norm();
+  }
+}
 
 TEST_CASE("blue_noise: decimated-knight", "[igl]")
 {
@@ -38,3 +57,63 @@ TEST_CASE("blue_noise: decimated-knight", "[igl]")
   Eigen::VectorXd D = (P-P2).rowwise().norm();
   REQUIRE(D.minCoeff() > r);
 }
+
+TEST_CASE("blue_noise: parallel", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::readOBJ(test_common::data_path("decimated-knight.obj"),V,F);
+  const double r = 0.01;
+  Eigen::MatrixXd B[2],P[2];
+  Eigen::VectorXi I[2];
+  const igl::BlueNoiseMethod methods[2] =
+    {igl::BLUE_NOISE_METHOD_SERIAL,igl::BLUE_NOISE_METHOD_PARALLEL};
+  for(int m = 0;m<2;m++)
+  {
+    igl::blue_noise(V,F,r,methods[m],B[m],I[m],P[m]);
+    REQUIRE(P[m].rows() == B[m].rows());
+    REQUIRE(P[m].rows() == I[m].rows());
+    // Samples are where their barycentric coordinates say they are
+    for(int i = 0;i<P[m].rows();i++)
+    {
+      const Eigen::RowVector3d Pi =
+        B[m](i,0)*V.row(F(I[m](i),0)) +
+        B[m](i,1)*V.row(F(I[m](i),1)) +
+        B[m](i,2)*V.row(F(I[m](i),2));
+      REQUIRE((Pi-P[m].row(i)).norm() < 1e-6);
+    }
+    const Eigen::VectorXd D = nearest_neighbor_distances(P[m]);
+    REQUIRE(D.minCoeff() > r);
+    // Maximal: no large holes between samples
+    REQUIRE(D.mean() < 2*r);
+  }
+  // Both are maximal samplings so they should have about the same density
+  REQUIRE(std::abs(P[1].rows()-P[0].rows()) < 0.05*P[0].rows());
+}
+
+TEST_CASE("blue_noise: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::readOBJ(test_common::data_path("decimated-knight.obj"),V,F);
+  const double r = 0.005;
+  Eigen::MatrixXd B,P;
+  Eigen::VectorXi I;
+  const igl::BlueNoiseMethod methods[2] =
+    {igl::BLUE_NOISE_METHOD_SERIAL,igl::BLUE_NOISE_METHOD_PARALLEL};
+  const std::string names[2] = {"serial","parallel"};
+  for(int m = 0;m<2;m++)
+  {
+    BENCHMARK("blue_noise "+names[m]+" (r = 0.005)")
+    {
+      igl::blue_noise(V,F,r,methods[m],B,I,P);
+      return P.rows();
+    };
+    // Sample quality
+    const Eigen::VectorXd D = nearest_neighbor_distances(P);
+    UNSCOPED_INFO(names[m] << ": " << P.rows() << " samples, " <<
+      "nearest neighbor distance min/mean: " <<
+      D.minCoeff()/r << "r/" << D.mean()/r << "r");
+    CHECK(D.minCoeff() > r);
+  }
+}
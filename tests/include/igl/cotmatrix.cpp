@@ -1,8 +1,12 @@
 #include <test_common.h>
 #include <igl/PI.h>
 #include <igl/cotmatrix.h>
+#include <igl/cotmatrix_entries.h>
+#include <igl/doublearea.h>
+#include <igl/massmatrix.h>
 #include <igl/matrix_to_list.h>
 #include <igl/polygon_corners.h>
+#include <igl/triangulated_grid.h>
 
 TEST_CASE("cotmatrix: poly", "[igl]" )
 {
@@ -213,3 +217,49 @@ TEST_CASE("cotmatrix: tetrahedron", "[igl]")
     REQUIRE (L1.col(f).sum() == Approx (0.0).margin( epsilon));
   }
 }
+
+TEST_CASE("cotmatrix: cached", "[igl]")
+{
+  // Bumpy grid whose vertices move while its connectivity stays the same
+  Eigen::MatrixXd UV,V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(30,20,UV,F);
+  V.resize(UV.rows(),3);
+  igl::sparse_cached_data L_data,M_data;
+  Eigen::SparseMatrix<double> L,M;
+  for(int iter = 0;iter<3;iter++)
+  {
+    for(int i = 0;i<UV.rows();i++)
+    {
+      V.row(i) << UV(i,0), UV(i,1), 0.1*sin(10*UV(i,0)+iter)*cos(7*UV(i,1));
+    }
+    igl::cotmatrix(V,F,L_data,L);
+    igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_BARYCENTRIC,M_data,M);
+    // Independent assembly with setFromTriplets in the same order
+    Eigen::MatrixXd C;
+    igl::cotmatrix_entries(V,F,C);
+    Eigen::VectorXd dblA;
+    igl::doublearea(V,F,dblA);
+    std::vector<Eigen::Triplet<double> > L_ijv,M_ijv;
+    for(int f = 0;f<F.rows();f++)
+    {
+      for(int e = 0;e<3;e++)
+      {
+        const int source = F(f,(e+1)%3);
+        const int dest = F(f,(e+2)%3);
+        L_ijv.emplace_back(source,dest,C(f,e));
+        L_ijv.emplace_back(dest,source,C(f,e));
+        L_ijv.emplace_back(source,source,-C(f,e));
+        L_ijv.emplace_back(dest,dest,-C(f,e));
+        M_ijv.emplace_back(F(f,e),F(f,e),dblA(f)/6.);
+      }
+    }
+    Eigen::SparseMatrix<double> L_ref(V.rows(),V.rows()),M_ref(V.rows(),V.rows());
+    L_ref.setFromTriplets(L_ijv.begin(),L_ijv.end());
+    M_ref.setFromTriplets(M_ijv.begin(),M_ijv.end());
+    REQUIRE(L.nonZeros() == L_ref.nonZeros());
+    REQUIRE(M.nonZeros() == M_ref.nonZeros());
+    test_common::assert_eq(Eigen::MatrixXd(L),Eigen::MatrixXd(L_ref));
+    test_common::assert_near(Eigen::MatrixXd(M),Eigen::MatrixXd(M_ref),1e-15);
+  }
+}
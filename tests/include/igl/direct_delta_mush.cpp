@@ -1,7 +1,55 @@
 #include <test_common.h>
 #include <igl/direct_delta_mush.h>
-#include <igl/adjacency_list.h>
-#include <iostream>
+#include <igl/PI.h>
+#include <igl/triangulated_grid.h>
+#include <Eigen/Geometry>
+#include <string>
+
+namespace
+{
+  typedef std::vector<Eigen::Affine3d, Eigen::aligned_allocator<Eigen::Affine3d>>
+    AffineList;
+
+  // Open cylinder of height 1 (along z) rigged to m bones stacked along z,
+  // each vertex weighted linearly between its two nearest bone centers.
+  void tube_rig(
+    const int nu,
+    const int nv,
+    const int m,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F,
+    Eigen::MatrixXd & W)
+  {
+    Eigen::MatrixXd GV;
+    igl::triangulated_grid(nu, nv, GV, F);
+    V.resize(GV.rows(), 3);
+    W = Eigen::MatrixXd::Zero(GV.rows(), m);
+    for (int i = 0; i < GV.rows(); ++i)
+    {
+      const double theta = 2. * igl::PI * GV(i, 0);
+      V.row(i) << 0.2 * cos(theta), 0.2 * sin(theta), GV(i, 1);
+      const double b = std::min(std::max(GV(i, 1) * m - 0.5, 0.), m - 1.);
+      const int j = std::min(int(b), m - 2 < 0 ? 0 : m - 2);
+      const double t = b - j;
+      W(i, j) += 1. - t;
+      if (m > 1) { W(i, j + 1) += t; }
+    }
+  }
+
+  // Bend: bone j rotated about the x-axis through its base by j*angle/m.
+  AffineList tube_pose(const int m, const double angle)
+  {
+    AffineList T(m);
+    for (int j = 0; j < m; ++j)
+    {
+      const Eigen::Vector3d c(0, 0, double(j) / m);
+      T[j] = Eigen::Translation3d(c) *
+        Eigen::AngleAxisd(j * angle / m, Eigen::Vector3d::UnitX()) *
+        Eigen::Translation3d(-c);
+    }
+    return T;
+  }
+}
 
 TEST_CASE("direct_delta_mush: cube", "[igl]")
 {
@@ -23,3 +71,73 @@ TEST_CASE("direct_delta_mush: cube", "[igl]")
 
   test_common::assert_near(U, V, 1e-4);
 }
+
+TEST_CASE("direct_delta_mush: sparse", "[igl]")
+{
+  Eigen::MatrixXd V, W, Omega;
+  Eigen::MatrixXi F;
+  const int m = 6;
+  tube_rig(16, 24, m, V, F, W);
+  igl::direct_delta_mush_precomputation(V, F, W, 4, 0.5, 0.25, 0.5, Omega);
+  const AffineList T = tube_pose(m, igl::PI / 2.);
+  Eigen::MatrixXd U;
+  igl::direct_delta_mush(V, T, Omega, U);
+
+  // Keeping every bone matches the dense evaluation
+  Eigen::SparseMatrix<double, Eigen::RowMajor> S;
+  igl::direct_delta_mush_precomputation(V, F, W, 4, 0.5, 0.25, 0.5, 0., S);
+  REQUIRE(S.rows() == Omega.rows());
+  REQUIRE(S.cols() == Omega.cols());
+  REQUIRE(Eigen::MatrixXd(S) == Omega);
+  Eigen::MatrixXd US;
+  igl::direct_delta_mush(V, T, S, US);
+  test_common::assert_near(US, U, 1e-12);
+
+  // Pruning bones with negligible smoothed weight barely changes the result
+  igl::direct_delta_mush_precomputation(V, F, W, 4, 0.5, 0.25, 0.5, 1e-4, S);
+  REQUIRE(S.nonZeros() < Omega.size());
+  REQUIRE(S.nonZeros() % 10 == 0);
+  igl::direct_delta_mush(V, T, S, US);
+  test_common::assert_near(US, U, 1e-3);
+
+  // The same rigid transformation for every bone is reproduced exactly
+  const Eigen::Affine3d R = Eigen::Translation3d(0.1, -0.2, 0.3) *
+    Eigen::AngleAxisd(0.7, Eigen::Vector3d(1, 2, 3).normalized());
+  const AffineList TR(m, R);
+  igl::direct_delta_mush(V, TR, S, US);
+  const Eigen::MatrixXd RV = (V * R.linear().transpose()).rowwise() +
+    R.translation().transpose();
+  test_common::assert_near(US, RV, 1e-10);
+  igl::direct_delta_mush(V, TR, Omega, U);
+  test_common::assert_near(U, RV, 1e-10);
+}
+
+TEST_CASE("direct_delta_mush: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V, W;
+  Eigen::MatrixXi F;
+  // Same number of bones as the tutorial's elephant rig, at production
+  // vertex counts
+  const int m = 18;
+  tube_rig(256, 400, m, V, F, W);
+  const std::string size =
+    std::to_string(V.rows()) + " vertices, " + std::to_string(m) + " bones";
+  Eigen::MatrixXd Omega;
+  igl::direct_delta_mush_precomputation(V, F, W, 20, 3., 1., 0.8, Omega);
+  Eigen::SparseMatrix<double, Eigen::RowMajor> S;
+  igl::direct_delta_mush_precomputation(V, F, W, 20, 3., 1., 0.8, 1e-6, S);
+  UNSCOPED_INFO("stored bones per vertex: " <<
+    S.nonZeros() / 10. / V.rows() << " of " << m);
+  const AffineList T = tube_pose(m, igl::PI / 2.);
+  Eigen::MatrixXd U;
+  BENCHMARK("direct_delta_mush, dense Omega (" + size + ")")
+  {
+    igl::direct_delta_mush(V, T, Omega, U);
+    return U(0, 0);
+  };
+  BENCHMARK("direct_delta_mush, sparse Omega (" + size + ")")
+  {
+    igl::direct_delta_mush(V, T, S, U);
+    return U(0, 0);
+  };
+}
@@ -0,0 +1,108 @@
+#include <test_common.h>
+#include <igl/eigs.h>
+#include <igl/cotmatrix.h>
+#include <igl/massmatrix.h>
+#include <igl/triangulated_grid.h>
+#include <Eigen/Eigenvalues>
+#include <string>
+
+namespace
+{
+  // Laplace-Beltrami operator of a rectangle whose side lengths have an
+  // irrational ratio (so that its eigen values are simple)
+  void rectangle_laplacian(
+    const int nx,
+    const int ny,
+    Eigen::SparseMatrix<double> & L,
+    Eigen::SparseMatrix<double> & M)
+  {
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    igl::triangulated_grid(nx,ny,V,F);
+    V.col(1) *= std::sqrt(2.);
+    igl::cotmatrix(V,F,L);
+    L = (-L).eval();
+    igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_DEFAULT,M);
+  }
+
+  void check_eigen_pairs(
+    const Eigen::SparseMatrix<double> & A,
+    const Eigen::SparseMatrix<double> & B,
+    const Eigen::MatrixXd & U,
+    const Eigen::VectorXd & S,
+    const Eigen::VectorXd & gtS)
+  {
+    const int k = S.size();
+    REQUIRE(U.cols() == k);
+    test_common::assert_near(S,gtS,1e-8*(1+gtS.cwiseAbs().maxCoeff()));
+    // Descending
+    for(int i = 1;i<k;i++)
+    {
+      REQUIRE(S(i-1) >= S(i));
+    }
+    // B-orthonormal eigen vectors
+    test_common::assert_near(
+      Eigen::MatrixXd(U.transpose()*B*U),Eigen::MatrixXd::Identity(k,k),1e-8);
+    const Eigen::MatrixXd R = A*U-B*U*S.asDiagonal();
+    REQUIRE(R.cwiseAbs().maxCoeff() < 1e-6*(1+gtS.cwiseAbs().maxCoeff()));
+  }
+}
+
+TEST_CASE("eigs: matches dense solver", "[igl]")
+{
+  Eigen::SparseMatrix<double> L,M;
+  rectangle_laplacian(13,11,L,M);
+  const int n = L.rows();
+  const Eigen::MatrixXd denseL = L, denseM = M;
+  const Eigen::GeneralizedSelfAdjointEigenSolver<Eigen::MatrixXd> es(
+    denseL,denseM);
+  // Ascending
+  const Eigen::VectorXd & gt = es.eigenvalues();
+  for(const int k : {1,5,12})
+  {
+    Eigen::MatrixXd U;
+    Eigen::VectorXd S;
+    REQUIRE(igl::eigs(L,M,k,igl::EIGS_TYPE_SM,U,S));
+    check_eigen_pairs(L,M,U,S,gt.head(k).reverse());
+    // The zero eigen value has a constant eigen vector
+    REQUIRE(std::abs(S(k-1)) < 1e-8);
+    REQUIRE(
+      U.col(k-1).maxCoeff()-U.col(k-1).minCoeff() <
+      1e-8*U.col(k-1).cwiseAbs().maxCoeff());
+
+    REQUIRE(igl::eigs(L,M,k,igl::EIGS_TYPE_LM,U,S));
+    check_eigen_pairs(L,M,U,S,gt.tail(k).reverse());
+
+    Eigen::MatrixXd Ui;
+    Eigen::VectorXd Si;
+    REQUIRE(igl::eigs(
+      L,M,k,igl::EIGS_TYPE_SM,igl::EIGS_METHOD_INVERSE_ITERATION,Ui,Si));
+    test_common::assert_near(Si,Eigen::VectorXd(gt.head(k).reverse()),1e-6);
+  }
+  // All of them
+  Eigen::MatrixXd U;
+  Eigen::VectorXd S;
+  REQUIRE(igl::eigs(L,M,n,igl::EIGS_TYPE_SM,U,S));
+  check_eigen_pairs(L,M,U,S,gt.reverse());
+}
+
+TEST_CASE("eigs: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::SparseMatrix<double> L,M;
+  rectangle_laplacian(60,60,L,M);
+  const int k = 20;
+  const std::string size =
+    std::to_string(L.rows())+" vertices, "+std::to_string(k)+" modes";
+  Eigen::MatrixXd U;
+  Eigen::VectorXd S;
+  BENCHMARK("eigs inverse iteration ("+size+")")
+  {
+    igl::eigs(L,M,k,igl::EIGS_TYPE_SM,igl::EIGS_METHOD_INVERSE_ITERATION,U,S);
+    return S.sum();
+  };
+  BENCHMARK("eigs block Lanczos ("+size+")")
+  {
+    igl::eigs(L,M,k,igl::EIGS_TYPE_SM,igl::EIGS_METHOD_BLOCK_LANCZOS,U,S);
+    return S.sum();
+  };
+}
@@ -0,0 +1,91 @@
+#include <test_common.h>
+#include <igl/exact_geodesic.h>
+#include <string>
+#include <vector>
+
+TEST_CASE("exact_geodesic: ExactGeodesic", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(2,V,F);
+  const Eigen::VectorXi VT = Eigen::VectorXi::LinSpaced(V.rows(),0,V.rows()-1);
+  const Eigen::VectorXi FT = Eigen::VectorXi::LinSpaced(F.rows(),0,F.rows()-1);
+  std::vector<Eigen::VectorXi> VS,FS;
+  for(int s = 0;s<8;s++)
+  {
+    VS.push_back((Eigen::VectorXi(2)<<(7*s)%V.rows(),(13*s+5)%V.rows()).finished());
+    FS.push_back((Eigen::VectorXi(1)<<(11*s)%F.rows()).finished());
+  }
+  const igl::ExactGeodesic geodesic(V,F);
+  Eigen::MatrixXd D;
+  geodesic.distance(VS,FS,VT,FT,D);
+  REQUIRE(D.rows() == VT.size()+FT.size());
+  REQUIRE(D.cols() == VS.size());
+  for(int s = 0;s<VS.size();s++)
+  {
+    // Same as a fresh computation and as a repeated (pooled) query
+    Eigen::VectorXd Ds,Dr;
+    igl::exact_geodesic(V,F,VS[s],FS[s],VT,FT,Ds);
+    test_common::assert_eq(Ds,Eigen::VectorXd(D.col(s)));
+    geodesic.distance(VS[s],FS[s],VT,FT,Dr);
+    test_common::assert_eq(Ds,Dr);
+    // Vertex and face sources together give the nearest of both
+    Eigen::VectorXd DV,DF;
+    geodesic.distance(VS[s],Eigen::VectorXi(),VT,FT,DV);
+    geodesic.distance(Eigen::VectorXi(),FS[s],VT,FT,DF);
+    test_common::assert_near(Ds,Eigen::VectorXd(DV.cwiseMin(DF)),1e-12);
+  }
+  // Sources are at distance zero
+  geodesic.distance(VS,{},VS[0],Eigen::VectorXi(),D);
+  REQUIRE(D.col(0).maxCoeff() == 0);
+  // Only source faces
+  geodesic.distance({},FS,VT,FT,D);
+  REQUIRE(D.cols() == FS.size());
+  for(int s = 0;s<FS.size();s++)
+  {
+    Eigen::VectorXd DF;
+    geodesic.distance(Eigen::VectorXi(),FS[s],VT,FT,DF);
+    test_common::assert_eq(DF,Eigen::VectorXd(D.col(s)));
+  }
+}
+
+TEST_CASE("exact_geodesic: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(5,V,F);
+  const Eigen::VectorXi VT = Eigen::VectorXi::LinSpaced(V.rows(),0,V.rows()-1);
+  std::vector<Eigen::VectorXi> VS;
+  for(int s = 0;s<16;s++)
+  {
+    VS.push_back((Eigen::VectorXi(1)<<(997*s)%V.rows()).finished());
+  }
+  const std::string size = std::to_string(F.rows())+" faces";
+  Eigen::MatrixXd D(V.rows(),VS.size());
+  BENCHMARK("exact_geodesic per source set ("+size+", 16 sets)")
+  {
+    for(int s = 0;s<VS.size();s++)
+    {
+      Eigen::VectorXd Ds;
+      igl::exact_geodesic(V,F,VS[s],Eigen::VectorXi(),VT,Eigen::VectorXi(),Ds);
+      D.col(s) = Ds;
+    }
+    return D.sum();
+  };
+  const igl::ExactGeodesic geodesic(V,F);
+  BENCHMARK("ExactGeodesic serial queries ("+size+", 16 sets)")
+  {
+    for(int s = 0;s<VS.size();s++)
+    {
+      Eigen::VectorXd Ds;
+      geodesic.distance(VS[s],Eigen::VectorXi(),VT,Eigen::VectorXi(),Ds);
+      D.col(s) = Ds;
+    }
+    return D.sum();
+  };
+  BENCHMARK("ExactGeodesic parallel batch ("+size+", 16 sets)")
+  {
+    geodesic.distance(VS,{},VT,Eigen::VectorXi(),D);
+    return D.sum();
+  };
+}
@@ -13,6 +13,7 @@
 #include <igl/barycenter.h>
 #include <igl/per_face_normals.h>
 #include <igl/doublearea.h>
+#include <igl/PI.h>
 
 TEST_CASE("fast_winding_number: one_point_cloud", "[igl]")
 {
@@ -50,6 +51,55 @@ TEST_CASE("fast_winding_number: one_point_cloud", "[igl]")
     -0.00362978253577090,
     -0.00041235296362485;
   test_common::assert_near(WiP,WiP_cached,1e-15);
+
+  // Flat octree
+  Eigen::VectorXi O_I;
+  Eigen::MatrixXi O_CR;
+  igl::octree(P,O_I,O_CR,O_CH,O_CN,O_W);
+  igl::fast_winding_number(P,N,A,O_I,O_CR,O_CH,2,O_CM,O_R,O_EC);
+  igl::fast_winding_number(P,N,A,O_I,O_CR,O_CH,O_CM,O_R,O_EC,Q,2,WiP);
+  test_common::assert_near(WiP,WiP_cached,1e-15);
+}
+
+TEST_CASE("fast_winding_number: flat octree matches nested", "[igl]")
+{
+  // Points and normals on a sphere
+  Eigen::MatrixXd P = Eigen::MatrixXd::Random(5000,3).rowwise().normalized();
+  const Eigen::MatrixXd N = P;
+  const Eigen::VectorXd A = Eigen::VectorXd::Constant(P.rows(),4.*igl::PI/P.rows());
+  const Eigen::MatrixXd Q = 1.5*Eigen::MatrixXd::Random(200,3);
+
+  std::vector<std::vector<int > > O_PI;
+  Eigen::MatrixXi O_CH;
+  Eigen::MatrixXd O_CN;
+  Eigen::VectorXd O_W;
+  igl::octree(P,O_PI,O_CH,O_CN,O_W);
+  Eigen::MatrixXd O_CM;
+  Eigen::VectorXd O_R;
+  Eigen::MatrixXd O_EC;
+  Eigen::VectorXi O_I;
+  Eigen::MatrixXi O_CR;
+  Eigen::MatrixXi F_CH;
+  Eigen::MatrixXd F_CN;
+  Eigen::VectorXd F_W;
+  igl::octree(P,O_I,O_CR,F_CH,F_CN,F_W);
+  Eigen::MatrixXd F_CM;
+  Eigen::VectorXd F_R;
+  Eigen::MatrixXd F_EC;
+  for(const int order : {0,1,2})
+  {
+    igl::fast_winding_number(P,N,A,O_PI,O_CH,order,O_CM,O_R,O_EC);
+    igl::fast_winding_number(P,N,A,O_I,O_CR,F_CH,order,F_CM,F_R,F_EC);
+    for(const double beta : {0.,2.})
+    {
+      Eigen::VectorXd W,FW,AW;
+      igl::fast_winding_number(P,N,A,O_PI,O_CH,O_CM,O_R,O_EC,Q,beta,W);
+      igl::fast_winding_number(P,N,A,O_I,O_CR,F_CH,F_CM,F_R,F_EC,Q,beta,FW);
+      test_common::assert_near(W,FW,1e-12);
+      igl::fast_winding_number(P,N,A,Q,order,beta,AW);
+      test_common::assert_near(W,AW,1e-12);
+    }
+  }
 }
 
 TEST_CASE("fast_winding_number: meshes", "[igl]" "[slow]")
@@ -0,0 +1,80 @@
+#include <test_common.h>
+#include <igl/fit_rotations.h>
+#include <string>
+
+namespace
+{
+  // Stacked covariance matrices as built by arap: S.row(i*nr+r) is row i of
+  // the rth matrix
+  Eigen::MatrixXd random_covariances(const int nr)
+  {
+    Eigen::MatrixXd S = Eigen::MatrixXd::Random(3*nr,3);
+    // Include nearly diagonal, reflections and rank deficient matrices
+    for(int r = 0;r<nr;r+=7)
+    {
+      for(int i = 0;i<3;i++)
+      {
+        for(int j = 0;j<3;j++)
+        {
+          S(i*nr+r,j) =
+            (i==j ? (i+1)*(r%2 || i ? 1. : -1.) : 0) + 1e-3*S(i*nr+r,j);
+        }
+      }
+    }
+    for(int r = 3;r<nr;r+=11)
+    {
+      S.row(2*nr+r).setZero();
+    }
+    return S;
+  }
+}
+
+TEST_CASE("fit_rotations: batched matches scalar", "[igl]")
+{
+  for(const int nr : {1,5,16,37,1001})
+  {
+    const Eigen::MatrixXd S = random_covariances(nr);
+    Eigen::MatrixXd R;
+    igl::fit_rotations(S,true,R);
+    for(const int max_lanes : {1,4,8,16})
+    {
+      Eigen::MatrixXd B;
+      igl::fit_rotations_batched(S,max_lanes,B);
+      REQUIRE(B.rows() == 3);
+      REQUIRE(B.cols() == 3*nr);
+      for(int r = 0;r<nr;r++)
+      {
+        const Eigen::Matrix3d Br = B.block(0,3*r,3,3);
+        REQUIRE(Br.determinant() > 0);
+        test_common::assert_near(
+          (Br*Br.transpose()).eval(),Eigen::Matrix3d::Identity(),1e-5);
+      }
+      test_common::assert_near(B,R,1e-4);
+    }
+    Eigen::MatrixXf Rf;
+    igl::fit_rotations_batched(Eigen::MatrixXf(S.cast<float>()),Rf);
+    test_common::assert_near(Eigen::MatrixXd(Rf.cast<double>()),R,1e-4);
+  }
+}
+
+TEST_CASE("fit_rotations: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  const int nr = 200000;
+  const Eigen::MatrixXd S = Eigen::MatrixXd::Random(3*nr,3);
+  Eigen::MatrixXd R;
+  const std::string size = std::to_string(nr)+" rotations";
+  BENCHMARK("fit_rotations ("+size+")")
+  {
+    igl::fit_rotations(S,true,R);
+    return R(0,0);
+  };
+  for(const int max_lanes : {1,4,8,16})
+  {
+    BENCHMARK(
+      "fit_rotations_batched "+std::to_string(max_lanes)+" lanes ("+size+")")
+    {
+      igl::fit_rotations_batched(S,max_lanes,R);
+      return R(0,0);
+    };
+  }
+}
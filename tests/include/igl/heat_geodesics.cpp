@@ -2,6 +2,64 @@
 #include <igl/heat_geodesics.h>
 #include <igl/upsample.h>
 #include <igl/avg_edge_length.h>
+#include <igl/min_quad_with_fixed.h>
+#include <string>
+#include <vector>
+
+namespace
+{
+  // Reference: the single-source-set heat method written out one solve at a
+  // time, independent of igl::heat_geodesics_solve
+  Eigen::VectorXd reference_heat_geodesics(
+    const igl::HeatGeodesicsData<double> & data,
+    const Eigen::VectorXi & gamma)
+  {
+    const int n = data.Grad.cols();
+    Eigen::VectorXd u0 = Eigen::VectorXd::Zero(n);
+    for(int g = 0;g<gamma.size();g++)
+    {
+      u0(gamma(g)) = 1;
+    }
+    Eigen::VectorXd u;
+    igl::min_quad_with_fixed_solve(
+      data.Neumann,u0,Eigen::VectorXd(),Eigen::VectorXd(),u);
+    if(data.b.size()>0)
+    {
+      Eigen::VectorXd uD;
+      igl::min_quad_with_fixed_solve(
+        data.Dirichlet,u0,Eigen::VectorXd::Zero(data.b.size()).eval(),
+        Eigen::VectorXd(),uD);
+      u = 0.5*(u+uD);
+    }
+    Eigen::VectorXd X = data.Grad*u;
+    const int m = data.Grad.rows()/data.ng;
+    for(int i = 0;i<m;i++)
+    {
+      Eigen::VectorXd gi(data.ng);
+      for(int d = 0;d<data.ng;d++) { gi(d) = X(d*m+i); }
+      const double norm = gi.stableNorm();
+      for(int d = 0;d<data.ng;d++)
+      {
+        X(d*m+i) = (norm == 0 || norm != norm) ? 0 : gi(d)/norm;
+      }
+    }
+    Eigen::VectorXd D;
+    igl::min_quad_with_fixed_solve(
+      data.Poisson,(data.Div*X).eval(),Eigen::VectorXd(),
+      Eigen::VectorXd::Zero(1).eval(),D);
+    double Dgamma = 0;
+    for(int g = 0;g<gamma.size();g++)
+    {
+      Dgamma += D(gamma(g));
+    }
+    D.array() -= Dgamma/gamma.size();
+    if(D.mean() < 0)
+    {
+      D = -D;
+    }
+    return D;
+  }
+}
 
 TEST_CASE("heat_geodesic: upsampled cube", "[igl]")
 {
@@ -24,4 +82,80 @@ TEST_CASE("heat_geodesic: upsampled cube", "[igl]")
   REQUIRE((V.row(i)-V.row(0)).norm() == Approx(dist(i)).margin(avg_edge));
   }
 
-}
\ No newline at end of file
+}
+TEST_CASE("heat_geodesic: batched source sets", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::read_triangle_mesh(test_common::data_path("cube.obj"), V, F);
+  igl::upsample(V,F,3);
+  for(const bool with_boundary : {false,true})
+  {
+    Eigen::MatrixXi FF = F;
+    if(with_boundary)
+    {
+      // Open the cube by removing a few faces
+      FF = F.bottomRows(F.rows()-8).eval();
+    }
+    igl::HeatGeodesicsData<double> data;
+    igl::heat_geodesics_precompute(V,FF,data);
+    REQUIRE((data.b.size() > 0) == with_boundary);
+    std::vector<Eigen::VectorXi> gammas;
+    for(int s = 0;s<10;s++)
+    {
+      // 1 to 3 sources per set
+      Eigen::VectorXi gamma(s%3+1);
+      for(int g = 0;g<gamma.size();g++)
+      {
+        gamma(g) = (37*s+101*g)%V.rows();
+      }
+      gammas.push_back(gamma);
+    }
+    Eigen::MatrixXd D;
+    igl::heat_geodesics_solve(data,gammas,D);
+    REQUIRE(D.rows() == V.rows());
+    REQUIRE(D.cols() == gammas.size());
+    for(int s = 0;s<gammas.size();s++)
+    {
+      const Eigen::VectorXd Ds = reference_heat_geodesics(data,gammas[s]);
+      test_common::assert_near(Ds,Eigen::VectorXd(D.col(s)),1e-10);
+      // Single set overload agrees as well
+      Eigen::VectorXd D1;
+      igl::heat_geodesics_solve(data,gammas[s],D1);
+      test_common::assert_near(Ds,D1,1e-10);
+    }
+  }
+}
+
+TEST_CASE("heat_geodesic: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::read_triangle_mesh(test_common::data_path("cube.obj"), V, F);
+  igl::upsample(V,F,6);
+  igl::HeatGeodesicsData<double> data;
+  igl::heat_geodesics_precompute(V,F,data);
+  std::vector<Eigen::VectorXi> gammas;
+  for(int s = 0;s<64;s++)
+  {
+    gammas.push_back((Eigen::VectorXi(1)<<(997*s)%V.rows()).finished());
+  }
+  const std::string size =
+    std::to_string(F.rows())+" faces, "+std::to_string(gammas.size())+" sets";
+  Eigen::MatrixXd D(V.rows(),gammas.size());
+  BENCHMARK("heat_geodesics_solve per source set ("+size+")")
+  {
+    for(int s = 0;s<gammas.size();s++)
+    {
+      Eigen::VectorXd Ds;
+      igl::heat_geodesics_solve(data,gammas[s],Ds);
+      D.col(s) = Ds;
+    }
+    return D.sum();
+  };
+  BENCHMARK("heat_geodesics_solve batched ("+size+")")
+  {
+    igl::heat_geodesics_solve(data,gammas,D);
+    return D.sum();
+  };
+}
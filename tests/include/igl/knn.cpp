@@ -76,3 +76,30 @@ TEST_CASE("knn", "[igl]")
 
 
 }
+
+TEST_CASE("knn: flat octree", "[igl]")
+{
+    const Eigen::MatrixXd V = Eigen::MatrixXd::Random(3000,3);
+    const Eigen::MatrixXd P = Eigen::MatrixXd::Random(500,3);
+    std::vector<std::vector<int> > point_indices;
+    Eigen::Matrix<int,Eigen::Dynamic,8> CH;
+    Eigen::Matrix<double,Eigen::Dynamic,3> CN;
+    Eigen::Matrix<double,Eigen::Dynamic,1> W;
+    igl::octree(V,point_indices,CH,CN,W);
+    Eigen::VectorXi O_I;
+    Eigen::Matrix<int,Eigen::Dynamic,2> O_CR;
+    Eigen::Matrix<int,Eigen::Dynamic,8> O_CH;
+    Eigen::Matrix<double,Eigen::Dynamic,3> O_CN;
+    Eigen::Matrix<double,Eigen::Dynamic,1> O_W;
+    igl::octree(V,O_I,O_CR,O_CH,O_CN,O_W);
+    for(const int k : {1,7,21})
+    {
+        Eigen::MatrixXi I,fI;
+        igl::knn(P,V,k,point_indices,CH,CN,W,I);
+        igl::knn(P,V,k,O_I,O_CR,O_CH,O_CN,O_W,fI);
+        test_common::assert_eq(I,fI);
+        igl::knn(V,k,point_indices,CH,CN,W,I);
+        igl::knn(V,k,O_I,O_CR,O_CH,O_CN,O_W,fI);
+        test_common::assert_eq(I,fI);
+    }
+}
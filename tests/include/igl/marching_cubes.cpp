@@ -0,0 +1,90 @@
+#include <test_common.h>
+#include <igl/marching_cubes.h>
+#include <igl/grid.h>
+#include <string>
+
+namespace
+{
+  // Signed distance to a union of spheres sampled on a res^3 grid
+  void spheres_sdf(
+    const int res,
+    Eigen::MatrixXd & GV,
+    Eigen::VectorXd & S)
+  {
+    igl::grid(Eigen::RowVector3i(res,res,res),GV);
+    const Eigen::MatrixXd C =
+      (Eigen::MatrixXd(3,3)<<0.3,0.3,0.3, 0.7,0.6,0.5, 0.4,0.7,0.8).finished();
+    S.resize(GV.rows());
+    for(int i = 0;i<GV.rows();i++)
+    {
+      S(i) = (C.rowwise()-GV.row(i)).rowwise().norm().minCoeff()-0.25;
+    }
+  }
+
+  // Serial march in the same cube order using the cube-list overload
+  void marching_cubes_serial(
+    const Eigen::VectorXd & S,
+    const Eigen::MatrixXd & GV,
+    const int res,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F)
+  {
+    Eigen::MatrixXi GI((res-1)*(res-1)*(res-1),8);
+    const int ioffset[8] =
+      {0,1,1+res,res,res*res,1+res*res,1+res+res*res,res+res*res};
+    int c = 0;
+    for(int z = 0;z<res-1;z++)
+    {
+      for(int y = 0;y<res-1;y++)
+      {
+        for(int x = 0;x<res-1;x++,c++)
+        {
+          for(int v = 0;v<8;v++)
+          {
+            GI(c,v) = x+res*(y+res*z)+ioffset[v];
+          }
+        }
+      }
+    }
+    igl::marching_cubes(S,GV,GI,0.,V,F);
+  }
+}
+
+TEST_CASE("marching_cubes: slabs match serial march", "[igl]")
+{
+  for(const int res : {2,9,17,40})
+  {
+    Eigen::MatrixXd GV;
+    Eigen::VectorXd S;
+    spheres_sdf(res,GV,S);
+    Eigen::MatrixXd V,sV;
+    Eigen::MatrixXi F,sF;
+    igl::marching_cubes(S,GV,res,res,res,0.,V,F);
+    marching_cubes_serial(S,GV,res,sV,sF);
+    REQUIRE(V.rows() == sV.rows());
+    REQUIRE(F.rows() == sF.rows());
+    test_common::assert_eq(V,sV);
+    test_common::assert_eq(F,sF);
+  }
+}
+
+TEST_CASE("marching_cubes: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  const int res = 200;
+  Eigen::MatrixXd GV;
+  Eigen::VectorXd S;
+  spheres_sdf(res,GV,S);
+  const std::string size = std::to_string(res)+"^3";
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  BENCHMARK("marching_cubes serial cube list ("+size+")")
+  {
+    marching_cubes_serial(S,GV,res,V,F);
+    return F.rows();
+  };
+  BENCHMARK("marching_cubes slabs ("+size+")")
+  {
+    igl::marching_cubes(S,GV,res,res,res,0.,V,F);
+    return F.rows();
+  };
+}
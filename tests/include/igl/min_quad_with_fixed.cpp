@@ -1,6 +1,12 @@
 #include <test_common.h>
 #include <igl/min_quad_with_fixed.h>
+#include <igl/boundary_loop.h>
+#include <igl/cotmatrix.h>
+#include <igl/massmatrix.h>
+#include <igl/triangulated_grid.h>
 #include <igl/EPS.h>
+#include <Eigen/SparseCholesky>
+#include <string>
 
 TEST_CASE("min_quad_with_fixed: dense", "[igl]" )
 {
@@ -16,3 +22,117 @@ TEST_CASE("min_quad_with_fixed: dense", "[igl]" )
   REQUIRE(abs(x(1)- 1.5)<igl::EPS<double>());
   REQUIRE(abs(x(2)- -.5)<igl::EPS<double>());
 }
+
+namespace
+{
+  // Screened Poisson problem on an nu by nu grid with fixed boundary and
+  // optionally a (redundant) linear equality constraint
+  void grid_problem(
+    const int nu,
+    Eigen::SparseMatrix<double> & A,
+    Eigen::VectorXi & b,
+    Eigen::MatrixXd & B)
+  {
+    Eigen::MatrixXd V;
+    Eigen::MatrixXi F;
+    igl::triangulated_grid(nu,nu,V,F);
+    Eigen::SparseMatrix<double> L,M;
+    igl::cotmatrix(V,F,L);
+    igl::massmatrix(V,F,igl::MASSMATRIX_TYPE_VORONOI,M);
+    A = M - L;
+    Eigen::VectorXi bnd;
+    igl::boundary_loop(F,bnd);
+    b = bnd;
+    B = M*V.leftCols(2);
+  }
+}
+
+TEST_CASE("min_quad_with_fixed: cholesky_backends", "[igl]")
+{
+  // Existing callers keep Eigen::SimplicialLLT unless they opt in
+  REQUIRE(igl::min_quad_with_fixed_data<double>().cholesky_backend ==
+    igl::min_quad_with_fixed_data<double>::SIMPLICIAL_CHOLESKY);
+  Eigen::SparseMatrix<double> A;
+  Eigen::VectorXi b;
+  Eigen::MatrixXd B;
+  grid_problem(30,A,b,B);
+  const Eigen::MatrixXd Y = Eigen::MatrixXd::Random(b.size(),2);
+  // Two copies of the same constraint on an interior vertex: not linearly
+  // independent so QR_LLT is used
+  const int interior = 15*30+15;
+  Eigen::SparseMatrix<double> Aeq(2,A.rows());
+  Aeq.insert(0,interior) = 1;
+  Aeq.insert(1,interior) = 1;
+  const Eigen::MatrixXd Beq = Eigen::MatrixXd::Constant(2,2,0.5);
+  for(const bool use_Aeq : {false,true})
+  {
+    const Eigen::SparseMatrix<double> Aeq_or_empty =
+      use_Aeq ? Aeq : Eigen::SparseMatrix<double>();
+    const Eigen::MatrixXd Beq_or_empty = use_Aeq ? Beq : Eigen::MatrixXd();
+    Eigen::MatrixXd Z[igl::min_quad_with_fixed_data<double>::NUM_CHOLESKY_BACKENDS];
+    for(int backend = 0;
+      backend<igl::min_quad_with_fixed_data<double>::NUM_CHOLESKY_BACKENDS;
+      backend++)
+    {
+      igl::min_quad_with_fixed_data<double> data;
+      data.cholesky_backend =
+        igl::min_quad_with_fixed_data<double>::CholeskyBackend(backend);
+      // Custom backend wrapping another Eigen solver
+      Eigen::SimplicialLDLT<Eigen::SparseMatrix<double> > ldlt;
+      data.custom_factorize = [&ldlt](const Eigen::SparseMatrix<double> & A)
+      {
+        ldlt.compute(A);
+        return ldlt.info() == Eigen::Success;
+      };
+      data.custom_solve = [&ldlt](const Eigen::MatrixXd & B)->Eigen::MatrixXd
+      {
+        return ldlt.solve(B);
+      };
+      REQUIRE(igl::min_quad_with_fixed_precompute(
+        A,b,Aeq_or_empty,true,data));
+      REQUIRE(data.solver_type == (use_Aeq ?
+        igl::min_quad_with_fixed_data<double>::QR_LLT :
+        igl::min_quad_with_fixed_data<double>::LLT));
+      REQUIRE(igl::min_quad_with_fixed_solve(data,B,Y,Beq_or_empty,Z[backend]));
+      test_common::assert_near(Z[backend],Z[0],1e-10);
+    }
+    if(use_Aeq)
+    {
+      REQUIRE(Z[0](interior,0) == Approx(0.5));
+    }
+  }
+}
+
+TEST_CASE("min_quad_with_fixed: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  for(const int nu : {50,100,200})
+  {
+    Eigen::SparseMatrix<double> A;
+    Eigen::VectorXi b;
+    Eigen::MatrixXd B;
+    grid_problem(nu,A,b,B);
+    const Eigen::MatrixXd Y = Eigen::MatrixXd::Zero(b.size(),2);
+    const std::string size = std::to_string(A.rows())+" vertices";
+    for(const auto backend : {
+      igl::min_quad_with_fixed_data<double>::SIMPLICIAL_CHOLESKY,
+      igl::min_quad_with_fixed_data<double>::SUPERNODAL_CHOLESKY})
+    {
+      const std::string name = std::string(
+        backend == igl::min_quad_with_fixed_data<double>::SIMPLICIAL_CHOLESKY ?
+        "simplicial" : "supernodal")+", "+size;
+      igl::min_quad_with_fixed_data<double> data;
+      data.cholesky_backend = backend;
+      BENCHMARK("precompute ("+name+")")
+      {
+        return igl::min_quad_with_fixed_precompute(
+          A,b,Eigen::SparseMatrix<double>(),true,data);
+      };
+      Eigen::MatrixXd Z;
+      BENCHMARK("solve ("+name+")")
+      {
+        igl::min_quad_with_fixed_solve(data,B,Y,Eigen::MatrixXd(),Z);
+        return Z.sum();
+      };
+    }
+  }
+}
@@ -0,0 +1,100 @@
+#include <test_common.h>
+#include <igl/octree.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+TEST_CASE("octree: flat matches nested", "[igl]")
+{
+  const Eigen::MatrixXd P = Eigen::MatrixXd::Random(2000,3).array().cube();
+  std::vector<std::vector<int> > point_indices;
+  Eigen::MatrixXi CH;
+  Eigen::MatrixXd CN;
+  Eigen::VectorXd W;
+  igl::octree(P,point_indices,CH,CN,W);
+  Eigen::VectorXi I;
+  Eigen::MatrixXi CR,fCH;
+  Eigen::MatrixXd fCN;
+  Eigen::VectorXd fW;
+  igl::octree(P,I,CR,fCH,fCN,fW);
+  REQUIRE(fCH.rows() == CH.rows());
+  REQUIRE(CR.rows() == fCH.rows());
+  {
+    Eigen::VectorXi sI = I;
+    std::sort(sI.data(),sI.data()+sI.size());
+    test_common::assert_eq(sI,Eigen::VectorXi::LinSpaced(P.rows(),0,P.rows()-1));
+  }
+  // Walk both trees in lock step
+  const std::function<void(int,int)> compare = [&](const int c, const int f)
+  {
+    REQUIRE(fCN.row(f) == CN.row(c));
+    REQUIRE(fW(f) == W(c));
+    std::vector<int> flat(I.data()+CR(f,0),I.data()+CR(f,1));
+    std::vector<int> nested = point_indices[c];
+    std::sort(flat.begin(),flat.end());
+    std::sort(nested.begin(),nested.end());
+    REQUIRE(flat == nested);
+    REQUIRE((fCH(f,0) == -1) == (CH(c,0) == -1));
+    if(CH(c,0) != -1)
+    {
+      for(int i = 0;i<8;i++)
+      {
+        REQUIRE(CR(fCH(f,i),0) == (i==0 ? CR(f,0) : CR(fCH(f,i-1),1)));
+        compare(CH(c,i),fCH(f,i));
+      }
+      REQUIRE(CR(fCH(f,7),1) == CR(f,1));
+    }
+  };
+  compare(0,0);
+}
+
+TEST_CASE("octree: flat duplicate points", "[igl]")
+{
+  Eigen::MatrixXd P(6,3);
+  P<<
+    0,0,0,
+    1,1,1,
+    1,1,1,
+    0,0,1,
+    1,1,1,
+    0,0,0;
+  Eigen::VectorXi I;
+  Eigen::MatrixXi CR,CH;
+  Eigen::MatrixXd CN;
+  Eigen::VectorXd W;
+  igl::octree(P,I,CR,CH,CN,W);
+  // Root and its 8 children: copies of a point share a leaf
+  REQUIRE(CH.rows() == 9);
+  REQUIRE(CR(CH(0,0),1)-CR(CH(0,0),0) == 2);
+  REQUIRE(CR(CH(0,4),1)-CR(CH(0,4),0) == 1);
+  REQUIRE(CR(CH(0,7),1)-CR(CH(0,7),0) == 3);
+  // Stable within a leaf
+  test_common::assert_eq(I,(Eigen::VectorXi(6)<<0,5,3,1,2,4).finished());
+  // All the same point
+  igl::octree(Eigen::MatrixXd(P.topRows(1)),I,CR,CH,CN,W);
+  REQUIRE(CH.rows() == 1);
+  REQUIRE(W(0) == 0);
+}
+
+TEST_CASE("octree: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  const Eigen::MatrixXd P = Eigen::MatrixXd::Random(1000000,3);
+  BENCHMARK("octree nested (1M points)")
+  {
+    std::vector<std::vector<int> > point_indices;
+    Eigen::MatrixXi CH;
+    Eigen::MatrixXd CN;
+    Eigen::VectorXd W;
+    igl::octree(P,point_indices,CH,CN,W);
+    return CH.rows();
+  };
+  BENCHMARK("octree flat (1M points)")
+  {
+    Eigen::VectorXi I;
+    Eigen::MatrixXi CR,CH;
+    Eigen::MatrixXd CN;
+    Eigen::VectorXd W;
+    igl::octree(P,I,CR,CH,CN,W);
+    return CH.rows();
+  };
+}
@@ -0,0 +1,164 @@
+#include <test_common.h>
+#include <igl/parallel_for.h>
+#include <atomic>
+#include <cmath>
+#include <thread>
+#include <vector>
+
+namespace
+{
+  // Previous implementation of igl::parallel_for: start num_threads threads
+  // on even slices of the loop and join them
+  template <typename FunctionType>
+  void spawn_threads_for(
+    const int loop_size,
+    const FunctionType & func,
+    const int num_threads)
+  {
+    std::vector<std::thread> threads;
+    threads.reserve(num_threads);
+    for(int t = 0;t<num_threads;t++)
+    {
+      const int k1 = (loop_size*t)/num_threads;
+      const int k2 = (loop_size*(t+1))/num_threads;
+      threads.emplace_back([&func,k1,k2]{ for(int k = k1;k<k2;k++) func(k); });
+    }
+    for(std::thread & thread : threads) { thread.join(); }
+  }
+
+  // Some work whose cost grows with i
+  double uneven_work(const int i)
+  {
+    double s = 0;
+    for(int j = 0;j<i;j++) { s += std::sqrt(double(j+i)); }
+    return s;
+  }
+}
+
+TEST_CASE("parallel_for: sum", "[igl]")
+{
+  const int n = 10000;
+  Eigen::VectorXd X = Eigen::VectorXd::LinSpaced(n,0,n-1);
+  double sum = 0;
+  Eigen::VectorXd S;
+  igl::parallel_for(
+    n,
+    [&S](const int n){ S = Eigen::VectorXd::Zero(n); },
+    [&X,&S](const int i, const int t){ S(t) += X(i); },
+    [&S,&sum](const int t){ sum += S(t); },
+    100);
+  REQUIRE(sum == X.sum());
+  // Each iteration exactly once
+  std::vector<std::atomic<int> > count(n);
+  for(auto & c : count) { c = 0; }
+  igl::parallel_for(n,[&count](const int i){ count[i]++; });
+  for(const auto & c : count) { REQUIRE(c == 1); }
+  // Index passed by reference and unsigned index
+  igl::parallel_for(size_t(n),[&count](size_t & i){ count[i]--; });
+  for(const auto & c : count) { REQUIRE(c == 0); }
+}
+
+TEST_CASE("parallel_for: pool", "[igl]")
+{
+  // Use a pool of its own since igl::default_num_threads() may be 1
+  for(const size_t num_threads : {1,2,4,7})
+  {
+    igl::internal::ThreadPool pool(num_threads);
+    REQUIRE(pool.num_threads() == num_threads);
+    for(const size_t n : {1,3,100,10007})
+    {
+      std::vector<std::atomic<int> > count(n);
+      for(auto & c : count) { c = 0; }
+      std::vector<std::atomic<int> > busy(num_threads);
+      for(auto & b : busy) { b = 0; }
+      // (Catch2 assertions are not thread-safe)
+      std::atomic<bool> bad_thread_id(false);
+      pool.run(n,[&](const size_t begin, const size_t end, const size_t t)
+      {
+        if(t >= num_threads) { bad_thread_id = true; return; }
+        // No two concurrent chunks share a thread id
+        if(busy[t]++ != 0) { bad_thread_id = true; }
+        for(size_t i = begin;i<end;i++)
+        {
+          count[i] += 1+int(uneven_work(int(i%64))>1e10);
+        }
+        busy[t]--;
+      });
+      REQUIRE(!bad_thread_id);
+      for(const auto & c : count) { REQUIRE(c == 1); }
+    }
+  }
+}
+
+TEST_CASE("parallel_for: nested", "[igl]")
+{
+  const int m = 50;
+  const int n = 200;
+  igl::internal::ThreadPool pool(4);
+  // Nested runs on the same pool
+  std::vector<std::atomic<int> > count(m*n);
+  for(auto & c : count) { c = 0; }
+  pool.run(m,[&](const size_t begin, const size_t end, const size_t)
+  {
+    for(size_t i = begin;i<end;i++)
+    {
+      pool.run(n,[&](const size_t b, const size_t e, const size_t)
+      {
+        for(size_t j = b;j<e;j++) { count[i*n+j]++; }
+      });
+    }
+  });
+  for(const auto & c : count) { REQUIRE(c == 1); }
+  // Nested igl::parallel_for with accumulation
+  Eigen::VectorXd row_sums(m);
+  igl::parallel_for(m,[&](const int i)
+  {
+    Eigen::VectorXd S;
+    double sum = 0;
+    igl::parallel_for(
+      n,
+      [&S](const int n){ S = Eigen::VectorXd::Zero(n); },
+      [&S,i](const int j, const int t){ S(t) += i*j; },
+      [&S,&sum](const int t){ sum += S(t); });
+    row_sums(i) = sum;
+  });
+  for(int i = 0;i<m;i++) { REQUIRE(row_sums(i) == i*(n*(n-1)/2)); }
+}
+
+TEST_CASE("parallel_for: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  const int num_threads = igl::default_num_threads();
+  // Call overhead: many short loops
+  const int num_calls = 1000;
+  const int small_n = 64;
+  Eigen::VectorXd X = Eigen::VectorXd::Zero(small_n);
+  BENCHMARK("short loops (spawn threads)")
+  {
+    for(int c = 0;c<num_calls;c++)
+    {
+      spawn_threads_for(small_n,[&X](const int i){ X(i) += 1; },num_threads);
+    }
+    return X.sum();
+  };
+  BENCHMARK("short loops (igl::parallel_for)")
+  {
+    for(int c = 0;c<num_calls;c++)
+    {
+      igl::parallel_for(small_n,[&X](const int i){ X(i) += 1; });
+    }
+    return X.sum();
+  };
+  // Load balance: cost of iteration i grows linearly with i
+  const int n = 20000;
+  Eigen::VectorXd Y(n);
+  BENCHMARK("uneven loop (spawn threads)")
+  {
+    spawn_threads_for(n,[&Y](const int i){ Y(i) = uneven_work(i); },num_threads);
+    return Y.sum();
+  };
+  BENCHMARK("uneven loop (igl::parallel_for)")
+  {
+    igl::parallel_for(n,[&Y](const int i){ Y(i) = uneven_work(i); });
+    return Y.sum();
+  };
+}
@@ -1,6 +1,8 @@
 #include <test_common.h>
 #include <igl/principal_curvature.h>
 #include <igl/cylinder.h>
+#include <string>
+#include <vector>
 
 TEST_CASE("principal_curvature: cylinder", "[igl]")
 {
@@ -26,4 +28,120 @@ TEST_CASE("principal_curvature: cylinder", "[igl]")
     //max curvature is greater than or equal to min curvature
     REQUIRE (PV1[i]>=PV2[i]);
   }
-}
\ No newline at end of file
+}
+
+TEST_CASE("principal_curvature: sphere", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(4,V,F);
+  V *= 2.0;
+  for(const bool useKring : {true,false})
+  {
+    Eigen::MatrixXd PD1,PD2;
+    Eigen::VectorXd PV1,PV2;
+    std::vector<int> bad;
+    igl::principal_curvature(V,F,PD1,PD2,PV1,PV2,bad,5,useKring);
+    REQUIRE(bad.empty());
+    test_common::assert_near(
+      Eigen::VectorXd(PV1.cwiseAbs()),Eigen::VectorXd::Constant(V.rows(),0.5),0.03);
+    test_common::assert_near(
+      Eigen::VectorXd(PV2.cwiseAbs()),Eigen::VectorXd::Constant(V.rows(),0.5),0.03);
+    // Tangent, orthogonal directions
+    for(int i = 0;i<V.rows();i++)
+    {
+      REQUIRE(std::abs(PD1.row(i).dot(V.row(i).normalized())) < 1e-2);
+      REQUIRE(std::abs(PD2.row(i).dot(V.row(i).normalized())) < 1e-2);
+      REQUIRE(std::abs(PD1.row(i).dot(PD2.row(i))) < 1e-6);
+    }
+    // Same result with the overload without bad vertices
+    Eigen::MatrixXd QD1,QD2;
+    Eigen::VectorXd QV1,QV2;
+    igl::principal_curvature(V,F,QD1,QD2,QV1,QV2,5,useKring);
+    test_common::assert_eq(PD1,QD1);
+    test_common::assert_eq(PD2,QD2);
+    test_common::assert_eq(PV1,QV1);
+    test_common::assert_eq(PV2,QV2);
+  }
+}
+
+TEST_CASE("principal_curvature: matches reference values", "[igl]")
+{
+  // Ellipsoid so that curvatures vary over the mesh
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(1,V,F);
+  V = V*Eigen::Vector3d(1.5,1.0,0.7).asDiagonal();
+  Eigen::MatrixXd PD1,PD2;
+  Eigen::VectorXd PV1,PV2;
+  igl::principal_curvature(V,F,PD1,PD2,PV1,PV2);
+  // PV1, PV2 and PD1 of the original per-vertex implementation (up to
+  // rounding differences across compilers and platforms)
+  Eigen::MatrixXd R(42,5);
+  R<<
+    3.4446921587745636,0.78650273443472163, -0.00048985920024563478,-0.00020183309030244456,0.99999985965067395,
+    3.4427270700276091,0.78846782318167852, 0.002786361897992585,-0.0011480442386113954,-0.99999545908058984,
+    3.444692158774564,0.78650273443472185, -0.0004898592002451907,0.00020183309030225027,-0.99999985965067395,
+    3.4446921587745636,0.78650273443472163, 0.00048985920024563478,0.00020183309030244456,0.99999985965067395,
+    1.2523617933603726,0.48184853263953248, -1.1102230246251568e-16,-0.91779304118656346,-0.39705910586399984,
+    1.2523617933603735,0.48184853263953298, 2.2204460492503131e-16,-0.91779304118656357,0.39705910586399978,
+    1.2523617933603732,0.48184853263953337, 0,0.91779304118656357,-0.39705910586399984,
+    1.2223777748939078,0.52303380014807488, -0.0027086353466980739,-0.9177896743917886,-0.39705764930847687,
+    1.6201984120542183,0.89975576597357732, 2.7755575615628914e-16,-1,3.2612801348363978e-16,
+    1.4717528009377445,0.9065246267325785, -5.5511151231257827e-17,-1,5.5511151231257827e-17,
+    1.6201984120542181,0.89975576597357698, 2.2204460492503131e-16,-1,-1.6653345369377346e-16,
+    1.4717528009377465,0.90652462673257905, 1.9428902930940242e-16,-1,4.1633363423443376e-17,
+    2.3338006909728595,0.98806965855961393, -0.10066138300489255,0.59526772635854563,-0.79719735318644269,
+    1.2573389678229803,0.57981025741052228, -0.029839091156694007,0.96345296495344257,-0.26621046741509458,
+    1.8817108977692472,0.61637592328394308, -0.0034544085010039249,-0.66234480644433613,0.74919118016573261,
+    1.8817108977692474,0.61637592328394297, -0.0034544085010038148,0.66234480644433613,-0.7491911801657325,
+    3.0661414901648869,0.72958449779289913, -0.0063237577452819049,3.1666262892324237e-17,0.99998000484408645,
+    1.8817108977692474,0.61637592328394331, 0.0034544085010039809,-0.66234480644433624,-0.74919118016573238,
+    1.8817108977692474,0.61637592328394308, 0.0034544085010039809,0.66234480644433624,0.74919118016573238,
+    1.2573389678229818,0.5798102574105225, 0.029839091156694249,-0.96345296495344268,-0.26621046741509463,
+    2.3338006909728599,0.98806965855961382, 0.10066138300489225,-0.59526772635854586,-0.79719735318644269,
+    3.8680697644992157,2.3733437743104417, 0,0,-1,
+    1.2573389678229803,0.57981025741052217, -0.029839091156694031,-0.96345296495344257,0.26621046741509458,
+    2.3338006909728586,0.98806965855961348, -0.1006613830048924,-0.59526772635854563,0.79719735318644269,
+    1.2573389678229814,0.57981025741052239, 0.029839091156694034,0.96345296495344268,0.26621046741509463,
+    1.1008939108203908,0.43953611638766232, 0.10714066011467832,0.99424387297593686,0,
+    2.3338006909728599,0.9880696585596136, -0.10066138300489264,-0.59526772635854552,0.79719735318644291,
+    2.333800690972859,0.98806965855961371, 0.1006613830048923,0.59526772635854575,0.79719735318644269,
+    1.2367857593192328,0.41841189227382669, -0.063934560520175029,0.99795409311806138,-0,
+    1.2573389678229816,0.57981025741052283, -0.029839091156694194,-0.96345296495344268,0.26621046741509463,
+    2.3338006909728581,0.98806965855961348, 0.10066138300489214,0.59526772635854575,0.79719735318644269,
+    1.2573389678229809,0.57981025741052283, 0.0298390911566941,0.96345296495344246,0.26621046741509452,
+    2.3338006909728595,0.98806965855961393, 0.10066138300489255,-0.59526772635854563,-0.79719735318644269,
+    1.2573389678229803,0.57981025741052228, 0.029839091156693889,-0.96345296495344257,-0.26621046741509458,
+    1.8817108977692472,0.61637592328394308, 0.0034544085010039249,0.66234480644433613,0.74919118016573261,
+    1.8817108977692472,0.61637592328394297, 0.0034544085010039809,-0.66234480644433624,-0.7491911801657325,
+    3.0661414901648874,0.72958449779289913, -0.006323757745281911,3.1666262892324231e-17,-0.99998000484408633,
+    1.8817108977692474,0.61637592328394286, -0.0034544085010039809,0.66234480644433624,-0.74919118016573238,
+    1.8817108977692474,0.61637592328394308, -0.0034544085010039809,-0.66234480644433624,0.74919118016573238,
+    1.2573389678229818,0.5798102574105225, -0.029839091156694166,0.96345296495344268,-0.26621046741509463,
+    2.3338006909728599,0.98806965855961382, -0.10066138300489225,0.59526772635854586,-0.79719735318644269,
+    4.2715390590408919,2.3538021011197081, 0,-0.10748056467407822,0.99420718576026257;
+  test_common::assert_near(PV1,Eigen::VectorXd(R.col(0)),1e-12);
+  test_common::assert_near(PV2,Eigen::VectorXd(R.col(1)),1e-12);
+  test_common::assert_near(PD1,Eigen::MatrixXd(R.rightCols(3)),1e-12);
+}
+
+TEST_CASE("principal_curvature: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(6,V,F);
+  const std::string size = std::to_string(V.rows())+" vertices";
+  Eigen::MatrixXd PD1,PD2;
+  Eigen::VectorXd PV1,PV2;
+  BENCHMARK("principal_curvature k-ring ("+size+")")
+  {
+    igl::principal_curvature(V,F,PD1,PD2,PV1,PV2,5,true);
+    return PV1.sum();
+  };
+  BENCHMARK("principal_curvature sphere ("+size+")")
+  {
+    igl::principal_curvature(V,F,PD1,PD2,PV1,PV2,5,false);
+    return PV1.sum();
+  };
+}
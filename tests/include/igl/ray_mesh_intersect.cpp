@@ -0,0 +1,119 @@
+#include <test_common.h>
+#include <igl/ray_mesh_intersect.h>
+#include <igl/AABB.h>
+#include <igl/triangulated_grid.h>
+#include <random>
+
+namespace
+{
+  // Stack of crumpled n by n grids so that rays hit many faces
+  void layered_grids(
+    const int n,
+    const int num_layers,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F)
+  {
+    Eigen::MatrixXd GV;
+    Eigen::MatrixXi GF;
+    igl::triangulated_grid(n,n,GV,GF);
+    V.resize(GV.rows()*num_layers,3);
+    F.resize(GF.rows()*num_layers,3);
+    std::mt19937 gen(0);
+    std::uniform_real_distribution<double> noise(-0.01,0.01);
+    for(int l = 0;l<num_layers;l++)
+    {
+      for(int v = 0;v<GV.rows();v++)
+      {
+        V.row(l*GV.rows()+v) <<
+          GV(v,0),GV(v,1),0.05*l+noise(gen);
+      }
+      F.block(l*GF.rows(),0,GF.rows(),3) = GF.array()+l*GV.rows();
+    }
+  }
+}
+
+TEST_CASE("ray_mesh_intersect: AABB", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  layered_grids(20,20,V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> unif(0,1);
+  std::normal_distribution<double> normal;
+  for(int r = 0;r<200;r++)
+  {
+    const Eigen::RowVector3d source(unif(gen),unif(gen),-1);
+    Eigen::RowVector3d dir(0.3*normal(gen),0.3*normal(gen),1);
+    if(r%10 == 0)
+    {
+      // Axis aligned
+      dir << 0,0,1;
+    }
+    std::vector<igl::Hit> hits,tree_hits;
+    const bool ret = igl::ray_mesh_intersect(source,dir,V,F,hits);
+    const bool tree_ret = igl::ray_mesh_intersect(source,dir,V,F,tree,tree_hits);
+    REQUIRE(ret == tree_ret);
+    REQUIRE(hits.size() == tree_hits.size());
+    for(size_t h = 0;h<hits.size();h++)
+    {
+      REQUIRE(hits[h].id == tree_hits[h].id);
+      REQUIRE(hits[h].t == tree_hits[h].t);
+      REQUIRE(hits[h].u == tree_hits[h].u);
+      REQUIRE(hits[h].v == tree_hits[h].v);
+    }
+    igl::Hit hit,tree_hit;
+    REQUIRE(
+      igl::ray_mesh_intersect(source,dir,V,F,hit) ==
+      igl::ray_mesh_intersect(source,dir,V,F,tree,tree_hit));
+    if(ret)
+    {
+      REQUIRE(hit.id == tree_hit.id);
+      REQUIRE(hit.t == tree_hit.t);
+    }
+  }
+}
+
+TEST_CASE("ray_mesh_intersect: AABB benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  layered_grids(100,50,V,F);
+  igl::AABB<Eigen::MatrixXd,3> tree;
+  tree.init(V,F);
+  std::mt19937 gen(0);
+  std::uniform_real_distribution<double> unif(0,1);
+  std::normal_distribution<double> normal;
+  const int num_rays = 1000;
+  Eigen::MatrixXd S(num_rays,3),D(num_rays,3);
+  for(int r = 0;r<num_rays;r++)
+  {
+    S.row(r) << unif(gen),unif(gen),-1;
+    D.row(r) << 0.3*normal(gen),0.3*normal(gen),1;
+  }
+  BENCHMARK("all hits")
+  {
+    int num_hits = 0;
+    std::vector<igl::Hit> hits;
+    for(int r = 0;r<num_rays;r++)
+    {
+      igl::ray_mesh_intersect(
+        Eigen::RowVector3d(S.row(r)),Eigen::RowVector3d(D.row(r)),V,F,tree,hits);
+      num_hits += hits.size();
+    }
+    return num_hits;
+  };
+  BENCHMARK("first hit")
+  {
+    int num_hits = 0;
+    igl::Hit hit;
+    for(int r = 0;r<num_rays;r++)
+    {
+      num_hits += igl::ray_mesh_intersect(
+        Eigen::RowVector3d(S.row(r)),Eigen::RowVector3d(D.row(r)),V,F,tree,hit);
+    }
+    return num_hits;
+  };
+}
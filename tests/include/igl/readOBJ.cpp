@@ -1,5 +1,10 @@
 #include <igl/readOBJ.h>
+#include <igl/list_to_matrix.h>
+#include <igl/triangulated_grid.h>
+#include <igl/writeOBJ.h>
 #include <test_common.h>
+#include <fstream>
+#include <iomanip>
 #include <iostream>
 #include <string>
 #include <tuple>
@@ -39,3 +44,137 @@ TEST_CASE("readOBJ: Obj with material", "[igl]")
     }
     REQUIRE (FM.size() == 2);
 }
+
+namespace
+{
+  // Read with the std::vector overload and convert to matrices
+  bool readOBJ_lists(
+    const std::string & path,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXd & TC,
+    Eigen::MatrixXd & N,
+    Eigen::MatrixXi & F,
+    Eigen::MatrixXi & FTC,
+    Eigen::MatrixXi & FN)
+  {
+    std::vector<std::vector<double> > vV,vTC,vN;
+    std::vector<std::vector<int> > vF,vFTC,vFN;
+    return
+      igl::readOBJ(path,vV,vTC,vN,vF,vFTC,vFN) &&
+      igl::list_to_matrix(vV,V) &&
+      igl::list_to_matrix(vTC,TC) &&
+      igl::list_to_matrix(vN,N) &&
+      igl::list_to_matrix(vF,F) &&
+      (vFTC.empty() || vFTC[0].empty() || igl::list_to_matrix(vFTC,FTC)) &&
+      (vFN.empty() || vFN[0].empty() || igl::list_to_matrix(vFN,FN));
+  }
+}
+
+TEST_CASE("readOBJ: matrices match lists", "[igl]")
+{
+  const std::string path = "readOBJ_test_matrices.obj";
+  {
+    std::ofstream f(path);
+    f<<
+      "# comment\n"
+      "mtllib cube.mtl\n"
+      "v 0 0 0\n"
+      "v 1 0 0 # trailing comment\n"
+      "v\t1.5e0 1 -0.0\n"
+      "v 0 1e-3 .5\r\n"
+      "vt 0 0\n"
+      "vt 1 0\n"
+      "vt 0.333333333333333314829616256247 1\n"
+      "vn 0 0 1\n"
+      "g group\n"
+      "usemtl material\n"
+      "f 1/1/1 2/2/1 3/3/1\n"
+      "f -4/-3/-1 -2/-1/-1 -1/-1/-1\n"
+      "s off\n"
+      "f 1/1/1 3/3/1 4/3/1";
+  }
+  Eigen::MatrixXd V1,TC1,N1,V2,TC2,N2;
+  Eigen::MatrixXi F1,FTC1,FN1,F2,FTC2,FN2;
+  REQUIRE(readOBJ_lists(path,V1,TC1,N1,F1,FTC1,FN1));
+  REQUIRE(igl::readOBJ(path,V2,TC2,N2,F2,FTC2,FN2));
+  REQUIRE(V2.rows() == 4);
+  REQUIRE(F2.rows() == 3);
+  test_common::assert_eq(V1,V2);
+  test_common::assert_eq(TC1,TC2);
+  test_common::assert_eq(N1,N2);
+  test_common::assert_eq(F1,F2);
+  test_common::assert_eq(FTC1,FTC2);
+  test_common::assert_eq(FN1,FN2);
+}
+
+TEST_CASE("readOBJ: polygons", "[igl]")
+{
+  const std::string path = "readOBJ_test_polygons.obj";
+  {
+    std::ofstream f(path);
+    f<<"v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\nv 2 2 2\nf 1 2 3 4\nf 2 -1 3\n";
+  }
+  Eigen::MatrixXd V;
+  Eigen::VectorXi I,C;
+  REQUIRE(igl::readOBJ(path,V,I,C));
+  REQUIRE(V.rows() == 5);
+  test_common::assert_eq(I,(Eigen::VectorXi(7)<<0,1,2,3,1,4,2).finished());
+  test_common::assert_eq(C,(Eigen::VectorXi(3)<<0,4,7).finished());
+  // Mixed degrees do not fit in a matrix
+  Eigen::MatrixXi F;
+  REQUIRE(!igl::readOBJ(path,V,F));
+}
+
+TEST_CASE("readOBJ: large", "[igl]")
+{
+  // Large enough to be parsed in several chunks
+  Eigen::MatrixXd V2;
+  Eigen::MatrixXi F2;
+  igl::triangulated_grid(200,200,V2,F2);
+  Eigen::MatrixXd V(V2.rows(),3);
+  V<<V2,Eigen::VectorXd::Random(V2.rows());
+  Eigen::MatrixXd N = V.rowwise().normalized();
+  const std::string path = "readOBJ_test_large.obj";
+  REQUIRE(igl::writeOBJ(path,V,F2,N,F2,V2,F2));
+  Eigen::MatrixXd V1,TC1,N1,Vr,TCr,Nr;
+  Eigen::MatrixXi F1,FTC1,FN1,Fr,FTCr,FNr;
+  REQUIRE(readOBJ_lists(path,V1,TC1,N1,F1,FTC1,FN1));
+  REQUIRE(igl::readOBJ(path,Vr,TCr,Nr,Fr,FTCr,FNr));
+  test_common::assert_eq(V1,Vr);
+  test_common::assert_eq(TC1,TCr);
+  test_common::assert_eq(N1,Nr);
+  test_common::assert_eq(F1,Fr);
+  test_common::assert_eq(FTC1,FTCr);
+  test_common::assert_eq(FN1,FNr);
+  test_common::assert_eq(F2,Fr);
+}
+
+TEST_CASE("readOBJ: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  for(const int nu : {100,300,1000})
+  {
+    Eigen::MatrixXd V2;
+    Eigen::MatrixXi F;
+    igl::triangulated_grid(nu,nu,V2,F);
+    Eigen::MatrixXd V(V2.rows(),3);
+    V<<V2,Eigen::VectorXd::Random(V2.rows());
+    const Eigen::MatrixXd N = V.rowwise().normalized();
+    const std::string path = "readOBJ_benchmark.obj";
+    REQUIRE(igl::writeOBJ(path,V,F,N,F,V2,F));
+    std::ifstream file(path,std::ios::binary | std::ios::ate);
+    const double megabytes = double(file.tellg())/1e6;
+    file.close();
+    // Throughput in MB/s is megabytes divided by the mean time in seconds
+    const std::string size = STR(std::fixed<<std::setprecision(1)<<megabytes);
+    Eigen::MatrixXd Vr,TC,CN;
+    Eigen::MatrixXi Fr,FTC,FN;
+    BENCHMARK("readOBJ lists + list_to_matrix ("+size+" MB)")
+    {
+      return readOBJ_lists(path,Vr,TC,CN,Fr,FTC,FN);
+    };
+    BENCHMARK("readOBJ matrices ("+size+" MB)")
+    {
+      return igl::readOBJ(path,Vr,TC,CN,Fr,FTC,FN);
+    };
+  }
+}
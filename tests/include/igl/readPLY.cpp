@@ -1,6 +1,11 @@
 #include <test_common.h>
 #include <igl/readPLY.h>
+#include <igl/writePLY.h>
+#include <igl/triangulated_grid.h>
+#include <cstdio>
+#include <cstring>
 #include <fstream>
+#include <iomanip>
 #include <string>
 #include <vector>
 
@@ -137,4 +142,171 @@ TEST_CASE("readPLY: quad_cube.ply", "[igl]")
     REQUIRE (V.cols() == 3);
     REQUIRE (F.rows() == 6);
     REQUIRE (F.cols() == 4);
-}
\ No newline at end of file
+    std::remove("quad_cube.ply");
+}
+
+namespace
+{
+  // Read through tinyply from a stream, bypassing the memory mapped reader
+  template <typename DerivedV, typename DerivedF, typename DerivedD>
+  bool readPLY_stream(
+    const std::string & path,
+    Eigen::PlainObjectBase<DerivedV> & V,
+    Eigen::PlainObjectBase<DerivedF> & F,
+    Eigen::PlainObjectBase<DerivedF> & E,
+    Eigen::PlainObjectBase<DerivedV> & N,
+    Eigen::PlainObjectBase<DerivedV> & UV,
+    Eigen::PlainObjectBase<DerivedD> & VD,
+    std::vector<std::string> & Vheader,
+    Eigen::PlainObjectBase<DerivedD> & FD,
+    std::vector<std::string> & Fheader,
+    Eigen::PlainObjectBase<DerivedD> & ED,
+    std::vector<std::string> & Eheader,
+    std::vector<std::string> & comments)
+  {
+    std::ifstream f(path,std::ios::binary);
+    return igl::readPLY(f,V,F,E,N,UV,VD,Vheader,FD,Fheader,ED,Eheader,comments);
+  }
+}
+
+TEST_CASE("readPLY: binary matches stream reader", "[igl]")
+{
+  Eigen::MatrixXd V2;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(30,20,V2,F);
+  Eigen::MatrixXd V(V2.rows(),3);
+  V<<V2,Eigen::VectorXd::Random(V2.rows());
+  const Eigen::MatrixXd N = V.rowwise().normalized();
+  const Eigen::MatrixXd VD = Eigen::MatrixXd::Random(V.rows(),2);
+  const Eigen::MatrixXd FD = Eigen::MatrixXd::Random(F.rows(),2);
+  const std::vector<std::string> Vheader = {"confidence","intensity"};
+  const std::vector<std::string> Fheader = {"quality","area"};
+  const std::vector<std::string> comments = {"first","second"};
+  Eigen::MatrixXi E(0,2);
+  for(const auto encoding : {igl::FileEncoding::Binary,igl::FileEncoding::Ascii})
+  {
+    const std::string path = "readPLY_test_binary.ply";
+    REQUIRE(igl::writePLY(
+      path,V,F,E,N,V2,VD,Vheader,FD,Fheader,Eigen::MatrixXd(),{},comments,encoding));
+    Eigen::MatrixXd V1,N1,UV1,VD1,FD1,ED1,Vr,Nr,UVr,VDr,FDr,EDr;
+    Eigen::MatrixXi F1,E1,Fr,Er;
+    std::vector<std::string> Vh1,Fh1,Eh1,c1,Vhr,Fhr,Ehr,cr;
+    REQUIRE(readPLY_stream(path,V1,F1,E1,N1,UV1,VD1,Vh1,FD1,Fh1,ED1,Eh1,c1));
+    REQUIRE(igl::readPLY(path,Vr,Fr,Er,Nr,UVr,VDr,Vhr,FDr,Fhr,EDr,Ehr,cr));
+    test_common::assert_eq(V1,Vr);
+    test_common::assert_eq(F1,Fr);
+    test_common::assert_eq(E1,Er);
+    test_common::assert_eq(N1,Nr);
+    test_common::assert_eq(UV1,UVr);
+    test_common::assert_eq(VD1,VDr);
+    test_common::assert_eq(FD1,FDr);
+    test_common::assert_eq(ED1,EDr);
+    REQUIRE(Vh1 == Vhr);
+    REQUIRE(Fh1 == Fhr);
+    REQUIRE(Eh1 == Ehr);
+    REQUIRE(c1 == cr);
+    // Every face data column survives either encoding
+    test_common::assert_near(FD,FDr,1e-6);
+    REQUIRE(Fhr == Fheader);
+    if(encoding == igl::FileEncoding::Binary)
+    {
+      test_common::assert_eq(V,Vr);
+      test_common::assert_eq(F,Fr);
+      test_common::assert_eq(N,Nr);
+      test_common::assert_eq(V2,UVr);
+      test_common::assert_eq(VD,VDr);
+      test_common::assert_eq(FD,FDr);
+      REQUIRE(Vhr == Vheader);
+      REQUIRE(cr == comments);
+    }
+    std::remove(path.c_str());
+  }
+  // Records that are exactly the rows of the output are copied at once
+  {
+    const Eigen::Matrix<float,Eigen::Dynamic,3,Eigen::RowMajor> Vf =
+      V.cast<float>();
+    const std::string path = "readPLY_test_binary_float.ply";
+    REQUIRE(igl::writePLY(path,Vf,F));
+    Eigen::Matrix<float,Eigen::Dynamic,3,Eigen::RowMajor> Vr;
+    Eigen::Matrix<unsigned int,Eigen::Dynamic,3,Eigen::RowMajor> Fr;
+    REQUIRE(igl::readPLY(path,Vr,Fr));
+    test_common::assert_eq(Vf,Vr);
+    test_common::assert_eq(Eigen::MatrixXi(Fr.cast<int>()),F);
+    std::remove(path.c_str());
+  }
+}
+
+TEST_CASE("readPLY: binary with mixed polygons", "[igl]")
+{
+  // Lists of different lengths are left to the general reader, which does
+  // not support them either
+  const std::string path = "readPLY_test_binary_mixed.ply";
+  {
+    std::ofstream f(path,std::ios::binary);
+    f<<
+      "ply\n"
+      "format binary_little_endian 1.0\n"
+      "element vertex 5\n"
+      "property float x\n"
+      "property float y\n"
+      "property float z\n"
+      "element face 2\n"
+      "property list uchar int vertex_indices\n"
+      "end_header\n";
+    for(int i = 0;i<15;i++)
+    {
+      const float x = float(i);
+      f.write(reinterpret_cast<const char*>(&x),sizeof(float));
+    }
+    const auto put_face = [&f](const std::vector<int> & face)
+    {
+      const unsigned char n = face.size();
+      f.write(reinterpret_cast<const char*>(&n),1);
+      f.write(reinterpret_cast<const char*>(face.data()),face.size()*sizeof(int));
+    };
+    put_face({0,1,2});
+    put_face({1,2,3,4});
+  }
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  REQUIRE(!igl::readPLY(path,V,F));
+  std::remove(path.c_str());
+}
+
+TEST_CASE("readPLY: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  for(const int nu : {300,1000})
+  {
+    Eigen::MatrixXd V2;
+    Eigen::MatrixXi F;
+    igl::triangulated_grid(nu,nu,V2,F);
+    Eigen::MatrixXd V(V2.rows(),3);
+    V<<V2,Eigen::VectorXd::Random(V2.rows());
+    const Eigen::MatrixXd N = V.rowwise().normalized();
+    const std::string path = "readPLY_benchmark.ply";
+    Eigen::MatrixXi E;
+    Eigen::MatrixXd D;
+    std::vector<std::string> h;
+    REQUIRE(igl::writePLY(path,V,F,E,N,V2,D,h,D,h,D,h,h,igl::FileEncoding::Binary));
+    std::ifstream file(path,std::ios::binary | std::ios::ate);
+    const double megabytes = double(file.tellg())/1e6;
+    file.close();
+    const std::string size = STR(std::fixed<<std::setprecision(1)<<megabytes);
+    Eigen::MatrixXd Vr,Nr,UVr,VD,FD,ED;
+    Eigen::MatrixXi Fr,Er;
+    std::vector<std::string> Vh,Fh,Eh,c;
+    BENCHMARK("readPLY stream ("+size+" MB)")
+    {
+      return readPLY_stream(path,Vr,Fr,Er,Nr,UVr,VD,Vh,FD,Fh,ED,Eh,c);
+    };
+    BENCHMARK("readPLY mapped ("+size+" MB)")
+    {
+      return igl::readPLY(path,Vr,Fr,Er,Nr,UVr,VD,Vh,FD,Fh,ED,Eh,c);
+    };
+    BENCHMARK("writePLY binary ("+size+" MB)")
+    {
+      return igl::writePLY(path,V,F,E,N,V2,D,h,D,h,D,h,h,igl::FileEncoding::Binary);
+    };
+    std::remove(path.c_str());
+  }
+}
@@ -0,0 +1,160 @@
+#include <test_common.h>
+#include <igl/remove_duplicate_vertices.h>
+#include <igl/triangulated_grid.h>
+#include <functional>
+#include <vector>
+
+namespace
+{
+  // Brute force welding: union all pairs within epsilon and number the sets
+  // in order of first occurrence
+  template <typename DerivedV>
+  void weld_brute_force(
+    const Eigen::MatrixBase<DerivedV> & V,
+    const double epsilon,
+    Eigen::VectorXi & SVI,
+    Eigen::VectorXi & SVJ)
+  {
+    const int n = V.rows();
+    std::vector<int> parent(n);
+    for(int i = 0;i<n;i++) { parent[i] = i; }
+    const std::function<int(int)> find = [&](int i)
+    {
+      return parent[i] == i ? i : (parent[i] = find(parent[i]));
+    };
+    for(int i = 0;i<n;i++)
+    {
+      for(int j = i+1;j<n;j++)
+      {
+        if((V.row(i)-V.row(j)).template cast<double>().norm() <= epsilon)
+        {
+          const int a = find(i), b = find(j);
+          parent[std::max(a,b)] = std::min(a,b);
+        }
+      }
+    }
+    std::vector<int> vSVI;
+    SVJ.resize(n);
+    for(int i = 0;i<n;i++)
+    {
+      const int r = find(i);
+      if(r == i)
+      {
+        SVJ(i) = vSVI.size();
+        vSVI.push_back(i);
+      }else
+      {
+        SVJ(i) = SVJ(r);
+      }
+    }
+    SVI = Eigen::Map<Eigen::VectorXi>(vSVI.data(),vSVI.size());
+  }
+}
+
+TEST_CASE("remove_duplicate_vertices: weld matches brute force", "[igl]")
+{
+  for(const int dim : {2,3})
+  {
+    for(const double epsilon : {0.0,1e-3,0.05})
+    {
+      // Clusters of nearby points, including exact copies
+      const int n = 2000;
+      Eigen::MatrixXd C = Eigen::MatrixXd::Random(n/8,dim);
+      Eigen::MatrixXd V(n,dim);
+      for(int i = 0;i<n;i++)
+      {
+        V.row(i) = C.row(i%C.rows());
+        if(i%3)
+        {
+          V.row(i) += 1e-3*Eigen::RowVectorXd::Random(dim);
+        }
+      }
+      Eigen::MatrixXd SV;
+      Eigen::VectorXi SVI,SVJ,gtSVI,gtSVJ;
+      igl::remove_duplicate_vertices(
+        V,epsilon,igl::REMOVE_DUPLICATE_VERTICES_METHOD_WELD,SV,SVI,SVJ);
+      weld_brute_force(V,epsilon,gtSVI,gtSVJ);
+      test_common::assert_eq(SVI,gtSVI);
+      test_common::assert_eq(SVJ,gtSVJ);
+      REQUIRE(SV.rows() == SVI.size());
+      for(int s = 0;s<SVI.size();s++)
+      {
+        REQUIRE(SV.row(s) == V.row(SVI(s)));
+      }
+    }
+  }
+}
+
+TEST_CASE("remove_duplicate_vertices: weld across rounding boundaries", "[igl]")
+{
+  // Triangle soup of a grid whose copies of each vertex are perturbed to
+  // either side of a rounding boundary
+  Eigen::MatrixXd GV;
+  Eigen::MatrixXi GF;
+  igl::triangulated_grid(20,20,GV,GF);
+  const double epsilon = 1e-6;
+  Eigen::MatrixXf V(GF.size(),3);
+  Eigen::MatrixXi F(GF.rows(),3);
+  for(int f = 0;f<GF.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      F(f,c) = 3*f+c;
+      V.row(F(f,c)) <<
+        GV.row(GF(f,c)).cast<float>(),
+        float((f%2 ? 0.55 : 0.45)*epsilon);
+    }
+  }
+  Eigen::MatrixXf SV;
+  Eigen::VectorXi SVI,SVJ;
+  Eigen::MatrixXi SF;
+  igl::remove_duplicate_vertices(
+    V,F,epsilon,igl::REMOVE_DUPLICATE_VERTICES_METHOD_WELD,SV,SVI,SVJ,SF);
+  REQUIRE(SV.rows() == GV.rows());
+  for(int f = 0;f<F.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      REQUIRE(SF(f,c) == SVJ(F(f,c)));
+      REQUIRE((SV.row(SF(f,c))-V.row(F(f,c))).norm() <= epsilon);
+    }
+  }
+  // Rounding keeps the two sides apart
+  Eigen::MatrixXf RSV;
+  Eigen::MatrixXi RSVI,RSVJ,RSF;
+  igl::remove_duplicate_vertices(V,F,epsilon,RSV,RSVI,RSVJ,RSF);
+  REQUIRE(RSV.rows() > SV.rows());
+}
+
+TEST_CASE("remove_duplicate_vertices: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  // Triangle soup as read from an STL file
+  Eigen::MatrixXd GV;
+  Eigen::MatrixXi GF;
+  igl::triangulated_grid(1000,1000,GV,GF);
+  Eigen::MatrixXd V(GF.size(),3);
+  Eigen::MatrixXi F(GF.rows(),3);
+  for(int f = 0;f<GF.rows();f++)
+  {
+    for(int c = 0;c<3;c++)
+    {
+      F(f,c) = 3*f+c;
+      V.row(F(f,c)) << GV.row(GF(f,c)),0;
+    }
+  }
+  Eigen::MatrixXd SV;
+  Eigen::VectorXi SVI,SVJ;
+  Eigen::MatrixXi SF;
+  BENCHMARK("remove_duplicate_vertices round")
+  {
+    igl::remove_duplicate_vertices(
+      V,F,1e-7,igl::REMOVE_DUPLICATE_VERTICES_METHOD_ROUND,SV,SVI,SVJ,SF);
+    return SV.rows();
+  };
+  BENCHMARK("remove_duplicate_vertices weld")
+  {
+    igl::remove_duplicate_vertices(
+      V,F,1e-7,igl::REMOVE_DUPLICATE_VERTICES_METHOD_WELD,SV,SVI,SVJ,SF);
+    return SV.rows();
+  };
+}
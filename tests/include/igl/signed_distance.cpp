@@ -1,5 +1,8 @@
 #include <test_common.h>
 #include <igl/signed_distance.h>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST_CASE("signed_distance: single_tet", "[igl]")
 {
@@ -74,3 +77,106 @@ TEST_CASE("signed_distance: single_triangle", "[igl]")
   }
 }
 
+
+TEST_CASE("signed_distance: SignedDistance", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(3,V,F);
+  const Eigen::MatrixXd P = 1.5*Eigen::MatrixXd::Random(500,3);
+  const igl::SignedDistance<Eigen::MatrixXd,Eigen::MatrixXi> engine(V,F);
+  for(int type = 0;type<igl::NUM_SIGNED_DISTANCE_TYPE;type++)
+  {
+    const igl::SignedDistanceType sign_type = igl::SignedDistanceType(type);
+    Eigen::VectorXd S1,S2;
+    Eigen::VectorXi I1,I2;
+    Eigen::MatrixXd C1,C2,N1,N2;
+    igl::signed_distance(P,V,F,sign_type,S1,I1,C1,N1);
+    // Several threads sharing one engine. The first query of each type also
+    // builds its sign structures concurrently.
+    const int num_threads = 4;
+    std::vector<Eigen::VectorXd> S(num_threads);
+    std::vector<Eigen::VectorXi> I(num_threads);
+    std::vector<Eigen::MatrixXd> C(num_threads),N(num_threads);
+    std::vector<std::thread> threads;
+    for(int t = 0;t<num_threads;t++)
+    {
+      threads.emplace_back([&,t]()
+      {
+        engine.signed_distance(P,sign_type,S[t],I[t],C[t],N[t]);
+      });
+    }
+    for(auto & thread : threads) { thread.join(); }
+    for(int t = 0;t<num_threads;t++)
+    {
+      // Separately built winding number hierarchies may differ in round-off
+      test_common::assert_near(S1,S[t],1e-12);
+      test_common::assert_eq(S[0],S[t]);
+      test_common::assert_eq(I1,I[t]);
+      test_common::assert_eq(C1,C[t]);
+      if(sign_type == igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL)
+      {
+        test_common::assert_eq(N1,N[t]);
+      }
+    }
+    // Bounds
+    engine.signed_distance(P,sign_type,-0.1,0.2,S2,I2,C2,N2);
+    igl::signed_distance(P,V,F,sign_type,-0.1,0.2,S1,I1,C1,N1);
+    REQUIRE(S1.hasNaN());
+    REQUIRE(S2.size() == S1.size());
+    for(int i = 0;i<S1.size();i++)
+    {
+      CAPTURE(i);
+      // Outside the bounds both are NaN
+      REQUIRE(std::isnan(S1(i)) == std::isnan(S2(i)));
+      if(!std::isnan(S1(i)))
+      {
+        REQUIRE(S2(i) == Approx(S1(i)).margin(1e-12));
+      }
+    }
+    test_common::assert_eq(I1,I2);
+    test_common::assert_eq(C1,C2);
+  }
+}
+
+TEST_CASE("signed_distance: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  // Many small batches of queries against a static mesh
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  test_common::sphere(5,V,F);
+  const Eigen::MatrixXd P = 1.5*Eigen::MatrixXd::Random(1000,3);
+  const int num_batches = 20;
+  for(const igl::SignedDistanceType sign_type :
+    {
+      igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL,
+      igl::SIGNED_DISTANCE_TYPE_WINDING_NUMBER,
+      igl::SIGNED_DISTANCE_TYPE_FAST_WINDING_NUMBER
+    })
+  {
+    const std::string name =
+      sign_type == igl::SIGNED_DISTANCE_TYPE_PSEUDONORMAL ? "pseudonormal" :
+      sign_type == igl::SIGNED_DISTANCE_TYPE_WINDING_NUMBER ? "winding number" :
+      "fast winding number";
+    Eigen::VectorXd S;
+    Eigen::VectorXi I;
+    Eigen::MatrixXd C,N;
+    BENCHMARK("signed_distance per call ("+name+")")
+    {
+      for(int b = 0;b<num_batches;b++)
+      {
+        igl::signed_distance(P,V,F,sign_type,S,I,C,N);
+      }
+      return S.sum();
+    };
+    BENCHMARK("SignedDistance built once ("+name+")")
+    {
+      const igl::SignedDistance<Eigen::MatrixXd,Eigen::MatrixXi> engine(V,F);
+      for(int b = 0;b<num_batches;b++)
+      {
+        engine.signed_distance(P,sign_type,S,I,C,N);
+      }
+      return S.sum();
+    };
+  }
+}
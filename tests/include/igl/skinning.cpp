@@ -0,0 +1,168 @@
+#include <test_common.h>
+#include <igl/skinning.h>
+#include <igl/dqs.h>
+#include <igl/lbs_matrix.h>
+#include <Eigen/Geometry>
+#include <Eigen/StdVector>
+#include <string>
+#include <vector>
+
+namespace
+{
+  typedef std::vector<Eigen::Quaterniond,
+    Eigen::aligned_allocator<Eigen::Quaterniond> > RotationList;
+
+  // Random rig: n vertices in [-1,1]³ each influenced by `nnz` of m handles
+  // with positive weights summing to one.
+  void random_rig(
+    const int n,
+    const int m,
+    const int nnz,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXd & W,
+    RotationList & vQ,
+    std::vector<Eigen::Vector3d> & vT,
+    Eigen::MatrixXd & T)
+  {
+    srand(0);
+    V = Eigen::MatrixXd::Random(n,3);
+    W = Eigen::MatrixXd::Zero(n,m);
+    for(int i = 0;i<n;i++)
+    {
+      for(int j = 0;j<nnz;j++)
+      {
+        W(i,rand()%m) += 0.1+(1.0+Eigen::internal::random<double>())/2.0;
+      }
+      W.row(i) /= W.row(i).sum();
+    }
+    vQ.resize(m);
+    vT.resize(m);
+    T.resize(4*m,3);
+    for(int c = 0;c<m;c++)
+    {
+      vQ[c] = Eigen::Quaterniond(Eigen::Vector4d::Random()).normalized();
+      // Keep quaternions in the same hemisphere
+      if(vQ[c].w() < 0) { vQ[c].coeffs() *= -1; }
+      vT[c] = Eigen::Vector3d::Random();
+      Eigen::Affine3d a = Eigen::Affine3d::Identity();
+      a.translate(vT[c]);
+      a.rotate(vQ[c]);
+      T.block(4*c,0,4,3) = a.matrix().transpose().block(0,0,4,3);
+    }
+  }
+}
+
+TEST_CASE("skinning: matches lbs_matrix and dqs", "[igl]")
+{
+  Eigen::MatrixXd V,W,T;
+  RotationList vQ;
+  std::vector<Eigen::Vector3d> vT;
+  random_rig(1000,12,4,V,W,vQ,vT,T);
+  Eigen::MatrixXd M;
+  igl::lbs_matrix(V,W,M);
+  const Eigen::MatrixXd gtLBS = M*T;
+  Eigen::MatrixXd gtDQS;
+  igl::dqs(V,W,vQ,vT,gtDQS);
+
+  igl::SkinningData<double> data;
+  // No vertex has more than 4 nonzero weights
+  for(const int k : {4,8,12})
+  {
+    igl::skinning_precompute(V,W,k,data);
+    REQUIRE(data.k == k);
+    Eigen::MatrixXd U;
+    igl::skinning_lbs(data,T,U);
+    test_common::assert_near(U,gtLBS,1e-12);
+    igl::skinning_dqs(data,vQ,vT,U);
+    test_common::assert_near(U,gtDQS,1e-12);
+  }
+  // More influences than handles
+  igl::skinning_precompute(V,W,20,data);
+  REQUIRE(data.k == 12);
+
+  // Float output
+  igl::SkinningData<float> fdata;
+  igl::skinning_precompute(V,W,4,fdata);
+  Eigen::Matrix<float,Eigen::Dynamic,3,Eigen::RowMajor> fU;
+  igl::skinning_lbs(fdata,T,fU);
+  test_common::assert_near(Eigen::MatrixXd(fU.cast<double>()),gtLBS,1e-5);
+  igl::skinning_dqs(fdata,vQ,vT,fU);
+  test_common::assert_near(Eigen::MatrixXd(fU.cast<double>()),gtDQS,1e-5);
+}
+
+TEST_CASE("skinning: top-k influences", "[igl]")
+{
+  Eigen::MatrixXd V,W,T;
+  RotationList vQ;
+  std::vector<Eigen::Vector3d> vT;
+  // Every vertex has (up to) 8 nonzero weights
+  random_rig(100,10,8,V,W,vQ,vT,T);
+  const int k = 2;
+  igl::SkinningData<double> data;
+  igl::skinning_precompute(V,W,k,data);
+  REQUIRE(data.I.rows() == V.rows());
+  REQUIRE(data.I.cols() == k);
+  for(int i = 0;i<V.rows();i++)
+  {
+    // Kept handles have the largest weights
+    REQUIRE(W(i,data.I(i,0)) >= W(i,data.I(i,1)));
+    for(int c = 0;c<W.cols();c++)
+    {
+      if(c != data.I(i,0) && c != data.I(i,1))
+      {
+        REQUIRE(W(i,c) <= W(i,data.I(i,1)));
+      }
+    }
+    // Rescaled to partition unity
+    REQUIRE(std::abs(data.W.row(i).sum()-1.0) < 1e-12);
+    REQUIRE(std::abs(
+      data.W(i,0)/data.W(i,1) - W(i,data.I(i,0))/W(i,data.I(i,1))) < 1e-12);
+  }
+  // Identity transformations are reproduced exactly
+  for(int c = 0;c<W.cols();c++)
+  {
+    T.block(4*c,0,4,3) << Eigen::Matrix3d::Identity(),Eigen::RowVector3d::Zero();
+    vQ[c] = Eigen::Quaterniond::Identity();
+    vT[c].setZero();
+  }
+  Eigen::MatrixXd U;
+  igl::skinning_lbs(data,T,U);
+  test_common::assert_near(U,V,1e-12);
+  igl::skinning_dqs(data,vQ,vT,U);
+  test_common::assert_near(U,V,1e-12);
+}
+
+TEST_CASE("skinning: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V,W,T;
+  RotationList vQ;
+  std::vector<Eigen::Vector3d> vT;
+  const int n = 250000;
+  const int m = 16;
+  random_rig(n,m,4,V,W,vQ,vT,T);
+  const std::string size =
+    std::to_string(n)+" vertices, "+std::to_string(m)+" handles";
+  Eigen::MatrixXd U;
+  BENCHMARK("dqs ("+size+")")
+  {
+    igl::dqs(V,W,vQ,vT,U);
+    return U(0,0);
+  };
+  igl::SkinningData<float> data;
+  BENCHMARK("skinning_precompute, k=4 ("+size+")")
+  {
+    igl::skinning_precompute(V,W,4,data);
+    return data.k;
+  };
+  Eigen::Matrix<float,Eigen::Dynamic,3,Eigen::RowMajor> fU;
+  BENCHMARK("skinning_dqs, k=4, float ("+size+")")
+  {
+    igl::skinning_dqs(data,vQ,vT,fU);
+    return fU(0,0);
+  };
+  BENCHMARK("skinning_lbs, k=4, float ("+size+")")
+  {
+    igl::skinning_lbs(data,T,fU);
+    return fU(0,0);
+  };
+}
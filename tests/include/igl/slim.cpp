@@ -0,0 +1,133 @@
+#include <test_common.h>
+#include <igl/slim.h>
+#include <igl/triangulated_grid.h>
+#include <string>
+
+namespace
+{
+  // Bumpy square patch and its flattening as an injective initial map
+  void bumpy_patch(
+    const int n,
+    Eigen::MatrixXd & V,
+    Eigen::MatrixXi & F,
+    Eigen::MatrixXd & V_init)
+  {
+    igl::triangulated_grid(n,n,V_init,F);
+    V.resize(V_init.rows(),3);
+    V<<V_init,
+      0.3*(3.*V_init.col(0).array()).sin()*(2.*V_init.col(1).array()).cos();
+  }
+}
+
+TEST_CASE("slim: reused factorization matches fresh solves", "[igl]")
+{
+  Eigen::MatrixXd V,V_init;
+  Eigen::MatrixXi F;
+  bumpy_patch(30,V,F,V_init);
+  const Eigen::VectorXi b;
+  const Eigen::MatrixXd bc;
+  igl::SLIMData reused,fresh;
+  igl::slim_precompute(V,F,V_init,reused,
+    igl::MappingEnergyType::SYMMETRIC_DIRICHLET,b,bc,0);
+  igl::slim_precompute(V,F,V_init,fresh,
+    igl::MappingEnergyType::SYMMETRIC_DIRICHLET,b,bc,0);
+  for(int iter = 0;iter<5;iter++)
+  {
+    igl::slim_solve(reused,1);
+    // Drop the factorization to analyze from scratch
+    fresh.solver.reset();
+    igl::slim_solve(fresh,1);
+    test_common::assert_near(reused.V_o,fresh.V_o,1e-10);
+  }
+  REQUIRE(reused.energy < 4.1);
+}
+
+TEST_CASE("slim: copies do not share the factorization", "[igl]")
+{
+  Eigen::MatrixXd V,V_init;
+  Eigen::MatrixXi F;
+  bumpy_patch(20,V,F,V_init);
+  const Eigen::VectorXi b;
+  const Eigen::MatrixXd bc;
+  igl::SLIMData data;
+  igl::slim_precompute(V,F,V_init,data,
+    igl::MappingEnergyType::SYMMETRIC_DIRICHLET,b,bc,0);
+  igl::slim_solve(data,1);
+  REQUIRE(data.solver.ptr);
+  igl::SLIMData copy(data);
+  REQUIRE(!copy.solver.ptr);
+  igl::slim_solve(data,2);
+  igl::slim_solve(copy,2);
+  REQUIRE(copy.solver.ptr);
+  REQUIRE(copy.solver.ptr != data.solver.ptr);
+  test_common::assert_near(copy.V_o,data.V_o,1e-10);
+  igl::SLIMData assigned;
+  assigned = copy;
+  REQUIRE(!assigned.solver.ptr);
+  igl::slim_solve(assigned,1);
+  igl::slim_solve(copy,1);
+  test_common::assert_near(assigned.V_o,copy.V_o,1e-10);
+}
+
+TEST_CASE("slim: iterative switch", "[igl]")
+{
+  Eigen::MatrixXd V,V_init;
+  Eigen::MatrixXi F;
+  bumpy_patch(30,V,F,V_init);
+  const Eigen::VectorXi b;
+  const Eigen::MatrixXd bc;
+  igl::SLIMData direct,switched;
+  igl::slim_precompute(V,F,V_init,direct,
+    igl::MappingEnergyType::SYMMETRIC_DIRICHLET,b,bc,0);
+  switched.iterative_switch_tolerance = 1e-2;
+  igl::slim_precompute(V,F,V_init,switched,
+    igl::MappingEnergyType::SYMMETRIC_DIRICHLET,b,bc,0);
+  double prev_energy = switched.energy;
+  for(int iter = 0;iter<20;iter++)
+  {
+    igl::slim_solve(direct,1);
+    igl::slim_solve(switched,1);
+    REQUIRE(switched.energy <= prev_energy);
+    prev_energy = switched.energy;
+  }
+  REQUIRE(switched.iterative_solve);
+  REQUIRE(switched.energy == Approx(direct.energy).epsilon(1e-4));
+}
+
+TEST_CASE("slim: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  Eigen::MatrixXd V,V_init;
+  Eigen::MatrixXi F;
+  bumpy_patch(150,V,F,V_init);
+  const Eigen::VectorXi b;
+  const Eigen::MatrixXd bc;
+  const std::string size = std::to_string(F.rows())+" faces, 10 iterations";
+  igl::SLIMData data;
+  BENCHMARK("slim analyze every iteration ("+size+")")
+  {
+    igl::slim_precompute(V,F,V_init,data,
+      igl::MappingEnergyType::SYMMETRIC_DIRICHLET,b,bc,0);
+    for(int iter = 0;iter<10;iter++)
+    {
+      data.solver.reset();
+      igl::slim_solve(data,1);
+    }
+    return data.energy;
+  };
+  BENCHMARK("slim reused analysis ("+size+")")
+  {
+    igl::slim_precompute(V,F,V_init,data,
+      igl::MappingEnergyType::SYMMETRIC_DIRICHLET,b,bc,0);
+    igl::slim_solve(data,10);
+    return data.energy;
+  };
+  BENCHMARK("slim reused analysis + iterative switch ("+size+")")
+  {
+    data.iterative_switch_tolerance = 1e-2;
+    igl::slim_precompute(V,F,V_init,data,
+      igl::MappingEnergyType::SYMMETRIC_DIRICHLET,b,bc,0);
+    igl::slim_solve(data,10);
+    data.iterative_switch_tolerance = 0;
+    return data.energy;
+  };
+}
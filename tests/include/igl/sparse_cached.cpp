@@ -0,0 +1,46 @@
+#include <test_common.h>
+#include <igl/sparse_cached.h>
+#include <igl/sparse.h>
+#include <random>
+
+TEST_CASE("sparse_cached: duplicates", "[igl]")
+{
+  const int m = 50;
+  const int n = 40;
+  const int nv = 5000;
+  std::mt19937 gen(0);
+  std::uniform_int_distribution<int> row(0,m-1);
+  std::uniform_int_distribution<int> col(0,n-2);
+  std::uniform_real_distribution<double> value(-1,1);
+  // Many duplicates, last column empty
+  Eigen::VectorXi I(nv),J(nv);
+  for(int k = 0;k<nv;k++)
+  {
+    I(k) = row(gen);
+    J(k) = col(gen);
+  }
+  igl::sparse_cached_data data;
+  Eigen::SparseMatrix<double> X;
+  igl::sparse_cached_precompute(I,J,m,n,data,X);
+  REQUIRE(X.rows() == m);
+  REQUIRE(X.cols() == n);
+  for(int iter = 0;iter<3;iter++)
+  {
+    Eigen::VectorXd V(nv);
+    for(int k = 0;k<nv;k++) { V(k) = value(gen); }
+    Eigen::SparseMatrix<double> Y;
+    igl::sparse(I,J,V,m,n,Y);
+    igl::sparse_cached(V,data,X);
+    // Same pattern and bit-identical values
+    REQUIRE(X.nonZeros() == Y.nonZeros());
+    for(int j = 0;j<=n;j++)
+    {
+      REQUIRE(X.outerIndexPtr()[j] == Y.outerIndexPtr()[j]);
+    }
+    for(int s = 0;s<X.nonZeros();s++)
+    {
+      REQUIRE(X.innerIndexPtr()[s] == Y.innerIndexPtr()[s]);
+      REQUIRE(X.valuePtr()[s] == Y.valuePtr()[s]);
+    }
+  }
+}
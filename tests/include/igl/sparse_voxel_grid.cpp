@@ -1,6 +1,8 @@
 #include <test_common.h>
 #include <igl/sparse_voxel_grid.h>
 #include <igl/unique_rows.h>
+#include <cmath>
+#include <functional>
 
 TEST_CASE("sparse_voxel_grid: unique", "[igl]" )
 {
@@ -20,3 +22,111 @@ TEST_CASE("sparse_voxel_grid: unique", "[igl]" )
   REQUIRE(GV.rows() == uGV.rows());
 }
 
+
+namespace
+{
+  // Sorted integer coordinates of the cubes of a grid of eps sized cubes
+  // centered at p0
+  Eigen::MatrixXi cube_coordinates(
+    const Eigen::RowVector3d & p0,
+    const double eps,
+    const Eigen::MatrixXd & GV,
+    const Eigen::MatrixXi & GI)
+  {
+    Eigen::MatrixXi C(GI.rows(),3);
+    for(int i = 0;i<GI.rows();i++)
+    {
+      Eigen::RowVector3d ctr = Eigen::RowVector3d::Zero();
+      for(int c = 0;c<8;c++)
+      {
+        ctr += GV.row(GI(i,c))/8.;
+      }
+      C.row(i) = ((ctr-p0)/eps).array().round().cast<int>();
+    }
+    Eigen::MatrixXi sC;
+    Eigen::VectorXi _1,_2;
+    igl::unique_rows(C,sC,_1,_2);
+    return sC;
+  }
+}
+
+TEST_CASE("sparse_voxel_grid: batched matches serial", "[igl]" )
+{
+  // Torus
+  const std::function<double(const Eigen::RowVector3d & x)> f = 
+    [](const Eigen::RowVector3d & x)->double
+  {
+    return Eigen::Vector2d(Eigen::Vector2d(x(0),x(2)).norm()-1.0,x(1)).norm()-0.3;
+  };
+  const Eigen::RowVector3d p0(1.3,0,0);
+  Eigen::MatrixXd GV;
+  Eigen::VectorXd GS;
+  Eigen::MatrixXi GI;
+  igl::sparse_voxel_grid(p0,f,0.05,1024,GS,GV,GI);
+  int num_calls = 0;
+  const std::function<void(const Eigen::Matrix<double,Eigen::Dynamic,3> &,Eigen::VectorXd &)> bf =
+    [&](const Eigen::Matrix<double,Eigen::Dynamic,3> & P,Eigen::VectorXd & S)
+  {
+    num_calls++;
+    S.resize(P.rows());
+    for(int i = 0;i<P.rows();i++) { S(i) = f(P.row(i)); }
+  };
+  for(const bool batched : {true,false})
+  {
+    Eigen::MatrixXd bGV;
+    Eigen::VectorXd bGS;
+    Eigen::MatrixXi bGI;
+    if(batched)
+    {
+      igl::sparse_voxel_grid_batched(p0,bf,0.05,1024,bGS,bGV,bGI);
+      // One call per level
+      REQUIRE(num_calls > 1);
+      REQUIRE(num_calls < bGI.rows());
+    }else
+    {
+      igl::sparse_voxel_grid(p0,f,0.05,1024,true,bGS,bGV,bGI);
+    }
+    REQUIRE(bGI.rows() == GI.rows());
+    REQUIRE(bGV.rows() == GV.rows());
+    // Same cubes, shared corners
+    test_common::assert_eq(
+      cube_coordinates(p0,0.05,bGV,bGI),cube_coordinates(p0,0.05,GV,GI));
+    Eigen::MatrixXd uGV;
+    Eigen::VectorXi _1,_2;
+    igl::unique_rows(bGV,uGV,_1,_2);
+    REQUIRE(bGV.rows() == uGV.rows());
+    for(int i = 0;i<bGV.rows();i++)
+    {
+      REQUIRE(bGS(i) == f(bGV.row(i)));
+    }
+  }
+}
+
+TEST_CASE("sparse_voxel_grid: benchmark", "[igl]" IGL_DEBUG_OFF)
+{
+  // Sphere with an artificially expensive evaluation
+  const std::function<double(const Eigen::RowVector3d & x)> f = 
+    [](const Eigen::RowVector3d & x)->double
+  {
+    double noise = 0;
+    for(int k = 1;k<=20;k++)
+    {
+      noise += std::sin(k*x(0))*std::cos(k*x(1))*std::sin(k*x(2))/(k*k);
+    }
+    return x.norm() - 1.0 + 1e-3*noise;
+  };
+  const Eigen::RowVector3d p0(0,1.0,0);
+  Eigen::MatrixXd GV;
+  Eigen::VectorXd GS;
+  Eigen::MatrixXi GI;
+  BENCHMARK("sparse_voxel_grid serial")
+  {
+    igl::sparse_voxel_grid(p0,f,0.05,1<<14,GS,GV,GI);
+    return GI.rows();
+  };
+  BENCHMARK("sparse_voxel_grid parallel levels")
+  {
+    igl::sparse_voxel_grid(p0,f,0.05,1<<14,true,GS,GV,GI);
+    return GI.rows();
+  };
+}
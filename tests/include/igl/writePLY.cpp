@@ -1,6 +1,8 @@
 #include <test_common.h>
 #include <igl/readPLY.h>
 #include <igl/writePLY.h>
+#include <igl/triangulated_grid.h>
+#include <cstdio>
 #include <fstream>
 #include <string>
 #include <vector>
@@ -88,6 +90,7 @@ TEST_CASE("writePLY: bunny.ply", "[igl]")
 
     // there are comments
     REQUIRE (comments.size() == 2);
+    std::remove("writePLY_test_bunny.ply");
 }
 
 
@@ -163,4 +166,39 @@ TEST_CASE("writePLY: bunny.ply float", "[igl]")
 
     // there are comments
     REQUIRE (comments.size() == 2);
+    std::remove("writePLY_test_bunny_float.ply");
+}
+
+TEST_CASE("writePLY: edges", "[igl]")
+{
+  Eigen::MatrixXd V;
+  Eigen::MatrixXi F;
+  igl::triangulated_grid(4,3,V,F);
+  V.conservativeResize(V.rows(),3);
+  V.col(2).setZero();
+  Eigen::MatrixXi E(3,2);
+  E<<0,1, 1,2, 2,3;
+  Eigen::MatrixXf ED(3,1);
+  ED<<0.5,1.5,2.5;
+  const std::vector<std::string> Eheader = {"length"};
+  Eigen::MatrixXd empty;
+  for(const auto encoding : {igl::FileEncoding::Binary,igl::FileEncoding::Ascii})
+  {
+    REQUIRE(igl::writePLY(
+      "writePLY_test_edges.ply",V,F,E,empty,empty,empty,{},empty,{},ED,Eheader,{},
+      encoding));
+    Eigen::MatrixXd Vr,N,UV,VD,FD;
+    Eigen::MatrixXf EDr;
+    Eigen::MatrixXi Fr,Er;
+    std::vector<std::string> Vh,Fh,Eh,c;
+    REQUIRE(igl::readPLY("writePLY_test_edges.ply",Vr,Fr,Er,N,UV,VD,Vh,FD,Fh,EDr,Eh,c));
+    test_common::assert_near(V,Vr,1e-6);
+    test_common::assert_eq(F,Fr);
+    test_common::assert_eq(E,Er);
+    test_common::assert_eq(ED,EDr);
+    REQUIRE(Eh == Eheader);
+    REQUIRE(N.size() == 0);
+    REQUIRE(Vh.empty());
+  }
+  std::remove("writePLY_test_edges.ply");
 }
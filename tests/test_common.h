@@ -6,6 +6,9 @@
 #include <igl/readDMAT.h>
 
 #include <igl/find.h>
+#include <igl/triangulated_grid.h>
+#include <igl/PI.h>
+#include <igl/upsample.h>
 
 #include <Eigen/Core>
 #include <catch2/catch.hpp>
@@ -119,6 +122,41 @@ namespace test_common
     return std::string(LIBIGL_DATA_DIR) + "/" + s;
   };
 
+  // Unit sphere-like mesh: icosahedron upsampled n times (20*4^n triangles)
+  // and projected onto the sphere
+  inline void sphere(const int n, Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    const double t = (1.+sqrt(5.))/2.;
+    V.resize(12,3);
+    V<<
+      -1,t,0, 1,t,0, -1,-t,0, 1,-t,0,
+      0,-1,t, 0,1,t, 0,-1,-t, 0,1,-t,
+      t,0,-1, t,0,1, -t,0,-1, -t,0,1;
+    F.resize(20,3);
+    F<<
+      0,11,5, 0,5,1, 0,1,7, 0,7,10, 0,10,11,
+      1,5,9, 5,11,4, 11,10,2, 10,7,6, 7,1,8,
+      3,9,4, 3,4,2, 3,2,6, 3,6,8, 3,8,9,
+      4,9,5, 2,4,11, 6,2,10, 8,6,7, 9,8,1;
+    igl::upsample(Eigen::MatrixXd(V),Eigen::MatrixXi(F),V,F,n);
+    V.rowwise().normalize();
+  }
+
+  // Parametric torus with nu*nv vertices
+  inline void torus(
+    const int nu, const int nv, Eigen::MatrixXd & V, Eigen::MatrixXi & F)
+  {
+    Eigen::MatrixXd UV;
+    igl::triangulated_grid(nu,nv,UV,F);
+    V.resize(UV.rows(),3);
+    for(int i = 0;i<UV.rows();i++)
+    {
+      const double u = 2.*igl::PI*UV(i,0);
+      const double v = 2.*igl::PI*UV(i,1);
+      V.row(i) << (1.+0.3*cos(v))*cos(u), (1.+0.3*cos(v))*sin(u), 0.3*sin(v);
+    }
+  }
+
   template <typename DerivedA, typename DerivedB>
   void assert_eq(
     const Eigen::MatrixBase<DerivedA> & A,
@@ -18,6 +18,8 @@ int main(int argc, char *argv[])
   igl::opengl::glfw::Viewer viewer;
   // Load a mesh in OFF format
   igl::readOBJ(TUTORIAL_SHARED_PATH "/armadillo.obj", V, F);
+  // Build the mesh data structure once for all queries
+  const igl::ExactGeodesic geodesic(V,F);
 
   const auto update_distance = [&](const int vid)
   {
@@ -29,7 +31,7 @@ int main(int argc, char *argv[])
     VT.setLinSpaced(V.rows(),0,V.rows()-1);
     Eigen::VectorXd d;
     std::cout<<"Computing geodesic distance to vertex "<<vid<<"..."<<std::endl;
-    igl::exact_geodesic(V,F,VS,FS,VT,FT,d);
+    geodesic.distance(VS,FS,VT,FT,d);
     // Plot the mesh
     Eigen::MatrixXd CM;
     igl::parula(Eigen::VectorXd::LinSpaced(21,0,1).eval(),false,CM);
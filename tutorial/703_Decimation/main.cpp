@@ -35,7 +35,7 @@ int main(int argc, char * argv[])
   // Prepare array-based edge data structures and priority queue
   VectorXi EMAP;
   MatrixXi E,EF,EI;
-  igl::min_heap< std::tuple<double,int,int> > Q;
+  igl::IndexedPriorityQueue<double> Q;
   Eigen::VectorXi EQ;
   // If an edge were collapsed, we'd collapse it to these points:
   MatrixXd C;
@@ -49,9 +49,6 @@ int main(int argc, char * argv[])
     edge_flaps(F,E,EMAP,EF,EI);
     C.resize(E.rows(),V.cols());
     VectorXd costs(E.rows());
-    // https://stackoverflow.com/questions/2852140/priority-queue-clear-method
-    // Q.clear();
-    Q = {};
     EQ = Eigen::VectorXi::Zero(E.rows());
     {
       Eigen::VectorXd costs(E.rows());
@@ -63,10 +60,7 @@ int main(int argc, char * argv[])
         C.row(e) = p;
         costs(e) = cost;
       },10000);
-      for(int e = 0;e<E.rows();e++)
-      {
-        Q.emplace(costs(e),e,0);
-      }
+      Q.init(costs);
     }
 
     num_collapsed = 0;